@@ -12,5 +12,6 @@
 #include "azure/data/appconfiguration/configuration_client_models.hpp"
 #include "azure/data/appconfiguration/configuration_client_options.hpp"
 #include "azure/data/appconfiguration/configuration_client_paged_responses.hpp"
+#include "azure/data/appconfiguration/configuration_store.hpp"
 #include "azure/data/appconfiguration/dll_import_export.hpp"
 #include "azure/data/appconfiguration/rtti.hpp"
@@ -0,0 +1,196 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief A local copy of App Configuration settings which is refreshed incrementally.
+ *
+ */
+
+#pragma once
+
+#include "configuration_client.hpp"
+#include "configuration_client_models.hpp"
+
+#include <azure/core/context.hpp>
+#include <azure/core/nullable.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Azure { namespace Data { namespace AppConfiguration {
+
+  /**
+   * @brief A setting which is updated last when the application configuration changes, so that a
+   * change can be detected without checking every setting.
+   *
+   */
+  struct ConfigurationSentinel final
+  {
+    /**
+     * @brief The key of the setting.
+     *
+     */
+    std::string Key;
+
+    /**
+     * @brief The label of the setting, empty for no label.
+     *
+     */
+    std::string Label;
+  };
+
+  /**
+   * @brief Options for ConfigurationStore.
+   *
+   */
+  struct ConfigurationStoreOptions final
+  {
+    /**
+     * @brief The filter on the keys of the loaded settings, such as `app1*`. All the keys
+     * are loaded if empty.
+     *
+     */
+    std::string KeyFilter;
+
+    /**
+     * @brief The filter on the labels of the loaded settings. Settings with any label are loaded
+     * if empty.
+     *
+     */
+    std::string LabelFilter;
+
+    /**
+     * @brief The name of a snapshot to load the settings from, instead of the filters.
+     *
+     * @remark Snapshots never change, so a store loaded from a snapshot is never refreshed.
+     */
+    std::string Snapshot;
+
+    /**
+     * @brief The settings which are checked to detect a change before the settings are reloaded.
+     *
+     * @remark When there are no sentinels, every page of settings is checked for changes.
+     */
+    std::vector<ConfigurationSentinel> Sentinels;
+  };
+
+  namespace _detail {
+    // A page of settings, as last returned by the service.
+    struct ConfigurationPage final
+    {
+      // The token which requests the page, empty for the first page.
+      std::string PageToken;
+      std::string NextPageToken;
+      std::string ETag;
+      std::vector<KeyValue> Items;
+    };
+  } // namespace _detail
+
+  /**
+   * @brief Keeps a local copy of the settings selected from an App Configuration store.
+   *
+   * @details Settings are loaded once, and refreshing only requests what may have changed: the
+   * sentinels are checked with HEAD requests, and the pages of settings are requested with the
+   * ETag of their last version so that unchanged pages are neither downloaded nor parsed again.
+   *
+   * Lookups are served from an immutable copy of the settings which is replaced when they are
+   * refreshed, so they never wait for a refresh and may be done from any number of threads.
+   *
+   */
+  class ConfigurationStore final {
+  public:
+    /**
+     * @brief Construct a new store.
+     *
+     * @param client The client used to load the settings.
+     * @param options Options which select the settings to load.
+     */
+    explicit ConfigurationStore(
+        std::shared_ptr<ConfigurationClient const> client,
+        ConfigurationStoreOptions options = {});
+
+    ~ConfigurationStore();
+
+    ConfigurationStore(ConfigurationStore const&) = delete;
+    ConfigurationStore& operator=(ConfigurationStore const&) = delete;
+
+    /**
+     * @brief Loads every selected setting, replacing the settings loaded previously.
+     *
+     * @param context The context for cancelling the operation.
+     */
+    void Load(Core::Context const& context = {});
+
+    /**
+     * @brief Reloads the settings which have changed since they were loaded.
+     *
+     * @remark The settings are loaded if they have not been loaded yet.
+     *
+     * @param context The context for cancelling the operation.
+     * @return `true` if the settings have changed.
+     */
+    bool Refresh(Core::Context const& context = {});
+
+    /**
+     * @brief Gets a setting.
+     *
+     * @param key The key of the setting.
+     * @param label The label of the setting, empty for no label.
+     * @return The setting, or no value if it was not loaded.
+     */
+    Nullable<KeyValue> GetKeyValue(std::string const& key, std::string const& label = {}) const;
+
+    /**
+     * @brief Gets every loaded setting, ordered by key and label.
+     *
+     */
+    std::vector<KeyValue> GetKeyValues() const;
+
+    /**
+     * @brief Gets the number of loaded settings.
+     *
+     */
+    std::size_t Size() const;
+
+  private:
+    // Key and label.
+    using SettingsMap = std::map<std::pair<std::string, std::string>, KeyValue>;
+
+    // Loads the settings and the sentinels, with m_refreshMutex held.
+    void LoadAll(Core::Context const& context);
+
+    // Returns the pages of the selected settings, requesting only the pages which have changed.
+    std::vector<_detail::ConfigurationPage> LoadPages(
+        std::vector<_detail::ConfigurationPage> const& previousPages,
+        bool& changed,
+        Core::Context const& context) const;
+
+    // Returns the ETag of a sentinel, or an empty string if it does not exist.
+    std::string CheckSentinel(
+        ConfigurationSentinel const& sentinel,
+        std::string const& previousETag,
+        Core::Context const& context) const;
+
+    void Publish(std::vector<_detail::ConfigurationPage> pages);
+
+    std::shared_ptr<SettingsMap const> GetSettings() const;
+
+    std::shared_ptr<ConfigurationClient const> m_client;
+    ConfigurationStoreOptions m_options;
+
+    // Serializes loads and refreshes, and guards the state below.
+    std::mutex m_refreshMutex;
+    bool m_loaded{false};
+    std::vector<_detail::ConfigurationPage> m_pages;
+    std::vector<std::string> m_sentinelETags;
+
+    // Read without locking, replaced atomically.
+    std::shared_ptr<SettingsMap const> m_settings;
+  };
+}}} // namespace Azure::Data::AppConfiguration
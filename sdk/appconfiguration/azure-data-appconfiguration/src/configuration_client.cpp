@@ -185,7 +185,11 @@ ConfigurationClient::ConfigurationClient(
   }
 
   m_pipeline.reset(new Core::Http::_internal::HttpPipeline(
-      {}, "data-appconfiguration", PackageVersion::ToString(), std::move(perRetryPolicies), {}));
+      options,
+      "data-appconfiguration",
+      PackageVersion::ToString(),
+      std::move(perRetryPolicies),
+      {}));
 }
 
 std::string ConfigurationClient::GetUrl() const { return m_url.GetAbsoluteUrl(); }
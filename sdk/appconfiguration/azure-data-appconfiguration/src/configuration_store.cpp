@@ -0,0 +1,246 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/data/appconfiguration/configuration_store.hpp"
+
+#include <azure/core/exception.hpp>
+#include <azure/core/http/http_status_code.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+
+using namespace Azure::Data::AppConfiguration;
+using namespace Azure::Data::AppConfiguration::_detail;
+using Azure::Core::RequestFailedException;
+using Azure::Core::Http::HttpStatusCode;
+
+namespace {
+constexpr char const KeyValuesAccept[]
+    = "application/vnd.microsoft.appconfig.kvset+json, application/problem+json";
+} // namespace
+
+ConfigurationStore::ConfigurationStore(
+    std::shared_ptr<ConfigurationClient const> client,
+    ConfigurationStoreOptions options)
+    : m_client(std::move(client)), m_options(std::move(options)),
+      m_settings(std::make_shared<SettingsMap const>())
+{
+  if (!m_client)
+  {
+    throw std::invalid_argument("client cannot be null.");
+  }
+}
+
+ConfigurationStore::~ConfigurationStore() = default;
+
+void ConfigurationStore::Load(Core::Context const& context)
+{
+  std::lock_guard<std::mutex> lock(m_refreshMutex);
+  LoadAll(context);
+}
+
+void ConfigurationStore::LoadAll(Core::Context const& context)
+{
+  // Sentinels are checked first, so that a change made while the pages are loaded is detected by
+  // the next refresh.
+  std::vector<std::string> sentinelETags;
+  for (auto const& sentinel : m_options.Sentinels)
+  {
+    sentinelETags.emplace_back(CheckSentinel(sentinel, std::string(), context));
+  }
+
+  bool changed = false;
+  auto pages = LoadPages({}, changed, context);
+
+  m_sentinelETags = std::move(sentinelETags);
+  Publish(std::move(pages));
+  m_loaded = true;
+}
+
+bool ConfigurationStore::Refresh(Core::Context const& context)
+{
+  std::lock_guard<std::mutex> lock(m_refreshMutex);
+  if (!m_loaded)
+  {
+    LoadAll(context);
+    return true;
+  }
+
+  if (!m_options.Snapshot.empty())
+  {
+    return false;
+  }
+
+  std::vector<std::string> sentinelETags;
+  if (!m_options.Sentinels.empty())
+  {
+    bool sentinelChanged = false;
+    for (size_t i = 0; i < m_options.Sentinels.size(); ++i)
+    {
+      sentinelETags.emplace_back(
+          CheckSentinel(m_options.Sentinels[i], m_sentinelETags[i], context));
+      sentinelChanged = sentinelChanged || sentinelETags.back() != m_sentinelETags[i];
+    }
+
+    if (!sentinelChanged)
+    {
+      return false;
+    }
+  }
+
+  bool changed = false;
+  auto pages = LoadPages(m_pages, changed, context);
+
+  // The sentinel ETags are only updated once the settings are reloaded, so that a failed reload
+  // is attempted again by the next refresh.
+  if (!m_options.Sentinels.empty())
+  {
+    m_sentinelETags = std::move(sentinelETags);
+  }
+
+  if (changed)
+  {
+    Publish(std::move(pages));
+  }
+
+  return changed;
+}
+
+Azure::Nullable<KeyValue> ConfigurationStore::GetKeyValue(
+    std::string const& key,
+    std::string const& label) const
+{
+  auto const settings = GetSettings();
+  auto const setting = settings->find(std::make_pair(key, label));
+  if (setting == settings->end())
+  {
+    return {};
+  }
+
+  return setting->second;
+}
+
+std::vector<KeyValue> ConfigurationStore::GetKeyValues() const
+{
+  auto const settings = GetSettings();
+  std::vector<KeyValue> keyValues;
+  keyValues.reserve(settings->size());
+  for (auto const& setting : *settings)
+  {
+    keyValues.emplace_back(setting.second);
+  }
+
+  return keyValues;
+}
+
+std::size_t ConfigurationStore::Size() const { return GetSettings()->size(); }
+
+std::vector<ConfigurationPage> ConfigurationStore::LoadPages(
+    std::vector<ConfigurationPage> const& previousPages,
+    bool& changed,
+    Core::Context const& context) const
+{
+  std::vector<ConfigurationPage> pages;
+  std::string pageToken;
+  do
+  {
+    // A page can only be compared with its previous version while the pages before it have kept
+    // their boundaries.
+    auto const index = pages.size();
+    ConfigurationPage const* previousPage
+        = index < previousPages.size() && previousPages[index].PageToken == pageToken
+        ? &previousPages[index]
+        : nullptr;
+
+    GetKeyValuesOptions options;
+    options.Key = m_options.KeyFilter;
+    options.Label = m_options.LabelFilter;
+    options.Snapshot = m_options.Snapshot;
+    options.NextPageToken = pageToken;
+    if (previousPage != nullptr)
+    {
+      options.IfNoneMatch = previousPage->ETag;
+    }
+
+    ConfigurationPage page;
+    try
+    {
+      auto response = m_client->GetKeyValues(KeyValuesAccept, options, context);
+      page.PageToken = pageToken;
+      page.ETag = response.ETag;
+      if (response.NextPageToken.HasValue())
+      {
+        page.NextPageToken = response.NextPageToken.Value();
+      }
+      if (response.Items.HasValue())
+      {
+        page.Items = std::move(response.Items.Value());
+      }
+      changed = true;
+    }
+    catch (RequestFailedException const& e)
+    {
+      if (previousPage == nullptr || e.StatusCode != HttpStatusCode::NotModified)
+      {
+        throw;
+      }
+      page = *previousPage;
+    }
+
+    pageToken = page.NextPageToken;
+    pages.emplace_back(std::move(page));
+  } while (!pageToken.empty());
+
+  // Pages removed from the end.
+  changed = changed || pages.size() != previousPages.size();
+  return pages;
+}
+
+std::string ConfigurationStore::CheckSentinel(
+    ConfigurationSentinel const& sentinel,
+    std::string const& previousETag,
+    Core::Context const& context) const
+{
+  CheckKeyValueOptions options;
+  options.Label = sentinel.Label;
+  options.IfNoneMatch = previousETag;
+  try
+  {
+    return m_client->CheckKeyValue(sentinel.Key, options, context).Value.ETag;
+  }
+  catch (RequestFailedException const& e)
+  {
+    if (e.StatusCode == HttpStatusCode::NotModified)
+    {
+      return previousETag;
+    }
+    if (e.StatusCode == HttpStatusCode::NotFound)
+    {
+      return std::string();
+    }
+    throw;
+  }
+}
+
+void ConfigurationStore::Publish(std::vector<ConfigurationPage> pages)
+{
+  auto settings = std::make_shared<SettingsMap>();
+  for (auto const& page : pages)
+  {
+    for (auto const& item : page.Items)
+    {
+      settings->emplace(
+          std::make_pair(item.Key, item.Label.HasValue() ? item.Label.Value() : std::string()),
+          item);
+    }
+  }
+
+  m_pages = std::move(pages);
+  std::atomic_store(&m_settings, std::shared_ptr<SettingsMap const>(std::move(settings)));
+}
+
+std::shared_ptr<ConfigurationStore::SettingsMap const> ConfigurationStore::GetSettings() const
+{
+  return std::atomic_load(&m_settings);
+}
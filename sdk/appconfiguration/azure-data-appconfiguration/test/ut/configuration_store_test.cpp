@@ -0,0 +1,217 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <azure/core/test/test_proxy_manager.hpp>
+#include <azure/core/test/test_transport.hpp>
+#include <azure/data/appconfiguration.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Azure::Data::AppConfiguration;
+using Azure::Core::Http::HttpStatusCode;
+using Azure::Core::Http::RawResponse;
+using Azure::Core::Http::Request;
+
+namespace {
+struct TestSetting final
+{
+  std::string Key;
+  std::string Label;
+  std::string Value;
+  std::string ETag;
+};
+
+// Serves settings two per page, with a page ETag derived from the ETags of its settings, and a
+// sentinel setting at `kv/sentinel`.
+class TestConfigurationTransport final : public Azure::Core::Test::TestTransport {
+  std::unique_ptr<RawResponse> CreateResponse(
+      HttpStatusCode statusCode,
+      std::string const& etag,
+      std::string body = {})
+  {
+    bool const hasBody = !body.empty();
+    auto response = TestTransport::CreateResponse(statusCode, std::move(body));
+    if (hasBody)
+    {
+      response->SetHeader("Content-Type", "application/vnd.microsoft.appconfig.kvset+json");
+    }
+    response->SetHeader("Sync-Token", "token=1;sn=1");
+    response->SetHeader("ETag", etag);
+    return response;
+  }
+
+public:
+  std::vector<TestSetting> Settings;
+  std::string SentinelETag = "\"s1\"";
+  std::vector<std::string> Requests;
+  int ChangedPages = 0;
+
+  std::unique_ptr<RawResponse> Send(Request& request, Azure::Core::Context const&) override
+  {
+    auto const path = request.GetUrl().GetPath();
+    auto const ifNoneMatch = request.GetHeader("If-None-Match");
+    Requests.emplace_back(request.GetMethod().ToString() + " " + path);
+
+    if (path == "kv/sentinel")
+    {
+      if (ifNoneMatch.HasValue() && ifNoneMatch.Value() == SentinelETag)
+      {
+        return CreateResponse(HttpStatusCode::NotModified, SentinelETag);
+      }
+      return CreateResponse(HttpStatusCode::Ok, SentinelETag);
+    }
+
+    size_t const page = path == "kv" ? 0 : std::stoul(path.substr(std::string("kv/page").size()));
+    std::string etag = "\"";
+    std::string items;
+    for (size_t i = page * 2; i < Settings.size() && i < page * 2 + 2; ++i)
+    {
+      auto const& setting = Settings[i];
+      etag += setting.ETag;
+      items += std::string(items.empty() ? "" : ",") + "{\"key\":\"" + setting.Key
+          + "\",\"label\":" + (setting.Label.empty() ? "null" : "\"" + setting.Label + "\"")
+          + ",\"value\":\"" + setting.Value + "\",\"etag\":\"" + setting.ETag + "\"}";
+    }
+    etag += "\"";
+
+    if (ifNoneMatch.HasValue() && ifNoneMatch.Value() == etag)
+    {
+      return CreateResponse(HttpStatusCode::NotModified, etag);
+    }
+
+    ++ChangedPages;
+    std::string body = "{\"items\":[" + items + "]";
+    if (Settings.size() > page * 2 + 2)
+    {
+      body += ",\"@nextLink\":\"/kv/page" + std::to_string(page + 1) + "\"";
+    }
+    body += "}";
+    return CreateResponse(HttpStatusCode::Ok, etag, body);
+  }
+};
+
+std::shared_ptr<ConfigurationClient const> CreateClient(
+    std::shared_ptr<TestConfigurationTransport> transport)
+{
+  ConfigurationClientOptions options;
+  options.Retry.MaxRetries = 0;
+  options.Transport.Transport = transport;
+  return std::make_shared<ConfigurationClient>(
+      "https://test.azconfig.io",
+      std::make_shared<Azure::Core::Test::TestNonExpiringCredential>(),
+      options);
+}
+
+std::shared_ptr<TestConfigurationTransport> CreateTransport()
+{
+  auto transport = std::make_shared<TestConfigurationTransport>();
+  transport->Settings = {
+      {"app/color", "", "red", "a1"},
+      {"app/color", "prod", "blue", "b1"},
+      {"app/size", "", "10", "c1"},
+  };
+  return transport;
+}
+} // namespace
+
+TEST(ConfigurationStore, Load)
+{
+  auto transport = CreateTransport();
+  ConfigurationStore store(CreateClient(transport));
+  store.Load();
+
+  EXPECT_EQ(store.Size(), 3u);
+  EXPECT_EQ(store.GetKeyValue("app/color").Value().Value.Value(), "red");
+  EXPECT_EQ(store.GetKeyValue("app/color", "prod").Value().Value.Value(), "blue");
+  EXPECT_EQ(store.GetKeyValue("app/size").Value().Value.Value(), "10");
+  EXPECT_FALSE(store.GetKeyValue("app/size", "prod").HasValue());
+  EXPECT_FALSE(store.GetKeyValue("app/missing").HasValue());
+  EXPECT_EQ(store.GetKeyValues().size(), 3u);
+  EXPECT_EQ(transport->ChangedPages, 2);
+}
+
+TEST(ConfigurationStore, RefreshWithoutChanges)
+{
+  auto transport = CreateTransport();
+  ConfigurationStore store(CreateClient(transport));
+  store.Load();
+
+  EXPECT_FALSE(store.Refresh());
+  // Both pages were checked, neither was downloaded again.
+  EXPECT_EQ(transport->Requests.size(), 4u);
+  EXPECT_EQ(transport->ChangedPages, 2);
+  EXPECT_EQ(store.Size(), 3u);
+}
+
+TEST(ConfigurationStore, RefreshReloadsChangedPages)
+{
+  auto transport = CreateTransport();
+  ConfigurationStore store(CreateClient(transport));
+  store.Load();
+
+  transport->Settings[2] = {"app/size", "", "20", "c2"};
+  EXPECT_TRUE(store.Refresh());
+  EXPECT_EQ(transport->ChangedPages, 3);
+  EXPECT_EQ(store.GetKeyValue("app/size").Value().Value.Value(), "20");
+  EXPECT_EQ(store.GetKeyValue("app/color").Value().Value.Value(), "red");
+
+  // Settings added at the end fill the last page and add a new one.
+  transport->Settings.push_back({"app/text", "", "a", "d1"});
+  transport->Settings.push_back({"app/width", "", "5", "e1"});
+  EXPECT_TRUE(store.Refresh());
+  EXPECT_EQ(store.Size(), 5u);
+
+  transport->Settings.resize(2);
+  EXPECT_TRUE(store.Refresh());
+  EXPECT_EQ(store.Size(), 2u);
+  EXPECT_FALSE(store.GetKeyValue("app/size").HasValue());
+}
+
+TEST(ConfigurationStore, SentinelGatesRefresh)
+{
+  auto transport = CreateTransport();
+  ConfigurationStoreOptions options;
+  options.Sentinels.push_back({"sentinel", ""});
+  ConfigurationStore store(CreateClient(transport), options);
+  store.Load();
+  transport->Requests.clear();
+
+  // A change without a sentinel update is not detected.
+  transport->Settings[0].Value = "green";
+  transport->Settings[0].ETag = "a2";
+  EXPECT_FALSE(store.Refresh());
+  ASSERT_EQ(transport->Requests.size(), 1u);
+  EXPECT_EQ(transport->Requests[0], "HEAD kv/sentinel");
+  EXPECT_EQ(store.GetKeyValue("app/color").Value().Value.Value(), "red");
+
+  transport->SentinelETag = "\"s2\"";
+  EXPECT_TRUE(store.Refresh());
+  EXPECT_EQ(store.GetKeyValue("app/color").Value().Value.Value(), "green");
+  EXPECT_FALSE(store.Refresh());
+}
+
+TEST(ConfigurationStore, SnapshotIsNotRefreshed)
+{
+  auto transport = CreateTransport();
+  ConfigurationStoreOptions options;
+  options.Snapshot = "release";
+  ConfigurationStore store(CreateClient(transport), options);
+
+  // The first refresh loads the settings.
+  EXPECT_TRUE(store.Refresh());
+  auto const requests = transport->Requests.size();
+  EXPECT_FALSE(store.Refresh());
+  EXPECT_EQ(transport->Requests.size(), requests);
+  EXPECT_EQ(store.Size(), 3u);
+}
+
+TEST(ConfigurationStore, NullClient)
+{
+  EXPECT_THROW(ConfigurationStore(nullptr), std::invalid_argument);
+}
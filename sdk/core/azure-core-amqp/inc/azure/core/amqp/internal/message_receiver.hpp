@@ -81,6 +81,23 @@ namespace Azure { namespace Core { namespace Amqp { namespace _internal {
      * client. */
     uint32_t MaxLinkCredit{};
 
+    /** @brief The minimum link credit used when communicating with the service.
+     *
+     * When non-zero and less than MaxLinkCredit, the link credit is adjusted between
+     * MinLinkCredit and MaxLinkCredit based on how quickly the application consumes received
+     * messages. Credit grows when the application waits for messages and shrinks when received
+     * messages are left unconsumed.
+     */
+    uint32_t MinLinkCredit{};
+
+    /** @brief The maximum number of message body bytes which may be buffered by the receiver.
+     *
+     * When the application has not consumed this many bytes of received messages, the link credit
+     * is reduced to MinLinkCredit (or one, if MinLinkCredit is not set) until the application
+     * catches up.
+     */
+    Nullable<uint64_t> MaxBufferedBytes;
+
     /** @brief Attach properties for the link associated with the message receiver. */
     Models::AmqpMap Properties;
 
@@ -91,6 +108,24 @@ namespace Azure { namespace Core { namespace Amqp { namespace _internal {
     bool AuthenticationRequired{true};
   };
 
+  /** @brief Metrics describing the receive buffer of a message receiver. */
+  struct MessageReceiverMetrics final
+  {
+    /** @brief The number of received messages which have not been consumed by the application. */
+    uint64_t BufferedMessages{};
+
+    /** @brief The body size, in bytes, of the messages counted in BufferedMessages. Only tracked
+     * when MinLinkCredit or MaxBufferedBytes is set.
+     */
+    uint64_t BufferedBytes{};
+
+    /** @brief The link credit currently granted to the remote node. */
+    uint32_t LinkCredit{};
+
+    /** @brief The number of times the application waited for a message with none buffered. */
+    uint64_t CreditStalls{};
+  };
+
 #if ENABLE_UAMQP
   class MessageReceiverEvents {
   protected:
@@ -161,6 +196,13 @@ namespace Azure { namespace Core { namespace Amqp { namespace _internal {
      * @return The name of the underlying link object.
      */
     std::string GetLinkName() const;
+
+    /** @brief Gets the current receive buffer metrics.
+     *
+     * @return The number of buffered messages and bytes, the current link credit, and the number
+     * of credit stalls observed by the receiver.
+     */
+    MessageReceiverMetrics GetMetrics() const;
 #endif
     /** @brief Gets the Address of the message receiver's source node.
      *
@@ -15,6 +15,7 @@
 
 #include <azure/core/nullable.hpp>
 
+#include <memory>
 #include <tuple>
 
 #if defined(_azure_TESTING_BUILD)
@@ -28,6 +29,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace Tests { namespace
 namespace Azure { namespace Core { namespace Amqp { namespace _detail {
   class MessageSenderImpl;
   class MessageSenderFactory;
+  class MessageSendOperation;
 }}}} // namespace Azure::Core::Amqp::_detail
 
 namespace Azure { namespace Core { namespace Amqp { namespace _internal {
@@ -122,6 +124,15 @@ namespace Azure { namespace Core { namespace Amqp { namespace _internal {
      */
     Nullable<uint32_t> InitialDeliveryCount;
 
+    /** @brief The maximum number of messages which may be awaiting settlement at once.
+     *
+     * Bounds the number of deliveries SendAsync will have outstanding on the link. When the limit
+     * is reached, SendAsync blocks until the remote node settles an outstanding delivery. If this
+     * is zero, the limit is MaxLinkCredits; if both are zero, the number of outstanding
+     * deliveries is not limited.
+     */
+    std::uint32_t MaxOutstandingSends{};
+
     /** @brief If true, the message sender will log trace events. */
     bool EnableTrace{false};
 
@@ -129,6 +140,35 @@ namespace Azure { namespace Core { namespace Amqp { namespace _internal {
     bool AuthenticationRequired{true};
   };
 
+#if ENABLE_UAMQP
+  /** @brief The outcome of a message send started with MessageSender::SendAsync.
+   *
+   * The send completes when the remote node settles the delivery, independently of whether the
+   * completion is waited on.
+   */
+  class MessageSendCompletion final {
+  public:
+    /** @brief Wait for the remote node to settle the message.
+     *
+     * @param context The context to use for the wait. Cancelling the context abandons the wait, it
+     * does not cancel the send.
+     *
+     * @return A tuple containing the status of the send operation and the send disposition.
+     */
+    _azure_NODISCARD std::tuple<MessageSendStatus, Models::_internal::AmqpError> Wait(
+        Context const& context = {}) const;
+
+  private:
+    MessageSendCompletion(std::shared_ptr<_detail::MessageSendOperation> operation)
+        : m_operation{std::move(operation)}
+    {
+    }
+
+    friend class _detail::MessageSenderImpl;
+    std::shared_ptr<_detail::MessageSendOperation> m_operation;
+  };
+#endif
+
   class MessageSender final {
   public:
 #if ENABLE_UAMQP
@@ -181,6 +221,21 @@ namespace Azure { namespace Core { namespace Amqp { namespace _internal {
     _azure_NODISCARD std::tuple<MessageSendStatus, Models::_internal::AmqpError> Send(
         Models::AmqpMessage const& message,
         Context const& context = {});
+
+    /** @brief Start sending a message to the target of the message sender.
+     *
+     * Several messages may be in flight on the link at once, up to the MaxOutstandingSends limit
+     * in the sender options. If that many deliveries are already awaiting settlement, this blocks
+     * until one of them is settled or the context is cancelled.
+     *
+     * @param message The message to send.
+     * @param context The context to use for the operation.
+     *
+     * @return A completion which can be used to wait for the outcome of the send.
+     */
+    MessageSendCompletion SendAsync(
+        Models::AmqpMessage const& message,
+        Context const& context = {});
 #elif ENABLE_RUST_AMQP
     _azure_NODISCARD Models::_internal::AmqpError Send(
         Models::AmqpMessage const& message,
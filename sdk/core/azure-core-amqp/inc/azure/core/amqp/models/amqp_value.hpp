@@ -10,6 +10,7 @@
 #include <azure/core/internal/unique_handle.hpp>
 #include <azure/core/uuid.hpp>
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <cstddef>
@@ -19,6 +20,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Azure { namespace Core { namespace Amqp { namespace Models { namespace _detail {
@@ -573,6 +575,174 @@ namespace Azure { namespace Core { namespace Amqp { namespace Models {
 
 namespace Azure { namespace Core { namespace Amqp { namespace Models { namespace _detail {
 
+  /** @brief Associative container used as the storage for the AMQP map types.
+   *
+   * AMQP maps are usually small (message annotations, link and connection properties), so they
+   * are held as a vector of key/value pairs sorted by key rather than as a node based tree.
+   * Lookups are a binary search over contiguous storage, and building a map whose keys arrive in
+   * order, as they do when a map is decoded, appends to the vector without searching.
+   *
+   * @remarks As with std::map, the element type is std::pair<const Key, Value>. Unlike std::map,
+   * inserting or erasing an element invalidates iterators and references to the other elements
+   * of the map.
+   */
+  template <typename Key, typename Value> class AmqpFlatMap final {
+  public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<const Key, Value>;
+    using size_type = typename std::vector<value_type>::size_type;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    AmqpFlatMap() = default;
+    AmqpFlatMap(AmqpFlatMap const& that) = default;
+    AmqpFlatMap(AmqpFlatMap&& that) noexcept = default;
+    AmqpFlatMap& operator=(AmqpFlatMap&& that) noexcept = default;
+    AmqpFlatMap& operator=(AmqpFlatMap const& that)
+    {
+      // The keys are const, so the elements cannot be assigned in place.
+      std::vector<value_type> items{that.m_items};
+      m_items.swap(items);
+      return *this;
+    }
+
+    /** @brief Construct a map from a list of key/value pairs. As with std::map, only the first of
+     * several pairs with the same key is retained.
+     */
+    AmqpFlatMap(std::initializer_list<value_type> const& values)
+    {
+      m_items.reserve(values.size());
+      for (auto const& value : values)
+      {
+        Insert(value_type{value});
+      }
+    }
+
+    size_type size() const noexcept { return m_items.size(); }
+    bool empty() const noexcept { return m_items.empty(); }
+    void clear() noexcept { m_items.clear(); }
+    void reserve(size_type count) { m_items.reserve(count); }
+
+    iterator begin() noexcept { return m_items.begin(); }
+    iterator end() noexcept { return m_items.end(); }
+    const_iterator begin() const noexcept { return m_items.begin(); }
+    const_iterator end() const noexcept { return m_items.end(); }
+
+    iterator find(Key const& key)
+    {
+      auto it{LowerBound(key)};
+      return (it != m_items.end() && !(key < it->first)) ? it : m_items.end();
+    }
+    const_iterator find(Key const& key) const
+    {
+      return const_cast<AmqpFlatMap*>(this)->find(key);
+    }
+    size_type count(Key const& key) const { return find(key) == end() ? 0 : 1; }
+
+    Value& operator[](Key const& key) { return Insert(value_type{key, Value{}}).first->second; }
+    Value& operator[](Key&& key)
+    {
+      auto it{LowerBound(key)};
+      if (it == m_items.end() || key < it->first)
+      {
+        it = InsertAt(it, value_type{std::move(key), Value{}});
+      }
+      return it->second;
+    }
+
+    template <class... ValueTypes> std::pair<iterator, bool> emplace(ValueTypes&&... values)
+    {
+      return Insert(value_type(std::forward<ValueTypes>(values)...));
+    }
+
+    iterator erase(const_iterator position)
+    {
+      // The keys are const, so the elements cannot be shifted down by assignment. The elements
+      // after the erased one are moved into a new vector instead.
+      auto const index{static_cast<size_type>(position - m_items.cbegin())};
+      if (index + 1 == m_items.size())
+      {
+        m_items.pop_back();
+        return m_items.end();
+      }
+      std::vector<value_type> items;
+      items.reserve(m_items.size() - 1);
+      for (size_type i = 0; i < m_items.size(); i += 1)
+      {
+        if (i != index)
+        {
+          items.emplace_back(std::move(m_items[i]));
+        }
+      }
+      m_items.swap(items);
+      return m_items.begin() + index;
+    }
+    size_type erase(Key const& key)
+    {
+      auto it{find(key)};
+      if (it == m_items.end())
+      {
+        return 0;
+      }
+      erase(it);
+      return 1;
+    }
+
+    bool operator==(AmqpFlatMap const& that) const { return m_items == that.m_items; }
+    bool operator!=(AmqpFlatMap const& that) const { return m_items != that.m_items; }
+    bool operator<(AmqpFlatMap const& that) const { return m_items < that.m_items; }
+
+  private:
+    std::vector<value_type> m_items;
+
+    iterator LowerBound(Key const& key)
+    {
+      if (m_items.empty() || m_items.back().first < key)
+      {
+        return m_items.end();
+      }
+      return std::lower_bound(
+          m_items.begin(), m_items.end(), key, [](value_type const& item, Key const& searchKey) {
+            return item.first < searchKey;
+          });
+    }
+
+    std::pair<iterator, bool> Insert(value_type&& value)
+    {
+      auto it{LowerBound(value.first)};
+      if (it != m_items.end() && !(value.first < it->first))
+      {
+        return {it, false};
+      }
+      return {InsertAt(it, std::move(value)), true};
+    }
+
+    iterator InsertAt(iterator position, value_type&& value)
+    {
+      if (position == m_items.end())
+      {
+        m_items.emplace_back(std::move(value));
+        return m_items.end() - 1;
+      }
+      // The keys are const, so the elements cannot be shifted up by assignment. They are moved
+      // into a new vector around the inserted element instead.
+      auto const index{static_cast<size_type>(position - m_items.begin())};
+      std::vector<value_type> items;
+      items.reserve(m_items.size() + 1);
+      for (size_type i = 0; i < m_items.size(); i += 1)
+      {
+        if (i == index)
+        {
+          items.emplace_back(std::move(value));
+        }
+        items.emplace_back(std::move(m_items[i]));
+      }
+      m_items.swap(items);
+      return m_items.begin() + index;
+    }
+  };
+
   /** @brief Base type for AMQP collection types.
    *
    * Provides convenient conversions for STL collection types to enable classes derived from
@@ -696,15 +866,15 @@ namespace Azure { namespace Core { namespace Amqp { namespace Models {
    *
    */
   class AmqpMap final
-      : public _detail::AmqpCollectionBase<std::map<AmqpValue, AmqpValue>, AmqpMap> {
+      : public _detail::
+            AmqpCollectionBase<_detail::AmqpFlatMap<AmqpValue, AmqpValue>, AmqpMap> {
 
   public:
     /** @brief Construct a new AmqpMap object. */
     AmqpMap() : AmqpCollectionBase(){};
 
     /** @brief Construct a new AmqpArray object with an initializer list. */
-    AmqpMap(std::initializer_list<std::map<AmqpValue, AmqpValue>::value_type> const& values)
-        : AmqpCollectionBase(values)
+    AmqpMap(initializer_type const& values) : AmqpCollectionBase(values)
     {
     }
 
@@ -764,6 +934,15 @@ namespace Azure { namespace Core { namespace Amqp { namespace Models {
     {
       return m_value.emplace(std::forward<ValueTypes>(values)...);
     }
+
+    /** @brief Returns the contents of the map as a std::map. */
+    explicit operator std::map<AmqpValue, AmqpValue>() const
+    {
+      return {m_value.begin(), m_value.end()};
+    }
+
+  private:
+    using AmqpCollectionBase::operator _detail::AmqpFlatMap<AmqpValue, AmqpValue> const&;
   };
   std::ostream& operator<<(std::ostream& os, AmqpMap const& value);
 
@@ -928,16 +1107,15 @@ namespace Azure { namespace Core { namespace Amqp { namespace Models {
    *
    */
   class AmqpAnnotations final
-      : public _detail::AmqpCollectionBase<std::map<AmqpSymbol, AmqpValue>, AmqpAnnotations> {
+      : public _detail::
+            AmqpCollectionBase<_detail::AmqpFlatMap<AmqpSymbol, AmqpValue>, AmqpAnnotations> {
 
   public:
     /** @brief Construct a new AmqpMap object. */
     AmqpAnnotations() : AmqpCollectionBase(){};
 
     /** @brief Construct a new AmqpArray object with an initializer list. */
-    AmqpAnnotations(
-        std::initializer_list<std::map<AmqpSymbol, AmqpValue>::value_type> const& values)
-        : AmqpCollectionBase(values)
+    AmqpAnnotations(initializer_type const& values) : AmqpCollectionBase(values)
     {
     }
 
@@ -1005,6 +1183,15 @@ namespace Azure { namespace Core { namespace Amqp { namespace Models {
      * @returns true if the given AmqpAnnotations object is equal to this object, false otherwise.
      */
     bool operator==(AmqpAnnotations const& that) const { return m_value == that.m_value; }
+
+    /** @brief Returns the contents of the annotations as a std::map. */
+    explicit operator std::map<AmqpSymbol, AmqpValue>() const
+    {
+      return {m_value.begin(), m_value.end()};
+    }
+
+  private:
+    using AmqpCollectionBase::operator _detail::AmqpFlatMap<AmqpSymbol, AmqpValue> const&;
   };
   std::ostream& operator<<(std::ostream& os, AmqpAnnotations const& value);
 
@@ -14,7 +14,11 @@
 #include <azure/core/diagnostics/logger.hpp>
 #include <azure/core/internal/diagnostics/log.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <thread>
+#include <vector>
 
 using namespace Azure::Core::Diagnostics::_internal;
 using namespace Azure::Core::Diagnostics;
@@ -136,109 +140,467 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     return false;
   }
 
+  namespace {
+    // Tokens are renewed this long before they expire, so that links never observe an expired
+    // token while the renewal is in flight.
+    constexpr std::chrono::minutes TokenRenewalMargin{5};
+    // How long to wait before retrying a failed token renewal.
+    constexpr std::chrono::seconds TokenRenewalRetryInterval{30};
+
+    std::chrono::system_clock::time_point GetRenewalTime(Credentials::AccessToken const& token)
+    {
+      return static_cast<std::chrono::system_clock::time_point>(token.ExpiresOn)
+          - TokenRenewalMargin;
+    }
+  } // namespace
+
+  std::string ConnectionImpl::GetAudienceUrl(std::string const& audience) const
+  {
+    // If the audience looks like a URL for AMQP, AMQPS, or SB, we can use the URL as provided.
+    if ((audience.find("amqps://") == 0) || (audience.find("amqp://") == 0)
+        || (audience.find("sb://") == 0))
+    {
+      return audience;
+    }
+    std::string audienceUrl = "amqps://" + GetHost();
+    // The provided audience may begin with a /, if not, we need to add the separator.
+    if (audience.empty() || audience.front() != '/')
+    {
+      audienceUrl += "/";
+    }
+    audienceUrl += audience;
+    if (m_options.EnableTrace)
+    {
+      Log::Stream(Logger::Level::Verbose) << "Initial audience is not URL, using " << audienceUrl;
+    }
+    return audienceUrl;
+  }
+
   // Ensure that we have a token for the provided audience.
-  // If we don't, authenticate the audience with the service using the provided session.
-  // Note that the granularity of
+  // If we don't, authenticate the audience with the service over the connection's CBS link.
+  //
+  // Once an audience has been authenticated, its token is renewed in the background before it
+  // expires for as long as the connection remains open.
   Credentials::AccessToken ConnectionImpl::AuthenticateAudience(
-      std::shared_ptr<SessionImpl> session,
       std::string const& audience,
       Azure::Core::Context const& context)
   {
-    if (GetCredential())
+    if (!GetCredential())
     {
-      std::string audienceUrl = audience;
-      if (m_options.EnableTrace)
+      Log::Stream(Logger::Level::Verbose) << "No credential, returning empty token.";
+      // If the connection is unauthenticated, then just return an empty access token.
+      return {};
+    }
+
+    if (m_options.EnableTrace)
+    {
+      Log::Stream(Logger::Level::Verbose) << "Authenticate connection for audience " << audience;
+    }
+    std::string audienceUrl = GetAudienceUrl(audience);
+
+    std::promise<Credentials::AccessToken> authentication;
+    {
+      std::unique_lock<std::mutex> lock(m_tokenMutex);
+      // If we have authenticated this audience, we're done and can return success.
+      auto token = m_tokenStore.find(audienceUrl);
+      if (token != m_tokenStore.end()
+          && static_cast<std::chrono::system_clock::time_point>(token->second.ExpiresOn)
+              > std::chrono::system_clock::now())
       {
-        Log::Stream(Logger::Level::Verbose) << "Authenticate connection for audience " << audience;
+        if (m_options.EnableTrace)
+        {
+          Log::Stream(Logger::Level::Verbose) << "Using cached token for " << audienceUrl;
+        }
+        return token->second;
       }
-      // If the audience looks like a URL for AMQP, AMQPS, or SB, we can use the URL as
-      // provided.
-      if ((audience.find("amqps://") != 0) && (audience.find("amqp://") != 0)
-          && (audience.find("sb://") != 0))
+
+      // If another link is already authenticating this audience, wait for its result rather than
+      // sending a second put-token.
+      auto pending = m_pendingAuthentications.find(audienceUrl);
+      if (pending != m_pendingAuthentications.end())
       {
-        audienceUrl = "amqps://" + GetHost();
-        // The provided audience may begin with a /, if not, we need to add the separator.
-        if (audience.front() != '/')
+        auto pendingAuthentication = pending->second;
+        lock.unlock();
+        // A context cannot be waited on, so only its deadline bounds the wait. The put-token
+        // itself is bounded by the context of the caller which sent it. A cancelled context's
+        // deadline cannot be converted to a time point, so it is checked first.
+        auto const deadline{context.GetDeadline()};
+        if (deadline == (Azure::DateTime::max)())
         {
-          audienceUrl += "/";
+          pendingAuthentication.wait();
         }
-        audienceUrl += audience;
-        if (m_options.EnableTrace)
+        else if (
+            context.IsCancelled()
+            || pendingAuthentication.wait_until(
+                   static_cast<std::chrono::system_clock::time_point>(deadline))
+                != std::future_status::ready)
         {
-          Log::Stream(Logger::Level::Verbose)
-              << "Initial audience is not URL, using " << audienceUrl;
+          throw Azure::Core::OperationCancelledException("Authentication was cancelled.");
         }
+        return pendingAuthentication.get();
       }
+      m_pendingAuthentications.emplace(audienceUrl, authentication.get_future().share());
+    }
 
-      std::unique_lock<std::mutex> lock(m_tokenMutex);
-      // If we have authenticated this audience, we're done and can return success.
-      auto token = m_tokenStore.find(audienceUrl);
-      if (token != m_tokenStore.end())
+    if (m_options.EnableTrace)
+    {
+      Log::Stream(Logger::Level::Verbose)
+          << "No cached token for " << audienceUrl << ", Authenticating.";
+    }
+
+    try
+    {
+      auto accessToken = PutToken(audienceUrl, context);
+      std::shared_ptr<TokenRenewalState> renewal;
       {
-        if (m_options.EnableTrace)
+        std::unique_lock<std::mutex> lock(m_tokenMutex);
+        m_tokenStore[audienceUrl] = accessToken;
+        m_pendingAuthentications.erase(audienceUrl);
+        StartTokenRenewal();
+        renewal = m_tokenRenewal;
+      }
+      // Wake the renewal thread so that it accounts for the new token's expiration time.
+      {
+        std::unique_lock<std::mutex> lock(renewal->Mutex);
+        renewal->Wake = true;
+      }
+      renewal->Condition.notify_all();
+      authentication.set_value(accessToken);
+      return accessToken;
+    }
+    catch (...)
+    {
+      {
+        std::unique_lock<std::mutex> lock(m_tokenMutex);
+        m_pendingAuthentications.erase(audienceUrl);
+      }
+      authentication.set_exception(std::current_exception());
+      throw;
+    }
+  }
+
+  std::shared_ptr<ClaimsBasedSecurityImpl> ConnectionImpl::GetClaimsBasedSecurity(
+      Azure::Core::Context const& context)
+  {
+    std::unique_lock<std::mutex> lock(m_claimsBasedSecurityMutex);
+    if (m_claimsBasedSecurity)
+    {
+      return m_claimsBasedSecurity;
+    }
+
+    // The CBS link lives on its own session so that it is unaffected by the lifetime of the
+    // sessions which use it to authenticate.
+    if (!m_claimsBasedSecuritySession)
+    {
+      auto session = std::make_shared<SessionImpl>(shared_from_this(), _internal::SessionOptions{});
+#if ENABLE_UAMQP
+      session->SetOwnedByConnection();
+#endif
+      session->Begin(context);
+      m_claimsBasedSecuritySession = session;
+    }
+
+    // If the CBS link cannot be opened, end its session so that it does not keep the connection
+    // alive.
+    auto endSession = [this, &context]() {
+      std::shared_ptr<SessionImpl> session;
+      session.swap(m_claimsBasedSecuritySession);
+      try
+      {
+        session->End(context);
+      }
+      catch (std::exception const& ex)
+      {
+        Log::Stream(Logger::Level::Warning) << "Failed to end CBS session: " << ex.what();
+      }
+    };
+
+    auto claimsBasedSecurity
+        = std::make_shared<ClaimsBasedSecurityImpl>(m_claimsBasedSecuritySession);
+    CbsOpenResult cbsOpenStatus;
+    try
+    {
+      cbsOpenStatus = claimsBasedSecurity->Open(context);
+    }
+    catch (...)
+    {
+      endSession();
+      throw;
+    }
+    if (cbsOpenStatus != CbsOpenResult::Ok)
+    {
+      endSession();
+      throw std::runtime_error("Could not open Claims Based Security object.");
+    }
+    m_claimsBasedSecurity = claimsBasedSecurity;
+    {
+      // The token renewal thread also closes the CBS link once the connection is idle.
+      std::unique_lock<std::mutex> tokenLock(m_tokenMutex);
+      StartTokenRenewal();
+    }
+    return m_claimsBasedSecurity;
+  }
+
+  void ConnectionImpl::DiscardClaimsBasedSecurity(
+      std::shared_ptr<ClaimsBasedSecurityImpl> const& cbs)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_claimsBasedSecurityMutex);
+      if (m_claimsBasedSecurity != cbs)
+      {
+        // Another caller has already replaced the CBS object.
+        return;
+      }
+      m_claimsBasedSecurity.reset();
+    }
+    try
+    {
+      Log::Stream(Logger::Level::Verbose) << "Close CBS object";
+      cbs->Close({});
+    }
+    catch (std::exception const& ex)
+    {
+      Log::Stream(Logger::Level::Warning) << "Failed to close CBS object: " << ex.what();
+    }
+  }
+
+  Credentials::AccessToken ConnectionImpl::PutToken(
+      std::string const& audienceUrl,
+      Azure::Core::Context const& context)
+  {
+    auto claimsBasedSecurity = GetClaimsBasedSecurity(context);
+    try
+    {
+      Credentials::TokenRequestContext requestContext;
+
+      requestContext.Scopes = m_options.AuthenticationScopes;
+      auto accessToken{GetCredential()->GetToken(requestContext, context)};
+
+      auto result = claimsBasedSecurity->PutToken(
+          (IsSasCredential() ? CbsTokenType::Sas : CbsTokenType::Jwt),
+          audienceUrl,
+          accessToken.Token,
+          accessToken.ExpiresOn,
+          context);
+      if (std::get<0>(result) != CbsOperationResult::Ok)
+      {
+        // A rejected token leaves the CBS link usable, any other failure means that the link
+        // needs to be re-established before it can be used again.
+        if (std::get<0>(result) != CbsOperationResult::Failed)
         {
-          Log::Stream(Logger::Level::Verbose) << "Using cached token for " << audienceUrl;
+          DiscardClaimsBasedSecurity(claimsBasedSecurity);
         }
-        return token->second;
+        throw Azure::Core::Credentials::AuthenticationException(
+            "Could not authenticate client. Error Status: " + std::to_string(std::get<1>(result))
+            + " reason: " + std::get<2>(result));
       }
-      // We've not authenticated this audience.
-      // Authenticate it with the server
-
       if (m_options.EnableTrace)
       {
         Log::Stream(Logger::Level::Verbose)
-            << "No cached token for " << audienceUrl << ", Authenticating.";
+            << "Authenticated connection for audience " << audienceUrl << " successfully.";
       }
+      return accessToken;
+    }
+    catch (Azure::Core::Credentials::AuthenticationException const&)
+    {
+      throw;
+    }
+    catch (...)
+    {
+      DiscardClaimsBasedSecurity(claimsBasedSecurity);
+      throw;
+    }
+  }
 
-      auto claimsBasedSecurity = std::make_shared<ClaimsBasedSecurityImpl>(session);
-      auto cbsOpenStatus = claimsBasedSecurity->Open(context);
-      if (cbsOpenStatus != CbsOpenResult::Ok)
+  // Renew every token which is about to expire, returning the time at which the next token needs
+  // to be renewed.
+  std::chrono::system_clock::time_point ConnectionImpl::RenewTokens(
+      Azure::Core::Context const& context)
+  {
+    std::unique_lock<std::mutex> lock(m_tokenMutex);
+    auto now = std::chrono::system_clock::now();
+    auto nextRenewal = std::chrono::system_clock::time_point::max();
+    std::vector<std::string> audiences;
+    for (auto const& token : m_tokenStore)
+    {
+      auto renewalTime = GetRenewalTime(token.second);
+      if (renewalTime <= now)
+      {
+        audiences.push_back(token.first);
+      }
+      else
       {
-        throw std::runtime_error("Could not open Claims Based Security object.");
+        nextRenewal = (std::min)(nextRenewal, renewalTime);
       }
+    }
 
+    for (auto const& audienceUrl : audiences)
+    {
+      if (context.IsCancelled())
+      {
+        break;
+      }
+      // Renew the token without holding the lock so that links can continue to use the
+      // current token while the put-token is outstanding.
+      lock.unlock();
       try
       {
-        Credentials::TokenRequestContext requestContext;
-
-        requestContext.Scopes = m_options.AuthenticationScopes;
-        auto accessToken{GetCredential()->GetToken(requestContext, context)};
+        auto accessToken = PutToken(audienceUrl, context);
+        Log::Stream(Logger::Level::Verbose) << "Renewed token for audience " << audienceUrl;
+        lock.lock();
+        m_tokenStore[audienceUrl] = accessToken;
+        nextRenewal = (std::min)(nextRenewal, GetRenewalTime(accessToken));
+      }
+      catch (std::exception const& ex)
+      {
+        Log::Stream(Logger::Level::Warning)
+            << "Could not renew token for audience " << audienceUrl << ": " << ex.what();
+        lock.lock();
+        auto token = m_tokenStore.find(audienceUrl);
+        if (token != m_tokenStore.end()
+            && static_cast<std::chrono::system_clock::time_point>(token->second.ExpiresOn)
+                <= std::chrono::system_clock::now())
+        {
+          // The token has expired, the next link to use this audience re-authenticates it.
+          m_tokenStore.erase(token);
+        }
+        else
+        {
+          nextRenewal = (std::min)(
+              nextRenewal,
+              std::chrono::system_clock::now()
+                  + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                      TokenRenewalRetryInterval));
+        }
+      }
+    }
+    return nextRenewal;
+  }
 
-        auto result = claimsBasedSecurity->PutToken(
-            (IsSasCredential() ? CbsTokenType::Sas : CbsTokenType::Jwt),
-            audienceUrl,
-            accessToken.Token,
-            accessToken.ExpiresOn,
-            context);
-        if (std::get<0>(result) != CbsOperationResult::Ok)
+  void ConnectionImpl::RunTokenRenewal(
+      std::weak_ptr<ConnectionImpl> weakConnection,
+      std::shared_ptr<TokenRenewalState> renewal)
+  {
+    std::unique_lock<std::mutex> lock(renewal->Mutex);
+    while (!renewal->Stop)
+    {
+      renewal->Wake = false;
+#if ENABLE_UAMQP
+      bool const closeIdle{renewal->CloseIdle};
+      renewal->CloseIdle = false;
+#endif
+      lock.unlock();
+      auto nextRenewal = std::chrono::system_clock::time_point::max();
+      {
+        // Only keep the connection alive for the duration of a renewal pass. If this was the last
+        // reference, the connection is destroyed here and stops the renewal.
+        auto connection = weakConnection.lock();
+        if (!connection)
         {
-          throw Azure::Core::Credentials::AuthenticationException(
-              "Could not authenticate client. Error Status: " + std::to_string(std::get<1>(result))
-              + " reason: " + std::get<2>(result));
+          return;
         }
-        Log::Stream(Logger::Level::Verbose) << "Close CBS object";
-        claimsBasedSecurity->Close(context);
-        if (m_options.EnableTrace)
+#if ENABLE_UAMQP
+        if (closeIdle && connection->CloseIdleClaimsBasedSecurity())
         {
-          Log::Stream(Logger::Level::Verbose)
-              << "Authenticated connection for audience " << audienceUrl << " successfully.";
+          // Closing the CBS link stopped the renewal, it is restarted with the next CBS link.
+          return;
         }
+#endif
+        nextRenewal = connection->RenewTokens(renewal->Context);
+      }
+      lock.lock();
+
+      auto shouldWake = [&renewal]() { return renewal->Stop || renewal->Wake; };
+      if (nextRenewal == std::chrono::system_clock::time_point::max())
+      {
+        renewal->Condition.wait(lock, shouldWake);
+      }
+      else
+      {
+        renewal->Condition.wait_until(lock, nextRenewal, shouldWake);
+      }
+    }
+  }
+
+  void ConnectionImpl::StartTokenRenewal()
+  {
+    // Called with m_tokenMutex held.
+    if (!m_tokenRenewalThread.joinable())
+    {
+      m_tokenRenewalThread = std::thread(
+          &ConnectionImpl::RunTokenRenewal,
+          std::weak_ptr<ConnectionImpl>(shared_from_this()),
+          m_tokenRenewal);
+    }
+  }
 
-        m_tokenStore.emplace(audienceUrl, accessToken);
-        return accessToken;
+  void ConnectionImpl::StopTokenRenewal(bool waitForThread)
+  {
+    std::shared_ptr<TokenRenewalState> renewal;
+    std::thread renewalThread;
+    {
+      std::unique_lock<std::mutex> lock(m_tokenMutex);
+      renewal = std::move(m_tokenRenewal);
+      renewalThread = std::move(m_tokenRenewalThread);
+      // Allow the token renewal to be restarted if the connection is re-opened.
+      m_tokenRenewal = std::make_shared<TokenRenewalState>();
+    }
+    {
+      std::unique_lock<std::mutex> lock(renewal->Mutex);
+      renewal->Stop = true;
+    }
+    renewal->Context.Cancel();
+    renewal->Condition.notify_all();
+    if (renewalThread.joinable())
+    {
+      if (!waitForThread || renewalThread.get_id() == std::this_thread::get_id())
+      {
+        // The renewal thread exits once it sees the stop request. It only holds a weak reference
+        // to the connection, so it can outlive it.
+        renewalThread.detach();
       }
-      catch (...)
+      else
+      {
+        renewalThread.join();
+      }
+    }
+  }
+
+  void ConnectionImpl::CloseClaimsBasedSecurity(Azure::Core::Context const& context)
+  {
+    StopTokenRenewal();
+
+    std::shared_ptr<ClaimsBasedSecurityImpl> claimsBasedSecurity;
+    std::shared_ptr<SessionImpl> session;
+    {
+      std::unique_lock<std::mutex> lock(m_claimsBasedSecurityMutex);
+      claimsBasedSecurity.swap(m_claimsBasedSecurity);
+      session.swap(m_claimsBasedSecuritySession);
+    }
+    if (claimsBasedSecurity)
+    {
+      try
       {
-        // Ensure that the claims based security object is closed before we leave this scope.
         claimsBasedSecurity->Close(context);
-        throw;
+      }
+      catch (std::exception const& ex)
+      {
+        Log::Stream(Logger::Level::Warning) << "Failed to close CBS object: " << ex.what();
       }
     }
-    else
+    if (session)
     {
-      Log::Stream(Logger::Level::Verbose) << "No credential, returning empty token.";
-      // If the connection is unauthenticated, then just return an empty access token.
-      return {};
+      try
+      {
+        session->End(context);
+      }
+      catch (std::exception const& ex)
+      {
+        Log::Stream(Logger::Level::Warning) << "Failed to end CBS session: " << ex.what();
+      }
     }
+
+    std::unique_lock<std::mutex> lock(m_tokenMutex);
+    m_tokenStore.clear();
   }
 }}}} // namespace Azure::Core::Amqp::_detail
@@ -0,0 +1,123 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "private/link_credit_controller.hpp"
+
+#include "../models/private/amqp_codec.hpp"
+
+#include <algorithm>
+
+namespace Azure { namespace Core { namespace Amqp { namespace _detail {
+
+  LinkCreditController::LinkCreditController(
+      _internal::MessageReceiverOptions const& options,
+      std::uint32_t defaultLinkCredit)
+      : m_maxLinkCredit{options.MaxLinkCredit != 0 ? options.MaxLinkCredit : defaultLinkCredit},
+        m_maxBufferedBytes{
+            options.MaxBufferedBytes.HasValue() ? options.MaxBufferedBytes.Value() : 0}
+  {
+    // A link always has at least one credit outstanding, otherwise the remote node could never
+    // deliver another message.
+    m_minLinkCredit = (std::max)(options.MinLinkCredit, static_cast<std::uint32_t>(1));
+    m_minLinkCredit = (std::min)(m_minLinkCredit, m_maxLinkCredit);
+
+    bool creditRange = options.MinLinkCredit != 0 && m_minLinkCredit < m_maxLinkCredit;
+    m_adaptive = creditRange || m_maxBufferedBytes != 0;
+
+    // When a credit range is specified, start at the bottom of the range and let the consumer
+    // pull the window up. Otherwise keep the configured credit until the buffer limit is reached.
+    m_linkCredit = creditRange ? m_minLinkCredit : m_maxLinkCredit;
+  }
+
+  std::uint32_t LinkCreditController::GetLinkCredit() const
+  {
+    std::lock_guard<std::mutex> lock{m_lock};
+    return m_linkCredit;
+  }
+
+  bool LinkCreditController::OnMessageBuffered(std::size_t messageSize)
+  {
+    std::lock_guard<std::mutex> lock{m_lock};
+    m_bufferedMessages += 1;
+    m_bufferedBytes += messageSize;
+    if (!m_adaptive || m_linkCredit == m_minLinkCredit)
+    {
+      return false;
+    }
+
+    if (IsOverByteLimit())
+    {
+      // The byte limit is a hard bound - withhold as much credit as possible until the
+      // application catches up.
+      m_linkCredit = m_minLinkCredit;
+      return true;
+    }
+    if (m_bufferedMessages > 2 * static_cast<std::uint64_t>(m_linkCredit))
+    {
+      m_linkCredit = (std::max)(m_linkCredit / 2, m_minLinkCredit);
+      return true;
+    }
+    return false;
+  }
+
+  void LinkCreditController::OnMessageConsumed(std::size_t messageSize)
+  {
+    std::lock_guard<std::mutex> lock{m_lock};
+    if (m_bufferedMessages != 0)
+    {
+      m_bufferedMessages -= 1;
+    }
+    m_bufferedBytes -= (std::min)(static_cast<std::uint64_t>(messageSize), m_bufferedBytes);
+  }
+
+  bool LinkCreditController::OnReceiveStalled()
+  {
+    std::lock_guard<std::mutex> lock{m_lock};
+    m_creditStalls += 1;
+    if (!m_adaptive || m_linkCredit == m_maxLinkCredit || IsOverByteLimit())
+    {
+      return false;
+    }
+    m_linkCredit = static_cast<std::uint32_t>(
+        (std::min)(2 * static_cast<std::uint64_t>(m_linkCredit), std::uint64_t{m_maxLinkCredit}));
+    return true;
+  }
+
+  _internal::MessageReceiverMetrics LinkCreditController::GetMetrics() const
+  {
+    std::lock_guard<std::mutex> lock{m_lock};
+    _internal::MessageReceiverMetrics metrics;
+    metrics.BufferedMessages = m_bufferedMessages;
+    metrics.BufferedBytes = m_bufferedBytes;
+    metrics.LinkCredit = m_linkCredit;
+    metrics.CreditStalls = m_creditStalls;
+    return metrics;
+  }
+
+  std::size_t LinkCreditController::GetMessageSize(Models::AmqpMessage const& message)
+  {
+    std::size_t size{};
+    switch (message.BodyType)
+    {
+      case Models::MessageBodyType::Data:
+        for (auto const& data : message.GetBodyAsBinary())
+        {
+          size += data.size();
+        }
+        break;
+      case Models::MessageBodyType::Sequence:
+        for (auto const& sequence : message.GetBodyAsAmqpList())
+        {
+          size += Models::_detail::AmqpEncoder::GetEncodedSize(sequence.AsAmqpValue());
+        }
+        break;
+      case Models::MessageBodyType::Value:
+        size += Models::_detail::AmqpEncoder::GetEncodedSize(message.GetBodyAsAmqpValue());
+        break;
+      case Models::MessageBodyType::None:
+      case Models::MessageBodyType::Invalid:
+        break;
+    }
+    return size;
+  }
+}}}} // namespace Azure::Core::Amqp::_detail
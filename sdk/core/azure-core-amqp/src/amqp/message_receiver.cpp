@@ -98,6 +98,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _internal {
 
 #if ENABLE_UAMQP
   std::string MessageReceiver::GetLinkName() const { return m_impl->GetLinkName(); }
+  MessageReceiverMetrics MessageReceiver::GetMetrics() const { return m_impl->GetMetrics(); }
 #endif
   std::ostream& operator<<(std::ostream& stream, _internal::MessageReceiverState state)
   {
@@ -64,6 +64,19 @@ namespace Azure { namespace Core { namespace Amqp { namespace _internal {
   {
     return m_impl->Send(message, context);
   }
+
+  MessageSendCompletion MessageSender::SendAsync(
+      Models::AmqpMessage const& message,
+      Context const& context)
+  {
+    return m_impl->SendAsync(message, context);
+  }
+
+  std::tuple<MessageSendStatus, Models::_internal::AmqpError> MessageSendCompletion::Wait(
+      Context const& context) const
+  {
+    return m_operation->Wait(context);
+  }
 #elif ENABLE_RUST_AMQP
   Models::_internal::AmqpError MessageSender::Send(
       Models::AmqpMessage const& message,
@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "azure/core/amqp/internal/message_receiver.hpp"
+#include "azure/core/amqp/models/amqp_message.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace Azure { namespace Core { namespace Amqp { namespace _detail {
+
+  /** @brief Sizes the link credit of a message receiver from the rate at which the application
+   * drains received messages.
+   *
+   * The controller follows the number and size of messages which have been received from the
+   * link but not yet returned to the application. When the application waits on an empty buffer
+   * (a credit stall) the remote node could not keep up with the consumer, so the credit window is
+   * doubled. When the buffered backlog grows beyond two credit windows, or beyond the configured
+   * byte limit, the consumer is not keeping up with the remote node and the window is halved.
+   *
+   * The controller is transport agnostic, it only computes the credit to apply. Applying the credit
+   * to the link is the responsibility of the message receiver.
+   */
+  class LinkCreditController final {
+  public:
+    /** @brief Construct a link credit controller.
+     *
+     * @param options The options for the message receiver. MinLinkCredit, MaxLinkCredit and
+     * MaxBufferedBytes control the behavior of the controller.
+     * @param defaultLinkCredit The link credit used by the transport when
+     * MessageReceiverOptions::MaxLinkCredit is not set.
+     */
+    LinkCreditController(
+        _internal::MessageReceiverOptions const& options,
+        std::uint32_t defaultLinkCredit);
+
+    /** @brief Returns true if the link credit is adjusted dynamically. */
+    bool IsAdaptive() const { return m_adaptive; }
+
+    /** @brief Returns the link credit which should currently be granted on the link. */
+    std::uint32_t GetLinkCredit() const;
+
+    /** @brief Record that a message has been received and buffered for the application.
+     *
+     * @return true if the link credit was reduced as a result.
+     */
+    bool OnMessageBuffered(std::size_t messageSize);
+
+    /** @brief Record that a buffered message has been returned to the application. */
+    void OnMessageConsumed(std::size_t messageSize);
+
+    /** @brief Record that the application waited for a message with nothing buffered.
+     *
+     * @return true if the link credit was increased as a result.
+     */
+    bool OnReceiveStalled();
+
+    /** @brief Returns a snapshot of the receive buffer metrics. */
+    _internal::MessageReceiverMetrics GetMetrics() const;
+
+    /** @brief Returns the number of bytes a message contributes to the receive buffer.
+     *
+     * The size is the encoded size of the message body, which dominates the size of the message
+     * for all practical messages and is cheap to compute.
+     */
+    static std::size_t GetMessageSize(Models::AmqpMessage const& message);
+
+    /** @brief Returns the number of bytes a message contributes to the receive buffer, or 0 when
+     * the link credit is not adjusted dynamically and buffered bytes are not tracked.
+     */
+    std::size_t GetBufferedMessageSize(Models::AmqpMessage const& message) const
+    {
+      return m_adaptive ? GetMessageSize(message) : 0;
+    }
+
+  private:
+    bool IsOverByteLimit() const
+    {
+      return m_maxBufferedBytes != 0 && m_bufferedBytes > m_maxBufferedBytes;
+    }
+
+    mutable std::mutex m_lock;
+    bool m_adaptive;
+    std::uint32_t m_minLinkCredit;
+    std::uint32_t m_maxLinkCredit;
+    std::uint64_t m_maxBufferedBytes;
+    std::uint32_t m_linkCredit;
+    std::uint64_t m_bufferedMessages{};
+    std::uint64_t m_bufferedBytes{};
+    std::uint64_t m_creditStalls{};
+  };
+}}}} // namespace Azure::Core::Amqp::_detail
@@ -73,6 +73,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
       Azure::DateTime const& expirationTime,
       Context const& context)
   {
+    std::lock_guard<std::mutex> lock(m_putTokenMutex);
     Common::_detail::CallContext callContext(
         Common::_detail::GlobalStateHolder::GlobalStateInstance()->GetRuntimeContext(), context);
 
@@ -83,6 +83,9 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
 
   ConnectionImpl::~ConnectionImpl()
   {
+    // The renewal thread exits on its own once it sees the stop request, don't wait for it here.
+    StopTokenRenewal(false);
+
     std::unique_lock<LockType> lock(m_amqpMutex);
     if (m_openCount.load() != 0)
     {
@@ -229,6 +232,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
       {
         throw std::runtime_error("Cannot close an unopened connection.");
       }
+      CloseClaimsBasedSecurity(context);
       if (amqpconnection_close(callContext.GetCallContext(), m_connection.get()))
       {
         throw std::runtime_error("Could not close connection: " + callContext.GetError());
@@ -258,6 +262,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     {
       throw std::logic_error("Connection not opened.");
     }
+    CloseClaimsBasedSecurity(context);
     if (amqpconnection_close_with_error(
             callContext.GetCallContext(),
             m_connection.get(),
@@ -56,7 +56,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     try
     {
       m_accessToken = m_session->GetConnection()->AuthenticateAudience(
-          m_session, m_managementEntityPath + "/" + m_options.ManagementNodeName, context);
+          m_managementEntityPath + "/" + m_options.ManagementNodeName, context);
 
       Common::_detail::CallContext callContext(
           Common::_detail::GlobalStateHolder::GlobalStateInstance()->GetRuntimeContext(), context);
@@ -133,7 +133,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     if (m_options.AuthenticationRequired)
     {
       m_session->GetConnection()->AuthenticateAudience(
-          m_session, static_cast<std::string>(m_source.GetAddress()), context);
+          static_cast<std::string>(m_source.GetAddress()), context);
     }
 
     UniqueMessageReceiverOptions options{amqpmessagereceiveroptions_create()};
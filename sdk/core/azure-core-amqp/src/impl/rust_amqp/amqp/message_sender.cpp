@@ -103,7 +103,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
       // If we need to authenticate with either ServiceBus or BearerToken, now is the time to do
       // it.
       m_session->GetConnection()->AuthenticateAudience(
-          m_session, static_cast<std::string>(m_target.GetAddress()), context);
+          static_cast<std::string>(m_target.GetAddress()), context);
     }
 
     if (m_options.InitialDeliveryCount)
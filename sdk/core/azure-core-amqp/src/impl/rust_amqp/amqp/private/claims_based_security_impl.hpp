@@ -8,6 +8,8 @@
 #include "rust_amqp_wrapper.h"
 #include "unique_handle.hpp"
 
+#include <mutex>
+
 namespace Azure { namespace Core { namespace Amqp { namespace _detail {
   template <>
   struct UniqueHandleHelper<Azure::Core::Amqp::RustInterop::_detail::RustAmqpClaimsBasedSecurity>
@@ -49,5 +51,8 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
   private:
     std::shared_ptr<_detail::SessionImpl> m_session;
     UniqueAmqpCbsHandle m_claimsBasedSecurity;
+    // The CBS object is shared by every link on the connection, but the underlying Rust client
+    // does not support concurrent authorization requests.
+    std::mutex m_putTokenMutex;
   };
 }}}} // namespace Azure::Core::Amqp::_detail
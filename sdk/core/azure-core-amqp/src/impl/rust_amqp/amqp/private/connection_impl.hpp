@@ -13,8 +13,13 @@
 #include <azure/core/url.hpp>
 
 #include <chrono>
+#include <condition_variable>
+#include <future>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #if defined(_MSC_VER)
 #define _azure_ACQUIRES_LOCK(...) _Acquires_exclusive_lock_(__VA_ARGS__)
@@ -53,6 +58,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
       = UniqueHandle<Azure::Core::Amqp::_detail::AmqpConnectionOptionsImplementation>;
 
   class ClaimsBasedSecurity;
+  class ClaimsBasedSecurityImpl;
 
   class ConnectionFactory final {
   public:
@@ -122,9 +128,8 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     bool IsTraceEnabled() { return m_options.EnableTrace; }
     bool IsSasCredential() const;
 
-    // Authenticate the audience on this connection using the provided session.
+    // Authenticate the audience on this connection.
     Azure::Core::Credentials::AccessToken AuthenticateAudience(
-        std::shared_ptr<SessionImpl> session,
         std::string const& audience,
         Azure::Core::Context const& context);
 
@@ -153,10 +158,46 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     bool m_connectionOpened{false};
     std::atomic<uint32_t> m_openCount{0};
 
-    // mutex protecting the token acquisition process.
+    // State shared between the connection and its token renewal thread. The thread only holds a
+    // weak reference to the connection, so an abandoned connection is still destroyed.
+    struct TokenRenewalState
+    {
+      std::mutex Mutex;
+      std::condition_variable Condition;
+      bool Stop{false};
+      bool Wake{false};
+      Azure::Core::Context Context;
+    };
+
+    // mutex protecting the token store and the token renewal state.
     std::mutex m_tokenMutex;
     std::shared_ptr<const Credentials::TokenCredential> m_credential{};
     std::map<std::string, Credentials::AccessToken> m_tokenStore;
+    // Audiences currently being authenticated, so concurrent callers share one put-token.
+    std::map<std::string, std::shared_future<Credentials::AccessToken>> m_pendingAuthentications;
+    std::shared_ptr<TokenRenewalState> m_tokenRenewal{std::make_shared<TokenRenewalState>()};
+    std::thread m_tokenRenewalThread;
+
+    // The CBS link used to authenticate every audience on this connection, and the session which
+    // owns it.
+    std::mutex m_claimsBasedSecurityMutex;
+    std::shared_ptr<SessionImpl> m_claimsBasedSecuritySession;
+    std::shared_ptr<ClaimsBasedSecurityImpl> m_claimsBasedSecurity;
+
+    std::string GetAudienceUrl(std::string const& audience) const;
+    std::shared_ptr<ClaimsBasedSecurityImpl> GetClaimsBasedSecurity(
+        Azure::Core::Context const& context);
+    void DiscardClaimsBasedSecurity(std::shared_ptr<ClaimsBasedSecurityImpl> const& cbs);
+    Credentials::AccessToken PutToken(
+        std::string const& audienceUrl,
+        Azure::Core::Context const& context);
+    std::chrono::system_clock::time_point RenewTokens(Azure::Core::Context const& context);
+    static void RunTokenRenewal(
+        std::weak_ptr<ConnectionImpl> weakConnection,
+        std::shared_ptr<TokenRenewalState> renewal);
+    void StartTokenRenewal();
+    void StopTokenRenewal(bool waitForThread = true);
+    void CloseClaimsBasedSecurity(Azure::Core::Context const& context);
 
 #if ENABLE_UAMQP
     ConnectionImpl(
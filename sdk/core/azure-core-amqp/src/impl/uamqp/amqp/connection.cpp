@@ -148,6 +148,9 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
 
   ConnectionImpl::~ConnectionImpl()
   {
+    // The renewal thread exits on its own once it sees the stop request, don't wait for it here.
+    StopTokenRenewal(false);
+
     std::unique_lock<LockType> lock(m_amqpMutex);
     if (m_openCount.load() != 0)
     {
@@ -386,7 +389,8 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
             << "Try to disable async operation on connection: " << this << " ID: " << m_containerId
             << " count: " << m_openCount.load();
       }
-      if (--m_openCount == 0)
+      auto openCount = --m_openCount;
+      if (openCount == 0)
       {
         if (m_options.EnableTrace)
         {
@@ -399,6 +403,59 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     }
   }
 
+  void ConnectionImpl::OnSessionBegun() { ++m_sessionCount; }
+
+  void ConnectionImpl::OnSessionEnded()
+  {
+    if (--m_sessionCount != 0 || m_connectionOpened)
+    {
+      return;
+    }
+    {
+      std::unique_lock<std::mutex> lock(m_claimsBasedSecurityMutex);
+      if (!m_claimsBasedSecuritySession)
+      {
+        return;
+      }
+    }
+    // Closing the CBS link waits for its detach, which must not happen on the caller's thread (a
+    // destructor, or the polling thread), so leave it to the token renewal thread.
+    std::shared_ptr<TokenRenewalState> renewal;
+    {
+      std::unique_lock<std::mutex> lock(m_tokenMutex);
+      renewal = m_tokenRenewal;
+    }
+    {
+      std::unique_lock<std::mutex> lock(renewal->Mutex);
+      renewal->CloseIdle = true;
+      renewal->Wake = true;
+    }
+    renewal->Condition.notify_all();
+  }
+
+  bool ConnectionImpl::CloseIdleClaimsBasedSecurity()
+  {
+    // A session may have begun since the close was requested.
+    if (m_connectionOpened || m_sessionCount.load() != 0)
+    {
+      return false;
+    }
+    {
+      std::unique_lock<std::mutex> lock(m_claimsBasedSecurityMutex);
+      if (!m_claimsBasedSecuritySession)
+      {
+        return false;
+      }
+    }
+    if (m_options.EnableTrace)
+    {
+      Log::Stream(Logger::Level::Verbose)
+          << "Closing idle CBS link on connection: " << this << " ID: " << m_containerId;
+    }
+    CloseClaimsBasedSecurity({});
+    return true;
+  }
+
   void ConnectionImpl::Open(Azure::Core::Context const&)
   {
     if (m_options.EnableTrace)
@@ -426,7 +483,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
 
     EnableAsyncOperation(true);
   }
-  void ConnectionImpl::Close(Azure::Core::Context const&)
+  void ConnectionImpl::Close(Azure::Core::Context const& context)
   {
     Log::Stream(Logger::Level::Verbose)
         << "ConnectionImpl::Close: " << this << " ID: " << m_containerId;
@@ -435,6 +492,10 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
       throw std::logic_error("Connection not opened.");
     }
 
+    // Close the CBS link while the connection is still being polled, so that it can detach
+    // cleanly.
+    CloseClaimsBasedSecurity(context);
+
     // Stop polling on this connection, we're shutting it down.
     EnableAsyncOperation(false);
 
@@ -454,7 +515,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
       const std::string& condition,
       const std::string& description,
       Models::AmqpValue info,
-      Azure::Core::Context const&)
+      Azure::Core::Context const& context)
   {
     Log::Stream(Logger::Level::Verbose)
         << "ConnectionImpl::Close: " << this << " ID: " << m_containerId;
@@ -463,6 +524,10 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
       throw std::logic_error("Connection not opened.");
     }
 
+    // Close the CBS link while the connection is still being polled, so that it can detach
+    // cleanly.
+    CloseClaimsBasedSecurity(context);
+
     // Stop polling on this connection, we're shutting it down.
     EnableAsyncOperation(false);
 
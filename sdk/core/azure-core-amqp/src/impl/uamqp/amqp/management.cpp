@@ -57,7 +57,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
       if (m_options.ManagementNodeName == "$management")
       {
         m_accessToken = m_session->GetConnection()->AuthenticateAudience(
-            m_session, m_managementEntityPath + "/" + m_options.ManagementNodeName, context);
+            m_managementEntityPath + "/" + m_options.ManagementNodeName, context);
       }
       {
         _internal::MessageSenderOptions messageSenderOptions;
@@ -183,12 +183,18 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
 
       messageToSend.Properties.MessageId
           = static_cast<Azure::Core::Amqp::Models::AmqpValue>(requestId);
+      // Several operations may be outstanding at once (for instance concurrent put-token requests
+      // on a shared CBS link), so the queue is looked up while the map is locked and is only
+      // erased by this operation.
+      ManagementOperationQueue* operationQueue;
       {
         std::unique_lock<std::recursive_mutex> lock(m_messageQueuesLock);
 
         Log::Stream(Logger::Level::Verbose)
             << "ManagementClient::ExecuteOperation: " << requestId << ". Create Queue for request.";
-        m_messageQueues.emplace(requestId, std::make_unique<ManagementOperationQueue>());
+        operationQueue
+            = m_messageQueues.emplace(requestId, std::make_unique<ManagementOperationQueue>())
+                  .first->second.get();
         m_sendCompleted = false;
       }
 
@@ -229,7 +235,12 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
         return rv;
       }
 
-      auto result = m_messageQueues.at(requestId)->WaitForResult(context);
+      auto result = operationQueue->WaitForResult(context);
+      {
+        std::unique_lock<std::recursive_mutex> lock(m_messageQueuesLock);
+        // Remove the queue from the map, we don't need it anymore.
+        m_messageQueues.erase(requestId);
+      }
       if (result)
       {
         _internal::ManagementOperationResult rv;
@@ -237,12 +248,6 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
         rv.StatusCode = std::get<1>(*result);
         rv.Error = std::get<2>(*result);
         rv.Message = std::get<3>(*result);
-
-        {
-          std::unique_lock<std::recursive_mutex> lock(m_messageQueuesLock);
-          // Remove the queue from the map, we don't need it anymore.
-          m_messageQueues.erase(requestId);
-        }
         return rv;
       }
       else
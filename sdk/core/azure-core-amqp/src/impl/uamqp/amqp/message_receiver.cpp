@@ -42,7 +42,8 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
       Models::_internal::MessageSource const& source,
       MessageReceiverOptions const& options,
       MessageReceiverEvents* eventHandler)
-      : m_options{options}, m_source{source}, m_session{session}, m_eventHandler(eventHandler)
+      : m_options{options}, m_creditController{options, DefaultLinkCredit}, m_source{source},
+        m_session{session}, m_eventHandler(eventHandler)
   {
   }
 
@@ -54,7 +55,8 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
       Models::_internal::MessageSource const& source,
       MessageReceiverOptions const& options,
       MessageReceiverEvents* eventHandler)
-      : m_options{options}, m_source{source}, m_session{session}, m_eventHandler(eventHandler)
+      : m_options{options}, m_creditController{options, DefaultLinkCredit}, m_source{source},
+        m_session{session}, m_eventHandler(eventHandler)
   {
     CreateLink(linkEndpoint);
     m_messageReceiver.reset(messagereceiver_create(
@@ -118,9 +120,9 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     {
       m_link->SetMaxMessageSize((std::numeric_limits<uint64_t>::max)());
     }
-    if (m_options.MaxLinkCredit != 0)
+    if (m_options.MaxLinkCredit != 0 || m_creditController.IsAdaptive())
     {
-      m_link->SetMaxLinkCredit(m_options.MaxLinkCredit);
+      m_link->SetMaxLinkCredit(m_creditController.GetLinkCredit());
     }
     m_link->SetAttachProperties(m_options.Properties.AsAmqpValue());
   }
@@ -158,6 +160,16 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
   Models::AmqpValue MessageReceiverImpl::OnMessageReceived(
       std::shared_ptr<Models::AmqpMessage> const& message)
   {
+    // Account for the message before queuing it, so that the consumer never observes a message
+    // which has not been counted.
+    if (m_creditController.OnMessageBuffered(
+            m_creditController.GetBufferedMessageSize(*message)))
+    {
+      // The consumer is falling behind. Reduce the credit the link grants when the current credit
+      // is exhausted. Credit which has already been granted cannot be revoked.
+      auto lock{m_session->GetConnection()->Lock()};
+      m_link->SetMaxLinkCredit(m_creditController.GetLinkCredit());
+    }
     m_messageQueue.CompleteOperation(message, Models::_internal::AmqpError{});
     return Models::_internal::Messaging::DeliveryAccepted();
   }
@@ -194,13 +206,23 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
       throw std::runtime_error("Cannot call WaitForIncomingMessage when using an event handler.");
     }
 
-    auto result = m_messageQueue.WaitForResult(context);
+    auto result = m_messageQueue.TryWaitForResult();
+    if (!result)
+    {
+      // The consumer has drained every buffered message and is now waiting on the network.
+      if (m_creditController.OnReceiveStalled())
+      {
+        GrowLinkCredit();
+      }
+      result = m_messageQueue.WaitForResult(context);
+    }
     if (result)
     {
       std::pair<std::shared_ptr<Models::AmqpMessage>, Models::_internal::AmqpError> rv;
       std::shared_ptr<Models::AmqpMessage> message{std::move(std::get<0>(*result))};
       if (message)
       {
+        m_creditController.OnMessageConsumed(m_creditController.GetBufferedMessageSize(*message));
         rv.first = std::move(message);
       }
       rv.second = std::move(std::get<1>(*result));
@@ -226,6 +248,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
       std::shared_ptr<Models::AmqpMessage> message{std::move(std::get<0>(*result))};
       if (message)
       {
+        m_creditController.OnMessageConsumed(m_creditController.GetBufferedMessageSize(*message));
         rv.first = std::move(message);
       }
       rv.second = std::move(std::get<1>(*result));
@@ -237,6 +260,20 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
       return {};
     }
   }
+  void MessageReceiverImpl::GrowLinkCredit()
+  {
+    auto lock{m_session->GetConnection()->Lock()};
+    if (m_link && m_currentState == _internal::MessageReceiverState::Open)
+    {
+      auto linkCredit{m_creditController.GetLinkCredit()};
+      m_link->SetMaxLinkCredit(linkCredit);
+
+      // The consumer is waiting, so grant the larger window immediately instead of waiting for
+      // the current credit to be exhausted.
+      m_link->ResetLinkCredit(linkCredit, false);
+    }
+  }
+
   void MessageReceiverImpl::EnableLinkPolling()
   {
     std::unique_lock<std::mutex> lock{m_mutableState};
@@ -384,7 +421,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     if (m_options.AuthenticationRequired)
     {
       m_session->GetConnection()->AuthenticateAudience(
-          m_session, static_cast<std::string>(m_source.GetAddress()), context);
+          static_cast<std::string>(m_source.GetAddress()), context);
     }
 
     {
@@ -19,7 +19,11 @@
 
 #include <azure_uamqp_c/message_sender.h>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 
 using namespace Azure::Core::Diagnostics;
 using namespace Azure::Core::Diagnostics::_internal;
@@ -85,6 +89,39 @@ namespace Azure { namespace Core { namespace Amqp { namespace _internal {
 }}}} // namespace Azure::Core::Amqp::_internal
 
 namespace Azure { namespace Core { namespace Amqp { namespace _detail {
+  namespace {
+    // Context::Cancel cannot notify a waiter, so if the condition is not signalled the wait wakes
+    // at the context deadline, or after this interval to notice an explicit cancellation.
+    constexpr std::chrono::milliseconds CancellationCheckInterval{1000};
+
+    /** @brief Wait until the predicate is satisfied or the context is cancelled.
+     *
+     * @returns true if the predicate is satisfied, false if the context was cancelled first.
+     */
+    template <typename Predicate>
+    bool WaitUnlessCancelled(
+        std::condition_variable& condition,
+        std::unique_lock<std::mutex>& lock,
+        Context const& context,
+        Predicate predicate)
+    {
+      while (!predicate())
+      {
+        if (context.IsCancelled())
+        {
+          return false;
+        }
+        auto untilDeadline{std::chrono::duration_cast<std::chrono::milliseconds>(
+            context.GetDeadline() - DateTime{std::chrono::system_clock::now()})};
+        condition.wait_for(
+            lock,
+            (std::max)(
+                std::chrono::milliseconds{1}, (std::min)(untilDeadline, CancellationCheckInterval)),
+            predicate);
+      }
+      return true;
+    }
+  } // namespace
 
   MessageSenderImpl::MessageSenderImpl(
       std::shared_ptr<_detail::SessionImpl> session,
@@ -267,8 +304,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
         }
         else
         {
-          sender->m_sendCompleteQueue.CompleteOperation(
-              _internal::MessageSendStatus::Error,
+          sender->FailOutstandingSends(
               {Azure::Core::Amqp::Models::_internal::AmqpErrorCondition::InternalError,
                "Message Sender unexpectedly entered the Error State.",
                {}});
@@ -300,7 +336,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
       // If we need to authenticate with either ServiceBus or BearerToken, now is the time to do
       // it.
       m_session->GetConnection()->AuthenticateAudience(
-          m_session, static_cast<std::string>(m_target.GetAddress()), context);
+          static_cast<std::string>(m_target.GetAddress()), context);
     }
     if (m_senderOpen)
     {
@@ -513,7 +549,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     }
   };
 
-  void MessageSenderImpl::QueueSendInternal(
+  bool MessageSenderImpl::QueueSendInternal(
       Models::AmqpMessage const& message,
       Azure::Core::Amqp::_internal::MessageSender::MessageSendCompleteCallback onSendComplete,
       Context const& context)
@@ -537,79 +573,201 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
       {
         throw std::runtime_error("Could not send message");
       }
+      return true;
     }
+    return false;
   }
 
-  std::tuple<_internal::MessageSendStatus, Models::_internal::AmqpError> MessageSenderImpl::Send(
+  bool MessageSendOperation::Complete(
+      _internal::MessageSendStatus status,
+      Models::_internal::AmqpError const& error)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_lock);
+      if (m_isCompleted)
+      {
+        return false;
+      }
+      m_result = std::make_tuple(status, error);
+      m_isCompleted = true;
+    }
+    m_completed.notify_all();
+    return true;
+  }
+
+  std::tuple<_internal::MessageSendStatus, Models::_internal::AmqpError>
+  MessageSendOperation::Wait(Context const& context)
+  {
+    std::unique_lock<std::mutex> lock(m_lock);
+    if (!WaitUnlessCancelled(m_completed, lock, context, [this]() { return m_isCompleted; }))
+    {
+      return std::make_tuple(
+          _internal::MessageSendStatus::Cancelled,
+          Models::_internal::AmqpError{
+              Models::_internal::AmqpErrorCondition::OperationCancelled,
+              "Message send operation cancelled.",
+              {}});
+    }
+    return m_result;
+  }
+
+  Models::_internal::AmqpError MessageSenderImpl::GetSendError(
+      _internal::MessageSendStatus sendResult,
+      Models::AmqpValue const& deliveryStatus)
+  {
+    Models::_internal::AmqpError error;
+
+    // If the send failed. then we need to return the error. If the send completed because
+    // of an error, it's possible that the deliveryStatus provided is null. In that case,
+    // we use the cached saved error because it is highly likely to be better than
+    // nothing.
+    if (sendResult != _internal::MessageSendStatus::Ok)
+    {
+      if (deliveryStatus.IsNull())
+      {
+        error = m_savedMessageError;
+      }
+      else
+      {
+        if (deliveryStatus.GetType() != Models::AmqpValueType::List)
+        {
+          throw std::runtime_error("Delivery status is not a list");
+        }
+        auto deliveryStatusAsList{deliveryStatus.AsList()};
+        if (deliveryStatusAsList.size() != 1)
+        {
+          throw std::runtime_error("Delivery Status list is not of size 1");
+        }
+        Models::AmqpValue firstState{deliveryStatusAsList[0]};
+        ERROR_HANDLE errorHandle;
+        if (!amqpvalue_get_error(
+                Models::_detail::AmqpValueFactory::ToImplementation(firstState), &errorHandle))
+        {
+          Models::_detail::UniqueAmqpErrorHandle uniqueError{
+              errorHandle}; // This will free the error handle when it goes out of scope.
+          error = Models::_detail::AmqpErrorFactory::FromImplementation(errorHandle);
+        }
+      }
+    }
+    else
+    {
+      // If we successfully sent the message, then whatever saved error should be cleared,
+      // it's no longer valid.
+      m_savedMessageError = Models::_internal::AmqpError();
+    }
+    return error;
+  }
+
+  std::uint32_t MessageSenderImpl::GetMaxOutstandingSends() const
+  {
+    // There is no point in having more deliveries outstanding than the link can carry.
+    if (m_options.MaxOutstandingSends == 0)
+    {
+      return m_options.MaxLinkCredits;
+    }
+    if (m_options.MaxLinkCredits == 0)
+    {
+      return m_options.MaxOutstandingSends;
+    }
+    return (std::min)(m_options.MaxOutstandingSends, m_options.MaxLinkCredits);
+  }
+
+  void MessageSenderImpl::CompleteSend(
+      std::shared_ptr<MessageSendOperation> const& operation,
+      _internal::MessageSendStatus sendResult,
+      Models::_internal::AmqpError const& error)
+  {
+    if (operation->Complete(sendResult, error))
+    {
+      {
+        std::unique_lock<std::mutex> lock(m_outstandingSendsLock);
+        m_outstandingSends.remove(operation);
+      }
+      m_outstandingSendCompleted.notify_all();
+    }
+  }
+
+  void MessageSenderImpl::FailOutstandingSends(Models::_internal::AmqpError const& error)
+  {
+    std::list<std::shared_ptr<MessageSendOperation>> outstandingSends;
+    {
+      std::unique_lock<std::mutex> lock(m_outstandingSendsLock);
+      outstandingSends = m_outstandingSends;
+    }
+    for (auto const& operation : outstandingSends)
+    {
+      CompleteSend(operation, _internal::MessageSendStatus::Error, error);
+    }
+  }
+
+  _internal::MessageSendCompletion MessageSenderImpl::SendAsync(
       Models::AmqpMessage const& message,
       Context const& context)
   {
+    auto operation{std::make_shared<MessageSendOperation>()};
+    _internal::MessageSendCompletion completion{operation};
+
+    // Wait for room in the send window. This must not be done while holding the connection lock,
+    // because outstanding sends are completed with the connection lock held.
+    {
+      std::unique_lock<std::mutex> lock(m_outstandingSendsLock);
+      auto maxOutstandingSends{GetMaxOutstandingSends()};
+      if (!WaitUnlessCancelled(
+              m_outstandingSendCompleted, lock, context, [this, maxOutstandingSends]() {
+                return maxOutstandingSends == 0
+                    || m_outstandingSends.size() < maxOutstandingSends;
+              }))
+      {
+        // The window never opened, so the message is not sent.
+        operation->Complete(
+            _internal::MessageSendStatus::Cancelled,
+            {Models::_internal::AmqpErrorCondition::OperationCancelled,
+             "Message send operation cancelled.",
+             {}});
+        return completion;
+      }
+      m_outstandingSends.push_back(operation);
+    }
+
+    bool queued{};
+    try
     {
       auto lock{m_session->GetConnection()->Lock()};
 
-      QueueSendInternal(
+      queued = QueueSendInternal(
           message,
-          [this](
+          [this, operation](
               Azure::Core::Amqp::_internal::MessageSendStatus sendResult,
               Models::AmqpValue deliveryStatus) {
-            Models::_internal::AmqpError error;
-
-            // If the send failed. then we need to return the error. If the send completed because
-            // of an error, it's possible that the deliveryStatus provided is null. In that case,
-            // we use the cached saved error because it is highly likely to be better than
-            // nothing.
-            if (sendResult != _internal::MessageSendStatus::Ok)
-            {
-              if (deliveryStatus.IsNull())
-              {
-                error = m_savedMessageError;
-              }
-              else
-              {
-                if (deliveryStatus.GetType() != Models::AmqpValueType::List)
-                {
-                  throw std::runtime_error("Delivery status is not a list");
-                }
-                auto deliveryStatusAsList{deliveryStatus.AsList()};
-                if (deliveryStatusAsList.size() != 1)
-                {
-                  throw std::runtime_error("Delivery Status list is not of size 1");
-                }
-                Models::AmqpValue firstState{deliveryStatusAsList[0]};
-                ERROR_HANDLE errorHandle;
-                if (!amqpvalue_get_error(
-                        Models::_detail::AmqpValueFactory::ToImplementation(firstState),
-                        &errorHandle))
-                {
-                  Models::_detail::UniqueAmqpErrorHandle uniqueError{
-                      errorHandle}; // This will free the error handle when it goes out of scope.
-                  error = Models::_detail::AmqpErrorFactory::FromImplementation(errorHandle);
-                }
-              }
-            }
-            else
-            {
-              // If we successfully sent the message, then whatever saved error should be cleared,
-              // it's no longer valid.
-              m_savedMessageError = Models::_internal::AmqpError();
-            }
-            m_sendCompleteQueue.CompleteOperation(sendResult, error);
+            CompleteSend(operation, sendResult, GetSendError(sendResult, deliveryStatus));
           },
           context);
     }
-    auto result = m_sendCompleteQueue.WaitForResult(context);
-    if (result)
+    catch (...)
     {
-      return std::move(*result);
+      CompleteSend(
+          operation,
+          _internal::MessageSendStatus::Error,
+          {Models::_internal::AmqpErrorCondition::InternalError, "Could not send message", {}});
+      throw;
     }
-    else
+    if (!queued)
     {
-      Models::_internal::AmqpError error{
-          Models::_internal::AmqpErrorCondition::OperationCancelled,
-          "Message send operation cancelled.",
-          {}};
-      return std::make_tuple(_internal::MessageSendStatus::Cancelled, error);
+      CompleteSend(
+          operation,
+          _internal::MessageSendStatus::Cancelled,
+          {Models::_internal::AmqpErrorCondition::OperationCancelled,
+           "Message send operation cancelled.",
+           {}});
     }
+    return completion;
+  }
+
+  std::tuple<_internal::MessageSendStatus, Models::_internal::AmqpError> MessageSenderImpl::Send(
+      Models::AmqpMessage const& message,
+      Context const& context)
+  {
+    return SendAsync(message, context).Wait(context);
   }
 
   std::string MessageSenderImpl::GetLinkName() const { return m_link->GetName(); }
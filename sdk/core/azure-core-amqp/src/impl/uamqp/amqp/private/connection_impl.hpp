@@ -14,8 +14,13 @@
 #include <azure_uamqp_c/connection.h>
 
 #include <chrono>
+#include <condition_variable>
+#include <future>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #if defined(_MSC_VER)
 #define _azure_ACQUIRES_LOCK(...) _Acquires_exclusive_lock_(__VA_ARGS__)
@@ -44,6 +49,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
   std::ostream& operator<<(std::ostream& os, CONNECTION_STATE state);
 
   class ClaimsBasedSecurity;
+  class ClaimsBasedSecurityImpl;
 
   class ConnectionFactory final {
   public:
@@ -126,9 +132,14 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     bool IsTraceEnabled() { return m_options.EnableTrace; }
     bool IsSasCredential() const;
 
-    // Authenticate the audience on this connection using the provided session.
+    // Track the sessions using this connection, other than the one owning the CBS link. When the
+    // last one ends on a connection which was not explicitly opened, the CBS link is closed by the
+    // token renewal thread, as the CBS session would otherwise keep the connection alive forever.
+    void OnSessionBegun();
+    void OnSessionEnded();
+
+    // Authenticate the audience on this connection.
     Azure::Core::Credentials::AccessToken AuthenticateAudience(
-        std::shared_ptr<SessionImpl> session,
         std::string const& audience,
         Azure::Core::Context const& context);
 
@@ -159,10 +170,51 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     bool m_connectionOpened = false;
     std::atomic<uint32_t> m_openCount{0};
 
-    // mutex protecting the token acquisition process.
+    // State shared between the connection and its token renewal thread. The thread only holds a
+    // weak reference to the connection, so an abandoned connection is still destroyed.
+    struct TokenRenewalState
+    {
+      std::mutex Mutex;
+      std::condition_variable Condition;
+      bool Stop{false};
+      bool Wake{false};
+      // Set when the last session has ended, the CBS link is closed on the next pass.
+      bool CloseIdle{false};
+      Azure::Core::Context Context;
+    };
+
+    // mutex protecting the token store and the token renewal state.
     std::mutex m_tokenMutex;
     std::shared_ptr<const Credentials::TokenCredential> m_credential{};
     std::map<std::string, Credentials::AccessToken> m_tokenStore;
+    // Audiences currently being authenticated, so concurrent callers share one put-token.
+    std::map<std::string, std::shared_future<Credentials::AccessToken>> m_pendingAuthentications;
+    std::shared_ptr<TokenRenewalState> m_tokenRenewal{std::make_shared<TokenRenewalState>()};
+    std::thread m_tokenRenewalThread;
+
+    // The CBS link used to authenticate every audience on this connection, and the session which
+    // owns it.
+    std::mutex m_claimsBasedSecurityMutex;
+    std::shared_ptr<SessionImpl> m_claimsBasedSecuritySession;
+    std::shared_ptr<ClaimsBasedSecurityImpl> m_claimsBasedSecurity;
+    // Number of begun sessions other than the CBS session.
+    std::atomic<uint32_t> m_sessionCount{0};
+
+    std::string GetAudienceUrl(std::string const& audience) const;
+    std::shared_ptr<ClaimsBasedSecurityImpl> GetClaimsBasedSecurity(
+        Azure::Core::Context const& context);
+    void DiscardClaimsBasedSecurity(std::shared_ptr<ClaimsBasedSecurityImpl> const& cbs);
+    Credentials::AccessToken PutToken(
+        std::string const& audienceUrl,
+        Azure::Core::Context const& context);
+    std::chrono::system_clock::time_point RenewTokens(Azure::Core::Context const& context);
+    static void RunTokenRenewal(
+        std::weak_ptr<ConnectionImpl> weakConnection,
+        std::shared_ptr<TokenRenewalState> renewal);
+    void StartTokenRenewal();
+    void StopTokenRenewal(bool waitForThread = true);
+    void CloseClaimsBasedSecurity(Azure::Core::Context const& context);
+    bool CloseIdleClaimsBasedSecurity();
 
     ConnectionImpl(
         _internal::ConnectionEvents* eventHandler,
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "../../../../amqp/private/link_credit_controller.hpp"
 #include "../../../../amqp/private/unique_handle.hpp"
 #include "azure/core/amqp/internal/message_receiver.hpp"
 #include "link_impl.hpp"
@@ -68,11 +69,18 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     TryWaitForIncomingMessage();
     void EnableLinkPolling();
 
+    _internal::MessageReceiverMetrics GetMetrics() const { return m_creditController.GetMetrics(); }
+
   private:
+    // The link credit uAMQP grants when no maximum link credit is configured (DEFAULT_LINK_CREDIT
+    // in link.c).
+    static constexpr std::uint32_t DefaultLinkCredit = 10000;
+
     UniqueMessageReceiver m_messageReceiver{};
     bool m_receiverOpen{false};
     std::shared_ptr<_detail::LinkImpl> m_link;
     _internal::MessageReceiverOptions m_options;
+    LinkCreditController m_creditController;
     Models::_internal::MessageSource m_source;
     std::shared_ptr<_detail::SessionImpl> m_session;
     Models::_internal::AmqpError m_savedMessageError{};
@@ -108,5 +116,6 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     void CreateLink();
     void CreateLink(_internal::LinkEndpoint& endpoint);
     void PopulateLinkProperties();
+    void GrowLinkCredit();
   };
 }}}} // namespace Azure::Core::Amqp::_detail
@@ -9,6 +9,10 @@
 
 #include <azure_uamqp_c/message_sender.h>
 
+#include <condition_variable>
+#include <list>
+#include <mutex>
+
 namespace Azure { namespace Core { namespace Amqp { namespace _detail {
   template <> struct UniqueHandleHelper<MESSAGE_SENDER_INSTANCE_TAG>
   {
@@ -30,6 +34,27 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     }
   };
 
+  /** @brief A single message transfer, from the call to SendAsync until the remote node settles
+   * it.
+   */
+  class MessageSendOperation final {
+  public:
+    /** @brief Record the outcome of the send.
+     *
+     * @returns true if this call completed the operation, false if it had already completed.
+     */
+    bool Complete(_internal::MessageSendStatus status, Models::_internal::AmqpError const& error);
+
+    std::tuple<_internal::MessageSendStatus, Models::_internal::AmqpError> Wait(
+        Context const& context);
+
+  private:
+    std::mutex m_lock;
+    std::condition_variable m_completed;
+    bool m_isCompleted{false};
+    std::tuple<_internal::MessageSendStatus, Models::_internal::AmqpError> m_result;
+  };
+
   class MessageSenderImpl : public std::enable_shared_from_this<MessageSenderImpl> {
   public:
     MessageSenderImpl(
@@ -55,6 +80,9 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     std::tuple<_internal::MessageSendStatus, Models::_internal::AmqpError> Send(
         Models::AmqpMessage const& message,
         Context const& context);
+    _internal::MessageSendCompletion SendAsync(
+        Models::AmqpMessage const& message,
+        Context const& context);
 
     std::uint64_t GetMaxMessageSize() const;
 
@@ -68,21 +96,31 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     void CreateLink();
     void CreateLink(_internal::LinkEndpoint& endpoint);
     void PopulateLinkProperties();
-    void QueueSendInternal(
+    bool QueueSendInternal(
         Models::AmqpMessage const& message,
         Azure::Core::Amqp::_internal::MessageSender::MessageSendCompleteCallback onSendComplete,
         Context const& context);
     void OnLinkDetached(Models::_internal::AmqpError const& error);
+    Models::_internal::AmqpError GetSendError(
+        _internal::MessageSendStatus sendResult,
+        Models::AmqpValue const& deliveryStatus);
+    std::uint32_t GetMaxOutstandingSends() const;
+    void CompleteSend(
+        std::shared_ptr<MessageSendOperation> const& operation,
+        _internal::MessageSendStatus sendResult,
+        Models::_internal::AmqpError const& error);
+    void FailOutstandingSends(Models::_internal::AmqpError const& error);
 
     bool m_senderOpen{false};
     UniqueMessageSender m_messageSender{};
     std::shared_ptr<_detail::LinkImpl> m_link;
     _internal::MessageSenderEvents* m_events;
     Models::_internal::AmqpError m_savedMessageError;
-    Azure::Core::Amqp::Common::_internal::AsyncOperationQueue<
-        Azure::Core::Amqp::_internal::MessageSendStatus,
-        Models::_internal::AmqpError>
-        m_sendCompleteQueue;
+
+    // Sends which have been started but not yet settled by the remote node.
+    std::mutex m_outstandingSendsLock;
+    std::condition_variable m_outstandingSendCompleted;
+    std::list<std::shared_ptr<MessageSendOperation>> m_outstandingSends;
 
     Azure::Core::Amqp::Common::_internal::AsyncOperationQueue<Models::_internal::AmqpError>
         m_openQueue;
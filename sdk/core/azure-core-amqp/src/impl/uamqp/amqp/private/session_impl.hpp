@@ -72,6 +72,13 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
         std::string const& description,
         Azure::Core::Context const&);
 
+    /**
+     * @brief Marks this session as the one owning the CBS link of its connection. It does not
+     * count as a user of the connection, so the connection can still close the CBS link once every
+     * other session has ended.
+     */
+    void SetOwnedByConnection() { m_ownedByConnection = true; }
+
     void SendDetach(
         _internal::LinkEndpoint const& linkEndpoint,
         bool closeLink,
@@ -81,6 +88,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     SessionImpl();
     bool m_connectionAsyncStarted{false};
     bool m_isBegun{false};
+    bool m_ownedByConnection{false};
     std::shared_ptr<_detail::ConnectionImpl> m_connectionToPoll;
     UniqueAmqpSession m_session;
     _internal::SessionOptions m_options;
@@ -44,6 +44,10 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     if (m_connectionAsyncStarted)
     {
       m_connectionToPoll->EnableAsyncOperation(false);
+      if (!m_ownedByConnection)
+      {
+        m_connectionToPoll->OnSessionEnded();
+      }
     }
     auto lock{m_connectionToPoll->Lock()};
     m_session.reset();
@@ -163,6 +167,10 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     // Mark the connection as async so that we can use the async APIs.
     GetConnection()->EnableAsyncOperation(true);
     m_connectionAsyncStarted = true;
+    if (!m_ownedByConnection)
+    {
+      GetConnection()->OnSessionBegun();
+    }
   }
   void SessionImpl::End(Azure::Core::Context const&)
   {
@@ -180,6 +188,10 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     GetConnection()->EnableAsyncOperation(false);
     m_connectionAsyncStarted = false;
     m_isBegun = false;
+    if (!m_ownedByConnection)
+    {
+      GetConnection()->OnSessionEnded();
+    }
   }
 
   void SessionImpl::End(
@@ -204,6 +216,10 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     GetConnection()->EnableAsyncOperation(false);
     m_connectionAsyncStarted = false;
     m_isBegun = false;
+    if (!m_ownedByConnection)
+    {
+      GetConnection()->OnSessionEnded();
+    }
   }
 
   void SessionImpl::SendDetach(
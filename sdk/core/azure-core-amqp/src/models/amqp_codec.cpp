@@ -0,0 +1,1761 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "../models/private/amqp_codec.hpp"
+
+#include "azure/core/amqp/internal/models/amqp_protocol.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+using Azure::Core::Amqp::_detail::AmqpDescriptors;
+
+namespace Azure { namespace Core { namespace Amqp { namespace Models { namespace _detail {
+  namespace {
+    // AMQP 1.0 type constructors, from section 1.6 of the AMQP type system specification.
+    constexpr std::uint8_t DescribedTypeConstructor = 0x00;
+    constexpr std::uint8_t NullConstructor = 0x40;
+    constexpr std::uint8_t TrueConstructor = 0x41;
+    constexpr std::uint8_t FalseConstructor = 0x42;
+    constexpr std::uint8_t Uint0Constructor = 0x43;
+    constexpr std::uint8_t Ulong0Constructor = 0x44;
+    constexpr std::uint8_t List0Constructor = 0x45;
+    constexpr std::uint8_t UbyteConstructor = 0x50;
+    constexpr std::uint8_t ByteConstructor = 0x51;
+    constexpr std::uint8_t SmallUintConstructor = 0x52;
+    constexpr std::uint8_t SmallUlongConstructor = 0x53;
+    constexpr std::uint8_t SmallIntConstructor = 0x54;
+    constexpr std::uint8_t SmallLongConstructor = 0x55;
+    constexpr std::uint8_t BooleanConstructor = 0x56;
+    constexpr std::uint8_t UshortConstructor = 0x60;
+    constexpr std::uint8_t ShortConstructor = 0x61;
+    constexpr std::uint8_t UintConstructor = 0x70;
+    constexpr std::uint8_t IntConstructor = 0x71;
+    constexpr std::uint8_t FloatConstructor = 0x72;
+    constexpr std::uint8_t CharConstructor = 0x73;
+    constexpr std::uint8_t UlongConstructor = 0x80;
+    constexpr std::uint8_t LongConstructor = 0x81;
+    constexpr std::uint8_t DoubleConstructor = 0x82;
+    constexpr std::uint8_t TimestampConstructor = 0x83;
+    constexpr std::uint8_t UuidConstructor = 0x98;
+    constexpr std::uint8_t Binary8Constructor = 0xa0;
+    constexpr std::uint8_t String8Constructor = 0xa1;
+    constexpr std::uint8_t Symbol8Constructor = 0xa3;
+    constexpr std::uint8_t Binary32Constructor = 0xb0;
+    constexpr std::uint8_t String32Constructor = 0xb1;
+    constexpr std::uint8_t Symbol32Constructor = 0xb3;
+    constexpr std::uint8_t List8Constructor = 0xc0;
+    constexpr std::uint8_t Map8Constructor = 0xc1;
+    constexpr std::uint8_t List32Constructor = 0xd0;
+    constexpr std::uint8_t Map32Constructor = 0xd1;
+    constexpr std::uint8_t Array8Constructor = 0xe0;
+    constexpr std::uint8_t Array32Constructor = 0xf0;
+
+    // Compound values may nest this deeply in decoded input. Deeper input is rejected rather than
+    // recursing without bound.
+    constexpr size_t MaxNestingDepth = 100;
+
+    // Elements with a zero width constructor (null, true, false, uint0, ulong0, list0) consume
+    // no input, so the number of them an array may claim is capped instead.
+    constexpr std::uint32_t MaxZeroWidthArrayCount = 65536;
+
+    // Raised by the decoder when the buffer ends part way through a value.
+    class BufferUnderflow final : public std::exception {
+    public:
+      const char* what() const noexcept override { return "AMQP value is truncated."; }
+    };
+
+    size_t GetEncodedVariableSize(size_t size) { return (size <= 255) ? (2 + size) : (5 + size); }
+
+    size_t GetEncodedUintSize(std::uint32_t value)
+    {
+      return (value == 0) ? 1 : ((value <= 255) ? 2 : 5);
+    }
+
+    bool UseCompound8(std::uint32_t count, size_t itemsSize)
+    {
+      return (count <= 255) && (itemsSize < 255);
+    }
+
+    size_t GetEncodedCompoundSize(std::uint32_t count, size_t itemsSize)
+    {
+      return UseCompound8(count, itemsSize) ? (3 + itemsSize) : (9 + itemsSize);
+    }
+
+    // The uAMQP array size counts the element constructor only when the elements are wider
+    // than one byte each; mirror that so both encoders produce identical arrays.
+    size_t GetDeclaredArraySize(std::uint32_t count, size_t itemsSize)
+    {
+      return (itemsSize > count) ? itemsSize + 1 : itemsSize;
+    }
+
+    size_t GetEncodedArrayItemSize(AmqpValue const& value);
+
+    size_t GetEncodedArrayItemsSize(AmqpArray const& array)
+    {
+      size_t itemsSize{};
+      for (auto const& item : array)
+      {
+        itemsSize += GetEncodedArrayItemSize(item);
+      }
+      return itemsSize;
+    }
+
+    size_t GetEncodedListItemsSize(std::vector<AmqpValue> const& items)
+    {
+      size_t itemsSize{};
+      for (auto const& item : items)
+      {
+        itemsSize += AmqpEncoder::GetEncodedSize(item);
+      }
+      return itemsSize;
+    }
+
+    size_t GetEncodedMapItemsSize(AmqpMap const& map)
+    {
+      size_t itemsSize{};
+      for (auto const& item : map)
+      {
+        itemsSize += AmqpEncoder::GetEncodedSize(item.first);
+        itemsSize += AmqpEncoder::GetEncodedSize(item.second);
+      }
+      return itemsSize;
+    }
+
+    // Returns the smallest encoding of a value with the given constructor, excluding the
+    // constructor. The width category is the high nibble of the constructor.
+    size_t GetMinimumItemSize(std::uint8_t constructor)
+    {
+      switch (constructor >> 4)
+      {
+        case 0x4:
+          return 0;
+        case 0x6:
+          return 2;
+        case 0x7:
+        case 0xb:
+          return 4;
+        case 0x8:
+        case 0xd:
+        case 0xf:
+          return 8;
+        case 0x9:
+          return 16;
+        case 0xc:
+        case 0xe:
+          return 2;
+        default:
+          return 1;
+      }
+    }
+
+    // Returns the size of an array element, excluding its constructor.
+    size_t GetEncodedArrayItemSize(AmqpValue const& value)
+    {
+      switch (value.GetType())
+      {
+        case AmqpValueType::Null:
+          return 0;
+        case AmqpValueType::Bool:
+        case AmqpValueType::Ubyte:
+        case AmqpValueType::Byte:
+          return 1;
+        case AmqpValueType::Ushort:
+        case AmqpValueType::Short:
+          return 2;
+        case AmqpValueType::Uint:
+        case AmqpValueType::Int:
+        case AmqpValueType::Float:
+        case AmqpValueType::Char:
+          return 4;
+        case AmqpValueType::Ulong:
+        case AmqpValueType::Long:
+        case AmqpValueType::Double:
+        case AmqpValueType::Timestamp:
+          return 8;
+        case AmqpValueType::Uuid:
+          return 16;
+        case AmqpValueType::Binary:
+          return 4 + value.AsBinary().size();
+        case AmqpValueType::String:
+          return 4 + static_cast<std::string>(value).size();
+        case AmqpValueType::Symbol:
+          return 4 + value.AsSymbol().size();
+        case AmqpValueType::List:
+          return 8
+              + GetEncodedListItemsSize(
+                     static_cast<std::vector<AmqpValue> const&>(value.AsList()));
+        case AmqpValueType::Map:
+          return 8 + GetEncodedMapItemsSize(value.AsMap());
+        case AmqpValueType::Array: {
+          auto array{value.AsArray()};
+          return 8 + (array.empty() ? 0 : 1) + GetEncodedArrayItemsSize(array);
+        }
+        default:
+          throw std::runtime_error("Could not encode object");
+      }
+    }
+
+    bool IsSimpleApplicationPropertyValue(AmqpValue const& value)
+    {
+      auto type{value.GetType()};
+      return (type != AmqpValueType::List) && (type != AmqpValueType::Map)
+          && (type != AmqpValueType::Composite) && (type != AmqpValueType::Described);
+    }
+
+    std::int64_t ToMilliseconds(std::chrono::system_clock::time_point const& timePoint)
+    {
+      return std::chrono::duration_cast<std::chrono::milliseconds>(timePoint.time_since_epoch())
+          .count();
+    }
+
+    std::chrono::system_clock::time_point FromMilliseconds(std::chrono::milliseconds const& ms)
+    {
+      return std::chrono::system_clock::time_point{
+          std::chrono::duration_cast<std::chrono::system_clock::duration>(ms)};
+    }
+
+    std::string StringFieldValue(AmqpValue const& value)
+    {
+      if (value.GetType() == AmqpValueType::Symbol)
+      {
+        return static_cast<std::string const&>(value.AsSymbol());
+      }
+      return static_cast<std::string>(value);
+    }
+
+    // Accumulates the size of a list of optional fields, in which the absent fields which precede
+    // a present field are encoded as null.
+    struct FieldListSize final
+    {
+      std::uint32_t Count{};
+      size_t Size{};
+
+      void Add(std::uint32_t fieldIndex, size_t fieldSize)
+      {
+        Size += (fieldIndex - Count) + fieldSize;
+        Count = fieldIndex + 1;
+      }
+    };
+
+    // The AMQP ttl field is a uint of milliseconds, longer TTLs are encoded as the longest one.
+    std::uint32_t GetTimeToLive(MessageHeader const& header)
+    {
+      auto ttl{header.TimeToLive.Value().count()};
+      if (ttl < 0)
+      {
+        throw std::runtime_error("Message time to live cannot be negative.");
+      }
+      return static_cast<std::uint32_t>((std::min)(
+          static_cast<std::uint64_t>(ttl),
+          static_cast<std::uint64_t>((std::numeric_limits<std::uint32_t>::max)())));
+    }
+
+    FieldListSize GetHeaderFieldsSize(MessageHeader const& header)
+    {
+      FieldListSize fields;
+      if (header.Durable)
+      {
+        fields.Add(0, 1);
+      }
+      if (header.Priority != 4)
+      {
+        fields.Add(1, 2);
+      }
+      if (header.TimeToLive.HasValue())
+      {
+        fields.Add(2, GetEncodedUintSize(GetTimeToLive(header)));
+      }
+      if (header.IsFirstAcquirer)
+      {
+        fields.Add(3, 1);
+      }
+      if (header.DeliveryCount != 0)
+      {
+        fields.Add(4, GetEncodedUintSize(header.DeliveryCount));
+      }
+      return fields;
+    }
+
+    FieldListSize GetPropertiesFieldsSize(MessageProperties const& properties)
+    {
+      FieldListSize fields;
+      if (!properties.MessageId.IsNull())
+      {
+        fields.Add(0, AmqpEncoder::GetEncodedSize(properties.MessageId));
+      }
+      if (properties.UserId.HasValue())
+      {
+        fields.Add(1, GetEncodedVariableSize(properties.UserId.Value().size()));
+      }
+      if (!properties.To.IsNull())
+      {
+        fields.Add(2, AmqpEncoder::GetEncodedSize(properties.To));
+      }
+      if (properties.Subject.HasValue())
+      {
+        fields.Add(3, GetEncodedVariableSize(properties.Subject.Value().size()));
+      }
+      if (!properties.ReplyTo.IsNull())
+      {
+        fields.Add(4, AmqpEncoder::GetEncodedSize(properties.ReplyTo));
+      }
+      if (!properties.CorrelationId.IsNull())
+      {
+        fields.Add(5, AmqpEncoder::GetEncodedSize(properties.CorrelationId));
+      }
+      if (properties.ContentType.HasValue())
+      {
+        fields.Add(6, GetEncodedVariableSize(properties.ContentType.Value().size()));
+      }
+      if (properties.ContentEncoding.HasValue())
+      {
+        fields.Add(7, GetEncodedVariableSize(properties.ContentEncoding.Value().size()));
+      }
+      if (properties.AbsoluteExpiryTime.HasValue())
+      {
+        fields.Add(8, 9);
+      }
+      if (properties.CreationTime.HasValue())
+      {
+        fields.Add(9, 9);
+      }
+      if (properties.GroupId.HasValue())
+      {
+        fields.Add(10, GetEncodedVariableSize(properties.GroupId.Value().size()));
+      }
+      if (properties.GroupSequence.HasValue())
+      {
+        fields.Add(11, GetEncodedUintSize(properties.GroupSequence.Value()));
+      }
+      if (properties.ReplyToGroupId.HasValue())
+      {
+        fields.Add(12, GetEncodedVariableSize(properties.ReplyToGroupId.Value().size()));
+      }
+      return fields;
+    }
+
+    // Increments the nesting depth of the decoder for the lifetime of a compound value.
+    class NestingScope final {
+    public:
+      explicit NestingScope(size_t& depth) : m_depth{depth}
+      {
+        if (m_depth == MaxNestingDepth)
+        {
+          throw std::runtime_error("AMQP value is nested too deeply.");
+        }
+        m_depth += 1;
+      }
+      ~NestingScope() { m_depth -= 1; }
+      NestingScope(NestingScope const&) = delete;
+      NestingScope& operator=(NestingScope const&) = delete;
+
+    private:
+      size_t& m_depth;
+    };
+
+    // Message sections in the order in which they may appear in a message. All body sections
+    // share a rank.
+    int GetSectionRank(AmqpDescriptors descriptor)
+    {
+      switch (descriptor)
+      {
+        case AmqpDescriptors::Header:
+          return 0;
+        case AmqpDescriptors::DeliveryAnnotations:
+          return 1;
+        case AmqpDescriptors::MessageAnnotations:
+          return 2;
+        case AmqpDescriptors::Properties:
+          return 3;
+        case AmqpDescriptors::ApplicationProperties:
+          return 4;
+        case AmqpDescriptors::DataBinary:
+        case AmqpDescriptors::DataAmqpSequence:
+        case AmqpDescriptors::DataAmqpValue:
+          return 5;
+        case AmqpDescriptors::Footer:
+          return 6;
+        default:
+          throw std::runtime_error("Found message field is not in the set of expected fields.");
+      }
+    }
+  } // namespace
+
+  size_t AmqpEncoder::GetEncodedSize(AmqpValue const& value)
+  {
+    switch (value.GetType())
+    {
+      case AmqpValueType::Null:
+      case AmqpValueType::Bool:
+        return 1;
+      case AmqpValueType::Ubyte:
+      case AmqpValueType::Byte:
+        return 2;
+      case AmqpValueType::Ushort:
+      case AmqpValueType::Short:
+        return 3;
+      case AmqpValueType::Uint:
+        return GetEncodedUintSize(static_cast<std::uint32_t>(value));
+      case AmqpValueType::Ulong: {
+        auto ulongValue{static_cast<std::uint64_t>(value)};
+        return (ulongValue == 0) ? 1 : ((ulongValue <= 255) ? 2 : 9);
+      }
+      case AmqpValueType::Int: {
+        auto intValue{static_cast<std::int32_t>(value)};
+        return ((intValue >= -128) && (intValue <= 127)) ? 2 : 5;
+      }
+      case AmqpValueType::Long: {
+        auto longValue{static_cast<std::int64_t>(value)};
+        return ((longValue >= -128) && (longValue <= 127)) ? 2 : 9;
+      }
+      case AmqpValueType::Float:
+      case AmqpValueType::Char:
+        return 5;
+      case AmqpValueType::Double:
+      case AmqpValueType::Timestamp:
+        return 9;
+      case AmqpValueType::Uuid:
+        return 17;
+      case AmqpValueType::Binary:
+        return GetEncodedVariableSize(value.AsBinary().size());
+      case AmqpValueType::String:
+        return GetEncodedVariableSize(static_cast<std::string>(value).size());
+      case AmqpValueType::Symbol:
+        return GetEncodedVariableSize(value.AsSymbol().size());
+      case AmqpValueType::List: {
+        auto list{value.AsList()};
+        if (list.empty())
+        {
+          return 1;
+        }
+        return GetEncodedCompoundSize(
+            static_cast<std::uint32_t>(list.size()),
+            GetEncodedListItemsSize(static_cast<std::vector<AmqpValue> const&>(list)));
+      }
+      case AmqpValueType::Map: {
+        auto map{value.AsMap()};
+        return GetEncodedCompoundSize(
+            static_cast<std::uint32_t>(map.size() * 2), GetEncodedMapItemsSize(map));
+      }
+      case AmqpValueType::Array: {
+        auto array{value.AsArray()};
+        auto count{static_cast<std::uint32_t>(array.size())};
+        size_t itemsSize{GetEncodedArrayItemsSize(array)};
+        size_t declaredSize{GetDeclaredArraySize(count, itemsSize)};
+        size_t headerSize{UseCompound8(count, declaredSize) ? size_t{3} : size_t{9}};
+        return headerSize + (count != 0 ? 1 : 0) + itemsSize;
+      }
+      case AmqpValueType::Described: {
+        auto described{value.AsDescribed()};
+        return 1 + GetEncodedSize(described.GetDescriptor()) + GetEncodedSize(described.GetValue());
+      }
+      case AmqpValueType::Composite: {
+        auto composite{value.AsComposite()};
+        auto const& items{static_cast<std::vector<AmqpValue> const&>(composite)};
+        size_t listSize{
+            items.empty() ? 1
+                          : GetEncodedCompoundSize(
+                              static_cast<std::uint32_t>(items.size()),
+                              GetEncodedListItemsSize(items))};
+        return 1 + GetEncodedSize(composite.GetDescriptor()) + listSize;
+      }
+      default:
+        throw std::runtime_error("Could not encode object");
+    }
+  }
+
+  void AmqpEncoder::Encode(AmqpValue const& value)
+  {
+    switch (value.GetType())
+    {
+      case AmqpValueType::Null:
+        AppendByte(NullConstructor);
+        break;
+      case AmqpValueType::Bool:
+        AppendByte(static_cast<bool>(value) ? TrueConstructor : FalseConstructor);
+        break;
+      case AmqpValueType::Ubyte:
+        AppendByte(UbyteConstructor);
+        AppendByte(static_cast<std::uint8_t>(value));
+        break;
+      case AmqpValueType::Ushort:
+        AppendByte(UshortConstructor);
+        AppendUint16(static_cast<std::uint16_t>(value));
+        break;
+      case AmqpValueType::Uint:
+        EncodeUint(static_cast<std::uint32_t>(value));
+        break;
+      case AmqpValueType::Ulong:
+        EncodeUlong(static_cast<std::uint64_t>(value));
+        break;
+      case AmqpValueType::Byte:
+        AppendByte(ByteConstructor);
+        AppendByte(static_cast<std::uint8_t>(static_cast<std::int8_t>(value)));
+        break;
+      case AmqpValueType::Short:
+        AppendByte(ShortConstructor);
+        AppendUint16(static_cast<std::uint16_t>(static_cast<std::int16_t>(value)));
+        break;
+      case AmqpValueType::Int: {
+        auto intValue{static_cast<std::int32_t>(value)};
+        if ((intValue >= -128) && (intValue <= 127))
+        {
+          AppendByte(SmallIntConstructor);
+          AppendByte(static_cast<std::uint8_t>(intValue));
+        }
+        else
+        {
+          AppendByte(IntConstructor);
+          AppendUint32(static_cast<std::uint32_t>(intValue));
+        }
+        break;
+      }
+      case AmqpValueType::Long: {
+        auto longValue{static_cast<std::int64_t>(value)};
+        if ((longValue >= -128) && (longValue <= 127))
+        {
+          AppendByte(SmallLongConstructor);
+          AppendByte(static_cast<std::uint8_t>(longValue));
+        }
+        else
+        {
+          AppendByte(LongConstructor);
+          AppendUint64(static_cast<std::uint64_t>(longValue));
+        }
+        break;
+      }
+      case AmqpValueType::Binary: {
+        auto binary{value.AsBinary()};
+        EncodeVariable(
+            Binary8Constructor, Binary32Constructor, binary.data(), binary.size(), true, true);
+        break;
+      }
+      case AmqpValueType::String:
+        EncodeString(String8Constructor, String32Constructor, static_cast<std::string>(value));
+        break;
+      case AmqpValueType::Symbol:
+        EncodeString(
+            Symbol8Constructor,
+            Symbol32Constructor,
+            static_cast<std::string const&>(value.AsSymbol()));
+        break;
+      case AmqpValueType::List:
+        EncodeList(value.AsList());
+        break;
+      case AmqpValueType::Map:
+        EncodeMap(value.AsMap());
+        break;
+      case AmqpValueType::Array:
+        EncodeArray(value.AsArray());
+        break;
+      case AmqpValueType::Described: {
+        auto described{value.AsDescribed()};
+        AppendByte(DescribedTypeConstructor);
+        Encode(described.GetDescriptor());
+        Encode(described.GetValue());
+        break;
+      }
+      case AmqpValueType::Composite: {
+        auto composite{value.AsComposite()};
+        AppendByte(DescribedTypeConstructor);
+        Encode(composite.GetDescriptor());
+        EncodeListItems(static_cast<std::vector<AmqpValue> const&>(composite));
+        break;
+      }
+      default:
+        // All the remaining scalar types share their encoding with array elements.
+        EncodeArrayItem(value, true);
+        break;
+    }
+  }
+
+  void AmqpEncoder::EncodeArrayItem(AmqpValue const& value, bool firstElement)
+  {
+    switch (value.GetType())
+    {
+      case AmqpValueType::Null:
+        if (firstElement)
+        {
+          AppendByte(NullConstructor);
+        }
+        break;
+      case AmqpValueType::Bool:
+        if (firstElement)
+        {
+          AppendByte(BooleanConstructor);
+        }
+        AppendByte(static_cast<bool>(value) ? 0x01 : 0x00);
+        break;
+      case AmqpValueType::Ubyte:
+        if (firstElement)
+        {
+          AppendByte(UbyteConstructor);
+        }
+        AppendByte(static_cast<std::uint8_t>(value));
+        break;
+      case AmqpValueType::Ushort:
+        if (firstElement)
+        {
+          AppendByte(UshortConstructor);
+        }
+        AppendUint16(static_cast<std::uint16_t>(value));
+        break;
+      case AmqpValueType::Uint:
+        if (firstElement)
+        {
+          AppendByte(UintConstructor);
+        }
+        AppendUint32(static_cast<std::uint32_t>(value));
+        break;
+      case AmqpValueType::Ulong:
+        if (firstElement)
+        {
+          AppendByte(UlongConstructor);
+        }
+        AppendUint64(static_cast<std::uint64_t>(value));
+        break;
+      case AmqpValueType::Byte:
+        if (firstElement)
+        {
+          AppendByte(ByteConstructor);
+        }
+        AppendByte(static_cast<std::uint8_t>(static_cast<std::int8_t>(value)));
+        break;
+      case AmqpValueType::Short:
+        if (firstElement)
+        {
+          AppendByte(ShortConstructor);
+        }
+        AppendUint16(static_cast<std::uint16_t>(static_cast<std::int16_t>(value)));
+        break;
+      case AmqpValueType::Int:
+        if (firstElement)
+        {
+          AppendByte(IntConstructor);
+        }
+        AppendUint32(static_cast<std::uint32_t>(static_cast<std::int32_t>(value)));
+        break;
+      case AmqpValueType::Long:
+        if (firstElement)
+        {
+          AppendByte(LongConstructor);
+        }
+        AppendUint64(static_cast<std::uint64_t>(static_cast<std::int64_t>(value)));
+        break;
+      case AmqpValueType::Float: {
+        if (firstElement)
+        {
+          AppendByte(FloatConstructor);
+        }
+        auto floatValue{static_cast<float>(value)};
+        std::uint32_t bits;
+        std::memcpy(&bits, &floatValue, sizeof(bits));
+        AppendUint32(bits);
+        break;
+      }
+      case AmqpValueType::Double: {
+        if (firstElement)
+        {
+          AppendByte(DoubleConstructor);
+        }
+        auto doubleValue{static_cast<double>(value)};
+        std::uint64_t bits;
+        std::memcpy(&bits, &doubleValue, sizeof(bits));
+        AppendUint64(bits);
+        break;
+      }
+      case AmqpValueType::Char:
+        if (firstElement)
+        {
+          AppendByte(CharConstructor);
+        }
+        AppendUint32(static_cast<std::uint32_t>(static_cast<char32_t>(value)));
+        break;
+      case AmqpValueType::Timestamp:
+        if (firstElement)
+        {
+          AppendByte(TimestampConstructor);
+        }
+        AppendUint64(static_cast<std::uint64_t>(
+            static_cast<std::chrono::milliseconds>(value.AsTimestamp()).count()));
+        break;
+      case AmqpValueType::Uuid: {
+        if (firstElement)
+        {
+          AppendByte(UuidConstructor);
+        }
+        auto uuid{static_cast<Azure::Core::Uuid>(value)};
+        AppendBytes(uuid.AsArray().data(), uuid.AsArray().size());
+        break;
+      }
+      case AmqpValueType::Binary: {
+        auto binary{value.AsBinary()};
+        EncodeVariable(
+            Binary8Constructor,
+            Binary32Constructor,
+            binary.data(),
+            binary.size(),
+            false,
+            firstElement);
+        break;
+      }
+      case AmqpValueType::String: {
+        auto stringValue{static_cast<std::string>(value)};
+        EncodeVariable(
+            String8Constructor,
+            String32Constructor,
+            reinterpret_cast<std::uint8_t const*>(stringValue.data()),
+            stringValue.size(),
+            false,
+            firstElement);
+        break;
+      }
+      case AmqpValueType::Symbol: {
+        auto symbol{value.AsSymbol()};
+        auto const& symbolValue{static_cast<std::string const&>(symbol)};
+        EncodeVariable(
+            Symbol8Constructor,
+            Symbol32Constructor,
+            reinterpret_cast<std::uint8_t const*>(symbolValue.data()),
+            symbolValue.size(),
+            false,
+            firstElement);
+        break;
+      }
+      case AmqpValueType::List: {
+        if (firstElement)
+        {
+          AppendByte(List32Constructor);
+        }
+        auto list{value.AsList()};
+        size_t listStart{m_buffer.size()};
+        m_buffer.resize(listStart + 8);
+        for (auto const& item : list)
+        {
+          Encode(item);
+        }
+        WriteUint32At(listStart, static_cast<std::uint32_t>(m_buffer.size() - listStart - 4));
+        WriteUint32At(listStart + 4, static_cast<std::uint32_t>(list.size()));
+        break;
+      }
+      case AmqpValueType::Map: {
+        if (firstElement)
+        {
+          AppendByte(Map32Constructor);
+        }
+        auto map{value.AsMap()};
+        size_t mapStart{m_buffer.size()};
+        m_buffer.resize(mapStart + 8);
+        for (auto const& item : map)
+        {
+          Encode(item.first);
+          Encode(item.second);
+        }
+        WriteUint32At(mapStart, static_cast<std::uint32_t>(m_buffer.size() - mapStart - 4));
+        WriteUint32At(mapStart + 4, static_cast<std::uint32_t>(map.size() * 2));
+        break;
+      }
+      case AmqpValueType::Array: {
+        if (firstElement)
+        {
+          AppendByte(Array32Constructor);
+        }
+        auto array{value.AsArray()};
+        size_t arrayStart{m_buffer.size()};
+        m_buffer.resize(arrayStart + 8);
+        bool firstItem{true};
+        for (auto const& item : array)
+        {
+          EncodeArrayItem(item, firstItem);
+          firstItem = false;
+        }
+        auto count{static_cast<std::uint32_t>(array.size())};
+        size_t itemsSize{m_buffer.size() - arrayStart - 8 - (count != 0 ? 1 : 0)};
+        WriteUint32At(
+            arrayStart, static_cast<std::uint32_t>(GetDeclaredArraySize(count, itemsSize) + 4));
+        WriteUint32At(arrayStart + 4, count);
+        break;
+      }
+      default:
+        throw std::runtime_error("Could not encode object");
+    }
+  }
+
+  void AmqpEncoder::EncodeUint(std::uint32_t value)
+  {
+    if (value == 0)
+    {
+      AppendByte(Uint0Constructor);
+    }
+    else if (value <= 255)
+    {
+      AppendByte(SmallUintConstructor);
+      AppendByte(static_cast<std::uint8_t>(value));
+    }
+    else
+    {
+      AppendByte(UintConstructor);
+      AppendUint32(value);
+    }
+  }
+
+  void AmqpEncoder::EncodeUlong(std::uint64_t value)
+  {
+    if (value == 0)
+    {
+      AppendByte(Ulong0Constructor);
+    }
+    else if (value <= 255)
+    {
+      AppendByte(SmallUlongConstructor);
+      AppendByte(static_cast<std::uint8_t>(value));
+    }
+    else
+    {
+      AppendByte(UlongConstructor);
+      AppendUint64(value);
+    }
+  }
+
+  void AmqpEncoder::EncodeTimestamp(std::int64_t milliseconds)
+  {
+    AppendByte(TimestampConstructor);
+    AppendUint64(static_cast<std::uint64_t>(milliseconds));
+  }
+
+  void AmqpEncoder::EncodeVariable(
+      std::uint8_t constructor8,
+      std::uint8_t constructor32,
+      std::uint8_t const* data,
+      size_t size,
+      bool useSmallest,
+      bool writeConstructor)
+  {
+    if (size > (std::numeric_limits<std::uint32_t>::max)())
+    {
+      throw std::runtime_error("Value is too large to be AMQP encoded.");
+    }
+    if (useSmallest && size <= 255)
+    {
+      AppendByte(constructor8);
+      AppendByte(static_cast<std::uint8_t>(size));
+    }
+    else
+    {
+      if (writeConstructor)
+      {
+        AppendByte(constructor32);
+      }
+      AppendUint32(static_cast<std::uint32_t>(size));
+    }
+    AppendBytes(data, size);
+  }
+
+  void AmqpEncoder::EncodeString(
+      std::uint8_t constructor8,
+      std::uint8_t constructor32,
+      std::string const& value)
+  {
+    EncodeVariable(
+        constructor8,
+        constructor32,
+        reinterpret_cast<std::uint8_t const*>(value.data()),
+        value.size(),
+        true,
+        true);
+  }
+
+  void AmqpEncoder::EncodeList(AmqpList const& list)
+  {
+    EncodeListItems(static_cast<std::vector<AmqpValue> const&>(list));
+  }
+
+  void AmqpEncoder::EncodeListItems(std::vector<AmqpValue> const& items)
+  {
+    if (items.empty())
+    {
+      AppendByte(List0Constructor);
+      return;
+    }
+    WriteCompoundHeader(
+        static_cast<std::uint32_t>(items.size()),
+        GetEncodedListItemsSize(items),
+        List8Constructor,
+        List32Constructor);
+    for (auto const& item : items)
+    {
+      Encode(item);
+    }
+  }
+
+  void AmqpEncoder::EncodeMap(AmqpMap const& map)
+  {
+    WriteCompoundHeader(
+        static_cast<std::uint32_t>(map.size() * 2),
+        GetEncodedMapItemsSize(map),
+        Map8Constructor,
+        Map32Constructor);
+    for (auto const& item : map)
+    {
+      Encode(item.first);
+      Encode(item.second);
+    }
+  }
+
+  void AmqpEncoder::EncodeArray(AmqpArray const& array)
+  {
+    auto count{static_cast<std::uint32_t>(array.size())};
+    // The items of a non-empty array are preceded by the (single) element constructor.
+    size_t declaredSize{GetDeclaredArraySize(count, GetEncodedArrayItemsSize(array))};
+    if (UseCompound8(count, declaredSize))
+    {
+      AppendByte(Array8Constructor);
+      AppendByte(static_cast<std::uint8_t>(declaredSize + 1));
+      AppendByte(static_cast<std::uint8_t>(count));
+    }
+    else
+    {
+      AppendByte(Array32Constructor);
+      AppendUint32(static_cast<std::uint32_t>(declaredSize + 4));
+      AppendUint32(count);
+    }
+    bool firstElement{true};
+    for (auto const& item : array)
+    {
+      EncodeArrayItem(item, firstElement);
+      firstElement = false;
+    }
+  }
+
+  void AmqpEncoder::EncodeDescriptor(AmqpDescriptors descriptor)
+  {
+    AppendByte(DescribedTypeConstructor);
+    EncodeUlong(static_cast<std::uint64_t>(descriptor));
+  }
+
+  void AmqpEncoder::EncodeAnnotationsSection(
+      AmqpDescriptors descriptor,
+      AmqpAnnotations const& annotations)
+  {
+    EncodeDescriptor(descriptor);
+    size_t itemsSize{};
+    for (auto const& annotation : annotations)
+    {
+      itemsSize += GetEncodedVariableSize(annotation.first.size())
+          + GetEncodedSize(annotation.second);
+    }
+    WriteCompoundHeader(
+        static_cast<std::uint32_t>(annotations.size() * 2),
+        itemsSize,
+        Map8Constructor,
+        Map32Constructor);
+    for (auto const& annotation : annotations)
+    {
+      EncodeString(
+          Symbol8Constructor,
+          Symbol32Constructor,
+          static_cast<std::string const&>(annotation.first));
+      Encode(annotation.second);
+    }
+  }
+
+  void AmqpEncoder::EncodeApplicationPropertiesSection(
+      std::map<std::string, AmqpValue> const& applicationProperties)
+  {
+    EncodeDescriptor(AmqpDescriptors::ApplicationProperties);
+    size_t itemsSize{};
+    for (auto const& property : applicationProperties)
+    {
+      if (!IsSimpleApplicationPropertyValue(property.second))
+      {
+        throw std::runtime_error("Message Application Property values must be simple value types");
+      }
+      itemsSize += GetEncodedVariableSize(property.first.size()) + GetEncodedSize(property.second);
+    }
+    WriteCompoundHeader(
+        static_cast<std::uint32_t>(applicationProperties.size() * 2),
+        itemsSize,
+        Map8Constructor,
+        Map32Constructor);
+    for (auto const& property : applicationProperties)
+    {
+      EncodeString(String8Constructor, String32Constructor, property.first);
+      Encode(property.second);
+    }
+  }
+
+  void AmqpEncoder::BeginField(std::uint32_t& fieldCount, std::uint32_t fieldIndex)
+  {
+    // Fields which are not present but precede a present field are encoded as null.
+    for (; fieldCount < fieldIndex; fieldCount += 1)
+    {
+      AppendByte(NullConstructor);
+    }
+    fieldCount = fieldIndex + 1;
+  }
+
+  // The header section is a described list of fields, of which only the fields which differ
+  // from their default values are encoded.
+  void AmqpEncoder::EncodeHeaderSection(MessageHeader const& header)
+  {
+    EncodeDescriptor(AmqpDescriptors::Header);
+    auto fields{GetHeaderFieldsSize(header)};
+    if (!BeginFieldList(fields.Count, fields.Size))
+    {
+      return;
+    }
+    std::uint32_t fieldCount{};
+    if (header.Durable)
+    {
+      BeginField(fieldCount, 0);
+      AppendByte(TrueConstructor);
+    }
+    if (header.Priority != 4)
+    {
+      BeginField(fieldCount, 1);
+      AppendByte(UbyteConstructor);
+      AppendByte(header.Priority);
+    }
+    if (header.TimeToLive.HasValue())
+    {
+      BeginField(fieldCount, 2);
+      EncodeUint(GetTimeToLive(header));
+    }
+    if (header.IsFirstAcquirer)
+    {
+      BeginField(fieldCount, 3);
+      AppendByte(TrueConstructor);
+    }
+    if (header.DeliveryCount != 0)
+    {
+      BeginField(fieldCount, 4);
+      EncodeUint(header.DeliveryCount);
+    }
+  }
+
+  void AmqpEncoder::EncodePropertiesSection(MessageProperties const& properties)
+  {
+    EncodeDescriptor(AmqpDescriptors::Properties);
+    auto fields{GetPropertiesFieldsSize(properties)};
+    if (!BeginFieldList(fields.Count, fields.Size))
+    {
+      return;
+    }
+    std::uint32_t fieldCount{};
+    if (!properties.MessageId.IsNull())
+    {
+      BeginField(fieldCount, 0);
+      Encode(properties.MessageId);
+    }
+    if (properties.UserId.HasValue())
+    {
+      BeginField(fieldCount, 1);
+      auto const& userId{properties.UserId.Value()};
+      EncodeVariable(
+          Binary8Constructor, Binary32Constructor, userId.data(), userId.size(), true, true);
+    }
+    if (!properties.To.IsNull())
+    {
+      BeginField(fieldCount, 2);
+      Encode(properties.To);
+    }
+    if (properties.Subject.HasValue())
+    {
+      BeginField(fieldCount, 3);
+      EncodeString(String8Constructor, String32Constructor, properties.Subject.Value());
+    }
+    if (!properties.ReplyTo.IsNull())
+    {
+      BeginField(fieldCount, 4);
+      Encode(properties.ReplyTo);
+    }
+    if (!properties.CorrelationId.IsNull())
+    {
+      BeginField(fieldCount, 5);
+      Encode(properties.CorrelationId);
+    }
+    if (properties.ContentType.HasValue())
+    {
+      BeginField(fieldCount, 6);
+      EncodeString(Symbol8Constructor, Symbol32Constructor, properties.ContentType.Value());
+    }
+    if (properties.ContentEncoding.HasValue())
+    {
+      BeginField(fieldCount, 7);
+      EncodeString(Symbol8Constructor, Symbol32Constructor, properties.ContentEncoding.Value());
+    }
+    if (properties.AbsoluteExpiryTime.HasValue())
+    {
+      BeginField(fieldCount, 8);
+      EncodeTimestamp(ToMilliseconds(properties.AbsoluteExpiryTime.Value()));
+    }
+    if (properties.CreationTime.HasValue())
+    {
+      BeginField(fieldCount, 9);
+      EncodeTimestamp(ToMilliseconds(properties.CreationTime.Value()));
+    }
+    if (properties.GroupId.HasValue())
+    {
+      BeginField(fieldCount, 10);
+      EncodeString(String8Constructor, String32Constructor, properties.GroupId.Value());
+    }
+    if (properties.GroupSequence.HasValue())
+    {
+      BeginField(fieldCount, 11);
+      EncodeUint(properties.GroupSequence.Value());
+    }
+    if (properties.ReplyToGroupId.HasValue())
+    {
+      BeginField(fieldCount, 12);
+      EncodeString(String8Constructor, String32Constructor, properties.ReplyToGroupId.Value());
+    }
+  }
+
+  void AmqpEncoder::EncodeMessage(AmqpMessage const& message)
+  {
+    if (message.Header.ShouldSerialize())
+    {
+      EncodeHeaderSection(message.Header);
+    }
+    if (!message.DeliveryAnnotations.empty())
+    {
+      EncodeAnnotationsSection(AmqpDescriptors::DeliveryAnnotations, message.DeliveryAnnotations);
+    }
+    if (!message.MessageAnnotations.empty())
+    {
+      EncodeAnnotationsSection(AmqpDescriptors::MessageAnnotations, message.MessageAnnotations);
+    }
+    if (message.Properties.ShouldSerialize())
+    {
+      EncodePropertiesSection(message.Properties);
+    }
+    if (!message.ApplicationProperties.empty())
+    {
+      EncodeApplicationPropertiesSection(message.ApplicationProperties);
+    }
+
+    switch (message.BodyType)
+    {
+      default:
+      case MessageBodyType::Invalid:
+        throw std::runtime_error("Invalid message body type.");
+
+      case MessageBodyType::Value:
+        EncodeDescriptor(AmqpDescriptors::DataAmqpValue);
+        Encode(message.GetBodyAsAmqpValue());
+        break;
+      case MessageBodyType::Data: {
+        auto const& body{message.GetBodyAsBinary()};
+        size_t bodySize{};
+        for (auto const& data : body)
+        {
+          bodySize += data.size() + 8;
+        }
+        // The body usually dominates the size of the message, reserve space for it up front.
+        m_buffer.reserve(m_buffer.size() + bodySize);
+        for (auto const& data : body)
+        {
+          EncodeDescriptor(AmqpDescriptors::DataBinary);
+          EncodeVariable(
+              Binary8Constructor, Binary32Constructor, data.data(), data.size(), true, true);
+        }
+        break;
+      }
+      case MessageBodyType::Sequence:
+        for (auto const& list : message.GetBodyAsAmqpList())
+        {
+          EncodeDescriptor(AmqpDescriptors::DataAmqpSequence);
+          EncodeList(list);
+        }
+        break;
+    }
+
+    if (!message.Footer.empty())
+    {
+      EncodeAnnotationsSection(AmqpDescriptors::Footer, message.Footer);
+    }
+  }
+
+  void AmqpEncoder::WriteCompoundHeader(
+      std::uint32_t count,
+      size_t itemsSize,
+      std::uint8_t constructor8,
+      std::uint8_t constructor32)
+  {
+    if (UseCompound8(count, itemsSize))
+    {
+      AppendByte(constructor8);
+      AppendByte(static_cast<std::uint8_t>(itemsSize + 1));
+      AppendByte(static_cast<std::uint8_t>(count));
+    }
+    else
+    {
+      if (itemsSize + 4 > (std::numeric_limits<std::uint32_t>::max)())
+      {
+        throw std::runtime_error("Value is too large to be AMQP encoded.");
+      }
+      AppendByte(constructor32);
+      AppendUint32(static_cast<std::uint32_t>(itemsSize + 4));
+      AppendUint32(count);
+    }
+  }
+
+  bool AmqpEncoder::BeginFieldList(std::uint32_t fieldCount, size_t fieldsSize)
+  {
+    if (fieldCount == 0)
+    {
+      AppendByte(List0Constructor);
+      return false;
+    }
+    WriteCompoundHeader(fieldCount, fieldsSize, List8Constructor, List32Constructor);
+    return true;
+  }
+
+  void AmqpEncoder::AppendUint16(std::uint16_t value)
+  {
+    AppendByte(static_cast<std::uint8_t>(value >> 8));
+    AppendByte(static_cast<std::uint8_t>(value));
+  }
+
+  void AmqpEncoder::AppendUint32(std::uint32_t value)
+  {
+    size_t position{m_buffer.size()};
+    m_buffer.resize(position + 4);
+    WriteUint32At(position, value);
+  }
+
+  void AmqpEncoder::AppendUint64(std::uint64_t value)
+  {
+    AppendUint32(static_cast<std::uint32_t>(value >> 32));
+    AppendUint32(static_cast<std::uint32_t>(value));
+  }
+
+  void AmqpEncoder::AppendBytes(std::uint8_t const* data, size_t size)
+  {
+    m_buffer.insert(m_buffer.end(), data, data + size);
+  }
+
+  void AmqpEncoder::WriteUint32At(size_t position, std::uint32_t value)
+  {
+    m_buffer[position] = static_cast<std::uint8_t>(value >> 24);
+    m_buffer[position + 1] = static_cast<std::uint8_t>(value >> 16);
+    m_buffer[position + 2] = static_cast<std::uint8_t>(value >> 8);
+    m_buffer[position + 3] = static_cast<std::uint8_t>(value);
+  }
+
+  bool AmqpDecoder::TryDecode(AmqpValue& value)
+  {
+    size_t startPosition{m_position};
+    try
+    {
+      if (m_position == m_size)
+      {
+        return false;
+      }
+      value = DecodeValue();
+      return true;
+    }
+    catch (BufferUnderflow const&)
+    {
+      m_position = startPosition;
+      return false;
+    }
+  }
+
+  AmqpValue AmqpDecoder::DecodeValue()
+  {
+    std::uint8_t constructor{ReadByte()};
+    if (constructor == DescribedTypeConstructor)
+    {
+      NestingScope nesting{m_depth};
+      AmqpValue descriptor{DecodeValue()};
+      AmqpValue value{DecodeValue()};
+      switch (descriptor.GetType())
+      {
+        case AmqpValueType::Ulong:
+          return AmqpDescribed{static_cast<std::uint64_t>(descriptor), value}.AsAmqpValue();
+        case AmqpValueType::Symbol:
+          return AmqpDescribed{descriptor.AsSymbol(), value}.AsAmqpValue();
+        default:
+          throw std::runtime_error("Descriptor of a described type must be a ulong or symbol.");
+      }
+    }
+    return DecodeValueOfType(constructor);
+  }
+
+  AmqpValue AmqpDecoder::DecodeValueOfType(std::uint8_t constructor)
+  {
+    switch (constructor)
+    {
+      case NullConstructor:
+        return AmqpValue{};
+      case TrueConstructor:
+        return AmqpValue{true};
+      case FalseConstructor:
+        return AmqpValue{false};
+      case BooleanConstructor: {
+        std::uint8_t boolValue{ReadByte()};
+        if (boolValue > 1)
+        {
+          throw std::runtime_error("Invalid boolean value.");
+        }
+        return AmqpValue{boolValue == 1};
+      }
+      case UbyteConstructor:
+        return AmqpValue{ReadByte()};
+      case UshortConstructor:
+        return AmqpValue{ReadUint16()};
+      case Uint0Constructor:
+        return AmqpValue{std::uint32_t{0}};
+      case SmallUintConstructor:
+        return AmqpValue{static_cast<std::uint32_t>(ReadByte())};
+      case UintConstructor:
+        return AmqpValue{ReadUint32()};
+      case Ulong0Constructor:
+        return AmqpValue{std::uint64_t{0}};
+      case SmallUlongConstructor:
+        return AmqpValue{static_cast<std::uint64_t>(ReadByte())};
+      case UlongConstructor:
+        return AmqpValue{ReadUint64()};
+      case ByteConstructor:
+        return AmqpValue{static_cast<std::int8_t>(ReadByte())};
+      case ShortConstructor:
+        return AmqpValue{static_cast<std::int16_t>(ReadUint16())};
+      case SmallIntConstructor:
+        return AmqpValue{static_cast<std::int32_t>(static_cast<std::int8_t>(ReadByte()))};
+      case IntConstructor:
+        return AmqpValue{static_cast<std::int32_t>(ReadUint32())};
+      case SmallLongConstructor:
+        return AmqpValue{static_cast<std::int64_t>(static_cast<std::int8_t>(ReadByte()))};
+      case LongConstructor:
+        return AmqpValue{static_cast<std::int64_t>(ReadUint64())};
+      case FloatConstructor: {
+        std::uint32_t bits{ReadUint32()};
+        float floatValue;
+        std::memcpy(&floatValue, &bits, sizeof(floatValue));
+        return AmqpValue{floatValue};
+      }
+      case DoubleConstructor: {
+        std::uint64_t bits{ReadUint64()};
+        double doubleValue;
+        std::memcpy(&doubleValue, &bits, sizeof(doubleValue));
+        return AmqpValue{doubleValue};
+      }
+      case CharConstructor:
+        return AmqpValue{static_cast<char32_t>(ReadUint32())};
+      case TimestampConstructor:
+        return AmqpTimestamp{std::chrono::milliseconds{static_cast<std::int64_t>(ReadUint64())}}
+            .AsAmqpValue();
+      case UuidConstructor: {
+        Azure::Core::Uuid::ValueArray uuid;
+        std::memcpy(uuid.data(), ReadBytes(uuid.size()), uuid.size());
+        return AmqpValue{Azure::Core::Uuid::CreateFromArray(uuid)};
+      }
+      case Binary8Constructor:
+      case Binary32Constructor: {
+        size_t size{(constructor == Binary8Constructor) ? ReadByte() : ReadUint32()};
+        auto data{ReadBytes(size)};
+        return AmqpBinaryData{std::vector<std::uint8_t>(data, data + size)}.AsAmqpValue();
+      }
+      case String8Constructor:
+      case String32Constructor:
+        return AmqpValue{ReadString(constructor)};
+      case Symbol8Constructor:
+      case Symbol32Constructor:
+        return AmqpSymbol{ReadString(constructor)}.AsAmqpValue();
+      case List0Constructor:
+      case List8Constructor:
+      case List32Constructor:
+        return DecodeList(constructor).AsAmqpValue();
+      case Map8Constructor:
+      case Map32Constructor: {
+        NestingScope nesting{m_depth};
+        std::uint32_t count{ReadCompoundHeader(constructor)};
+        if (count % 2 != 0)
+        {
+          throw std::runtime_error("AMQP map must have an even number of elements.");
+        }
+        AmqpMap map;
+        for (std::uint32_t i = 0; i < count; i += 2)
+        {
+          AmqpValue key{DecodeValue()};
+          map.emplace(std::move(key), DecodeValue());
+        }
+        return map.AsAmqpValue();
+      }
+      case Array8Constructor:
+      case Array32Constructor: {
+        NestingScope nesting{m_depth};
+        std::uint32_t count{ReadCompoundHeader(constructor)};
+        AmqpArray array;
+        if (count != 0)
+        {
+          std::uint8_t elementConstructor{ReadByte()};
+          if (elementConstructor == DescribedTypeConstructor)
+          {
+            throw std::runtime_error("Arrays of described types are not supported.");
+          }
+          size_t itemSize{GetMinimumItemSize(elementConstructor)};
+          if (itemSize == 0)
+          {
+            if (count > MaxZeroWidthArrayCount)
+            {
+              throw std::runtime_error("Invalid AMQP array element count.");
+            }
+          }
+          else if (count > (m_size - m_position) / itemSize)
+          {
+            throw BufferUnderflow{};
+          }
+          for (std::uint32_t i = 0; i < count; i += 1)
+          {
+            array.push_back(DecodeValueOfType(elementConstructor));
+          }
+        }
+        return array.AsAmqpValue();
+      }
+      default:
+        throw std::runtime_error("Could not decode object");
+    }
+  }
+
+  AmqpList AmqpDecoder::DecodeList(std::uint8_t constructor)
+  {
+    if (constructor != List0Constructor && constructor != List8Constructor
+        && constructor != List32Constructor)
+    {
+      throw std::runtime_error("Input AMQP value MUST be a list.");
+    }
+    AmqpList list;
+    if (constructor != List0Constructor)
+    {
+      NestingScope nesting{m_depth};
+      std::uint32_t count{ReadCompoundHeader(constructor)};
+      for (std::uint32_t i = 0; i < count; i += 1)
+      {
+        list.push_back(DecodeValue());
+      }
+    }
+    return list;
+  }
+
+  std::vector<AmqpValue> AmqpDecoder::DecodeSectionFields()
+  {
+    auto list{DecodeList(ReadByte())};
+    return static_cast<std::vector<AmqpValue> const&>(list);
+  }
+
+  AmqpAnnotations AmqpDecoder::DecodeAnnotationsSection()
+  {
+    std::uint8_t constructor{ReadByte()};
+    if (constructor != Map8Constructor && constructor != Map32Constructor)
+    {
+      throw std::runtime_error("Input AMQP value MUST be a map.");
+    }
+    std::uint32_t count{ReadCompoundHeader(constructor)};
+    if (count % 2 != 0)
+    {
+      throw std::runtime_error("AMQP map must have an even number of elements.");
+    }
+    AmqpAnnotations annotations;
+    for (std::uint32_t i = 0; i < count; i += 2)
+    {
+      std::uint8_t keyConstructor{ReadByte()};
+      if (keyConstructor != Symbol8Constructor && keyConstructor != Symbol32Constructor)
+      {
+        throw std::runtime_error("Annotation key MUST be a symbol.");
+      }
+      AmqpSymbol key{ReadString(keyConstructor)};
+      annotations.emplace(std::move(key), DecodeValue());
+    }
+    return annotations;
+  }
+
+  void AmqpDecoder::DecodeApplicationPropertiesSection(
+      std::map<std::string, AmqpValue>& applicationProperties)
+  {
+    std::uint8_t constructor{ReadByte()};
+    if (constructor != Map8Constructor && constructor != Map32Constructor)
+    {
+      throw std::runtime_error("Input AMQP value MUST be a map.");
+    }
+    std::uint32_t count{ReadCompoundHeader(constructor)};
+    if (count % 2 != 0)
+    {
+      throw std::runtime_error("AMQP map must have an even number of elements.");
+    }
+    for (std::uint32_t i = 0; i < count; i += 2)
+    {
+      std::uint8_t keyConstructor{ReadByte()};
+      if (keyConstructor != String8Constructor && keyConstructor != String32Constructor)
+      {
+        throw std::runtime_error("Key of applications properties must be a string.");
+      }
+      std::string key{ReadString(keyConstructor)};
+      AmqpValue value{DecodeValue()};
+      if (!IsSimpleApplicationPropertyValue(value))
+      {
+        throw std::runtime_error("Message Application Property values must be simple value types");
+      }
+      applicationProperties.emplace(std::move(key), std::move(value));
+    }
+  }
+
+  MessageHeader AmqpDecoder::DecodeHeaderSection()
+  {
+    auto fields{DecodeSectionFields()};
+    MessageHeader header;
+    for (size_t i = 0; i < fields.size(); i += 1)
+    {
+      auto const& field{fields[i]};
+      if (field.IsNull())
+      {
+        continue;
+      }
+      switch (i)
+      {
+        case 0:
+          header.Durable = static_cast<bool>(field);
+          break;
+        case 1:
+          header.Priority = static_cast<std::uint8_t>(field);
+          break;
+        case 2:
+          header.TimeToLive = std::chrono::milliseconds{static_cast<std::uint32_t>(field)};
+          break;
+        case 3:
+          header.IsFirstAcquirer = static_cast<bool>(field);
+          break;
+        case 4:
+          header.DeliveryCount = static_cast<std::uint32_t>(field);
+          break;
+        default:
+          // Fields beyond those defined by the specification are ignored.
+          break;
+      }
+    }
+    return header;
+  }
+
+  MessageProperties AmqpDecoder::DecodePropertiesSection()
+  {
+    auto fields{DecodeSectionFields()};
+    MessageProperties properties;
+    for (size_t i = 0; i < fields.size(); i += 1)
+    {
+      auto const& field{fields[i]};
+      if (field.IsNull())
+      {
+        continue;
+      }
+      switch (i)
+      {
+        case 0:
+          properties.MessageId = field;
+          break;
+        case 1:
+          properties.UserId = static_cast<std::vector<std::uint8_t> const&>(field.AsBinary());
+          break;
+        case 2:
+          properties.To = field;
+          break;
+        case 3:
+          properties.Subject = static_cast<std::string>(field);
+          break;
+        case 4:
+          properties.ReplyTo = field;
+          break;
+        case 5:
+          properties.CorrelationId = field;
+          break;
+        case 6:
+          properties.ContentType = StringFieldValue(field);
+          break;
+        case 7:
+          properties.ContentEncoding = StringFieldValue(field);
+          break;
+        case 8:
+          properties.AbsoluteExpiryTime
+              = FromMilliseconds(static_cast<std::chrono::milliseconds>(field.AsTimestamp()));
+          break;
+        case 9:
+          properties.CreationTime
+              = FromMilliseconds(static_cast<std::chrono::milliseconds>(field.AsTimestamp()));
+          break;
+        case 10:
+          properties.GroupId = static_cast<std::string>(field);
+          break;
+        case 11:
+          properties.GroupSequence = static_cast<std::uint32_t>(field);
+          break;
+        case 12:
+          properties.ReplyToGroupId = static_cast<std::string>(field);
+          break;
+        default:
+          break;
+      }
+    }
+    return properties;
+  }
+
+  AmqpMessage AmqpDecoder::DecodeMessage()
+  {
+    AmqpMessage message;
+    int lastSectionRank{-1};
+    AmqpDescriptors lastSection{};
+    while (m_position < m_size)
+    {
+      try
+      {
+        if (ReadByte() != DescribedTypeConstructor)
+        {
+          throw std::runtime_error("Decoded message field whose type is NOT described.");
+        }
+        AmqpValue descriptor{DecodeValue()};
+        if (descriptor.GetType() != AmqpValueType::Ulong)
+        {
+          throw std::runtime_error("Decoded message field MUST be a LONG type.");
+        }
+        auto section{static_cast<AmqpDescriptors>(static_cast<std::uint64_t>(descriptor))};
+
+        // Sections must appear in the order defined by the specification. Only the Data and
+        // AmqpSequence body sections may be repeated, and the body sections cannot be mixed.
+        int sectionRank{GetSectionRank(section)};
+        bool isRepeatedBody{
+            (section == lastSection)
+            && (section == AmqpDescriptors::DataBinary
+                || section == AmqpDescriptors::DataAmqpSequence)};
+        if (sectionRank <= lastSectionRank && !isRepeatedBody)
+        {
+          throw std::runtime_error("Found message field is not in the set of expected fields.");
+        }
+        lastSectionRank = sectionRank;
+        lastSection = section;
+
+        switch (section)
+        {
+          case AmqpDescriptors::Header:
+            message.Header = DecodeHeaderSection();
+            break;
+          case AmqpDescriptors::DeliveryAnnotations:
+            message.DeliveryAnnotations = DecodeAnnotationsSection();
+            break;
+          case AmqpDescriptors::MessageAnnotations:
+            message.MessageAnnotations = DecodeAnnotationsSection();
+            break;
+          case AmqpDescriptors::Properties:
+            message.Properties = DecodePropertiesSection();
+            break;
+          case AmqpDescriptors::ApplicationProperties:
+            DecodeApplicationPropertiesSection(message.ApplicationProperties);
+            break;
+          case AmqpDescriptors::DataAmqpValue:
+            message.SetBody(DecodeValue());
+            break;
+          case AmqpDescriptors::DataAmqpSequence:
+            message.SetBody(DecodeList(ReadByte()));
+            break;
+          case AmqpDescriptors::DataBinary: {
+            std::uint8_t constructor{ReadByte()};
+            if (constructor != Binary8Constructor && constructor != Binary32Constructor)
+            {
+              throw std::runtime_error("Data body section must contain a binary value.");
+            }
+            size_t size{(constructor == Binary8Constructor) ? ReadByte() : ReadUint32()};
+            auto data{ReadBytes(size)};
+            // Each call to SetBody will append the binary value to the vector of binary bodies.
+            message.SetBody(AmqpBinaryData{std::vector<std::uint8_t>(data, data + size)});
+            break;
+          }
+          case AmqpDescriptors::Footer:
+            message.Footer = DecodeAnnotationsSection();
+            break;
+          default:
+            throw std::runtime_error("Unknown message descriptor.");
+        }
+      }
+      catch (BufferUnderflow const&)
+      {
+        throw std::runtime_error("AMQP message section is truncated.");
+      }
+    }
+    return message;
+  }
+
+  std::string AmqpDecoder::ReadString(std::uint8_t constructor)
+  {
+    // The 8 bit variable width constructors are 0xaX, the 32 bit constructors are 0xbX.
+    size_t size{((constructor & 0xf0) == 0xa0) ? ReadByte() : ReadUint32()};
+    auto data{ReadBytes(size)};
+    return std::string(reinterpret_cast<char const*>(data), size);
+  }
+
+  std::uint32_t AmqpDecoder::ReadCompoundHeader(std::uint8_t constructor)
+  {
+    std::uint32_t size;
+    std::uint32_t count;
+    size_t countSize;
+    if (constructor == List8Constructor || constructor == Map8Constructor
+        || constructor == Array8Constructor)
+    {
+      size = ReadByte();
+      count = ReadByte();
+      countSize = 1;
+    }
+    else
+    {
+      size = ReadUint32();
+      count = ReadUint32();
+      countSize = 4;
+    }
+    if (size < countSize)
+    {
+      throw std::runtime_error("Invalid AMQP compound value size.");
+    }
+    // The declared size is not used to bound the items: uAMQP produced arrays may understate
+    // their size by the width of the element constructor. Truncation is detected as the items
+    // are read.
+    // Every list or map element occupies at least one byte.
+    if (constructor != Array8Constructor && constructor != Array32Constructor
+        && count > size - countSize)
+    {
+      throw std::runtime_error("Invalid AMQP compound value element count.");
+    }
+    return count;
+  }
+
+  std::uint8_t AmqpDecoder::ReadByte() { return *ReadBytes(1); }
+
+  std::uint16_t AmqpDecoder::ReadUint16()
+  {
+    auto data{ReadBytes(2)};
+    return static_cast<std::uint16_t>((data[0] << 8) | data[1]);
+  }
+
+  std::uint32_t AmqpDecoder::ReadUint32()
+  {
+    auto data{ReadBytes(4)};
+    return (static_cast<std::uint32_t>(data[0]) << 24) | (static_cast<std::uint32_t>(data[1]) << 16)
+        | (static_cast<std::uint32_t>(data[2]) << 8) | static_cast<std::uint32_t>(data[3]);
+  }
+
+  std::uint64_t AmqpDecoder::ReadUint64()
+  {
+    std::uint64_t high{ReadUint32()};
+    return (high << 32) | ReadUint32();
+  }
+
+  std::uint8_t const* AmqpDecoder::ReadBytes(size_t size)
+  {
+    if (size > m_size - m_position)
+    {
+      throw BufferUnderflow{};
+    }
+    auto data{m_data + m_position};
+    m_position += size;
+    return data;
+  }
+}}}}} // namespace Azure::Core::Amqp::Models::_detail
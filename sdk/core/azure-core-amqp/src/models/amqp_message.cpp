@@ -5,6 +5,7 @@
 #include "azure/core/amqp/models/amqp_message.hpp"
 
 #include "../amqp/private/unique_handle.hpp"
+#include "../models/private/amqp_codec.hpp"
 #include "../models/private/header_impl.hpp"
 #include "../models/private/message_impl.hpp"
 #include "../models/private/properties_impl.hpp"
@@ -35,7 +36,6 @@ constexpr auto MESSAGE_BODY_TYPE_VALUE = RustAmqpMessageBodyType::Value;
 #endif
 
 #include <iostream>
-#include <set>
 
 namespace Azure { namespace Core { namespace Amqp { namespace _detail {
   // @cond
@@ -588,352 +588,15 @@ namespace Azure { namespace Core { namespace Amqp { namespace Models {
 
   std::vector<uint8_t> AmqpMessage::Serialize(AmqpMessage const& message)
   {
+    // Each message section is encoded directly into the output buffer.
     std::vector<uint8_t> rv;
-
-    // Append the message Header to the serialized message.
-    if (message.Header.ShouldSerialize())
-    {
-      auto serializedHeader = MessageHeader::Serialize(message.Header);
-      rv.insert(rv.end(), serializedHeader.begin(), serializedHeader.end());
-    }
-    if (!message.DeliveryAnnotations.empty())
-    {
-      AmqpValue deliveryAnnotations{
-          _detail::AmqpValueFactory::FromImplementation(_detail::UniqueAmqpValueHandle{
-              amqpvalue_create_delivery_annotations(_detail::AmqpValueFactory::ToImplementation(
-                  message.DeliveryAnnotations.AsAmqpValue()))})};
-      auto serializedDeliveryAnnotations = AmqpValue::Serialize(deliveryAnnotations);
-      rv.insert(
-          rv.end(), serializedDeliveryAnnotations.begin(), serializedDeliveryAnnotations.end());
-    }
-    if (!message.MessageAnnotations.empty())
-    {
-      AmqpValue messageAnnotations{
-          _detail::AmqpValueFactory::FromImplementation(_detail::UniqueAmqpValueHandle{
-              amqpvalue_create_message_annotations(_detail::AmqpValueFactory::ToImplementation(
-                  message.MessageAnnotations.AsAmqpValue()))})};
-      auto serializedAnnotations = AmqpValue::Serialize(messageAnnotations);
-      rv.insert(rv.end(), serializedAnnotations.begin(), serializedAnnotations.end());
-    }
-
-    if (message.Properties.ShouldSerialize())
-    {
-      auto serializedMessageProperties = MessageProperties::Serialize(message.Properties);
-      rv.insert(rv.end(), serializedMessageProperties.begin(), serializedMessageProperties.end());
-    }
-
-    if (!message.ApplicationProperties.empty())
-    {
-      AmqpMap appProperties;
-      for (auto const& val : message.ApplicationProperties)
-      {
-        if ((val.second.GetType() == AmqpValueType::List)
-            || (val.second.GetType() == AmqpValueType::Map)
-            || (val.second.GetType() == AmqpValueType::Composite)
-            || (val.second.GetType() == AmqpValueType::Described))
-        {
-          throw std::runtime_error(
-              "Message Application Property values must be simple value types");
-        }
-        appProperties.emplace(val);
-      }
-      AmqpValue propertiesValue{Models::_detail::AmqpValueFactory::FromImplementation(
-          Models::_detail::UniqueAmqpValueHandle{amqpvalue_create_application_properties(
-              Models::_detail::AmqpValueFactory::ToImplementation(appProperties.AsAmqpValue()))})};
-      auto serializedApplicationProperties = AmqpValue::Serialize(propertiesValue);
-      rv.insert(
-          rv.end(), serializedApplicationProperties.begin(), serializedApplicationProperties.end());
-    }
-
-    switch (message.BodyType)
-    {
-      default:
-      case MessageBodyType::Invalid:
-        throw std::runtime_error("Invalid message body type.");
-
-      case MessageBodyType::Value: {
-        // The message body element is an AMQP Described type, create one and serialize the
-        // described body.
-        AmqpDescribed describedBody(
-            static_cast<std::uint64_t>(AmqpDescriptors::DataAmqpValue), message.m_amqpValueBody);
-        auto serializedBodyValue = AmqpValue::Serialize(describedBody.AsAmqpValue());
-        rv.insert(rv.end(), serializedBodyValue.begin(), serializedBodyValue.end());
-      }
-      break;
-      case MessageBodyType::Data:
-        for (auto const& val : message.m_binaryDataBody)
-        {
-          AmqpDescribed describedBody(
-              static_cast<std::uint64_t>(AmqpDescriptors::DataBinary), val.AsAmqpValue());
-          auto serializedBodyValue = AmqpValue::Serialize(describedBody.AsAmqpValue());
-          rv.insert(rv.end(), serializedBodyValue.begin(), serializedBodyValue.end());
-        }
-        break;
-      case MessageBodyType::Sequence: {
-        for (auto const& val : message.m_amqpSequenceBody)
-        {
-          AmqpDescribed describedBody(
-              static_cast<std::uint64_t>(AmqpDescriptors::DataAmqpSequence), val.AsAmqpValue());
-          auto serializedBodyValue = AmqpValue::Serialize(describedBody.AsAmqpValue());
-          rv.insert(rv.end(), serializedBodyValue.begin(), serializedBodyValue.end());
-        }
-      }
-    }
-    if (!message.Footer.empty())
-    {
-      AmqpValue footer{Models::_detail::AmqpValueFactory::FromImplementation(
-          Models::_detail::UniqueAmqpValueHandle{amqpvalue_create_footer(
-              Models::_detail::AmqpValueFactory::ToImplementation(message.Footer.AsAmqpValue()))})};
-      auto serializedFooter = AmqpValue::Serialize(footer);
-      rv.insert(rv.end(), serializedFooter.begin(), serializedFooter.end());
-    }
-
+    _detail::AmqpEncoder{rv}.EncodeMessage(message);
     return rv;
   }
 
-#if ENABLE_UAMQP
-  namespace {
-    class AmqpMessageDeserializer final {
-    public:
-      AmqpMessageDeserializer()
-          : m_decoder{amqpvalue_decoder_create(OnAmqpMessageFieldDecodedFn, this)}
-      {
-      }
-
-      AmqpMessage operator()(std::uint8_t const* data, size_t size) const
-      {
-        if (amqpvalue_decode_bytes(m_decoder.get(), data, size))
-        {
-          throw std::runtime_error("Could not decode object");
-        }
-        return m_decodedValue;
-      }
-
-    private:
-      UniqueAmqpDecoderHandle m_decoder;
-      AmqpMessage m_decodedValue;
-      // The message fields, in their expected order.
-      std::set<Amqp::_detail::AmqpDescriptors> m_expectedMessageFields{
-          AmqpDescriptors::Header,
-          AmqpDescriptors::DeliveryAnnotations,
-          AmqpDescriptors::MessageAnnotations,
-          AmqpDescriptors::Properties,
-          AmqpDescriptors::ApplicationProperties,
-          AmqpDescriptors::DataAmqpSequence,
-          AmqpDescriptors::DataAmqpValue,
-          AmqpDescriptors::DataBinary,
-          AmqpDescriptors::Footer};
-
-      // Invoked on each descriptor encountered while decrypting the message.
-      static void OnAmqpMessageFieldDecodedFn(void* context, AMQP_VALUE value)
-      {
-        auto deserializer = static_cast<AmqpMessageDeserializer*>(context);
-
-        deserializer->OnAmqpMessageFieldDecoded(
-            Models::_detail::AmqpValueFactory::FromImplementation(
-                _detail::UniqueAmqpValueHandle{amqpvalue_clone(value)}));
-      }
-
-      // Invoked when a message field
-      void OnAmqpMessageFieldDecoded(AmqpValue value)
-      {
-        if (value.GetType() != AmqpValueType::Described)
-        {
-          throw std::runtime_error("Decoded message field whose type is NOT described.");
-        }
-        AmqpDescribed describedType(value.AsDescribed());
-        if (describedType.GetDescriptor().GetType() != AmqpValueType::Ulong)
-        {
-          throw std::runtime_error("Decoded message field MUST be a LONG type.");
-        }
-
-        AmqpDescriptors fieldDescriptor(
-            static_cast<AmqpDescriptors>(static_cast<uint64_t>(describedType.GetDescriptor())));
-        if (m_expectedMessageFields.find(fieldDescriptor) == m_expectedMessageFields.end())
-        {
-          throw std::runtime_error("Found message field is not in the set of expected fields.");
-        }
-        else
-        {
-          // Once we've seen a field, we can remove that field from the set of expected fields,
-          // and also the fields which must come before it.
-          //
-          // The two exceptions are the DataBinary and DataAmqpSequence  fields, which can have
-          // more than one instance.
-          switch (fieldDescriptor)
-          {
-            case AmqpDescriptors::Header:
-              m_expectedMessageFields.erase(AmqpDescriptors::Header);
-              break;
-            case AmqpDescriptors::DeliveryAnnotations:
-              // Once we've seen a DeliveryAnnotations, we no longer expect to see a Header or
-              // another DeliveryAnnotations.
-              m_expectedMessageFields.erase(AmqpDescriptors::Header);
-              m_expectedMessageFields.erase(AmqpDescriptors::DeliveryAnnotations);
-              break;
-            case AmqpDescriptors::MessageAnnotations:
-              // Once we've seen a MessageAnnotations, we no longer expect to see a Header,
-              // DeliveryAnnotations, or a MessageAnnotations.
-              m_expectedMessageFields.erase(AmqpDescriptors::Header);
-              m_expectedMessageFields.erase(AmqpDescriptors::DeliveryAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::MessageAnnotations);
-              break;
-            case AmqpDescriptors::Properties:
-              m_expectedMessageFields.erase(AmqpDescriptors::Header);
-              m_expectedMessageFields.erase(AmqpDescriptors::DeliveryAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::MessageAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::Properties);
-              break;
-            case AmqpDescriptors::ApplicationProperties:
-              m_expectedMessageFields.erase(AmqpDescriptors::Header);
-              m_expectedMessageFields.erase(AmqpDescriptors::DeliveryAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::MessageAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::Properties);
-              m_expectedMessageFields.erase(AmqpDescriptors::ApplicationProperties);
-              break;
-            case AmqpDescriptors::DataAmqpSequence:
-              m_expectedMessageFields.erase(AmqpDescriptors::Header);
-              m_expectedMessageFields.erase(AmqpDescriptors::DeliveryAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::MessageAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::Properties);
-              m_expectedMessageFields.erase(AmqpDescriptors::ApplicationProperties);
-              // When we see an DataAmqpSequence, we no longer expect to see any other data type.
-              m_expectedMessageFields.erase(AmqpDescriptors::DataAmqpValue);
-              m_expectedMessageFields.erase(AmqpDescriptors::DataBinary);
-              break;
-            case AmqpDescriptors::DataAmqpValue:
-              m_expectedMessageFields.erase(AmqpDescriptors::Header);
-              m_expectedMessageFields.erase(AmqpDescriptors::DeliveryAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::MessageAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::Properties);
-              m_expectedMessageFields.erase(AmqpDescriptors::ApplicationProperties);
-              // When we see an DataAmqpValue, we no longer expect to see any other data type.
-              m_expectedMessageFields.erase(AmqpDescriptors::DataAmqpValue);
-              m_expectedMessageFields.erase(AmqpDescriptors::DataAmqpSequence);
-              m_expectedMessageFields.erase(AmqpDescriptors::DataBinary);
-              break;
-            case AmqpDescriptors::DataBinary:
-              m_expectedMessageFields.erase(AmqpDescriptors::Header);
-              m_expectedMessageFields.erase(AmqpDescriptors::DeliveryAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::MessageAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::Properties);
-              m_expectedMessageFields.erase(AmqpDescriptors::ApplicationProperties);
-              // When we see an DataBinary, we no longer expect to see any other data type.
-              m_expectedMessageFields.erase(AmqpDescriptors::DataAmqpValue);
-              m_expectedMessageFields.erase(AmqpDescriptors::DataAmqpSequence);
-              break;
-            case AmqpDescriptors::Footer:
-              m_expectedMessageFields.erase(AmqpDescriptors::Header);
-              m_expectedMessageFields.erase(AmqpDescriptors::DeliveryAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::MessageAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::Properties);
-              m_expectedMessageFields.erase(AmqpDescriptors::ApplicationProperties);
-              // When we see an DataBinary, we no longer expect to see any other data type.
-              m_expectedMessageFields.erase(AmqpDescriptors::DataBinary);
-              m_expectedMessageFields.erase(AmqpDescriptors::DataAmqpValue);
-              m_expectedMessageFields.erase(AmqpDescriptors::DataAmqpSequence);
-              m_expectedMessageFields.erase(AmqpDescriptors::Footer);
-              break;
-            default:
-              throw std::runtime_error("Unknown message descriptor.");
-          }
-        }
-
-        switch (fieldDescriptor)
-        {
-          case AmqpDescriptors::Header: {
-            UniqueMessageHeaderHandle messageHeader;
-            HEADER_HANDLE h;
-            if (amqpvalue_get_header(_detail::AmqpValueFactory::ToImplementation(value), &h))
-            {
-              throw std::runtime_error("Could not convert field to header.");
-            }
-            messageHeader.reset(h);
-            h = nullptr;
-            m_decodedValue.Header
-                = _detail::MessageHeaderFactory::FromImplementation(messageHeader);
-            break;
-          }
-          case AmqpDescriptors::DeliveryAnnotations:
-            m_decodedValue.DeliveryAnnotations = describedType.GetValue().AsAnnotations();
-            break;
-          case AmqpDescriptors::MessageAnnotations:
-            m_decodedValue.MessageAnnotations = describedType.GetValue().AsAnnotations();
-            break;
-          case AmqpDescriptors::Properties: {
-            UniquePropertiesHandle properties;
-            PROPERTIES_HANDLE h;
-            if (amqpvalue_get_properties(_detail::AmqpValueFactory::ToImplementation(value), &h))
-            {
-              throw std::runtime_error("Could not convert field to header.");
-            }
-            properties.reset(h);
-            h = nullptr;
-            m_decodedValue.Properties
-                = _detail::MessagePropertiesFactory::FromImplementation(properties);
-            break;
-          }
-          case AmqpDescriptors::ApplicationProperties: {
-            auto propertyMap = describedType.GetValue().AsMap();
-            for (auto const& val : propertyMap)
-            {
-              if (val.first.GetType() != AmqpValueType::String)
-              {
-                throw std::runtime_error("Key of applications properties must be a string.");
-              }
-              if ((val.second.GetType() == AmqpValueType::List)
-                  || (val.second.GetType() == AmqpValueType::Map)
-                  || (val.second.GetType() == AmqpValueType::Composite)
-                  || (val.second.GetType() == AmqpValueType::Described))
-              {
-                throw std::runtime_error(
-                    "Message Application Property values must be simple value types");
-              }
-              m_decodedValue.ApplicationProperties.emplace(
-                  static_cast<std::string>(val.first), val.second);
-            }
-            break;
-          }
-          case AmqpDescriptors::DataAmqpValue:
-            m_decodedValue.SetBody(describedType.GetValue());
-            break;
-          case AmqpDescriptors::DataAmqpSequence:
-            m_decodedValue.SetBody(describedType.GetValue().AsList());
-            break;
-          case AmqpDescriptors::DataBinary:
-            // Each call to SetBody will append the binary value to the vector of binary bodies.
-            m_decodedValue.SetBody(describedType.GetValue().AsBinary());
-            break;
-          case AmqpDescriptors::Footer:
-            m_decodedValue.Footer = describedType.GetValue().AsAnnotations();
-            break;
-          default:
-            throw std::runtime_error("Unknown message descriptor.");
-        }
-      }
-    };
-  } // namespace
-#endif // ENABLE_UAMQP
-
   AmqpMessage AmqpMessage::Deserialize(std::uint8_t const* buffer, size_t size)
   {
-#if ENABLE_UAMQP
-    return AmqpMessageDeserializer{}(buffer, size);
-#elif ENABLE_RUST_AMQP
-    Azure::Core::Amqp::_detail::MessageImplementation* message;
-
-    if (message_deserialize(buffer, size, &message))
-    {
-      throw std::runtime_error("Could not deserialize message.");
-    }
-
-    std::shared_ptr<AmqpMessage> messagePointer
-        = _detail::AmqpMessageFactory::FromImplementation(message);
-    AmqpMessage rv = *messagePointer;
-    messagePointer.reset();
-    return rv;
-
-#endif
+    return _detail::AmqpDecoder{buffer, size}.DecodeMessage();
   }
 
   std::ostream& operator<<(std::ostream& os, AmqpMessage const& message)
@@ -1063,8 +1063,8 @@ namespace Azure { namespace Core { namespace Amqp { namespace Models {
   }
 
   template <>
-  _detail::AmqpCollectionBase<std::map<AmqpValue, AmqpValue>, AmqpMap>::operator _detail::
-      AmqpValueImpl() const
+  _detail::AmqpCollectionBase<_detail::AmqpFlatMap<AmqpValue, AmqpValue>, AmqpMap>::
+  operator _detail::AmqpValueImpl() const
   {
     UniqueAmqpValueHandle value{amqpvalue_create_map()};
     for (const auto& val : *this)
@@ -1081,8 +1081,8 @@ namespace Azure { namespace Core { namespace Amqp { namespace Models {
   }
 
   template <>
-  _detail::AmqpCollectionBase<std::map<AmqpSymbol, AmqpValue>, AmqpAnnotations>::operator _detail::
-      AmqpValueImpl() const
+  _detail::AmqpCollectionBase<_detail::AmqpFlatMap<AmqpSymbol, AmqpValue>, AmqpAnnotations>::
+  operator _detail::AmqpValueImpl() const
   {
     UniqueAmqpValueHandle value{amqpvalue_create_map()};
     for (const auto& val : *this)
@@ -1100,13 +1100,15 @@ namespace Azure { namespace Core { namespace Amqp { namespace Models {
 
   template <>
   AmqpValue
-  _detail::AmqpCollectionBase<std::map<AmqpSymbol, AmqpValue>, AmqpAnnotations>::AsAmqpValue() const
+  _detail::AmqpCollectionBase<_detail::AmqpFlatMap<AmqpSymbol, AmqpValue>, AmqpAnnotations>::
+      AsAmqpValue() const
   {
     return _detail::AmqpValueFactory::FromImplementation(_detail::AmqpValueImpl{*this});
   }
 
   template <>
-  AmqpValue _detail::AmqpCollectionBase<std::map<AmqpValue, AmqpValue>, AmqpMap>::AsAmqpValue()
+  AmqpValue
+  _detail::AmqpCollectionBase<_detail::AmqpFlatMap<AmqpValue, AmqpValue>, AmqpMap>::AsAmqpValue()
       const
   {
     return _detail::AmqpValueFactory::FromImplementation(_detail::AmqpValueImpl{*this});
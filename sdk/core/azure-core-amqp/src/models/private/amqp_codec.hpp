@@ -0,0 +1,150 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "azure/core/amqp/internal/models/amqp_protocol.hpp"
+#include "azure/core/amqp/models/amqp_message.hpp"
+#include "azure/core/amqp/models/amqp_value.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Core { namespace Amqp { namespace Models { namespace _detail {
+
+  /** @brief Native AMQP 1.0 type encoder.
+   *
+   * Encodes AMQP values and message sections directly into a caller provided byte buffer,
+   * without building intermediate uAMQP value trees or invoking a per-fragment output callback.
+   *
+   * The encoder deliberately makes the same constructor choices as the uAMQP encoder (smallest
+   * encoding for scalars, 8 bit compound forms when they fit, widest element forms within arrays)
+   * so that the output of the two encoders is byte-for-byte identical.
+   */
+  class AmqpEncoder final {
+  public:
+    /** @brief Construct an encoder which appends to the specified buffer. */
+    explicit AmqpEncoder(std::vector<std::uint8_t>& buffer) : m_buffer{buffer} {}
+
+    /** @brief Append the encoding of an AMQP value to the buffer. */
+    void Encode(AmqpValue const& value);
+
+    /** @brief Append an AMQP message, section by section, to the buffer. */
+    void EncodeMessage(AmqpMessage const& message);
+
+    /** @brief Returns the number of bytes needed to encode the specified AMQP value. */
+    static size_t GetEncodedSize(AmqpValue const& value);
+
+  private:
+    std::vector<std::uint8_t>& m_buffer;
+
+    void EncodeArrayItem(AmqpValue const& value, bool firstElement);
+    void EncodeUint(std::uint32_t value);
+    void EncodeUlong(std::uint64_t value);
+    void EncodeTimestamp(std::int64_t milliseconds);
+    void EncodeVariable(
+        std::uint8_t constructor8,
+        std::uint8_t constructor32,
+        std::uint8_t const* data,
+        size_t size,
+        bool useSmallest,
+        bool writeConstructor);
+    void EncodeString(
+        std::uint8_t constructor8,
+        std::uint8_t constructor32,
+        std::string const& value);
+    void EncodeList(AmqpList const& list);
+    void EncodeListItems(std::vector<AmqpValue> const& items);
+    void EncodeMap(AmqpMap const& map);
+    void EncodeArray(AmqpArray const& array);
+
+    void EncodeDescriptor(Amqp::_detail::AmqpDescriptors descriptor);
+    void EncodeAnnotationsSection(
+        Amqp::_detail::AmqpDescriptors descriptor,
+        AmqpAnnotations const& annotations);
+    void EncodeApplicationPropertiesSection(
+        std::map<std::string, AmqpValue> const& applicationProperties);
+    void EncodeHeaderSection(MessageHeader const& header);
+    void EncodePropertiesSection(MessageProperties const& properties);
+    void BeginField(std::uint32_t& fieldCount, std::uint32_t fieldIndex);
+
+    // The size of a compound value is computed before it is encoded, so that its header is
+    // written in its final (narrow or wide) form ahead of the items.
+    void WriteCompoundHeader(
+        std::uint32_t count,
+        size_t itemsSize,
+        std::uint8_t constructor8,
+        std::uint8_t constructor32);
+    // Writes the header of a list of fields, or an empty list. Returns false if the list is empty.
+    bool BeginFieldList(std::uint32_t fieldCount, size_t fieldsSize);
+
+    void AppendByte(std::uint8_t value) { m_buffer.push_back(value); }
+    void AppendUint16(std::uint16_t value);
+    void AppendUint32(std::uint32_t value);
+    void AppendUint64(std::uint64_t value);
+    void AppendBytes(std::uint8_t const* data, size_t size);
+    void WriteUint32At(size_t position, std::uint32_t value);
+  };
+
+  /** @brief Native AMQP 1.0 type decoder.
+   *
+   * Decodes AMQP encoded values from a contiguous buffer directly into the AMQP model types,
+   * without a uAMQP decoder instance or the clone of every decoded value that the uAMQP
+   * decoder callback requires.
+   */
+  class AmqpDecoder final {
+  public:
+    /** @brief Construct a decoder over a buffer. The buffer must outlive the decoder. */
+    AmqpDecoder(std::uint8_t const* data, size_t size) : m_data{data}, m_size{size} {}
+
+    /** @brief Decode the next AMQP value from the buffer.
+     *
+     * @param value Receives the decoded value.
+     *
+     * @returns true if a complete value was decoded, false if the buffer is exhausted or holds
+     * only part of a value.
+     *
+     * @throws std::runtime_error if the buffer holds a malformed value, or a value nested more
+     * than 100 levels deep.
+     */
+    bool TryDecode(AmqpValue& value);
+
+    /** @brief Decode an AMQP message from the buffer.
+     *
+     * Message sections are decoded directly into the fields of the returned message. Sections
+     * must appear in the order defined by the AMQP specification.
+     *
+     * @throws std::runtime_error if the buffer holds a malformed or truncated message.
+     */
+    AmqpMessage DecodeMessage();
+
+  private:
+    std::uint8_t const* m_data;
+    size_t m_size;
+    size_t m_position{};
+    // The number of compound values enclosing the value being decoded.
+    size_t m_depth{};
+
+    AmqpValue DecodeValue();
+    AmqpValue DecodeValueOfType(std::uint8_t constructor);
+    AmqpList DecodeList(std::uint8_t constructor);
+    std::vector<AmqpValue> DecodeSectionFields();
+    AmqpAnnotations DecodeAnnotationsSection();
+    void DecodeApplicationPropertiesSection(
+        std::map<std::string, AmqpValue>& applicationProperties);
+    MessageHeader DecodeHeaderSection();
+    MessageProperties DecodePropertiesSection();
+
+    std::uint8_t ReadByte();
+    std::uint16_t ReadUint16();
+    std::uint32_t ReadUint32();
+    std::uint64_t ReadUint64();
+    std::uint8_t const* ReadBytes(size_t size);
+    std::string ReadString(std::uint8_t constructor);
+    // Reads the size and count of a compound value and returns the count.
+    std::uint32_t ReadCompoundHeader(std::uint8_t constructor);
+  };
+}}}}} // namespace Azure::Core::Amqp::Models::_detail
@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the AMQP message serialization performance.
+ *
+ */
+
+#pragma once
+
+#include <azure/core/amqp/models/amqp_message.hpp>
+#include <azure/perf.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Core { namespace Amqp { namespace Test {
+
+  /**
+   * @brief Measure the serialization and deserialization of a message shaped like an Event Hubs
+   * event.
+   */
+  class AmqpMessageCodecTest : public Azure::Perf::PerfTest {
+    enum class Action
+    {
+      Serialize,
+      Deserialize
+    };
+
+    Action m_action;
+    Azure::Core::Amqp::Models::AmqpMessage m_message;
+    std::vector<uint8_t> m_serializedMessage;
+
+  public:
+    /**
+     * @brief Construct a new AmqpMessageCodecTest test.
+     *
+     * @param options The test options.
+     */
+    AmqpMessageCodecTest(Azure::Perf::TestOptions options) : PerfTest(options) {}
+
+    void Setup() override
+    {
+      m_action = m_options.GetOptionOrDefault<std::string>("Action", "serialize") == "serialize"
+          ? Action::Serialize
+          : Action::Deserialize;
+
+      m_message.Properties.MessageId = "message-id";
+      m_message.Properties.ContentType = "application/json";
+      m_message.MessageAnnotations["x-opt-partition-key"] = "partition";
+      auto propertyCount{m_options.GetOptionOrDefault<int32_t>("Properties", 10)};
+      for (int32_t i = 0; i < propertyCount; i += 1)
+      {
+        m_message.ApplicationProperties["property" + std::to_string(i)] = i;
+      }
+      m_message.SetBody(Azure::Core::Amqp::Models::AmqpBinaryData{
+          std::vector<uint8_t>(m_options.GetOptionOrDefault<size_t>("Size", 1024), 0x5a)});
+
+      if (m_action == Action::Deserialize)
+      {
+        m_serializedMessage = Azure::Core::Amqp::Models::AmqpMessage::Serialize(m_message);
+      }
+    }
+
+    /**
+     * @brief Serialize or deserialize the message.
+     *
+     */
+    void Run(Azure::Core::Context const&) override
+    {
+      switch (m_action)
+      {
+        case Action::Serialize: {
+          Azure::Core::Amqp::Models::AmqpMessage::Serialize(m_message);
+          break;
+        }
+        case Action::Deserialize: {
+          Azure::Core::Amqp::Models::AmqpMessage::Deserialize(
+              m_serializedMessage.data(), m_serializedMessage.size());
+          break;
+        }
+      }
+    }
+
+    /**
+     * @brief Define the test options for the test.
+     *
+     * @return The list of test options.
+     */
+    std::vector<Azure::Perf::TestOption> GetTestOptions() override
+    {
+      return {
+          {"Action", {"--action"}, "Serialize/deserialize, default serialize", 1, false},
+          {"Properties",
+           {"--properties"},
+           "The number of application properties, default 10",
+           1,
+           false},
+          {"Size", {"--size"}, "The body size in bytes, default 1024", 1, false}};
+    }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {
+          "AmqpMessageCodec",
+          "Measures AMQP message serialize/deserialize performance",
+          [](Azure::Perf::TestOptions options) {
+            return std::make_unique<Azure::Core::Amqp::Test::AmqpMessageCodecTest>(options);
+          }};
+    }
+  };
+
+}}}} // namespace Azure::Core::Amqp::Test
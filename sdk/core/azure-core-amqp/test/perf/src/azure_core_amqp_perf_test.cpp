@@ -0,0 +1,20 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/core/amqp/test/amqp_message_codec_test.hpp"
+
+#include <azure/perf.hpp>
+
+#include <vector>
+
+int main(int argc, char** argv)
+{
+
+  // Create the test list
+  std::vector<Azure::Perf::TestMetadata> tests{
+      Azure::Core::Amqp::Test::AmqpMessageCodecTest::GetTestMetadata()};
+
+  Azure::Perf::Program::Run(Azure::Core::Context{}, tests, argc, argv);
+
+  return 0;
+}
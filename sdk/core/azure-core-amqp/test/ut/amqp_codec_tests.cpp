@@ -0,0 +1,362 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "../src/models/private/amqp_codec.hpp"
+#include "azure/core/amqp/models/amqp_message.hpp"
+#include "azure/core/amqp/models/amqp_value.hpp"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace Azure::Core::Amqp::Models;
+using namespace Azure::Core::Amqp::Models::_detail;
+
+class TestAmqpCodec : public testing::Test {
+protected:
+  void SetUp() override {}
+  void TearDown() override {}
+
+  static std::vector<uint8_t> Encode(AmqpValue const& value)
+  {
+    std::vector<uint8_t> buffer;
+    AmqpEncoder{buffer}.Encode(value);
+    return buffer;
+  }
+
+  static AmqpValue Decode(std::vector<uint8_t> const& buffer)
+  {
+    AmqpValue value;
+    AmqpDecoder decoder{buffer.data(), buffer.size()};
+    EXPECT_TRUE(decoder.TryDecode(value));
+    return value;
+  }
+
+  static std::vector<AmqpValue> GetTestValues()
+  {
+    return {
+        AmqpValue{},
+        AmqpValue{true},
+        AmqpValue{false},
+        AmqpValue{static_cast<uint8_t>(255)},
+        AmqpValue{static_cast<uint16_t>(65535)},
+        AmqpValue{static_cast<uint32_t>(0)},
+        AmqpValue{static_cast<uint32_t>(255)},
+        AmqpValue{static_cast<uint32_t>(256)},
+        AmqpValue{static_cast<uint64_t>(0)},
+        AmqpValue{static_cast<uint64_t>(255)},
+        AmqpValue{static_cast<uint64_t>(0x123456789abcdef0ull)},
+        AmqpValue{static_cast<int8_t>(-5)},
+        AmqpValue{static_cast<int16_t>(-1000)},
+        AmqpValue{static_cast<int32_t>(-128)},
+        AmqpValue{static_cast<int32_t>(128)},
+        AmqpValue{static_cast<int64_t>(127)},
+        AmqpValue{static_cast<int64_t>(-129)},
+        AmqpValue{3.25f},
+        AmqpValue{-2.5e100},
+        AmqpValue{U'\U0001F600'},
+        AmqpTimestamp{std::chrono::milliseconds{1234567890123}}.AsAmqpValue(),
+        AmqpValue{Azure::Core::Uuid::CreateUuid()},
+        AmqpBinaryData{1, 2, 3, 4}.AsAmqpValue(),
+        AmqpBinaryData{std::vector<uint8_t>(256, 0x5a)}.AsAmqpValue(),
+        AmqpValue{"String value"},
+        AmqpValue{std::string(255, 'a')},
+        AmqpValue{std::string(256, 'b')},
+        AmqpSymbol{"Symbol value"}.AsAmqpValue(),
+        AmqpList{}.AsAmqpValue(),
+        AmqpList{1, "two", 3.0, AmqpList{4, 5}.AsAmqpValue()}.AsAmqpValue(),
+        AmqpMap{}.AsAmqpValue(),
+        AmqpMap{{"key1", 1}, {2, "value2"}}.AsAmqpValue(),
+        AmqpArray{}.AsAmqpValue(),
+        AmqpArray{1, 2, 3, 4, 5}.AsAmqpValue(),
+        AmqpArray{static_cast<uint8_t>(1), static_cast<uint8_t>(2)}.AsAmqpValue(),
+        AmqpArray{"abc", "def"}.AsAmqpValue(),
+        AmqpArray{AmqpList{1, 2}.AsAmqpValue(), AmqpList{}.AsAmqpValue()}.AsAmqpValue(),
+        AmqpDescribed{static_cast<uint64_t>(0x1234), AmqpValue{"Described value"}}.AsAmqpValue(),
+        AmqpDescribed{AmqpSymbol{"descriptor"}, AmqpValue{5}}.AsAmqpValue(),
+    };
+  }
+};
+
+TEST_F(TestAmqpCodec, RoundTripValues)
+{
+  for (auto const& value : GetTestValues())
+  {
+    auto encoded{Encode(value)};
+    EXPECT_EQ(value, Decode(encoded)) << "Value: " << value;
+  }
+}
+
+TEST_F(TestAmqpCodec, EncodedSizeMatchesEncoding)
+{
+  auto values{GetTestValues()};
+  values.push_back(AmqpComposite{"composite", {1, "two", 3.0}}.AsAmqpValue());
+  values.push_back(AmqpComposite{static_cast<uint64_t>(25), {}}.AsAmqpValue());
+
+  // Lists, maps, and arrays which require the 32 bit compound encodings.
+  AmqpList largeList;
+  AmqpArray largeArray;
+  AmqpMap largeMap;
+  for (int32_t i = 0; i < 300; i += 1)
+  {
+    largeList.push_back(AmqpValue{i});
+    largeArray.push_back(AmqpValue{i});
+    largeMap.emplace(AmqpValue{i}, AmqpValue{"value"});
+  }
+  values.push_back(largeList.AsAmqpValue());
+  values.push_back(largeArray.AsAmqpValue());
+  values.push_back(largeMap.AsAmqpValue());
+  values.push_back(AmqpArray{largeArray.AsAmqpValue(), largeArray.AsAmqpValue()}.AsAmqpValue());
+
+  for (auto const& value : values)
+  {
+    EXPECT_EQ(AmqpEncoder::GetEncodedSize(value), Encode(value).size()) << "Value: " << value;
+  }
+}
+
+TEST_F(TestAmqpCodec, EncodingMatchesUamqp)
+{
+  auto values{GetTestValues()};
+  AmqpList largeList;
+  AmqpMap largeMap;
+  for (int32_t i = 0; i < 300; i += 1)
+  {
+    largeList.push_back(AmqpValue{i});
+    largeMap.emplace(AmqpValue{i}, AmqpValue{"value"});
+  }
+  values.push_back(largeList.AsAmqpValue());
+  values.push_back(largeMap.AsAmqpValue());
+  // Nested compound values, of which the outer ones need the 32 bit encodings.
+  AmqpValue nested{AmqpList{1, "two"}.AsAmqpValue()};
+  for (int i = 0; i < 14; i += 1)
+  {
+    AmqpMap map;
+    map.emplace(AmqpValue{i}, AmqpList{i}.AsAmqpValue());
+    nested = AmqpList{nested, AmqpValue{std::string(i, 'x')}, map.AsAmqpValue()}.AsAmqpValue();
+    values.push_back(nested);
+  }
+
+  for (auto const& value : values)
+  {
+    // uAMQP cannot encode char values.
+    if (value.GetType() != AmqpValueType::Char)
+    {
+      EXPECT_EQ(AmqpValue::Serialize(value), Encode(value));
+    }
+  }
+}
+
+TEST_F(TestAmqpCodec, DecodeNestingDepth)
+{
+  AmqpValue nested{};
+  for (int i = 0; i < 100; i += 1)
+  {
+    nested = AmqpList{nested}.AsAmqpValue();
+  }
+  EXPECT_EQ(nested, Decode(Encode(nested)));
+
+  nested = AmqpList{nested}.AsAmqpValue();
+  auto encoded{Encode(nested)};
+  AmqpValue value;
+  AmqpDecoder decoder{encoded.data(), encoded.size()};
+  EXPECT_THROW(decoder.TryDecode(value), std::runtime_error);
+
+  // A list8 which claims one element, nested far deeper than the limit.
+  std::vector<uint8_t> buffer;
+  for (int i = 0; i < 100000; i += 1)
+  {
+    buffer.insert(buffer.end(), {0xc0, 0xff, 0x01});
+  }
+  AmqpDecoder deepDecoder{buffer.data(), buffer.size()};
+  EXPECT_THROW(deepDecoder.TryDecode(value), std::runtime_error);
+}
+
+TEST_F(TestAmqpCodec, DecodeTruncatedValue)
+{
+  auto encoded{Encode(AmqpList{1, 2, "three"}.AsAmqpValue())};
+  for (size_t size = 0; size < encoded.size(); size += 1)
+  {
+    AmqpValue value;
+    AmqpDecoder decoder{encoded.data(), size};
+    EXPECT_FALSE(decoder.TryDecode(value));
+  }
+}
+
+TEST_F(TestAmqpCodec, DecodeInvalidValue)
+{
+  {
+    // 0xff is not a valid AMQP constructor.
+    std::vector<uint8_t> buffer{0xff};
+    AmqpValue value;
+    AmqpDecoder decoder{buffer.data(), buffer.size()};
+    EXPECT_ANY_THROW(decoder.TryDecode(value));
+  }
+  {
+    // Map with an odd number of elements.
+    std::vector<uint8_t> buffer{0xc1, 0x02, 0x01, 0x40};
+    AmqpValue value;
+    AmqpDecoder decoder{buffer.data(), buffer.size()};
+    EXPECT_ANY_THROW(decoder.TryDecode(value));
+  }
+  {
+    // List which claims more elements than it has room for.
+    std::vector<uint8_t> buffer{0xc0, 0x02, 0x05, 0x40};
+    AmqpValue value;
+    AmqpDecoder decoder{buffer.data(), buffer.size()};
+    EXPECT_ANY_THROW(decoder.TryDecode(value));
+  }
+}
+
+TEST_F(TestAmqpCodec, DecodeArrayElementCount)
+{
+  {
+    // Array of nulls which claims 0xffffffff elements; null elements occupy no input.
+    std::vector<uint8_t> buffer{0xf0, 0x00, 0x00, 0x00, 0x05, 0xff, 0xff, 0xff, 0xff, 0x40};
+    AmqpValue value;
+    AmqpDecoder decoder{buffer.data(), buffer.size()};
+    EXPECT_ANY_THROW(decoder.TryDecode(value));
+  }
+  {
+    // Array of ints which claims more elements than the buffer holds.
+    std::vector<uint8_t> buffer{
+        0xf0, 0x00, 0x00, 0x00, 0x09, 0xff, 0xff, 0xff, 0xff, 0x71, 0x00, 0x00, 0x00, 0x01};
+    AmqpValue value;
+    AmqpDecoder decoder{buffer.data(), buffer.size()};
+    EXPECT_FALSE(decoder.TryDecode(value));
+  }
+  {
+    // Arrays of zero width elements within the limit are decoded.
+    std::vector<uint8_t> buffer{0xe0, 0x02, 0x03, 0x41};
+    AmqpValue value;
+    AmqpDecoder decoder{buffer.data(), buffer.size()};
+    ASSERT_TRUE(decoder.TryDecode(value));
+    EXPECT_EQ((AmqpArray{true, true, true}), value.AsArray());
+  }
+}
+
+TEST_F(TestAmqpCodec, RoundTripMessage)
+{
+  AmqpMessage message;
+  message.Header.Durable = true;
+  message.Header.Priority = 7;
+  message.Header.TimeToLive = std::chrono::milliseconds{60000};
+  message.Header.IsFirstAcquirer = true;
+  message.Header.DeliveryCount = 3;
+  message.DeliveryAnnotations["delivery"] = "annotation";
+  message.MessageAnnotations["x-opt-partition-key"] = "partition";
+  message.MessageAnnotations["x-opt-sequence-number"] = static_cast<int64_t>(1024);
+  message.Properties.MessageId = Azure::Core::Uuid::CreateUuid();
+  message.Properties.UserId = std::vector<uint8_t>{1, 2, 3};
+  message.Properties.To = "amqps://example.servicebus.windows.net/queue";
+  message.Properties.Subject = "Subject";
+  message.Properties.ReplyTo = "reply-to";
+  message.Properties.CorrelationId = static_cast<uint64_t>(42);
+  message.Properties.ContentType = "application/octet-stream";
+  message.Properties.ContentEncoding = "gzip";
+  message.Properties.AbsoluteExpiryTime = std::chrono::system_clock::time_point{
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::milliseconds{1700000000000})};
+  message.Properties.CreationTime = std::chrono::system_clock::time_point{
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::milliseconds{1600000000000})};
+  message.Properties.GroupId = "group";
+  message.Properties.GroupSequence = 17;
+  message.Properties.ReplyToGroupId = "reply-group";
+  message.ApplicationProperties["string"] = "value";
+  message.ApplicationProperties["int"] = 37;
+  message.ApplicationProperties["double"] = 3.5;
+  message.SetBody(AmqpBinaryData{std::vector<uint8_t>(1024, 0xa5)});
+  message.SetBody(AmqpBinaryData{1, 2, 3});
+  message.Footer["footer"] = "value";
+
+  std::vector<uint8_t> buffer;
+  AmqpEncoder{buffer}.EncodeMessage(message);
+  EXPECT_EQ(buffer, AmqpMessage::Serialize(message));
+
+  AmqpMessage decoded{AmqpDecoder{buffer.data(), buffer.size()}.DecodeMessage()};
+  EXPECT_EQ(message, decoded);
+}
+
+TEST_F(TestAmqpCodec, DecodeTruncatedMessage)
+{
+  AmqpMessage message;
+  message.Properties.MessageId = "12345";
+  message.SetBody(AmqpBinaryData{1, 2, 3});
+  message.Footer["footer"] = "value";
+  auto buffer{AmqpMessage::Serialize(message)};
+  EXPECT_EQ(message, AmqpMessage::Deserialize(buffer.data(), buffer.size()));
+  EXPECT_THROW(AmqpMessage::Deserialize(buffer.data(), buffer.size() - 1), std::runtime_error);
+}
+
+TEST_F(TestAmqpCodec, MessageHeaderTimeToLive)
+{
+  AmqpMessage message;
+  message.SetBody(AmqpValue{});
+
+  // The AMQP ttl field holds at most 2^32-1 milliseconds, longer TTLs are clamped to it.
+  message.Header.TimeToLive = std::chrono::hours{24 * 365};
+  auto buffer{AmqpMessage::Serialize(message)};
+  auto decoded{AmqpMessage::Deserialize(buffer.data(), buffer.size())};
+  EXPECT_EQ(
+      std::chrono::milliseconds{(std::numeric_limits<std::uint32_t>::max)()},
+      decoded.Header.TimeToLive.Value());
+
+  message.Header.TimeToLive = std::chrono::milliseconds{-1};
+  EXPECT_THROW(AmqpMessage::Serialize(message), std::runtime_error);
+}
+
+TEST_F(TestAmqpCodec, MessageHeaderOmitsDefaultFields)
+{
+  AmqpMessage message;
+  message.Header.DeliveryCount = 2;
+  message.SetBody(AmqpValue{});
+
+  std::vector<uint8_t> buffer{AmqpMessage::Serialize(message)};
+  // Described list 0x70 with four null fields followed by the delivery count, then the
+  // AmqpValue body section.
+  std::vector<uint8_t> expected{
+      0x00, 0x53, 0x70, 0xc0, 0x07, 0x05, 0x40, 0x40, 0x40, 0x40, 0x52, 0x02,
+      0x00, 0x53, 0x77, 0x40};
+  EXPECT_EQ(expected, buffer);
+  EXPECT_EQ(message, AmqpMessage::Deserialize(buffer.data(), buffer.size()));
+}
+
+TEST_F(TestAmqpCodec, MessageSectionOrder)
+{
+  AmqpMessage message;
+  message.Header.Priority = 5;
+  message.Properties.MessageId = "12345";
+  message.SetBody(AmqpValue{"Body"});
+  auto header{MessageHeader::Serialize(message.Header)};
+  auto properties{MessageProperties::Serialize(message.Properties)};
+
+  // Properties before the header is out of order.
+  std::vector<uint8_t> buffer{properties};
+  buffer.insert(buffer.end(), header.begin(), header.end());
+  EXPECT_ANY_THROW(AmqpMessage::Deserialize(buffer.data(), buffer.size()));
+
+  // A section may not be repeated.
+  buffer = header;
+  buffer.insert(buffer.end(), header.begin(), header.end());
+  EXPECT_ANY_THROW(AmqpMessage::Deserialize(buffer.data(), buffer.size()));
+
+  // Body sections cannot be mixed.
+  AmqpMessage binaryMessage;
+  binaryMessage.SetBody(AmqpBinaryData{1, 2, 3});
+  AmqpMessage valueMessage;
+  valueMessage.SetBody(AmqpValue{"Body"});
+  buffer = AmqpMessage::Serialize(binaryMessage);
+  auto valueBody{AmqpMessage::Serialize(valueMessage)};
+  buffer.insert(buffer.end(), valueBody.begin(), valueBody.end());
+  EXPECT_ANY_THROW(AmqpMessage::Deserialize(buffer.data(), buffer.size()));
+}
+
+TEST_F(TestAmqpCodec, ApplicationPropertiesMustBeSimple)
+{
+  AmqpMessage message;
+  message.ApplicationProperties["list"] = AmqpList{1, 2}.AsAmqpValue();
+  message.SetBody(AmqpValue{"Body"});
+  EXPECT_ANY_THROW(AmqpMessage::Serialize(message));
+}
@@ -389,6 +389,60 @@ TEST_F(TestValues, TestMap)
   }
 }
 
+TEST_F(TestValues, TestMapOrdering)
+{
+  // Maps iterate in key order regardless of insertion order, and keep the first of several
+  // values inserted with the same key.
+  {
+    AmqpMap map1;
+    for (int32_t i = 10; i > 0; i -= 1)
+    {
+      EXPECT_TRUE(map1.emplace(AmqpValue{i}, AmqpValue{std::to_string(i)}).second);
+    }
+    EXPECT_FALSE(map1.emplace(AmqpValue{5}, AmqpValue{"five"}).second);
+    EXPECT_EQ(10, map1.size());
+    int32_t expected{1};
+    for (auto const& item : map1)
+    {
+      EXPECT_EQ(expected, static_cast<int32_t>(item.first));
+      EXPECT_EQ(std::to_string(expected), static_cast<std::string>(item.second));
+      expected += 1;
+    }
+    EXPECT_EQ(map1.end(), map1.find(AmqpValue{11}));
+    EXPECT_EQ("7", static_cast<std::string>(map1.find(AmqpValue{7})->second));
+  }
+
+  {
+    AmqpMap map1{{"b", 1}, {"a", 2}, {"b", 3}};
+    AmqpMap map2{{"a", 2}, {"b", 1}};
+    EXPECT_EQ(2, map1.size());
+    EXPECT_EQ(map1, map2);
+    map2["c"] = 4;
+    EXPECT_NE(map1, map2);
+    EXPECT_TRUE(map1 < map2);
+  }
+
+  {
+    AmqpAnnotations annotations;
+    annotations["x-opt-sequence-number"] = 5;
+    annotations["x-opt-enqueued-time"] = 7;
+    annotations["x-opt-partition-key"] = "key";
+    annotations["x-opt-sequence-number"] = 6;
+    EXPECT_EQ(3, annotations.size());
+    EXPECT_EQ("x-opt-enqueued-time", static_cast<std::string>(annotations.begin()->first));
+    EXPECT_EQ(6, static_cast<int32_t>(annotations.find("x-opt-sequence-number")->second));
+    EXPECT_TRUE(annotations == AmqpAnnotations{annotations.AsAmqpValue()});
+  }
+
+  {
+    AmqpMap map1{{"b", 1}, {"a", 2}, {"c", 3}};
+    map1["aa"] = 4;
+    auto values{static_cast<std::map<AmqpValue, AmqpValue>>(map1)};
+    EXPECT_EQ(4, values.size());
+    EXPECT_TRUE(std::equal(values.begin(), values.end(), map1.begin(), map1.end()));
+  }
+}
+
 TEST_F(TestValues, TestArray)
 {
   AmqpArray array1{1, 3, 5, 4, 553991123};
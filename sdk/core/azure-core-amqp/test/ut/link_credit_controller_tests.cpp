@@ -0,0 +1,170 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "../src/amqp/private/link_credit_controller.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace Azure::Core::Amqp::_detail;
+using namespace Azure::Core::Amqp::_internal;
+
+class TestLinkCreditController : public testing::Test {
+protected:
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(TestLinkCreditController, FixedCredit)
+{
+  {
+    MessageReceiverOptions options;
+    LinkCreditController controller{options, 10000};
+    EXPECT_FALSE(controller.IsAdaptive());
+    EXPECT_EQ(10000u, controller.GetLinkCredit());
+  }
+  {
+    MessageReceiverOptions options;
+    options.MaxLinkCredit = 300;
+    LinkCreditController controller{options, 10000};
+    EXPECT_FALSE(controller.IsAdaptive());
+    EXPECT_EQ(300u, controller.GetLinkCredit());
+
+    // A fixed credit never changes, but the buffer is still measured.
+    for (int i = 0; i < 1000; i += 1)
+    {
+      EXPECT_FALSE(controller.OnMessageBuffered(10));
+    }
+    EXPECT_FALSE(controller.OnReceiveStalled());
+    EXPECT_EQ(300u, controller.GetLinkCredit());
+
+    auto metrics{controller.GetMetrics()};
+    EXPECT_EQ(1000u, metrics.BufferedMessages);
+    EXPECT_EQ(10000u, metrics.BufferedBytes);
+    EXPECT_EQ(1u, metrics.CreditStalls);
+  }
+  {
+    // A minimum which is not below the maximum does not enable adaptive credit.
+    MessageReceiverOptions options;
+    options.MaxLinkCredit = 50;
+    options.MinLinkCredit = 50;
+    LinkCreditController controller{options, 10000};
+    EXPECT_FALSE(controller.IsAdaptive());
+    EXPECT_EQ(50u, controller.GetLinkCredit());
+  }
+}
+
+TEST_F(TestLinkCreditController, GrowsWhenConsumerStalls)
+{
+  MessageReceiverOptions options;
+  options.MinLinkCredit = 10;
+  options.MaxLinkCredit = 100;
+  LinkCreditController controller{options, 10000};
+  EXPECT_TRUE(controller.IsAdaptive());
+  EXPECT_EQ(10u, controller.GetLinkCredit());
+
+  EXPECT_TRUE(controller.OnReceiveStalled());
+  EXPECT_EQ(20u, controller.GetLinkCredit());
+  EXPECT_TRUE(controller.OnReceiveStalled());
+  EXPECT_TRUE(controller.OnReceiveStalled());
+  EXPECT_EQ(80u, controller.GetLinkCredit());
+  EXPECT_TRUE(controller.OnReceiveStalled());
+  EXPECT_EQ(100u, controller.GetLinkCredit());
+  EXPECT_FALSE(controller.OnReceiveStalled());
+  EXPECT_EQ(100u, controller.GetLinkCredit());
+  EXPECT_EQ(5u, controller.GetMetrics().CreditStalls);
+}
+
+TEST_F(TestLinkCreditController, ShrinksWhenConsumerFallsBehind)
+{
+  MessageReceiverOptions options;
+  options.MinLinkCredit = 10;
+  options.MaxLinkCredit = 80;
+  LinkCreditController controller{options, 10000};
+  for (int i = 0; i < 3; i += 1)
+  {
+    controller.OnReceiveStalled();
+  }
+  EXPECT_EQ(80u, controller.GetLinkCredit());
+
+  // Up to two credit windows may be buffered before the credit is reduced.
+  for (int i = 0; i < 160; i += 1)
+  {
+    EXPECT_FALSE(controller.OnMessageBuffered(1));
+  }
+  EXPECT_TRUE(controller.OnMessageBuffered(1));
+  EXPECT_EQ(40u, controller.GetLinkCredit());
+
+  // Keep buffering until the credit reaches the minimum.
+  while (controller.GetLinkCredit() != 10)
+  {
+    controller.OnMessageBuffered(1);
+  }
+  EXPECT_FALSE(controller.OnMessageBuffered(1));
+
+  // Draining the buffer does not change the credit, the next stall does.
+  auto buffered{controller.GetMetrics().BufferedMessages};
+  for (uint64_t i = 0; i < buffered; i += 1)
+  {
+    controller.OnMessageConsumed(1);
+  }
+  EXPECT_EQ(0u, controller.GetMetrics().BufferedMessages);
+  EXPECT_EQ(0u, controller.GetMetrics().BufferedBytes);
+  EXPECT_EQ(10u, controller.GetLinkCredit());
+  EXPECT_TRUE(controller.OnReceiveStalled());
+  EXPECT_EQ(20u, controller.GetLinkCredit());
+}
+
+TEST_F(TestLinkCreditController, ByteLimit)
+{
+  MessageReceiverOptions options;
+  options.MaxLinkCredit = 300;
+  options.MaxBufferedBytes = 1000;
+  LinkCreditController controller{options, 10000};
+  EXPECT_TRUE(controller.IsAdaptive());
+  EXPECT_EQ(300u, controller.GetLinkCredit());
+
+  for (int i = 0; i < 10; i += 1)
+  {
+    EXPECT_FALSE(controller.OnMessageBuffered(100));
+  }
+  EXPECT_TRUE(controller.OnMessageBuffered(100));
+  EXPECT_EQ(1u, controller.GetLinkCredit());
+  EXPECT_EQ(1100u, controller.GetMetrics().BufferedBytes);
+
+  // Credit is not granted while the buffer is over the limit.
+  EXPECT_FALSE(controller.OnReceiveStalled());
+  EXPECT_EQ(1u, controller.GetLinkCredit());
+
+  controller.OnMessageConsumed(100);
+  controller.OnMessageConsumed(100);
+  EXPECT_TRUE(controller.OnReceiveStalled());
+  EXPECT_EQ(2u, controller.GetLinkCredit());
+}
+
+TEST_F(TestLinkCreditController, MessageSize)
+{
+  using namespace Azure::Core::Amqp::Models;
+  AmqpMessage message;
+  EXPECT_EQ(0u, LinkCreditController::GetMessageSize(message));
+
+  message.SetBody(AmqpBinaryData{std::vector<uint8_t>(100)});
+  message.SetBody(AmqpBinaryData{std::vector<uint8_t>(50)});
+  EXPECT_EQ(150u, LinkCreditController::GetMessageSize(message));
+
+  AmqpMessage valueMessage;
+  valueMessage.SetBody(AmqpValue{std::string(300, 'a')});
+  EXPECT_LE(300u, LinkCreditController::GetMessageSize(valueMessage));
+
+  // Buffered bytes are only tracked when the credit is adaptive.
+  {
+    MessageReceiverOptions options;
+    LinkCreditController controller{options, 10000};
+    EXPECT_EQ(0u, controller.GetBufferedMessageSize(message));
+  }
+  {
+    MessageReceiverOptions options;
+    options.MaxBufferedBytes = 1000;
+    LinkCreditController controller{options, 10000};
+    EXPECT_EQ(150u, controller.GetBufferedMessageSize(message));
+  }
+}
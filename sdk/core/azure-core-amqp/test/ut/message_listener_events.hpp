@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Base class for in-process AMQP listeners built on the AMQP test hooks.
+ *
+ * @remarks The listener side of the AMQP stack (accepting connections and incoming links) is not
+ * part of the client API. This header requires _azure_TESTING_BUILD.
+ */
+
+#pragma once
+
+#include <azure/core/amqp/internal/connection.hpp>
+#include <azure/core/amqp/internal/message_receiver.hpp>
+#include <azure/core/amqp/internal/message_sender.hpp>
+#include <azure/core/amqp/internal/models/amqp_error.hpp>
+#include <azure/core/amqp/internal/models/message_source.hpp>
+#include <azure/core/amqp/internal/models/message_target.hpp>
+#include <azure/core/amqp/internal/network/socket_listener.hpp>
+#include <azure/core/amqp/internal/session.hpp>
+#include <azure/core/context.hpp>
+
+#if ENABLE_UAMQP
+
+namespace Azure { namespace Core { namespace Amqp { namespace Tests { namespace MessageTests {
+
+  /**
+   * @brief Events raised on an AMQP listener, together with the listener side operations needed
+   * to accept incoming connections and links.
+   *
+   * Classes outside of the AMQP tests which need to emulate an AMQP service (for instance a
+   * benchmark broker) derive from this class instead of being granted access to the AMQP stack.
+   */
+  class MessageListenerEvents : public Network::_detail::SocketListenerEvents,
+                                public _internal::ConnectionEvents,
+                                public _internal::ConnectionEndpointEvents {
+  public:
+    virtual ~MessageListenerEvents() = default;
+
+  protected:
+    /** @brief Start listening for the AMQP open from the peer of an accepted connection. */
+    static void Listen(_internal::Connection& connection) { connection.Listen(); }
+
+    /** @brief Close a connection which was started with Listen. */
+    static void Close(_internal::Connection& connection, Context const& context)
+    {
+      connection.Close(context);
+    }
+
+    /** @brief Create a sender for a link attached by a receiving peer. */
+    static _internal::MessageSender CreateMessageSender(
+        _internal::Session const& session,
+        _internal::LinkEndpoint& linkEndpoint,
+        Models::_internal::MessageTarget const& target,
+        _internal::MessageSenderOptions const& options,
+        _internal::MessageSenderEvents* events)
+    {
+      return session.CreateMessageSender(linkEndpoint, target, options, events);
+    }
+
+    /** @brief Create a receiver for a link attached by a sending peer. */
+    static _internal::MessageReceiver CreateMessageReceiver(
+        _internal::Session const& session,
+        _internal::LinkEndpoint& linkEndpoint,
+        Models::_internal::MessageSource const& source,
+        _internal::MessageReceiverOptions const& options,
+        _internal::MessageReceiverEvents* events)
+    {
+      return session.CreateMessageReceiver(linkEndpoint, source, options, events);
+    }
+
+    /**
+     * @brief Attach a sender created by CreateMessageSender without waiting for the peer.
+     *
+     * @remarks The link must be attached before the link attached callback returns.
+     */
+    static Models::_internal::AmqpError HalfOpen(
+        _internal::MessageSender& sender,
+        Context const& context)
+    {
+      return sender.HalfOpen(context);
+    }
+
+    /** @brief Refuse an incoming link. */
+    static void SendDetach(
+        _internal::Session const& session,
+        _internal::LinkEndpoint const& linkEndpoint,
+        Models::_internal::AmqpError const& error)
+    {
+      session.SendDetach(linkEndpoint, true, error);
+    }
+  };
+}}}}} // namespace Azure::Core::Amqp::Tests::MessageTests
+
+#endif // ENABLE_UAMQP
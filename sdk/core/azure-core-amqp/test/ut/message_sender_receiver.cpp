@@ -27,7 +27,10 @@
 #include <azure/core/platform.hpp>
 #include <azure/core/url.hpp>
 
+#include <condition_variable>
 #include <functional>
+#include <future>
+#include <mutex>
 #include <random>
 
 #include <gtest/gtest.h>
@@ -568,6 +571,125 @@ namespace Azure { namespace Core { namespace Amqp { namespace Tests {
     CloseAmqpConnection(connection);
   }
 
+#if ENABLE_UAMQP
+  TEST_F(TestMessageSendReceive, SenderSendAsyncWindow)
+  {
+    // Holds back the disposition of incoming messages until the test releases them, so that the
+    // sender's window fills up.
+    class DelayedDispositionEndpoint final : public MessageTests::MockServiceEndpoint {
+    public:
+      DelayedDispositionEndpoint(
+          std::string const& name,
+          MessageTests::MockServiceEndpointOptions const& options)
+          : MockServiceEndpoint(name, options)
+      {
+      }
+
+      virtual ~DelayedDispositionEndpoint() = default;
+
+      void ReleaseDispositions()
+      {
+        {
+          std::unique_lock<std::mutex> lock(m_releaseLock);
+          m_released = true;
+        }
+        m_releaseCondition.notify_all();
+      }
+
+    private:
+      std::mutex m_releaseLock;
+      std::condition_variable m_releaseCondition;
+      bool m_released{};
+
+      Models::AmqpValue OnMessageReceived(
+          MessageReceiver const& receiver,
+          std::shared_ptr<Models::AmqpMessage> const& message) override
+      {
+        {
+          std::unique_lock<std::mutex> lock(m_releaseLock);
+          m_releaseCondition.wait_for(lock, std::chrono::seconds(30), [this]() {
+            return m_released;
+          });
+        }
+        return MockServiceEndpoint::OnMessageReceived(receiver, message);
+      }
+
+      void MessageReceived(
+          std::string const& linkName,
+          std::shared_ptr<Azure::Core::Amqp::Models::AmqpMessage> const& message) override
+      {
+        GTEST_LOG_(INFO) << "Message received on link " << linkName << ": " << *message;
+      }
+    };
+
+    MessageTests::MockServiceEndpointOptions mockServiceEndpointOptions{};
+    auto senderEndpoint = std::make_shared<DelayedDispositionEndpoint>(
+        "localhost/ingress", mockServiceEndpointOptions);
+    m_mockServer.AddServiceEndpoint(senderEndpoint);
+
+    auto connection{CreateAmqpConnection({})};
+    auto session{CreateAmqpSession(connection)};
+
+    // Ensure that the thread is started before we start using the message sender.
+    StartServerListening();
+
+    {
+      constexpr std::uint32_t MaxOutstandingSends{4};
+      MessageSenderOptions options;
+      options.SettleMode = SenderSettleMode::Unsettled;
+      options.MaxMessageSize = 65536;
+      options.MessageSource = "ingress";
+      options.Name = "sender-link";
+      options.MaxOutstandingSends = MaxOutstandingSends;
+      MessageSender sender(session.CreateMessageSender("localhost/ingress", options));
+      EXPECT_FALSE(sender.Open());
+
+      auto createMessage = [](std::string const& body) {
+        Azure::Core::Amqp::Models::AmqpMessage message;
+        message.SetBody(Azure::Core::Amqp::Models::AmqpValue{body});
+        return message;
+      };
+
+      // Fill the window. None of these sends are settled until the dispositions are released.
+      std::vector<MessageSendCompletion> completions;
+      for (std::uint32_t i = 0; i < MaxOutstandingSends; i += 1)
+      {
+        completions.push_back(sender.SendAsync(createMessage("Message " + std::to_string(i))));
+      }
+
+      // A send whose context expires while the window is full completes as cancelled.
+      EXPECT_EQ(
+          MessageSendStatus::Cancelled,
+          std::get<0>(sender
+                          .SendAsync(
+                              createMessage("Cancelled"),
+                              Azure::Core::Context{}.WithDeadline(
+                                  std::chrono::system_clock::now()
+                                  + std::chrono::milliseconds(100)))
+                          .Wait()));
+
+      // The next send waits for room in the window.
+      auto nextSend = std::async(std::launch::async, [&]() {
+        return sender.SendAsync(createMessage("Message " + std::to_string(MaxOutstandingSends)));
+      });
+      EXPECT_EQ(std::future_status::timeout, nextSend.wait_for(std::chrono::milliseconds(500)));
+
+      senderEndpoint->ReleaseDispositions();
+      completions.push_back(nextSend.get());
+      for (auto const& completion : completions)
+      {
+        EXPECT_EQ(MessageSendStatus::Ok, std::get<0>(completion.Wait()));
+      }
+
+      sender.Close();
+    }
+    StopServerListening();
+
+    EndAmqpSession(session);
+    CloseAmqpConnection(connection);
+  }
+#endif // ENABLE_UAMQP
+
 #if ENABLE_UAMQP
   TEST_F(TestMessageSendReceive, AuthenticatedSender)
   {
@@ -711,6 +833,133 @@ namespace Azure { namespace Core { namespace Amqp { namespace Tests {
     CloseAmqpConnection(connection);
   }
 
+#if ENABLE_UAMQP && !defined(USE_NATIVE_BROKER)
+  namespace {
+    // Issues JWT tokens which expire the given amount of time after they are requested.
+    class ExpiringTokenCredential : public Azure::Core::Credentials::TokenCredential {
+    public:
+      ExpiringTokenCredential(std::chrono::system_clock::duration lifetime)
+          : Azure::Core::Credentials::TokenCredential("Testing"), m_lifetime{lifetime}
+      {
+      }
+
+      Azure::Core::Credentials::AccessToken GetToken(
+          const Azure::Core::Credentials::TokenRequestContext&,
+          const Azure::Core::Context&) const override
+      {
+        Azure::Core::Credentials::AccessToken rv;
+        rv.Token = "ThisIsAJwt.WithABogusBody.AndSignature";
+        rv.ExpiresOn = std::chrono::system_clock::now() + m_lifetime;
+        return rv;
+      }
+
+    private:
+      std::chrono::system_clock::duration m_lifetime;
+    };
+
+    class DiscardingServiceEndpoint : public MessageTests::MockServiceEndpoint {
+    public:
+      DiscardingServiceEndpoint(
+          std::string const& name,
+          MessageTests::MockServiceEndpointOptions const& options)
+          : MockServiceEndpoint(name, options)
+      {
+      }
+
+    private:
+      void MessageReceived(
+          std::string const&,
+          std::shared_ptr<Azure::Core::Amqp::Models::AmqpMessage> const&) override
+      {
+      }
+    };
+  } // namespace
+
+  TEST_F(TestMessageSendReceive, AuthenticatedSendersShareCbsLink)
+  {
+    std::string endpoint = GetBrokerEndpoint() + "/testLocation";
+    MessageTests::MockServiceEndpointOptions mockServiceEndpointOptions{};
+    mockServiceEndpointOptions.EnableTrace = false;
+    m_mockServer.AddServiceEndpoint(
+        std::make_shared<DiscardingServiceEndpoint>(endpoint, mockServiceEndpointOptions));
+
+    ConnectionOptions connectionOptions;
+    connectionOptions.Port = GetPort();
+    Connection connection(
+        "localhost",
+        std::make_shared<ExpiringTokenCredential>(std::chrono::hours(1)),
+        connectionOptions);
+    auto session{CreateAmqpSession(connection)};
+
+    StartServerListening();
+
+    std::vector<std::unique_ptr<MessageSender>> senders;
+    for (int i = 0; i < 3; i += 1)
+    {
+      MessageSenderOptions senderOptions;
+      senderOptions.Name = "sender-link" + std::to_string(i);
+      senderOptions.MessageSource = "ingress";
+      senderOptions.SettleMode = Azure::Core::Amqp::_internal::SenderSettleMode::Settled;
+      senders.push_back(std::make_unique<MessageSender>(
+          session.CreateMessageSender(endpoint, senderOptions, nullptr)));
+      EXPECT_FALSE(senders.back()->Open());
+    }
+
+    // Every link authenticates over the same CBS link (a sender and a receiver), and the token
+    // for the shared audience is only put once.
+    EXPECT_EQ(2, m_mockServer.GetCbsLinkAttachCount());
+    EXPECT_EQ(1, m_mockServer.GetCbsPutTokenCount());
+
+    for (auto& sender : senders)
+    {
+      sender->Close();
+    }
+
+    StopServerListening();
+  }
+
+  TEST_F(TestMessageSendReceive, AuthenticatedSenderRenewsToken)
+  {
+    std::string endpoint = GetBrokerEndpoint() + "/testLocation";
+    MessageTests::MockServiceEndpointOptions mockServiceEndpointOptions{};
+    mockServiceEndpointOptions.EnableTrace = false;
+    m_mockServer.AddServiceEndpoint(
+        std::make_shared<DiscardingServiceEndpoint>(endpoint, mockServiceEndpointOptions));
+
+    // Tokens are renewed five minutes before they expire, so these tokens are due for renewal
+    // one second after they are issued.
+    ConnectionOptions connectionOptions;
+    connectionOptions.Port = GetPort();
+    Connection connection(
+        "localhost",
+        std::make_shared<ExpiringTokenCredential>(
+            std::chrono::minutes(5) + std::chrono::seconds(1)),
+        connectionOptions);
+    auto session{CreateAmqpSession(connection)};
+
+    StartServerListening();
+
+    MessageSenderOptions senderOptions;
+    senderOptions.Name = "sender-link";
+    senderOptions.MessageSource = "ingress";
+    senderOptions.SettleMode = Azure::Core::Amqp::_internal::SenderSettleMode::Settled;
+    MessageSender sender(session.CreateMessageSender(endpoint, senderOptions, nullptr));
+    EXPECT_FALSE(sender.Open());
+    EXPECT_EQ(1, m_mockServer.GetCbsPutTokenCount());
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (m_mockServer.GetCbsPutTokenCount() < 2 && std::chrono::steady_clock::now() < deadline)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    EXPECT_GE(m_mockServer.GetCbsPutTokenCount(), 2);
+
+    sender.Close();
+
+    StopServerListening();
+  }
+#endif // ENABLE_UAMQP && !defined(USE_NATIVE_BROKER)
+
   TEST_F(TestMessageSendReceive, AuthenticatedReceiver)
   {
     std::string brokerEndpoint = GetBrokerEndpoint() + "/testLocation";
@@ -16,6 +16,7 @@
 #include <azure/core/amqp/internal/network/socket_listener.hpp>
 #include <azure/core/amqp/internal/session.hpp>
 
+#include <atomic>
 #include <memory>
 
 #include <gtest/gtest.h>
@@ -64,6 +65,9 @@ namespace Azure { namespace Core { namespace Amqp { namespace Tests {
 
       const std::string& GetName() const { return m_name; }
 
+      // The number of links which have attached to this endpoint.
+      int GetLinkAttachCount() const { return m_linkAttachCount; }
+
       bool OnLinkAttached(
           Azure::Core::Amqp::_internal::Session const& session,
           std::string const& linkName,
@@ -74,6 +78,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace Tests {
       {
         GTEST_LOG_(INFO) << "MockServiceEndpoint::OnLinkAttached for name: " << m_name
                          << " Source : " << source << " Target : " << target;
+        ++m_linkAttachCount;
 
         // If the incoming role is receiver, then we want to create a sender to talk to it.
         // Similarly, if the incoming role is sender, we want to create a receiver to receive
@@ -275,6 +280,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace Tests {
       Azure::Core::Context m_listenerContext; // Used to cancel the listener if necessary.
       bool m_enableTrace{true};
       std::string m_name;
+      std::atomic<int> m_linkAttachCount{0};
       std::thread m_serverThread;
       std::map<std::string, std::unique_ptr<Azure::Core::Amqp::_internal::MessageSender>> m_sender;
       std::map<std::string, std::unique_ptr<Azure::Core::Amqp::_internal::MessageReceiver>>
@@ -399,8 +405,12 @@ namespace Azure { namespace Core { namespace Amqp { namespace Tests {
 
       void ForceCbsError(bool forceError) { m_forceCbsError = forceError; }
 
+      // The number of put-token requests received.
+      int GetPutTokenCount() const { return m_putTokenCount; }
+
     private:
       bool m_forceCbsError{false};
+      std::atomic<int> m_putTokenCount{0};
 
       void MessageReceived(
           std::string const&,
@@ -450,6 +460,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace Tests {
           EXPECT_EQ(name.GetType(), Azure::Core::Amqp::Models::AmqpValueType::String);
           // The body of a put-token operation MUST be an AMQP AmqpValue.
           EXPECT_EQ(message->BodyType, Azure::Core::Amqp::Models::MessageBodyType::Value);
+          ++m_putTokenCount;
 
           // Respond to the operation.
           Azure::Core::Amqp::Models::AmqpMessage response;
@@ -656,16 +667,13 @@ namespace Azure { namespace Core { namespace Amqp { namespace Tests {
         m_listening = false;
       }
 
-      void ForceCbsError(bool forceError)
-      {
-        for (const auto& serviceEndpoint : m_serviceEndpoints)
-        {
-          if (serviceEndpoint->GetName() == "$cbs")
-          {
-            static_cast<AmqpClaimBasedSecurity*>(serviceEndpoint.get())->ForceCbsError(forceError);
-          }
-        }
-      }
+      void ForceCbsError(bool forceError) { GetCbsEndpoint()->ForceCbsError(forceError); }
+
+      // The number of links attached to the CBS endpoint (a client's CBS link attaches two).
+      int GetCbsLinkAttachCount() { return GetCbsEndpoint()->GetLinkAttachCount(); }
+
+      // The number of put-token requests received by the CBS endpoint.
+      int GetCbsPutTokenCount() { return GetCbsEndpoint()->GetPutTokenCount(); }
 
       void EnableTrace(bool enableTrace) { m_enableTrace = enableTrace; }
 
@@ -766,6 +774,18 @@ namespace Azure { namespace Core { namespace Amqp { namespace Tests {
     private:
       std::vector<std::shared_ptr<MockServiceEndpoint>> m_serviceEndpoints;
 
+      AmqpClaimBasedSecurity* GetCbsEndpoint()
+      {
+        for (const auto& serviceEndpoint : m_serviceEndpoints)
+        {
+          if (serviceEndpoint->GetName() == "$cbs")
+          {
+            return static_cast<AmqpClaimBasedSecurity*>(serviceEndpoint.get());
+          }
+        }
+        throw std::runtime_error("Mock server has no CBS endpoint.");
+      }
+
       // The set of incoming connections, used when tearing down the mock server.
       std::list<std::shared_ptr<Azure::Core::Amqp::_internal::Connection>> m_connections;
 
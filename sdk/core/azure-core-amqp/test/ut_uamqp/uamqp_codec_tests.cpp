@@ -0,0 +1,149 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "../src/models/private/amqp_codec.hpp"
+#include "../src/models/private/value_impl.hpp"
+#include "azure/core/amqp/models/amqp_value.hpp"
+
+#include <azure_uamqp_c/amqpvalue.h>
+
+#include <chrono>
+#include <random>
+
+#include <gtest/gtest.h>
+
+using namespace Azure::Core::Amqp::Models;
+using namespace Azure::Core::Amqp::Models::_detail;
+
+// Compares the native AMQP codec with the uAMQP value codec it replaces.
+class TestUamqpCodec : public testing::Test {
+protected:
+  void SetUp() override {}
+  void TearDown() override {}
+
+  static int OnBytesEncoded(void* context, unsigned char const* bytes, size_t length)
+  {
+    auto buffer = static_cast<std::vector<uint8_t>*>(context);
+    buffer->insert(buffer->end(), bytes, bytes + length);
+    return 0;
+  }
+
+  static std::vector<uint8_t> UamqpEncode(AmqpValue const& value)
+  {
+    std::vector<uint8_t> buffer;
+    if (amqpvalue_encode(AmqpValueFactory::ToImplementation(value), OnBytesEncoded, &buffer))
+    {
+      throw std::runtime_error("Could not encode object");
+    }
+    return buffer;
+  }
+
+  static void OnValueDecoded(void* context, AMQP_VALUE value)
+  {
+    *static_cast<AmqpValue*>(context)
+        = AmqpValueFactory::FromImplementation(UniqueAmqpValueHandle{amqpvalue_clone(value)});
+  }
+
+  static AmqpValue UamqpDecode(std::vector<uint8_t> const& buffer)
+  {
+    AmqpValue value;
+    UniqueAmqpDecoderHandle decoder{amqpvalue_decoder_create(OnValueDecoded, &value)};
+    if (amqpvalue_decode_bytes(decoder.get(), buffer.data(), buffer.size()))
+    {
+      throw std::runtime_error("Could not decode object");
+    }
+    return value;
+  }
+
+  static std::vector<uint8_t> NativeEncode(AmqpValue const& value)
+  {
+    std::vector<uint8_t> buffer;
+    AmqpEncoder{buffer}.Encode(value);
+    return buffer;
+  }
+
+  static AmqpValue NativeDecode(std::vector<uint8_t> const& buffer)
+  {
+    AmqpValue value;
+    AmqpDecoder{buffer.data(), buffer.size()}.TryDecode(value);
+    return value;
+  }
+
+  // A representative Event Hubs event: annotations, a handful of application properties and a
+  // binary body.
+  static AmqpValue CreateEventLikeValue()
+  {
+    AmqpMap applicationProperties;
+    for (int32_t i = 0; i < 10; i += 1)
+    {
+      applicationProperties.emplace(
+          AmqpValue{"property" + std::to_string(i)}, AmqpValue{"value" + std::to_string(i)});
+    }
+    AmqpMap annotations{
+        {AmqpSymbol{"x-opt-partition-key"}.AsAmqpValue(), AmqpValue{"partition"}},
+        {AmqpSymbol{"x-opt-sequence-number"}.AsAmqpValue(), AmqpValue{int64_t{1024}}},
+        {AmqpSymbol{"x-opt-enqueued-time"}.AsAmqpValue(),
+         AmqpTimestamp{std::chrono::milliseconds{1700000000000}}.AsAmqpValue()},
+    };
+    return AmqpList{
+        annotations.AsAmqpValue(),
+        applicationProperties.AsAmqpValue(),
+        AmqpBinaryData{std::vector<uint8_t>(1024, 0x5a)}.AsAmqpValue(),
+        AmqpArray{1, 2, 3, 4, 5, 6, 7, 8}.AsAmqpValue()}
+        .AsAmqpValue();
+  }
+};
+
+TEST_F(TestUamqpCodec, NativeEncodingMatchesUamqp)
+{
+  std::mt19937_64 random{0x414d5150};
+  std::vector<AmqpValue> values{
+      AmqpValue{},
+      AmqpValue{true},
+      AmqpValue{static_cast<uint8_t>(random())},
+      AmqpValue{static_cast<uint16_t>(random())},
+      AmqpValue{static_cast<uint32_t>(0)},
+      AmqpValue{static_cast<uint32_t>(200)},
+      AmqpValue{static_cast<uint32_t>(random())},
+      AmqpValue{static_cast<uint64_t>(0)},
+      AmqpValue{static_cast<uint64_t>(200)},
+      AmqpValue{static_cast<uint64_t>(random())},
+      AmqpValue{static_cast<int8_t>(random())},
+      AmqpValue{static_cast<int16_t>(random())},
+      AmqpValue{static_cast<int32_t>(-100)},
+      AmqpValue{static_cast<int32_t>(random())},
+      AmqpValue{static_cast<int64_t>(-100)},
+      AmqpValue{static_cast<int64_t>(random())},
+      AmqpValue{1.5f},
+      AmqpValue{-1.5e300},
+      AmqpTimestamp{std::chrono::milliseconds{1700000000000}}.AsAmqpValue(),
+      AmqpValue{Azure::Core::Uuid::CreateUuid()},
+      AmqpBinaryData{std::vector<uint8_t>(255, 1)}.AsAmqpValue(),
+      AmqpBinaryData{std::vector<uint8_t>(256, 1)}.AsAmqpValue(),
+      AmqpValue{std::string(255, 'a')},
+      AmqpValue{std::string(256, 'a')},
+      AmqpSymbol{std::string(20, 's')}.AsAmqpValue(),
+      AmqpList{}.AsAmqpValue(),
+      AmqpMap{}.AsAmqpValue(),
+      AmqpArray{}.AsAmqpValue(),
+      AmqpArray{true, false}.AsAmqpValue(),
+      AmqpArray{"a", "bc"}.AsAmqpValue(),
+      AmqpArray{AmqpArray{1, 2}.AsAmqpValue(), AmqpArray{3}.AsAmqpValue()}.AsAmqpValue(),
+      AmqpArray{AmqpMap{{1, 2}}.AsAmqpValue()}.AsAmqpValue(),
+      AmqpDescribed{static_cast<uint64_t>(0x70), AmqpList{1, 2}.AsAmqpValue()}.AsAmqpValue(),
+      AmqpComposite{AmqpSymbol{"composite"}.AsAmqpValue(), {1, "two"}}.AsAmqpValue(),
+      CreateEventLikeValue(),
+  };
+
+  for (auto const& value : values)
+  {
+    auto expected{UamqpEncode(value)};
+    EXPECT_EQ(expected, NativeEncode(value)) << "Value: " << value;
+    size_t expectedSize;
+    ASSERT_EQ(
+        0,
+        amqpvalue_get_encoded_size(AmqpValueFactory::ToImplementation(value), &expectedSize));
+    EXPECT_EQ(expectedSize, AmqpEncoder::GetEncodedSize(value)) << "Value: " << value;
+    EXPECT_EQ(UamqpDecode(expected), NativeDecode(expected)) << "Value: " << value;
+  }
+}
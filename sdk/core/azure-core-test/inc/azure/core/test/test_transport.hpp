@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Base class for HTTP transports which fake a service in unit tests.
+ *
+ */
+
+#pragma once
+
+#include <azure/core/http/http.hpp>
+#include <azure/core/http/raw_response.hpp>
+#include <azure/core/http/transport.hpp>
+#include <azure/core/io/body_stream.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Azure { namespace Core { namespace Test {
+  /**
+   * @brief An HTTP transport which answers requests in-process instead of sending them.
+   *
+   * @remark Derived transports implement `Send` and create their responses with
+   * #CreateResponse.
+   */
+  class TestTransport : public Azure::Core::Http::HttpTransport {
+    std::mutex m_bodiesMutex;
+    std::vector<std::unique_ptr<std::string>> m_bodies;
+
+  protected:
+    /**
+     * @brief Create a response with a body stream reading \p body.
+     *
+     * @remark The body is kept alive with the transport, so that the response can be read after
+     * `Send` returns. This method can be called concurrently.
+     *
+     * @param statusCode The status code of the response.
+     * @param body The body of the response.
+     * @return The response.
+     */
+    std::unique_ptr<Azure::Core::Http::RawResponse> CreateResponse(
+        Azure::Core::Http::HttpStatusCode statusCode,
+        std::string body = {})
+    {
+      auto response = std::make_unique<Azure::Core::Http::RawResponse>(
+          1, 1, statusCode, "TestReasonPhrase");
+      std::string const* ownedBody;
+      {
+        std::lock_guard<std::mutex> lock(m_bodiesMutex);
+        m_bodies.emplace_back(std::make_unique<std::string>(std::move(body)));
+        ownedBody = m_bodies.back().get();
+      }
+      response->SetBodyStream(std::make_unique<Azure::Core::IO::MemoryBodyStream>(
+          reinterpret_cast<uint8_t const*>(ownedBody->data()), ownedBody->size()));
+      return response;
+    }
+  };
+}}} // namespace Azure::Core::Test
@@ -7,6 +7,7 @@
  */
 
 #pragma once
+#include "azure/messaging/eventhubs/buffered_checkpoint_store.hpp"
 #include "azure/messaging/eventhubs/checkpoint_store.hpp"
 #include "azure/messaging/eventhubs/consumer_client.hpp"
 #include "azure/messaging/eventhubs/dll_import_export.hpp"
@@ -0,0 +1,181 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include "checkpoint_store.hpp"
+#include "models/checkpoint_store_models.hpp"
+
+#include <azure/core/context.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Azure { namespace Messaging { namespace EventHubs {
+
+  /**@brief Options used to configure a BufferedCheckpointStore.
+   */
+  struct BufferedCheckpointStoreOptions final
+  {
+    /**@brief The interval at which pending checkpoints are written to the underlying checkpoint
+     * store.
+     */
+    std::chrono::milliseconds FlushInterval{std::chrono::seconds(10)};
+
+    /**@brief When this many checkpoint updates have been received since the last flush, pending
+     * checkpoints are written without waiting for FlushInterval to elapse.
+     *
+     * Disabled if MaxPendingUpdates == 0.
+     */
+    std::uint32_t MaxPendingUpdates{1000};
+
+    /**@brief The longest time the destructor spends writing pending checkpoints. Checkpoints
+     * which have not been written when it elapses are lost.
+     */
+    std::chrono::milliseconds ShutdownTimeout{std::chrono::seconds(30)};
+  };
+
+  /**@brief Metrics describing the state of a BufferedCheckpointStore.
+   */
+  struct BufferedCheckpointStoreMetrics final
+  {
+    /// @brief The number of partitions with a checkpoint which has not yet been written.
+    std::size_t PendingCheckpoints{};
+
+    /// @brief The total number of checkpoint updates received.
+    std::uint64_t UpdatesReceived{};
+
+    /// @brief The number of checkpoint updates which were superseded before being written.
+    std::uint64_t UpdatesCoalesced{};
+
+    /// @brief The number of checkpoints written to the underlying checkpoint store.
+    std::uint64_t CheckpointsWritten{};
+
+    /// @brief The number of checkpoint writes which failed and were retained for a later flush.
+    std::uint64_t WriteFailures{};
+
+    /// @brief The time since the oldest pending checkpoint update was received.
+    std::chrono::milliseconds MaxCheckpointLag{};
+  };
+
+  /**@brief BufferedCheckpointStore is a CheckpointStore which writes checkpoints to another
+   * CheckpointStore from a background thread.
+   *
+   * UpdateCheckpoint records the checkpoint and returns immediately. Only the most recent
+   * checkpoint for each partition is retained, and pending checkpoints are written to the
+   * underlying store every FlushInterval, or sooner once MaxPendingUpdates updates have been
+   * received. Ownership operations are passed directly to the underlying store.
+   *
+   * Pending checkpoints are written when the BufferedCheckpointStore is destroyed, for at most
+   * ShutdownTimeout. Call Flush to write them earlier, for instance before stopping a Processor.
+   *
+   * @remark Checkpoints which have not been written are lost if the process terminates, so a
+   * consumer may reprocess up to FlushInterval worth of events after a failure.
+   */
+  class BufferedCheckpointStore final : public CheckpointStore {
+  public:
+    /**@brief Construct a BufferedCheckpointStore.
+     *
+     * @param checkpointStore The checkpoint store to which checkpoints are written, for instance
+     * a BlobCheckpointStore.
+     * @param options Options controlling when checkpoints are written.
+     */
+    BufferedCheckpointStore(
+        std::shared_ptr<CheckpointStore> checkpointStore,
+        BufferedCheckpointStoreOptions const& options = {});
+
+    /**@brief Stops the background writer and writes any pending checkpoints, for at most
+     * BufferedCheckpointStoreOptions::ShutdownTimeout.
+     */
+    ~BufferedCheckpointStore() override;
+
+    BufferedCheckpointStore(BufferedCheckpointStore const& other) = delete;
+    BufferedCheckpointStore& operator=(BufferedCheckpointStore const& other) = delete;
+
+    /**@brief ClaimOwnership attempts to claim ownership of the partitions in partitionOwnership
+     * and returns the actual partitions that were claimed.
+     */
+    std::vector<Models::Ownership> ClaimOwnership(
+        std::vector<Models::Ownership> const& partitionOwnership,
+        Core::Context const& context = {}) override;
+
+    /**@brief ListCheckpoints lists all the available checkpoints, including checkpoints which
+     * have not yet been written to the underlying store.
+     */
+    std::vector<Models::Checkpoint> ListCheckpoints(
+        std::string const& fullyQualifiedNamespace,
+        std::string const& eventHubName,
+        std::string const& consumerGroup,
+        Core::Context const& context = {}) override;
+
+    /**@brief ListOwnership lists all ownerships.
+     */
+    std::vector<Models::Ownership> ListOwnership(
+        std::string const& fullyQualifiedNamespace,
+        std::string const& eventHubName,
+        std::string const& consumerGroup,
+        Core::Context const& context = {}) override;
+
+    /**@brief UpdateCheckpoint records a checkpoint to be written by the background writer.
+     *
+     * The checkpoint replaces any pending checkpoint for the same partition.
+     */
+    void UpdateCheckpoint(Models::Checkpoint const& checkpoint, Core::Context const& context = {})
+        override;
+
+    /**@brief Write all pending checkpoints to the underlying checkpoint store.
+     *
+     * Checkpoints which could not be written, or were not written because the context was
+     * cancelled, remain pending unless a newer checkpoint has been recorded for the partition in
+     * the meantime.
+     *
+     * @param context The context for cancelling the flush.
+     *
+     * @throw The first exception thrown by the underlying checkpoint store.
+     * @throw Azure::Core::OperationCancelledException if the context was cancelled before every
+     * checkpoint was written.
+     */
+    void Flush(Core::Context const& context = {});
+
+    /**@brief Returns the current checkpoint metrics.
+     */
+    BufferedCheckpointStoreMetrics GetMetrics() const;
+
+  private:
+    struct PendingCheckpoint final
+    {
+      Models::Checkpoint Checkpoint;
+      std::chrono::steady_clock::time_point FirstUpdated;
+    };
+
+    void RunWriter();
+
+    // Returns the checkpoints which have not been written to the underlying store, whether they
+    // are pending or being written by Flush. Must be called with m_pendingLock held.
+    std::map<std::string, PendingCheckpoint> GetUnwrittenCheckpoints() const;
+
+    // Returns a checkpoint which was not written to the pending checkpoints, unless it has been
+    // superseded. Must be called with m_pendingLock held.
+    void RetainCheckpoint(std::string const& name, PendingCheckpoint const& checkpoint);
+
+    std::shared_ptr<CheckpointStore> m_checkpointStore;
+    BufferedCheckpointStoreOptions m_options;
+
+    mutable std::mutex m_pendingLock;
+    std::condition_variable m_writerCondition;
+    std::map<std::string, PendingCheckpoint> m_pendingCheckpoints;
+    // The checkpoints taken by Flush which it has not written yet.
+    std::map<std::string, PendingCheckpoint> m_flushingCheckpoints;
+    std::uint32_t m_updatesSinceFlush{};
+    bool m_stopWriter{false};
+    BufferedCheckpointStoreMetrics m_metrics;
+
+    // Serializes flushes so that an older checkpoint can never be written after a newer one.
+    std::mutex m_flushLock;
+    std::thread m_writerThread;
+  };
+}}} // namespace Azure::Messaging::EventHubs
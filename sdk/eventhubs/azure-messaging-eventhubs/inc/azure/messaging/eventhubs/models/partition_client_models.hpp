@@ -49,4 +49,23 @@ namespace Azure { namespace Messaging { namespace EventHubs { namespace Models {
   };
   std::ostream& operator<<(std::ostream&, StartPosition const&);
 
+  /**@brief Metrics describing the prefetch buffer of a PartitionClient.
+   */
+  struct PartitionClientMetrics final
+  {
+    /// @brief The number of prefetched events which have not yet been returned by ReceiveEvents.
+    std::uint64_t BufferedEvents{};
+
+    /** @brief The body size, in bytes, of the events counted in BufferedEvents. Only tracked when
+     * PartitionClientOptions::MinimumPrefetch or PartitionClientOptions::MaxPrefetchBytes is set.
+     */
+    std::uint64_t BufferedBytes{};
+
+    /// @brief The number of events the client currently allows the service to prefetch.
+    std::uint32_t Prefetch{};
+
+    /// @brief The number of times ReceiveEvents waited for an event with none prefetched.
+    std::uint64_t PrefetchStalls{};
+  };
+
 }}}} // namespace Azure::Messaging::EventHubs::Models
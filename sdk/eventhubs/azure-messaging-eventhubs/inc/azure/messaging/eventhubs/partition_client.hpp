@@ -48,6 +48,22 @@ namespace Azure { namespace Messaging { namespace EventHubs {
      */
 
     int32_t Prefetch = 300;
+
+    /**@brief MinimumPrefetch enables adaptive prefetch. When greater than zero and less than
+     * Prefetch, the size of the prefetch buffer starts at MinimumPrefetch and is adjusted between
+     * MinimumPrefetch and Prefetch based on how quickly ReceiveEvents() consumes events.
+     *
+     * Default is off.
+     */
+    int32_t MinimumPrefetch{};
+
+    /**@brief MaxPrefetchBytes bounds the total body size of events held in the prefetch buffer.
+     * When the limit is reached, the client stops requesting more events until ReceiveEvents()
+     * has consumed some of the buffered events.
+     *
+     * Default is off.
+     */
+    Azure::Nullable<std::uint64_t> MaxPrefetchBytes{};
   };
 
   /** PartitionClient is used to receive events from an Event Hub partition.
@@ -83,6 +99,13 @@ namespace Azure { namespace Messaging { namespace EventHubs {
         uint32_t maxMessages,
         Core::Context const& context = {});
 
+    /** @brief Returns a snapshot of the prefetch buffer metrics.
+     *
+     * @remark The metrics are only available on the uAMQP build. On other builds every metric is
+     * zero.
+     */
+    Models::PartitionClientMetrics GetMetrics() const;
+
     /** @brief Closes the connection to the Event Hub service.
      */
     void Close(Core::Context const& context) { m_receiver.Close(context); }
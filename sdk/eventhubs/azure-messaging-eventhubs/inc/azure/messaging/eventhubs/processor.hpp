@@ -12,6 +12,9 @@
 #include <azure/core/context.hpp>
 
 #include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
 #include <thread>
 
 #ifdef _azure_TESTING_BUILD_AMQP
@@ -67,6 +70,24 @@ namespace Azure { namespace Messaging { namespace EventHubs {
      * of partitions to process.
      */
     int32_t MaximumNumberOfPartitions{0};
+
+    /** @brief Specifies the maximum number of partition clients which are opened concurrently.
+     *
+     * When the processor claims several partitions at once, for instance when it starts, the links
+     * to those partitions are opened in parallel. Values less than 2 open partitions one at a time.
+     */
+    int32_t MaximumConcurrentPartitionStartup{16};
+
+    /** @brief If true, the processor runs load balancing again after a short delay instead of
+     * waiting for UpdateInterval while there are unowned or expired partitions it could still
+     * claim.
+     *
+     * This lets a processor reach its share of the partitions within a few load balancing cycles
+     * of starting, or of another processor stopping. The delay starts at 100 milliseconds and
+     * doubles for each consecutive accelerated cycle; after five of them the processor waits a
+     * full UpdateInterval.
+     */
+    bool AcceleratedLoadBalancing{true};
   };
 
   /**@brief Processor uses a [ConsumerClient] and [CheckpointStore] to provide automatic
@@ -274,10 +295,36 @@ namespace Azure { namespace Messaging { namespace EventHubs {
     Models::ConsumerClientDetails m_consumerClientDetails;
     std::shared_ptr<_detail::ProcessorLoadBalancer> m_loadBalancer;
     int64_t m_processorOwnerLevel{0};
+    size_t m_maximumConcurrentPartitionStartup;
+    bool m_acceleratedLoadBalancing;
     bool m_isRunning{false};
     std::thread m_processorThread;
+    // Signaled when the processor is stopped, to interrupt the wait between load balancing cycles.
+    std::mutex m_stopLock;
+    std::condition_variable m_stopCondition;
 
-    typedef std::map<std::string, std::shared_ptr<ProcessorPartitionClient>> ConsumersType;
+    /** @brief The active processor partition clients, keyed by partition id.
+     *
+     * Partition clients are added concurrently during partition startup and removed when they are
+     * closed, so the map is protected by a lock.
+     */
+    struct ConsumersType final
+    {
+      std::mutex Lock;
+      std::map<std::string, std::shared_ptr<ProcessorPartitionClient>> Clients;
+    };
+
+    /** @brief Waits before the next load balancing cycle.
+     *
+     * @param delay The time to wait.
+     * @param context The context to control the request lifetime. The wait ends at its deadline.
+     * @param publicInvocation True if the processor was run by a direct call to Run, which Stop
+     * does not interrupt.
+     */
+    void WaitForNextCycle(
+        Azure::DateTime::duration delay,
+        Core::Context const& context,
+        bool publicInvocation);
 
     /** @brief Dispatches events to the appropriate partition clients.
      *
@@ -292,7 +339,7 @@ namespace Azure { namespace Messaging { namespace EventHubs {
 
     void AddPartitionClient(
         Models::Ownership const& ownership,
-        std::map<std::string, Models::Checkpoint>& checkpoints,
+        std::map<std::string, Models::Checkpoint> const& checkpoints,
         std::weak_ptr<ConsumersType> consumers,
         Core::Context const& context);
 
@@ -43,6 +43,11 @@ namespace Azure { namespace Messaging { namespace EventHubs {
      */
     Azure::Nullable<std::uint64_t> MaxMessageSize{};
 
+    /**@brief  The maximum number of batches which may be in flight on a partition at once when
+     * sending several batches.
+     */
+    std::uint32_t MaxOutstandingSends{10};
+
   private:
     // The friend declaration is needed so that ProducerClient could access CppStandardVersion,
     // and it is not a struct's public field like the ones above to be set non-programmatically.
@@ -162,6 +167,26 @@ namespace Azure { namespace Messaging { namespace EventHubs {
      */
     void Send(std::vector<Models::EventData> const& eventData, Core::Context const& context = {});
 
+    /**@brief Send several EventDataBatch objects to the remote Event Hub.
+     *
+     * @remark Sends to a partition are pipelined: up to ProducerClientOptions::MaxOutstandingSends
+     * batches are sent before waiting for the service to accept them, rather than one batch per
+     * round trip. Every batch which was started is settled before this returns, even if a later
+     * batch could not be started. Failed batches are not retried, because a batch which failed or
+     * timed out may still have been stored by the service; the first failure is thrown once every
+     * batch has settled.
+     *
+     * @throw Azure::Core::OperationCancelledException if the context is cancelled before every
+     * batch has settled. The batches which were already sent may still be stored by the service.
+     * @throw EventHubsException if the service does not accept a batch.
+     *
+     * @param eventDataBatches Batches to send
+     * @param context Request context
+     */
+    void Send(
+        std::vector<EventDataBatch> const& eventDataBatches,
+        Core::Context const& context = {});
+
     /**@brief  GetEventHubProperties gets properties of an eventHub. This includes data
      * like name, and partitions.
      *
@@ -0,0 +1,300 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "azure/messaging/eventhubs/buffered_checkpoint_store.hpp"
+
+#include <azure/core/internal/diagnostics/log.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <stdexcept>
+
+using namespace Azure::Core::Diagnostics::_internal;
+using namespace Azure::Core::Diagnostics;
+
+namespace Azure { namespace Messaging { namespace EventHubs {
+
+  BufferedCheckpointStore::BufferedCheckpointStore(
+      std::shared_ptr<CheckpointStore> checkpointStore,
+      BufferedCheckpointStoreOptions const& options)
+      : CheckpointStore(), m_checkpointStore{checkpointStore}, m_options{options}
+  {
+    if (!m_checkpointStore)
+    {
+      throw std::invalid_argument("checkpointStore cannot be null.");
+    }
+    m_writerThread = std::thread([this]() { RunWriter(); });
+  }
+
+  BufferedCheckpointStore::~BufferedCheckpointStore()
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_pendingLock);
+      m_stopWriter = true;
+    }
+    m_writerCondition.notify_all();
+    if (m_writerThread.joinable())
+    {
+      m_writerThread.join();
+    }
+
+    try
+    {
+      Flush(Core::Context{}.WithDeadline(
+          std::chrono::system_clock::now() + m_options.ShutdownTimeout));
+    }
+    catch (std::exception const& ex)
+    {
+      Log::Stream(Logger::Level::Warning)
+          << "BufferedCheckpointStore: Pending checkpoints could not be written on shutdown: "
+          << ex.what();
+    }
+  }
+
+  void BufferedCheckpointStore::RunWriter()
+  {
+    std::unique_lock<std::mutex> lock(m_pendingLock);
+    while (!m_stopWriter)
+    {
+      m_writerCondition.wait_for(lock, m_options.FlushInterval, [this]() {
+        return m_stopWriter
+            || (m_options.MaxPendingUpdates != 0
+                && m_updatesSinceFlush >= m_options.MaxPendingUpdates);
+      });
+      if (m_stopWriter)
+      {
+        break;
+      }
+      if (m_pendingCheckpoints.empty())
+      {
+        continue;
+      }
+
+      // Write the checkpoints without holding the lock so that UpdateCheckpoint is never blocked
+      // on the underlying store.
+      lock.unlock();
+      try
+      {
+        Flush();
+      }
+      catch (std::exception const& ex)
+      {
+        Log::Stream(Logger::Level::Warning)
+            << "BufferedCheckpointStore: Checkpoint write failed, will retry: " << ex.what();
+      }
+      lock.lock();
+    }
+  }
+
+  std::vector<Models::Ownership> BufferedCheckpointStore::ClaimOwnership(
+      std::vector<Models::Ownership> const& partitionOwnership,
+      Core::Context const& context)
+  {
+    return m_checkpointStore->ClaimOwnership(partitionOwnership, context);
+  }
+
+  std::vector<Models::Checkpoint> BufferedCheckpointStore::ListCheckpoints(
+      std::string const& fullyQualifiedNamespace,
+      std::string const& eventHubName,
+      std::string const& consumerGroup,
+      Core::Context const& context)
+  {
+    std::vector<Models::Checkpoint> checkpoints{m_checkpointStore->ListCheckpoints(
+        fullyQualifiedNamespace, eventHubName, consumerGroup, context)};
+
+    std::string prefix = Models::Checkpoint{consumerGroup, eventHubName, fullyQualifiedNamespace}
+                             .GetCheckpointBlobPrefixName();
+
+    // Unwritten checkpoints are newer than anything in the underlying store.
+    std::map<std::string, PendingCheckpoint> unlisted;
+    {
+      std::unique_lock<std::mutex> lock(m_pendingLock);
+      unlisted = GetUnwrittenCheckpoints();
+    }
+    for (auto it = unlisted.begin(); it != unlisted.end();)
+    {
+      it = it->first.compare(0, prefix.size(), prefix) == 0 ? std::next(it) : unlisted.erase(it);
+    }
+    for (auto& checkpoint : checkpoints)
+    {
+      auto pending = unlisted.find(checkpoint.GetCheckpointBlobName());
+      if (pending != unlisted.end())
+      {
+        checkpoint = pending->second.Checkpoint;
+        unlisted.erase(pending);
+      }
+    }
+    for (auto const& pending : unlisted)
+    {
+      checkpoints.push_back(pending.second.Checkpoint);
+    }
+    return checkpoints;
+  }
+
+  std::vector<Models::Ownership> BufferedCheckpointStore::ListOwnership(
+      std::string const& fullyQualifiedNamespace,
+      std::string const& eventHubName,
+      std::string const& consumerGroup,
+      Core::Context const& context)
+  {
+    return m_checkpointStore->ListOwnership(
+        fullyQualifiedNamespace, eventHubName, consumerGroup, context);
+  }
+
+  void BufferedCheckpointStore::UpdateCheckpoint(
+      Models::Checkpoint const& checkpoint,
+      Core::Context const&)
+  {
+    std::string checkpointName = checkpoint.GetCheckpointBlobName();
+    bool wakeWriter = false;
+    {
+      std::unique_lock<std::mutex> lock(m_pendingLock);
+      auto pending = m_pendingCheckpoints.find(checkpointName);
+      if (pending != m_pendingCheckpoints.end())
+      {
+        // Last writer wins. The lag is measured from the oldest unwritten update.
+        pending->second.Checkpoint = checkpoint;
+        m_metrics.UpdatesCoalesced += 1;
+      }
+      else
+      {
+        m_pendingCheckpoints.emplace(
+            checkpointName, PendingCheckpoint{checkpoint, std::chrono::steady_clock::now()});
+      }
+      m_metrics.UpdatesReceived += 1;
+      m_updatesSinceFlush += 1;
+      wakeWriter = m_options.MaxPendingUpdates != 0
+          && m_updatesSinceFlush == m_options.MaxPendingUpdates;
+    }
+    if (wakeWriter)
+    {
+      m_writerCondition.notify_one();
+    }
+  }
+
+  void BufferedCheckpointStore::Flush(Core::Context const& context)
+  {
+    std::unique_lock<std::mutex> flushLock(m_flushLock);
+
+    // The checkpoints being written stay visible to ListCheckpoints and GetMetrics until they have
+    // been written.
+    {
+      std::unique_lock<std::mutex> lock(m_pendingLock);
+      m_flushingCheckpoints.swap(m_pendingCheckpoints);
+      m_updatesSinceFlush = 0;
+    }
+
+    std::exception_ptr firstError;
+    while (true)
+    {
+      std::string name;
+      PendingCheckpoint checkpoint;
+      {
+        std::unique_lock<std::mutex> lock(m_pendingLock);
+        if (m_flushingCheckpoints.empty())
+        {
+          break;
+        }
+        if (context.IsCancelled())
+        {
+          for (auto const& unwritten : m_flushingCheckpoints)
+          {
+            RetainCheckpoint(unwritten.first, unwritten.second);
+          }
+          m_flushingCheckpoints.clear();
+          if (!firstError)
+          {
+            firstError = std::make_exception_ptr(
+                Core::OperationCancelledException("Checkpoint flush was cancelled."));
+          }
+          break;
+        }
+        name = m_flushingCheckpoints.begin()->first;
+        checkpoint = m_flushingCheckpoints.begin()->second;
+      }
+
+      bool written = false;
+      try
+      {
+        m_checkpointStore->UpdateCheckpoint(checkpoint.Checkpoint, context);
+        written = true;
+      }
+      catch (...)
+      {
+        if (!firstError)
+        {
+          firstError = std::current_exception();
+        }
+      }
+
+      std::unique_lock<std::mutex> lock(m_pendingLock);
+      m_flushingCheckpoints.erase(name);
+      if (written)
+      {
+        m_metrics.CheckpointsWritten += 1;
+      }
+      else
+      {
+        m_metrics.WriteFailures += 1;
+        RetainCheckpoint(name, checkpoint);
+      }
+    }
+
+    if (firstError)
+    {
+      std::rethrow_exception(firstError);
+    }
+  }
+
+  std::map<std::string, BufferedCheckpointStore::PendingCheckpoint>
+  BufferedCheckpointStore::GetUnwrittenCheckpoints() const
+  {
+    std::map<std::string, PendingCheckpoint> checkpoints{m_flushingCheckpoints};
+    for (auto const& pending : m_pendingCheckpoints)
+    {
+      // A pending checkpoint supersedes the one being written, but the lag is measured from the
+      // older of the two.
+      auto checkpoint = checkpoints.emplace(pending.first, pending.second);
+      if (!checkpoint.second)
+      {
+        checkpoint.first->second.Checkpoint = pending.second.Checkpoint;
+        checkpoint.first->second.FirstUpdated
+            = (std::min)(checkpoint.first->second.FirstUpdated, pending.second.FirstUpdated);
+      }
+    }
+    return checkpoints;
+  }
+
+  void BufferedCheckpointStore::RetainCheckpoint(
+      std::string const& name,
+      PendingCheckpoint const& checkpoint)
+  {
+    // Retain the checkpoint for the next flush, unless it has been superseded while it was being
+    // written.
+    auto pending = m_pendingCheckpoints.emplace(name, checkpoint);
+    if (!pending.second)
+    {
+      m_metrics.UpdatesCoalesced += 1;
+      pending.first->second.FirstUpdated
+          = (std::min)(pending.first->second.FirstUpdated, checkpoint.FirstUpdated);
+    }
+  }
+
+  BufferedCheckpointStoreMetrics BufferedCheckpointStore::GetMetrics() const
+  {
+    std::unique_lock<std::mutex> lock(m_pendingLock);
+    BufferedCheckpointStoreMetrics metrics{m_metrics};
+    auto unwritten{GetUnwrittenCheckpoints()};
+    metrics.PendingCheckpoints = unwritten.size();
+
+    auto now = std::chrono::steady_clock::now();
+    for (auto const& pending : unwritten)
+    {
+      metrics.MaxCheckpointLag = (std::max)(
+          metrics.MaxCheckpointLag,
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              now - pending.second.FirstUpdated));
+    }
+    return metrics;
+  }
+}}} // namespace Azure::Messaging::EventHubs
@@ -131,6 +131,11 @@ namespace Azure { namespace Messaging { namespace EventHubs {
       {
         receiverOptions.MaxLinkCredit = options.Prefetch;
       }
+      if (options.MinimumPrefetch > 0)
+      {
+        receiverOptions.MinLinkCredit = options.MinimumPrefetch;
+      }
+      receiverOptions.MaxBufferedBytes = options.MaxPrefetchBytes;
       receiverOptions.Name = receiverName;
       receiverOptions.Properties.emplace("com.microsoft:receiver-name", receiverName);
       if (options.OwnerLevel.HasValue())
@@ -223,6 +228,19 @@ namespace Azure { namespace Messaging { namespace EventHubs {
     }
   }
 
+  Models::PartitionClientMetrics PartitionClient::GetMetrics() const
+  {
+    Models::PartitionClientMetrics metrics;
+#if ENABLE_UAMQP
+    auto receiverMetrics{m_receiver.GetMetrics()};
+    metrics.BufferedEvents = receiverMetrics.BufferedMessages;
+    metrics.BufferedBytes = receiverMetrics.BufferedBytes;
+    metrics.Prefetch = receiverMetrics.LinkCredit;
+    metrics.PrefetchStalls = receiverMetrics.CreditStalls;
+#endif
+    return metrics;
+  }
+
   /** Receive events from the partition.
    *
    * @param maxMessages The maximum number of messages to receive.
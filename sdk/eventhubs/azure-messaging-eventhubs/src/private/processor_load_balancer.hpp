@@ -77,6 +77,7 @@ namespace Azure { namespace Messaging { namespace EventHubs { namespace _detail
     Models::ConsumerClientDetails m_consumerClientDetails;
     Models::ProcessorStrategy m_strategy;
     std::chrono::minutes m_duration;
+    bool m_hasClaimablePartitions{false};
 
     /**@brief  GetAvailablePartitions finds all partitions that are either completely unowned _or_
      * their ownership is stale.
@@ -143,6 +144,7 @@ namespace Azure { namespace Messaging { namespace EventHubs { namespace _detail
         m_consumerClientDetails = other.m_consumerClientDetails;
         m_strategy = other.m_strategy;
         m_duration = other.m_duration;
+        m_hasClaimablePartitions = other.m_hasClaimablePartitions;
       }
       return *this;
     }
@@ -157,5 +159,11 @@ namespace Azure { namespace Messaging { namespace EventHubs { namespace _detail
     std::vector<Models::Ownership> LoadBalance(
         std::vector<std::string> const& partitionIDs,
         Core::Context const& context = {});
+
+    /**@brief HasClaimablePartitions returns true if, after the most recent call to LoadBalance,
+     * this consumer owns fewer partitions than it is allowed and unowned or expired partitions
+     * remain which it did not claim.
+     */
+    bool HasClaimablePartitions() const { return m_hasClaimablePartitions; }
   };
 }}}} // namespace Azure::Messaging::EventHubs::_detail
@@ -10,13 +10,26 @@
 #include <azure/core/diagnostics/logger.hpp>
 #include <azure/core/internal/diagnostics/log.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <future>
 #include <iomanip>
+#include <vector>
 
 using namespace Azure::Core::Diagnostics::_internal;
 using namespace Azure::Core::Diagnostics;
 
 namespace Azure { namespace Messaging { namespace EventHubs {
 
+  namespace {
+    // Delay before the first accelerated load balancing cycle, doubled for each consecutive
+    // accelerated cycle (but never longer than the update interval).
+    constexpr std::chrono::milliseconds AcceleratedLoadBalancingDelay{100};
+    // Maximum number of consecutive accelerated cycles before waiting a full update interval.
+    constexpr int MaximumAcceleratedLoadBalancingCycles{5};
+  } // namespace
+
   Processor::Processor(
       std::shared_ptr<ConsumerClient> consumerClient,
       std::shared_ptr<CheckpointStore> checkpointStore,
@@ -24,7 +37,10 @@ namespace Azure { namespace Messaging { namespace EventHubs {
       : m_defaultStartPositions(options.StartPositions),
         m_maximumNumberOfPartitions{options.MaximumNumberOfPartitions},
         m_checkpointStore(checkpointStore), m_consumerClient(consumerClient),
-        m_prefetch(options.Prefetch), m_nextPartitionClients{}
+        m_prefetch(options.Prefetch), m_nextPartitionClients{},
+        m_maximumConcurrentPartitionStartup{static_cast<size_t>(
+            (std::max)(options.MaximumConcurrentPartitionStartup, static_cast<int32_t>(1)))},
+        m_acceleratedLoadBalancing{options.AcceleratedLoadBalancing}
   {
     m_ownershipUpdateInterval = options.UpdateInterval == Azure::DateTime::duration::zero()
         ? std::chrono::seconds(10)
@@ -57,6 +73,11 @@ namespace Azure { namespace Messaging { namespace EventHubs {
 
   void Processor::Start(Azure::Core::Context const& context)
   {
+    {
+      // The processor must be marked running before its thread checks whether to stop.
+      std::lock_guard<std::mutex> lock(m_stopLock);
+      m_isRunning = true;
+    }
     m_processorThread = std::thread([this, context]() {
       try
       {
@@ -68,14 +89,17 @@ namespace Azure { namespace Messaging { namespace EventHubs {
         Log::Stream(Logger::Level::Warning) << "Exception caught running processor: " << ex.what();
       }
     });
-    m_isRunning = true;
   }
 
   // Stop the running processor, waiting for the processor to terminate.
   void Processor::Stop()
   {
     Log::Stream(Logger::Level::Verbose) << "Stop processor.";
-    m_isRunning = false;
+    {
+      std::lock_guard<std::mutex> lock(m_stopLock);
+      m_isRunning = false;
+    }
+    m_stopCondition.notify_all();
 
     if (m_processorThread.joinable())
     {
@@ -102,18 +126,40 @@ namespace Azure { namespace Messaging { namespace EventHubs {
 
     try
     {
+      int acceleratedCycles = 0;
       // If this is a public invocation (the caller directly called "Run"), then we want to ignore
       // the m_isRunning boolean.
       while (!context.IsCancelled() && (publicInvocation ? true : m_isRunning))
       {
         Dispatch(eventHubProperties, consumers, context);
 
+        // While partitions remain to be claimed, load balance again after a short, growing delay
+        // rather than a full update interval. The number of consecutive accelerated cycles is
+        // bounded so that processors competing for the same partitions don't hammer the
+        // checkpoint store.
+        if (m_acceleratedLoadBalancing && acceleratedCycles < MaximumAcceleratedLoadBalancingCycles
+            && m_loadBalancer->HasClaimablePartitions())
+        {
+          auto delay = (std::min)(
+              std::chrono::duration_cast<Azure::DateTime::duration>(
+                  AcceleratedLoadBalancingDelay * (1 << acceleratedCycles)),
+              m_ownershipUpdateInterval);
+          acceleratedCycles += 1;
+          Log::Stream(Logger::Level::Verbose)
+              << "Partitions remain to be claimed, load balancing again in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(delay).count()
+              << " milliseconds.";
+          WaitForNextCycle(delay, context, publicInvocation);
+          continue;
+        }
+        acceleratedCycles = 0;
+
         Log::Stream(Logger::Level::Verbose)
             << "Processor Sleeping for "
             << std::chrono::duration_cast<std::chrono::milliseconds>(m_ownershipUpdateInterval)
                    .count()
             << "  milliseconds. ";
-        std::this_thread::sleep_for(m_ownershipUpdateInterval);
+        WaitForNextCycle(m_ownershipUpdateInterval, context, publicInvocation);
       }
     }
     catch (std::exception& ex)
@@ -122,6 +168,30 @@ namespace Azure { namespace Messaging { namespace EventHubs {
     }
   }
 
+  void Processor::WaitForNextCycle(
+      Azure::DateTime::duration delay,
+      Core::Context const& context,
+      bool publicInvocation)
+  {
+    auto wakeTime = std::chrono::system_clock::now()
+        + std::chrono::duration_cast<std::chrono::system_clock::duration>(delay);
+    // A context cannot be waited on, so a context cancelled during the wait is only noticed by
+    // the next cycle.
+    auto const deadline = context.GetDeadline();
+    if (deadline != (Azure::DateTime::max)())
+    {
+      // A cancelled context's deadline cannot be converted to a time point.
+      if (context.IsCancelled())
+      {
+        return;
+      }
+      wakeTime = (std::min)(wakeTime, static_cast<std::chrono::system_clock::time_point>(deadline));
+    }
+    std::unique_lock<std::mutex> lock(m_stopLock);
+    m_stopCondition.wait_until(
+        lock, wakeTime, [this, publicInvocation]() { return !publicInvocation && !m_isRunning; });
+  }
+
   void Processor::Dispatch(
       Models::EventHubProperties const& eventHubProperties,
       std::shared_ptr<Processor::ConsumersType> consumers,
@@ -130,11 +200,67 @@ namespace Azure { namespace Messaging { namespace EventHubs {
     std::vector<Models::Ownership> ownerships
         = m_loadBalancer->LoadBalance(eventHubProperties.PartitionIds, context);
 
-    std::map<std::string, Models::Checkpoint> checkpoints = GetCheckpointsMap(context);
+    std::map<std::string, Models::Checkpoint> const checkpoints = GetCheckpointsMap(context);
+
+    // Only partitions without an active processor partition client need a new link.
+    std::vector<Models::Ownership> newOwnerships;
+    {
+      std::lock_guard<std::mutex> lock(consumers->Lock);
+      for (auto const& ownership : ownerships)
+      {
+        if (consumers->Clients.find(ownership.PartitionId) == consumers->Clients.end())
+        {
+          newOwnerships.push_back(ownership);
+        }
+      }
+    }
+
+    size_t workerCount = (std::min)(m_maximumConcurrentPartitionStartup, newOwnerships.size());
+    if (workerCount <= 1)
+    {
+      for (auto const& ownership : newOwnerships)
+      {
+        AddPartitionClient(ownership, checkpoints, consumers, context);
+      }
+      return;
+    }
 
-    for (auto const& ownership : ownerships)
+    // Opening a partition link takes several round trips to the service, so open the links for
+    // newly claimed partitions concurrently.
+    std::atomic<size_t> nextOwnership{0};
+    std::vector<std::future<void>> workers;
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; i += 1)
+    {
+      workers.push_back(std::async(std::launch::async, [&]() {
+        for (size_t index = nextOwnership++; index < newOwnerships.size();
+             index = nextOwnership++)
+        {
+          AddPartitionClient(newOwnerships[index], checkpoints, consumers, context);
+        }
+      }));
+    }
+
+    // Wait for every worker before reporting a failure, the workers reference locals of this
+    // function.
+    std::exception_ptr firstError;
+    for (auto& worker : workers)
+    {
+      try
+      {
+        worker.get();
+      }
+      catch (...)
+      {
+        if (!firstError)
+        {
+          firstError = std::current_exception();
+        }
+      }
+    }
+    if (firstError)
     {
-      AddPartitionClient(ownership, checkpoints, consumers, context);
+      std::rethrow_exception(firstError);
     }
   }
 
@@ -158,7 +284,7 @@ namespace Azure { namespace Messaging { namespace EventHubs {
 
   void Processor::AddPartitionClient(
       Models::Ownership const& ownership,
-      std::map<std::string, Models::Checkpoint>& checkpoints,
+      std::map<std::string, Models::Checkpoint> const& checkpoints,
       std::weak_ptr<ConsumersType> consumers,
       Core::Context const& context)
   {
@@ -172,7 +298,8 @@ namespace Azure { namespace Messaging { namespace EventHubs {
             [consumers, ownership]() {
               if (auto strongConsumers = consumers.lock())
               {
-                strongConsumers->erase(ownership.PartitionId);
+                std::lock_guard<std::mutex> lock(strongConsumers->Lock);
+                strongConsumers->Clients.erase(ownership.PartitionId);
               }
             }));
 
@@ -180,7 +307,9 @@ namespace Azure { namespace Messaging { namespace EventHubs {
     // created in favor of the existing processor partition client.
     if (auto strongConsumers = consumers.lock())
     {
-      auto added = strongConsumers->emplace(ownership.PartitionId, processorPartitionClient);
+      std::lock_guard<std::mutex> lock(strongConsumers->Lock);
+      auto added
+          = strongConsumers->Clients.emplace(ownership.PartitionId, processorPartitionClient);
       if (!added.second)
       {
         Log::Stream(Logger::Level::Verbose)
@@ -9,6 +9,7 @@
 #include <azure/core/diagnostics/logger.hpp>
 #include <azure/core/internal/diagnostics/log.hpp>
 
+#include <algorithm>
 #include <iomanip>
 #include <set>
 #include <stdexcept>
@@ -274,5 +275,24 @@ std::vector<Ownership> ProcessorLoadBalancer::LoadBalance(
       << "[" << m_consumerClientDetails.ClientId << "] Asked for "
       << partitionsForOwnerships(ownerships) << ", got " << partitionsForOwnerships(actual);
 
+  // The balanced strategy claims at most one unowned partition per cycle, and claims can be lost
+  // to other consumers, so remember whether there is more work for the next cycle.
+  size_t claimedUnowned = 0;
+  for (auto const& ownership : actual)
+  {
+    if (std::find_if(
+            loadBalancerInfo.UnownedOrExpired.begin(),
+            loadBalancerInfo.UnownedOrExpired.end(),
+            [&ownership](Models::Ownership const& unowned) {
+              return unowned.PartitionId == ownership.PartitionId;
+            })
+        != loadBalancerInfo.UnownedOrExpired.end())
+    {
+      claimedUnowned += 1;
+    }
+  }
+  m_hasClaimablePartitions = claimMore && actual.size() < loadBalancerInfo.MaxAllowed
+      && loadBalancerInfo.UnownedOrExpired.size() > claimedUnowned;
+
   return actual;
 }
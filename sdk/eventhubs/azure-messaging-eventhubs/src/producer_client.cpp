@@ -15,6 +15,7 @@
 #include <azure/core/internal/diagnostics/log.hpp>
 
 #include <stdexcept>
+#include <tuple>
 
 using namespace Azure::Core::Diagnostics::_internal;
 using namespace Azure::Core::Diagnostics;
@@ -184,6 +185,79 @@ namespace Azure { namespace Messaging { namespace EventHubs {
     Send(batch, context);
   }
 
+  void ProducerClient::Send(
+      std::vector<EventDataBatch> const& eventDataBatches,
+      Core::Context const& context)
+  {
+#if ENABLE_UAMQP
+    // Start sending every batch before waiting for any of them, the message senders bound the
+    // number of batches in flight on each partition.
+    std::vector<Azure::Core::Amqp::_internal::MessageSendCompletion> completions;
+    completions.reserve(eventDataBatches.size());
+    try
+    {
+      for (auto const& batch : eventDataBatches)
+      {
+        EnsureSender(batch.GetPartitionId(), context);
+        completions.push_back(
+            GetSender(batch.GetPartitionId()).SendAsync(batch.ToAmqpMessage(), context));
+      }
+    }
+    catch (...)
+    {
+      // The batches which were already started cannot be recalled, so wait for them to settle
+      // before reporting the failure to start the others. Their outcome is logged only.
+      for (auto const& completion : completions)
+      {
+        auto result = completion.Wait();
+        if (std::get<0>(result) != Azure::Core::Amqp::_internal::MessageSendStatus::Ok)
+        {
+          Log::Stream(Logger::Level::Warning)
+              << "Pipelined send of batch failed: " << std::get<0>(result) << ": "
+              << std::get<1>(result);
+        }
+      }
+      throw;
+    }
+
+    // Wait for every batch to settle before reporting a failure, so that no send is still in
+    // flight when this returns. A failed batch is not retried here: a send which timed out or
+    // failed may still have been stored by the service, and retrying it would duplicate its events.
+    // Cancellation takes precedence over other failures.
+    using Azure::Core::Amqp::_internal::MessageSendStatus;
+    auto failure{std::make_tuple(
+        MessageSendStatus::Ok, Azure::Core::Amqp::Models::_internal::AmqpError{})};
+    for (auto const& completion : completions)
+    {
+      auto result = completion.Wait(context);
+      if (std::get<0>(result) != MessageSendStatus::Ok)
+      {
+        Log::Stream(Logger::Level::Warning) << "Pipelined send of batch failed: "
+                                            << std::get<0>(result) << ": " << std::get<1>(result);
+        if (std::get<0>(failure) == MessageSendStatus::Ok
+            || std::get<0>(result) == MessageSendStatus::Cancelled)
+        {
+          failure = result;
+        }
+      }
+    }
+    if (std::get<0>(failure) == MessageSendStatus::Cancelled)
+    {
+      throw Azure::Core::OperationCancelledException("Event Hubs batch send was cancelled.");
+    }
+    if (std::get<0>(failure) != MessageSendStatus::Ok)
+    {
+      throw Azure::Messaging::EventHubs::_detail::EventHubsExceptionFactory::
+          CreateEventHubsException(std::get<1>(failure));
+    }
+#elif ENABLE_RUST_AMQP
+    for (auto const& batch : eventDataBatches)
+    {
+      Send(batch, context);
+    }
+#endif
+  }
+
   Azure::Core::Amqp::_internal::Connection ProducerClient::CreateConnection(
       Azure::Core::Context const& context) const
   {
@@ -259,6 +333,7 @@ namespace Azure { namespace Messaging { namespace EventHubs {
       senderOptions.Name = m_producerClientOptions.Name;
       senderOptions.EnableTrace = _detail::EnableAmqpTrace;
       senderOptions.MaxMessageSize = m_producerClientOptions.MaxMessageSize;
+      senderOptions.MaxOutstandingSends = m_producerClientOptions.MaxOutstandingSends;
 
       Azure::Core::Amqp::_internal::MessageSender sender
           = GetSession(partitionId).CreateMessageSender(targetUrl, senderOptions);
@@ -0,0 +1,207 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Common infrastructure for the Event Hubs tests which run against an in-process broker.
+ *
+ */
+
+#pragma once
+
+#include "azure/messaging/eventhubs/test/mock_eventhubs_broker.hpp"
+
+#include <azure/messaging/eventhubs/models/event_data.hpp>
+#include <azure/perf.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if ENABLE_UAMQP
+
+namespace Azure { namespace Messaging { namespace EventHubs { namespace PerfTest {
+  namespace LocalBroker {
+
+    /**
+     * @brief Base class for tests which measure the Event Hubs client stack against a
+     * MockEventHubsBroker listening on loopback, so the results are not affected by the network or
+     * by service throttling.
+     *
+     * A single broker is shared by every parallel instance of the test. Each instance works on
+     * one partition, instances being assigned to partitions in turn. Besides the operation rate
+     * reported by the perf framework, the test reports the event and byte rates and the latency
+     * percentiles of the measured operation when the test completes. These include the warm-up.
+     */
+    class LocalBrokerTest : public Azure::Perf::PerfTest {
+    protected:
+      std::uint32_t m_batchSize{};
+      std::uint32_t m_partitionCount{};
+      std::uint32_t m_messageSize{};
+      std::string m_partitionId;
+
+      /**
+       * @brief Construct a new local broker performance test.
+       *
+       * @param options The test options.
+       * @param operationName The name of the measured operation, used when reporting latency.
+       */
+      LocalBrokerTest(Azure::Perf::TestOptions options, std::string const& operationName)
+          : PerfTest(options), m_operationName{operationName}
+      {
+      }
+
+      /// @brief The broker shared by the parallel instances of the test.
+      static std::unique_ptr<MockEventHubsBroker>& GetBroker()
+      {
+        static std::unique_ptr<MockEventHubsBroker> broker;
+        return broker;
+      }
+
+      /// @brief Adjust the broker options before the broker is started.
+      virtual void ConfigureBroker(MockEventHubsBrokerOptions&) {}
+
+      /**
+       * @brief Record one measured operation.
+       *
+       * @param events The number of events sent or received by the operation.
+       * @param bytes The number of body bytes sent or received by the operation.
+       * @param start The time at which the operation started.
+       */
+      void RecordOperation(
+          std::size_t events,
+          std::size_t bytes,
+          std::chrono::steady_clock::time_point start)
+      {
+        auto end = std::chrono::steady_clock::now();
+        Statistics& statistics = GetStatistics();
+        statistics.Latency.Record(m_operationName, end - start);
+        statistics.Events += events;
+        statistics.Bytes += bytes;
+
+        std::int64_t startTime = start.time_since_epoch().count();
+        std::int64_t firstStart = statistics.FirstStart;
+        while ((firstStart == 0 || startTime < firstStart)
+               && !statistics.FirstStart.compare_exchange_weak(firstStart, startTime))
+        {
+        }
+        std::int64_t endTime = end.time_since_epoch().count();
+        std::int64_t lastEnd = statistics.LastEnd;
+        while (endTime > lastEnd && !statistics.LastEnd.compare_exchange_weak(lastEnd, endTime))
+        {
+        }
+      }
+
+      /// @brief Create an event with a body of MessageSize bytes.
+      Models::EventData CreateEvent() const
+      {
+        return Models::EventData{std::vector<uint8_t>(m_messageSize, 'a')};
+      }
+
+    public:
+      void GlobalSetup() override
+      {
+        ReadOptions();
+        MockEventHubsBrokerOptions brokerOptions;
+        brokerOptions.PartitionCount = m_partitionCount;
+        ConfigureBroker(brokerOptions);
+        GetBroker() = std::make_unique<MockEventHubsBroker>(brokerOptions);
+        GetBroker()->Start();
+        std::cout << "Event Hubs broker listening on port " << GetBroker()->GetPort() << std::endl;
+      }
+
+      void Setup() override
+      {
+        ReadOptions();
+        static std::atomic<std::uint32_t> instanceCount{0};
+        m_partitionId = std::to_string(instanceCount++ % m_partitionCount);
+      }
+
+      void GlobalCleanup() override
+      {
+        Statistics& statistics = GetStatistics();
+        double seconds
+            = std::chrono::duration<double>(
+                  std::chrono::steady_clock::duration(statistics.LastEnd - statistics.FirstStart))
+                  .count();
+        auto latency = statistics.Latency.Summarize();
+
+        std::cout << std::endl
+                  << "=== " << m_operationName << " against local broker ===" << std::endl
+                  << "Batch size: " << m_batchSize << ", partitions: " << m_partitionCount
+                  << ", message size: " << m_messageSize << " bytes" << std::endl;
+        if (seconds > 0)
+        {
+          std::cout << std::fixed << std::setprecision(2)
+                    << "Events/sec: " << static_cast<double>(statistics.Events) / seconds
+                    << std::endl
+                    << "MB/sec: " << static_cast<double>(statistics.Bytes) / seconds / 1048576
+                    << std::endl;
+        }
+        std::cout << std::fixed << std::setprecision(3) << m_operationName
+                  << " latency (ms): count=" << latency.Count << " mean=" << latency.MeanMs
+                  << " p50=" << latency.P50Ms << " p90=" << latency.P90Ms
+                  << " p99=" << latency.P99Ms << " p99.9=" << latency.P999Ms
+                  << " max=" << latency.P100Ms << std::endl;
+
+        GetBroker().reset();
+      }
+
+      std::vector<Azure::Perf::TestOption> GetTestOptions() override
+      {
+        return {
+            {"BatchSize",
+             {"--batchSize"},
+             "The number of events sent or received by each operation.",
+             1,
+             false},
+            {"PartitionCount",
+             {"--partitionCount"},
+             "The number of partitions in the Event Hub, instances are spread across them.",
+             1,
+             false},
+            {"MessageSize",
+             {"--messageSize"},
+             "The number of bytes in the body of each event.",
+             1,
+             false}};
+      }
+
+    private:
+      struct Statistics
+      {
+        Azure::Perf::LatencyCollector Latency;
+        std::atomic<std::uint64_t> Events{0};
+        std::atomic<std::uint64_t> Bytes{0};
+        std::atomic<std::int64_t> FirstStart{0};
+        std::atomic<std::int64_t> LastEnd{0};
+      };
+
+      static Statistics& GetStatistics()
+      {
+        static Statistics statistics;
+        return statistics;
+      }
+
+      void ReadOptions()
+      {
+        m_batchSize = m_options.GetOptionOrDefault<std::uint32_t>("BatchSize", 100);
+        m_partitionCount = m_options.GetOptionOrDefault<std::uint32_t>("PartitionCount", 1);
+        m_messageSize = m_options.GetOptionOrDefault<std::uint32_t>("MessageSize", 1024);
+        if (m_partitionCount == 0)
+        {
+          m_partitionCount = 1;
+        }
+      }
+
+      std::string m_operationName;
+    };
+  } // namespace LocalBroker
+}}}} // namespace Azure::Messaging::EventHubs::PerfTest
+
+#endif // ENABLE_UAMQP
@@ -0,0 +1,159 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test receiving events from an in-process broker.
+ *
+ */
+
+#pragma once
+
+#include "azure/messaging/eventhubs/test/eventhubs_local_broker_perf_test.hpp"
+
+#include <azure/messaging/eventhubs/consumer_client.hpp>
+#include <azure/messaging/eventhubs/producer_client.hpp>
+#include <azure/perf.hpp>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if ENABLE_UAMQP
+
+namespace Azure { namespace Messaging { namespace EventHubs { namespace PerfTest {
+  namespace LocalBroker {
+
+    /**
+     * @brief A test to measure the throughput and latency of PartitionClient::ReceiveEvents.
+     *
+     * Each partition is filled with PrefillCount events before the test starts. The broker replays
+     * the partition once a consumer has received every event, so each operation receives up to
+     * BatchSize events however long the test runs.
+     */
+    class ReceiveTest : public LocalBrokerTest {
+    private:
+      std::uint32_t m_prefillCount{};
+      std::int32_t m_prefetch{};
+      std::unique_ptr<Azure::Messaging::EventHubs::ConsumerClient> m_client;
+      std::unique_ptr<Azure::Messaging::EventHubs::PartitionClient> m_partitionClient;
+
+    protected:
+      void ConfigureBroker(MockEventHubsBrokerOptions& options) override
+      {
+        options.ReplayEvents = true;
+      }
+
+    public:
+      /**
+       * @brief Construct a new local broker receive test.
+       *
+       * @param options The test options.
+       */
+      ReceiveTest(Azure::Perf::TestOptions options) : LocalBrokerTest(options, "ReceiveEvents") {}
+
+      void GlobalSetup() override
+      {
+        LocalBrokerTest::GlobalSetup();
+        m_prefillCount = m_options.GetOptionOrDefault<std::uint32_t>("PrefillCount", 10000);
+
+        ProducerClient producer{
+            GetBroker()->GetConnectionString(), GetBroker()->GetEventHubName()};
+        Models::EventData event{CreateEvent()};
+        for (std::uint32_t partition = 0; partition < m_partitionCount; partition += 1)
+        {
+          EventDataBatchOptions batchOptions;
+          batchOptions.PartitionId = std::to_string(partition);
+          std::uint32_t remaining = m_prefillCount;
+          while (remaining != 0)
+          {
+            EventDataBatch batch{producer.CreateBatch(batchOptions)};
+            while (remaining != 0 && batch.TryAdd(event))
+            {
+              remaining -= 1;
+            }
+            if (batch.NumberOfEvents() == 0)
+            {
+              throw std::runtime_error("Could not add event to batch, reduce MessageSize.");
+            }
+            producer.Send(batch);
+          }
+        }
+        producer.Close();
+      }
+
+      void Setup() override
+      {
+        LocalBrokerTest::Setup();
+        m_prefetch = m_options.GetOptionOrDefault<std::int32_t>("Prefetch", 300);
+
+        m_client = std::make_unique<Azure::Messaging::EventHubs::ConsumerClient>(
+            GetBroker()->GetConnectionString(), GetBroker()->GetEventHubName());
+        PartitionClientOptions partitionOptions;
+        partitionOptions.StartPosition.Earliest = true;
+        partitionOptions.Prefetch = m_prefetch;
+        m_partitionClient = std::make_unique<Azure::Messaging::EventHubs::PartitionClient>(
+            m_client->CreatePartitionClient(m_partitionId, partitionOptions));
+      }
+
+      void Run(Azure::Core::Context const& context) override
+      {
+        auto start = std::chrono::steady_clock::now();
+        auto events = m_partitionClient->ReceiveEvents(m_batchSize, context);
+
+        std::size_t bytes = 0;
+        for (auto const& event : events)
+        {
+          bytes += event->Body.size();
+        }
+        RecordOperation(events.size(), bytes, start);
+      }
+
+      void Cleanup() override
+      {
+        m_partitionClient->Close({});
+        m_partitionClient.reset();
+        m_client->Close({});
+        m_client.reset();
+      }
+
+      std::vector<Azure::Perf::TestOption> GetTestOptions() override
+      {
+        auto options = LocalBrokerTest::GetTestOptions();
+        options.push_back(
+            {"PrefillCount",
+             {"--prefillCount"},
+             "The number of events sent to each partition before the test starts.",
+             1,
+             false});
+        options.push_back(
+            {"Prefetch",
+             {"--prefetch"},
+             "The prefetch count of the partition clients. Negative numbers disable prefetch.",
+             1,
+             false});
+        return options;
+      }
+
+      /**
+       * @brief Get the static Test Metadata for the test.
+       *
+       * @return Azure::Perf::TestMetadata describing the test.
+       */
+      static Azure::Perf::TestMetadata GetTestMetadata()
+      {
+        return {
+            "LocalBrokerReceive",
+            "Receive events from an in-process Event Hubs broker",
+            [](Azure::Perf::TestOptions options) {
+              return std::make_unique<
+                  Azure::Messaging::EventHubs::PerfTest::LocalBroker::ReceiveTest>(options);
+            }};
+      }
+    };
+  } // namespace LocalBroker
+}}}} // namespace Azure::Messaging::EventHubs::PerfTest
+
+#endif // ENABLE_UAMQP
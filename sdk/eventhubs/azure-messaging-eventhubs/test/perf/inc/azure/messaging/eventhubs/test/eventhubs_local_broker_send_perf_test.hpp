@@ -0,0 +1,98 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test sending batches to an in-process broker.
+ *
+ */
+
+#pragma once
+
+#include "azure/messaging/eventhubs/test/eventhubs_local_broker_perf_test.hpp"
+
+#include <azure/messaging/eventhubs/producer_client.hpp>
+#include <azure/perf.hpp>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#if ENABLE_UAMQP
+
+namespace Azure { namespace Messaging { namespace EventHubs { namespace PerfTest {
+  namespace LocalBroker {
+
+    /**
+     * @brief A test to measure the throughput and latency of ProducerClient::Send.
+     *
+     * Each operation sends a batch of BatchSize events to the partition of the test instance.
+     */
+    class SendTest : public LocalBrokerTest {
+    private:
+      std::unique_ptr<Azure::Messaging::EventHubs::ProducerClient> m_client;
+
+    public:
+      /**
+       * @brief Construct a new local broker send test.
+       *
+       * @param options The test options.
+       */
+      SendTest(Azure::Perf::TestOptions options) : LocalBrokerTest(options, "Send") {}
+
+      void Setup() override
+      {
+        LocalBrokerTest::Setup();
+        m_client = std::make_unique<Azure::Messaging::EventHubs::ProducerClient>(
+            GetBroker()->GetConnectionString(), GetBroker()->GetEventHubName());
+
+        // Establish the connection before the test starts.
+        (void)m_client->GetEventHubProperties();
+      }
+
+      void Run(Azure::Core::Context const& context) override
+      {
+        EventDataBatchOptions batchOptions;
+        batchOptions.PartitionId = m_partitionId;
+        EventDataBatch batch{m_client->CreateBatch(batchOptions, context)};
+        Models::EventData event{CreateEvent()};
+        for (std::uint32_t i = 0; i < m_batchSize; i += 1)
+        {
+          if (!batch.TryAdd(event))
+          {
+            throw std::runtime_error("Could not add event to batch, reduce BatchSize.");
+          }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        m_client->Send(batch, context);
+        RecordOperation(m_batchSize, static_cast<std::size_t>(m_batchSize) * m_messageSize, start);
+      }
+
+      void Cleanup() override
+      {
+        m_client->Close();
+        m_client.reset();
+      }
+
+      /**
+       * @brief Get the static Test Metadata for the test.
+       *
+       * @return Azure::Perf::TestMetadata describing the test.
+       */
+      static Azure::Perf::TestMetadata GetTestMetadata()
+      {
+        return {
+            "LocalBrokerSend",
+            "Send event batches to an in-process Event Hubs broker",
+            [](Azure::Perf::TestOptions options) {
+              return std::make_unique<
+                  Azure::Messaging::EventHubs::PerfTest::LocalBroker::SendTest>(options);
+            }};
+      }
+    };
+  } // namespace LocalBroker
+}}}} // namespace Azure::Messaging::EventHubs::PerfTest
+
+#endif // ENABLE_UAMQP
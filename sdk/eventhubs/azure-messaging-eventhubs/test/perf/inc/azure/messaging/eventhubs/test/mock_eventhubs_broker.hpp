@@ -0,0 +1,815 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief An in-process AMQP broker which emulates the parts of the Event Hubs service used by the
+ * producer and consumer clients.
+ *
+ */
+
+#pragma once
+
+#include "message_listener_events.hpp"
+
+#include <azure/core/amqp/internal/connection.hpp>
+#include <azure/core/amqp/internal/message_receiver.hpp>
+#include <azure/core/amqp/internal/message_sender.hpp>
+#include <azure/core/amqp/internal/models/message_source.hpp>
+#include <azure/core/amqp/internal/models/message_target.hpp>
+#include <azure/core/amqp/internal/models/messaging_values.hpp>
+#include <azure/core/amqp/internal/network/amqp_header_detect_transport.hpp>
+#include <azure/core/amqp/internal/network/socket_listener.hpp>
+#include <azure/core/amqp/internal/session.hpp>
+#include <azure/core/amqp/models/amqp_message.hpp>
+#include <azure/core/context.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#if ENABLE_UAMQP
+
+namespace Azure { namespace Messaging { namespace EventHubs { namespace PerfTest {
+
+  /**
+   * @brief Options used to configure a MockEventHubsBroker.
+   *
+   */
+  struct MockEventHubsBrokerOptions final
+  {
+    /// @brief The name of the Event Hub served by the broker.
+    std::string EventHubName{"eventhub"};
+
+    /// @brief The number of partitions in the Event Hub.
+    std::uint32_t PartitionCount{1};
+
+    /// @brief The maximum number of events retained in each partition. Older events are discarded.
+    std::size_t MaxRetainedEvents{100000};
+
+    /**
+     * @brief If true, a consumer which has received every retained event starts again from the
+     * oldest retained event instead of waiting for new events.
+     *
+     * This lets a receive benchmark run for as long as needed without an equally long send phase.
+     */
+    bool ReplayEvents{false};
+
+    /// @brief The maximum number of unsettled events sent to each consumer link.
+    std::uint32_t ConsumerWindow{300};
+  };
+
+  /**
+   * @brief An in-process Event Hubs broker.
+   *
+   * The broker listens on a loopback port and accepts plain AMQP connections from the
+   * ProducerClient and ConsumerClient, using a connection string with `UseDevelopmentEmulator=true`
+   * (see GetConnectionString). It accepts any CBS token, answers the Event Hub and partition
+   * property management requests, stores sent events per partition and streams them to consumers
+   * with Event Hubs sequence number, offset and enqueued time annotations.
+   *
+   * @remark The broker is intended for benchmarks of the client stack: it does not authenticate
+   * tokens, and the only start position filters it understands are the ones generated by
+   * PartitionClient.
+   */
+  class MockEventHubsBroker final
+      : public Azure::Core::Amqp::Tests::MessageTests::MessageListenerEvents {
+  public:
+    explicit MockEventHubsBroker(MockEventHubsBrokerOptions const& options = {})
+        : m_options{options}, m_partitions(options.PartitionCount == 0 ? 1 : options.PartitionCount)
+    {
+    }
+
+    ~MockEventHubsBroker() { Stop(); }
+
+    MockEventHubsBroker(MockEventHubsBroker const&) = delete;
+    MockEventHubsBroker& operator=(MockEventHubsBroker const&) = delete;
+
+    /**
+     * @brief Start listening on an available loopback port.
+     */
+    void Start()
+    {
+      std::random_device random;
+      for (int attempt = 0; attempt < 20 && !m_listener; attempt += 1)
+      {
+        std::uint16_t port;
+        do
+        {
+          port = static_cast<std::uint16_t>(random() % 1000 + 0xBFFF);
+        } while (port == Azure::Core::Amqp::_internal::AmqpTlsPort);
+
+        auto listener = std::make_unique<Azure::Core::Amqp::Network::_detail::SocketListener>(
+            port, this);
+        try
+        {
+          listener->Start();
+          m_listener = std::move(listener);
+          m_port = port;
+        }
+        catch (std::runtime_error const&)
+        {
+          // The port is in use, try another one.
+        }
+      }
+      if (!m_listener)
+      {
+        throw std::runtime_error("Could not find an available port for the Event Hubs broker.");
+      }
+
+      m_listenerThread = std::thread([this]() {
+        while (!m_context.IsCancelled())
+        {
+          m_listener->Poll();
+          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+      });
+      m_requestThread = std::thread([this]() { ProcessRequests(); });
+    }
+
+    /**
+     * @brief Stop the broker, closing every link, session and connection.
+     */
+    void Stop()
+    {
+      if (!m_listener)
+      {
+        return;
+      }
+      m_context.Cancel();
+      {
+        std::unique_lock<std::mutex> lock(m_requestLock);
+        m_requestCondition.notify_all();
+      }
+      for (auto& partition : m_partitions)
+      {
+        std::unique_lock<std::mutex> lock(partition.Lock);
+        partition.EventAdded.notify_all();
+      }
+      if (m_listenerThread.joinable())
+      {
+        m_listenerThread.join();
+      }
+      if (m_requestThread.joinable())
+      {
+        m_requestThread.join();
+      }
+
+      std::unique_lock<std::mutex> lock(m_sessionsLock);
+      for (auto& session : m_sessions)
+      {
+        for (auto& consumer : session->Consumers)
+        {
+          if (consumer->Pump.joinable())
+          {
+            consumer->Pump.join();
+          }
+          consumer->Sender->Close();
+        }
+        for (auto& sender : session->ReplySenders)
+        {
+          sender.second->Close();
+        }
+        for (auto& receiver : session->Receivers)
+        {
+          receiver.second.Receiver->Close();
+        }
+        session->AmqpSession->End({});
+      }
+      m_sessions.clear();
+      for (auto& connection : m_connections)
+      {
+        Close(*connection, {});
+      }
+      m_connections.clear();
+      m_listener->Stop();
+      m_listener.reset();
+    }
+
+    /// @brief The loopback port on which the broker is listening.
+    std::uint16_t GetPort() const { return m_port; }
+
+    /// @brief The name of the Event Hub served by the broker.
+    std::string const& GetEventHubName() const { return m_options.EventHubName; }
+
+    /// @brief A connection string which connects the Event Hubs clients to this broker.
+    std::string GetConnectionString() const
+    {
+      return "Endpoint=sb://localhost:" + std::to_string(m_port)
+          + ";SharedAccessKeyName=MockBroker;SharedAccessKey=MockBrokerKey;"
+            "UseDevelopmentEmulator=true";
+    }
+
+    /// @brief The number of events stored in every partition since the broker started.
+    std::uint64_t GetEventsReceived() const { return m_eventsReceived; }
+
+    /// @brief The number of events sent to consumers since the broker started.
+    std::uint64_t GetEventsDelivered() const { return m_eventsDelivered; }
+
+  private:
+    struct Partition
+    {
+      std::mutex Lock;
+      std::condition_variable EventAdded;
+      // Events[0] has sequence number FirstSequenceNumber.
+      std::deque<std::shared_ptr<Azure::Core::Amqp::Models::AmqpMessage const>> Events;
+      std::int64_t FirstSequenceNumber{};
+      std::int64_t LastEnqueuedTime{};
+    };
+
+    struct ConsumerLink
+    {
+      std::unique_ptr<Azure::Core::Amqp::_internal::MessageSender> Sender;
+      std::size_t PartitionIndex{};
+      std::int64_t NextSequenceNumber{};
+      std::atomic<bool> Detached{false};
+      std::thread Pump;
+    };
+
+    class BrokerSession;
+
+    struct LinkReceiver
+    {
+      std::unique_ptr<Azure::Core::Amqp::_internal::MessageReceiver> Receiver;
+      // Either "$cbs", "$management", or empty for an event link.
+      std::string Node;
+      std::size_t PartitionIndex{};
+      bool RoundRobin{false};
+    };
+
+    struct Request
+    {
+      BrokerSession* Session;
+      std::string Node;
+      std::shared_ptr<Azure::Core::Amqp::Models::AmqpMessage> Message;
+    };
+
+    // The incoming session which owns a set of links. The CBS and management reply links are
+    // specific to the session on which the request links were attached.
+    class BrokerSession final : public Azure::Core::Amqp::_internal::SessionEvents,
+                                public Azure::Core::Amqp::_internal::MessageReceiverEvents,
+                                public Azure::Core::Amqp::_internal::MessageSenderEvents {
+    public:
+      explicit BrokerSession(MockEventHubsBroker* broker) : Broker{broker} {}
+
+      MockEventHubsBroker* Broker;
+      std::unique_ptr<Azure::Core::Amqp::_internal::Session> AmqpSession;
+
+      std::mutex Lock;
+      std::map<std::string, LinkReceiver> Receivers;
+      std::map<std::string, std::unique_ptr<Azure::Core::Amqp::_internal::MessageSender>>
+          ReplySenders;
+      std::list<std::unique_ptr<ConsumerLink>> Consumers;
+
+      bool OnLinkAttached(
+          Azure::Core::Amqp::_internal::Session const& session,
+          Azure::Core::Amqp::_internal::LinkEndpoint& newLink,
+          std::string const& name,
+          Azure::Core::Amqp::_internal::SessionRole role,
+          Azure::Core::Amqp::Models::AmqpValue const& source,
+          Azure::Core::Amqp::Models::AmqpValue const& target,
+          Azure::Core::Amqp::Models::AmqpValue const&) override
+      {
+        return Broker->AttachLink(*this, session, newLink, name, role, source, target);
+      }
+
+      Azure::Core::Amqp::Models::AmqpValue OnMessageReceived(
+          Azure::Core::Amqp::_internal::MessageReceiver const& receiver,
+          std::shared_ptr<Azure::Core::Amqp::Models::AmqpMessage> const& message) override
+      {
+        Broker->MessageReceived(*this, receiver.GetLinkName(), message);
+        return Azure::Core::Amqp::Models::_internal::Messaging::DeliveryAccepted();
+      }
+
+      void OnMessageReceiverStateChanged(
+          Azure::Core::Amqp::_internal::MessageReceiver const&,
+          Azure::Core::Amqp::_internal::MessageReceiverState,
+          Azure::Core::Amqp::_internal::MessageReceiverState) override
+      {
+      }
+
+      void OnMessageReceiverDisconnected(
+          Azure::Core::Amqp::_internal::MessageReceiver const&,
+          Azure::Core::Amqp::Models::_internal::AmqpError const&) override
+      {
+      }
+
+      void OnMessageSenderStateChanged(
+          Azure::Core::Amqp::_internal::MessageSender const&,
+          Azure::Core::Amqp::_internal::MessageSenderState,
+          Azure::Core::Amqp::_internal::MessageSenderState) override
+      {
+      }
+
+      void OnMessageSenderDisconnected(
+          Azure::Core::Amqp::_internal::MessageSender const& sender,
+          Azure::Core::Amqp::Models::_internal::AmqpError const&) override
+      {
+        std::unique_lock<std::mutex> lock(Lock);
+        for (auto& consumer : Consumers)
+        {
+          if (consumer->Sender->GetLinkName() == sender.GetLinkName())
+          {
+            consumer->Detached = true;
+          }
+        }
+      }
+    };
+
+    MockEventHubsBrokerOptions m_options;
+    std::vector<Partition> m_partitions;
+    std::atomic<std::uint32_t> m_nextPartition{0};
+    std::atomic<std::uint64_t> m_eventsReceived{0};
+    std::atomic<std::uint64_t> m_eventsDelivered{0};
+
+    Azure::Core::Context m_context;
+    std::uint16_t m_port{};
+    std::unique_ptr<Azure::Core::Amqp::Network::_detail::SocketListener> m_listener;
+    std::thread m_listenerThread;
+
+    std::mutex m_sessionsLock;
+    std::list<std::shared_ptr<Azure::Core::Amqp::_internal::Connection>> m_connections;
+    std::list<std::unique_ptr<BrokerSession>> m_sessions;
+
+    std::mutex m_requestLock;
+    std::condition_variable m_requestCondition;
+    std::deque<Request> m_requests;
+    std::thread m_requestThread;
+
+    void OnSocketAccepted(
+        std::shared_ptr<Azure::Core::Amqp::Network::_internal::Transport> transport) override
+    {
+      auto amqpTransport{
+          Azure::Core::Amqp::Network::_internal::AmqpHeaderDetectTransportFactory::Create(
+              transport, nullptr)};
+      Azure::Core::Amqp::_internal::ConnectionOptions options;
+      options.ContainerId = "MockEventHubsBroker";
+      options.IdleTimeout = std::chrono::minutes(2);
+      auto connection = std::make_shared<Azure::Core::Amqp::_internal::Connection>(
+          amqpTransport, options, this, this);
+      {
+        std::unique_lock<std::mutex> lock(m_sessionsLock);
+        m_connections.push_back(connection);
+      }
+      Listen(*connection);
+    }
+
+    void OnConnectionStateChanged(
+        Azure::Core::Amqp::_internal::Connection const&,
+        Azure::Core::Amqp::_internal::ConnectionState,
+        Azure::Core::Amqp::_internal::ConnectionState) override
+    {
+    }
+
+    void OnIOError(Azure::Core::Amqp::_internal::Connection const&) override {}
+
+    bool OnNewEndpoint(
+        Azure::Core::Amqp::_internal::Connection const& connection,
+        Azure::Core::Amqp::_internal::Endpoint& endpoint) override
+    {
+      Azure::Core::Amqp::_internal::SessionOptions options;
+      options.InitialIncomingWindowSize = 10000;
+
+      auto brokerSession = std::make_unique<BrokerSession>(this);
+      brokerSession->AmqpSession = std::make_unique<Azure::Core::Amqp::_internal::Session>(
+          connection.CreateSession(endpoint, options, brokerSession.get()));
+
+      // The new session must begin before returning from the OnNewEndpoint callback.
+      brokerSession->AmqpSession->Begin({});
+      std::unique_lock<std::mutex> lock(m_sessionsLock);
+      m_sessions.push_back(std::move(brokerSession));
+      return true;
+    }
+
+    // Returns the partition index referenced by a link address, or the number of partitions if
+    // the address does not reference a partition.
+    std::size_t GetPartitionIndex(std::string const& address) const
+    {
+      auto partitionStart = address.rfind("/Partitions/");
+      if (partitionStart == std::string::npos)
+      {
+        return m_partitions.size();
+      }
+      auto partitionId = address.substr(partitionStart + sizeof("/Partitions/") - 1);
+      try
+      {
+        auto index = std::stoul(partitionId);
+        return index < m_partitions.size() ? index : m_partitions.size();
+      }
+      catch (std::exception const&)
+      {
+        return m_partitions.size();
+      }
+    }
+
+    bool AttachLink(
+        BrokerSession& brokerSession,
+        Azure::Core::Amqp::_internal::Session const& session,
+        Azure::Core::Amqp::_internal::LinkEndpoint& newLink,
+        std::string const& name,
+        Azure::Core::Amqp::_internal::SessionRole role,
+        Azure::Core::Amqp::Models::AmqpValue const& source,
+        Azure::Core::Amqp::Models::AmqpValue const& target)
+    {
+      Azure::Core::Amqp::Models::_internal::MessageSource messageSource(source);
+      Azure::Core::Amqp::Models::_internal::MessageTarget messageTarget(target);
+
+      // The role is the role of the remote link. If the remote is sending, the broker receives.
+      if (role == Azure::Core::Amqp::_internal::SessionRole::Sender)
+      {
+        std::string address = static_cast<std::string>(messageTarget.GetAddress());
+        LinkReceiver linkReceiver;
+        if (address == "$cbs" || address == "$management")
+        {
+          linkReceiver.Node = address;
+        }
+        else
+        {
+          linkReceiver.PartitionIndex = GetPartitionIndex(address);
+          linkReceiver.RoundRobin = linkReceiver.PartitionIndex == m_partitions.size();
+        }
+
+        Azure::Core::Amqp::_internal::MessageReceiverOptions receiverOptions;
+        receiverOptions.Name = name;
+        receiverOptions.MessageTarget = messageTarget;
+        receiverOptions.InitialDeliveryCount = 0;
+        receiverOptions.MaxLinkCredit = 1000;
+        linkReceiver.Receiver = std::make_unique<Azure::Core::Amqp::_internal::MessageReceiver>(
+            CreateMessageReceiver(
+                session, newLink, messageSource, receiverOptions, &brokerSession));
+
+        // The link endpoint must be attached before this callback returns, otherwise the incoming
+        // attach is discarded.
+        auto& receiver = *linkReceiver.Receiver;
+        {
+          std::unique_lock<std::mutex> lock(brokerSession.Lock);
+          brokerSession.Receivers[name] = std::move(linkReceiver);
+        }
+        receiver.Open(m_context);
+        return true;
+      }
+
+      std::string address = static_cast<std::string>(messageSource.GetAddress());
+      Azure::Core::Amqp::_internal::MessageSenderOptions senderOptions;
+      senderOptions.Name = name;
+      senderOptions.MessageSource = messageSource;
+      senderOptions.InitialDeliveryCount = 0;
+      if (address == "$cbs" || address == "$management")
+      {
+        auto sender = std::make_unique<Azure::Core::Amqp::_internal::MessageSender>(
+            CreateMessageSender(session, newLink, messageTarget, senderOptions, &brokerSession));
+        (void)!HalfOpen(*sender, m_context);
+        std::unique_lock<std::mutex> lock(brokerSession.Lock);
+        brokerSession.ReplySenders[address] = std::move(sender);
+        return true;
+      }
+
+      auto partitionIndex = GetPartitionIndex(address);
+      if (partitionIndex == m_partitions.size())
+      {
+        Azure::Core::Amqp::Models::_internal::AmqpError error;
+        error.Condition = Azure::Core::Amqp::Models::_internal::AmqpErrorCondition::NotFound;
+        error.Description = "Unknown partition: " + address;
+        SendDetach(session, newLink, error);
+        return false;
+      }
+
+      senderOptions.SettleMode = Azure::Core::Amqp::_internal::SenderSettleMode::Settled;
+      senderOptions.MaxOutstandingSends = m_options.ConsumerWindow;
+      auto consumer = std::make_unique<ConsumerLink>();
+      consumer->PartitionIndex = partitionIndex;
+      consumer->NextSequenceNumber = GetStartSequenceNumber(partitionIndex, messageSource);
+      consumer->Sender = std::make_unique<Azure::Core::Amqp::_internal::MessageSender>(
+          CreateMessageSender(session, newLink, messageTarget, senderOptions, &brokerSession));
+      (void)!HalfOpen(*consumer->Sender, m_context);
+
+      ConsumerLink* consumerLink = consumer.get();
+      consumer->Pump = std::thread([this, consumerLink]() { PumpEvents(*consumerLink); });
+      std::unique_lock<std::mutex> lock(brokerSession.Lock);
+      brokerSession.Consumers.push_back(std::move(consumer));
+      return true;
+    }
+
+    // Evaluate the selector filter generated by PartitionClient for its start position.
+    std::int64_t GetStartSequenceNumber(
+        std::size_t partitionIndex,
+        Azure::Core::Amqp::Models::_internal::MessageSource const& source)
+    {
+      Partition& partition = m_partitions[partitionIndex];
+      std::int64_t firstSequenceNumber;
+      std::int64_t nextSequenceNumber;
+      {
+        std::unique_lock<std::mutex> lock(partition.Lock);
+        firstSequenceNumber = partition.FirstSequenceNumber;
+        nextSequenceNumber
+            = partition.FirstSequenceNumber + static_cast<std::int64_t>(partition.Events.size());
+      }
+
+      std::string expression;
+      for (auto const& filter : source.GetFilter())
+      {
+        if (filter.second.GetType() == Azure::Core::Amqp::Models::AmqpValueType::Described)
+        {
+          auto const& value = filter.second.AsDescribed().GetValue();
+          if (value.GetType() == Azure::Core::Amqp::Models::AmqpValueType::String)
+          {
+            expression = static_cast<std::string>(value);
+          }
+        }
+      }
+
+      auto valueStart = expression.find('\'');
+      auto valueEnd = expression.rfind('\'');
+      if (valueStart == std::string::npos || valueEnd <= valueStart
+          || expression.find("@latest") != std::string::npos)
+      {
+        return nextSequenceNumber;
+      }
+      // Offsets are the string form of the sequence number. Start positions based on the enqueued
+      // time start at the beginning of the partition.
+      if (expression.find("x-opt-enqueued-time") != std::string::npos)
+      {
+        return firstSequenceNumber;
+      }
+      std::int64_t position = std::stoll(expression.substr(valueStart + 1, valueEnd - valueStart));
+      bool inclusive = expression.find(">=") != std::string::npos;
+      return (std::max)(firstSequenceNumber, inclusive ? position : position + 1);
+    }
+
+    void MessageReceived(
+        BrokerSession& brokerSession,
+        std::string const& linkName,
+        std::shared_ptr<Azure::Core::Amqp::Models::AmqpMessage> const& message)
+    {
+      std::string node;
+      std::size_t partitionIndex;
+      {
+        std::unique_lock<std::mutex> lock(brokerSession.Lock);
+        auto receiver = brokerSession.Receivers.find(linkName);
+        if (receiver == brokerSession.Receivers.end())
+        {
+          return;
+        }
+        node = receiver->second.Node;
+        partitionIndex = receiver->second.RoundRobin
+            ? m_nextPartition++ % m_partitions.size()
+            : receiver->second.PartitionIndex;
+      }
+
+      if (!node.empty())
+      {
+        // Replies are sent from the request thread, the reply link cannot be used from within an
+        // AMQP callback.
+        std::unique_lock<std::mutex> lock(m_requestLock);
+        m_requests.push_back(Request{&brokerSession, node, message});
+        m_requestCondition.notify_one();
+        return;
+      }
+
+      // A batch carries each event as a serialized message in a separate data section.
+      std::vector<Azure::Core::Amqp::Models::AmqpMessage> events;
+      if (message->BodyType == Azure::Core::Amqp::Models::MessageBodyType::Data)
+      {
+        try
+        {
+          for (auto const& section : message->GetBodyAsBinary())
+          {
+            events.push_back(Azure::Core::Amqp::Models::AmqpMessage::Deserialize(
+                section.data(), section.size()));
+          }
+        }
+        catch (std::exception const&)
+        {
+          events.clear();
+        }
+      }
+      if (events.empty())
+      {
+        events.push_back(*message);
+      }
+      AppendEvents(m_partitions[partitionIndex], events);
+    }
+
+    void AppendEvents(
+        Partition& partition,
+        std::vector<Azure::Core::Amqp::Models::AmqpMessage>& events)
+    {
+      auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch());
+      {
+        std::unique_lock<std::mutex> lock(partition.Lock);
+        for (auto& event : events)
+        {
+          auto sequenceNumber
+              = partition.FirstSequenceNumber + static_cast<std::int64_t>(partition.Events.size());
+          event.MessageAnnotations["x-opt-sequence-number"]
+              = Azure::Core::Amqp::Models::AmqpValue{sequenceNumber};
+          event.MessageAnnotations["x-opt-offset"]
+              = Azure::Core::Amqp::Models::AmqpValue{std::to_string(sequenceNumber)};
+          event.MessageAnnotations["x-opt-enqueued-time"]
+              = Azure::Core::Amqp::Models::AmqpTimestamp{now}.AsAmqpValue();
+          partition.Events.push_back(
+              std::make_shared<Azure::Core::Amqp::Models::AmqpMessage const>(std::move(event)));
+          if (partition.Events.size() > m_options.MaxRetainedEvents)
+          {
+            partition.Events.pop_front();
+            partition.FirstSequenceNumber += 1;
+          }
+        }
+        partition.LastEnqueuedTime = now.count();
+      }
+      m_eventsReceived += events.size();
+      partition.EventAdded.notify_all();
+    }
+
+    void PumpEvents(ConsumerLink& consumer)
+    {
+      Partition& partition = m_partitions[consumer.PartitionIndex];
+      std::vector<std::shared_ptr<Azure::Core::Amqp::Models::AmqpMessage const>> events;
+      while (!m_context.IsCancelled() && !consumer.Detached)
+      {
+        events.clear();
+        {
+          std::unique_lock<std::mutex> lock(partition.Lock);
+          auto available = [&]() {
+            return partition.FirstSequenceNumber
+                + static_cast<std::int64_t>(partition.Events.size())
+                > consumer.NextSequenceNumber;
+          };
+          if (!available() && m_options.ReplayEvents && !partition.Events.empty())
+          {
+            consumer.NextSequenceNumber = partition.FirstSequenceNumber;
+          }
+          partition.EventAdded.wait_for(lock, std::chrono::milliseconds(100), [&]() {
+            return available() || m_context.IsCancelled();
+          });
+          consumer.NextSequenceNumber
+              = (std::max)(consumer.NextSequenceNumber, partition.FirstSequenceNumber);
+          auto index = static_cast<std::size_t>(
+              consumer.NextSequenceNumber - partition.FirstSequenceNumber);
+          for (; index < partition.Events.size() && events.size() < m_options.ConsumerWindow;
+               index += 1)
+          {
+            events.push_back(partition.Events[index]);
+          }
+          consumer.NextSequenceNumber += static_cast<std::int64_t>(events.size());
+        }
+
+        try
+        {
+          for (auto const& event : events)
+          {
+            // SendAsync blocks once ConsumerWindow events are waiting for link credit.
+            (void)consumer.Sender->SendAsync(*event, m_context);
+            m_eventsDelivered += 1;
+          }
+        }
+        catch (std::exception const&)
+        {
+          consumer.Detached = true;
+        }
+      }
+    }
+
+    void ProcessRequests()
+    {
+      while (true)
+      {
+        Request request;
+        {
+          std::unique_lock<std::mutex> lock(m_requestLock);
+          m_requestCondition.wait(
+              lock, [this]() { return !m_requests.empty() || m_context.IsCancelled(); });
+          if (m_context.IsCancelled())
+          {
+            return;
+          }
+          request = m_requests.front();
+          m_requests.pop_front();
+        }
+
+        Azure::Core::Amqp::Models::AmqpMessage response{CreateResponse(request)};
+
+        Azure::Core::Amqp::_internal::MessageSender* sender{};
+        {
+          std::unique_lock<std::mutex> lock(request.Session->Lock);
+          auto replySender = request.Session->ReplySenders.find(request.Node);
+          if (replySender != request.Session->ReplySenders.end())
+          {
+            sender = replySender->second.get();
+          }
+        }
+        if (sender == nullptr)
+        {
+          continue;
+        }
+        try
+        {
+          auto result = sender->Send(response, m_context);
+          if (std::get<0>(result) != Azure::Core::Amqp::_internal::MessageSendStatus::Ok)
+          {
+            std::cerr << "MockEventHubsBroker: Could not send " << request.Node
+                      << " response: " << std::get<1>(result) << std::endl;
+          }
+        }
+        catch (std::exception const& ex)
+        {
+          std::cerr << "MockEventHubsBroker: Could not send " << request.Node
+                    << " response: " << ex.what() << std::endl;
+        }
+      }
+    }
+
+    Azure::Core::Amqp::Models::AmqpMessage CreateResponse(Request const& request)
+    {
+      auto const& message = *request.Message;
+      Azure::Core::Amqp::Models::AmqpMessage response;
+
+      // The correlation-id of the response is the correlation-id of the request if present,
+      // otherwise the message-id of the request.
+      response.Properties.CorrelationId = message.Properties.CorrelationId.IsNull()
+          ? message.Properties.MessageId
+          : message.Properties.CorrelationId;
+      response.ApplicationProperties["status-code"] = 200;
+      response.ApplicationProperties["status-description"] = "OK";
+      response.SetBody(Azure::Core::Amqp::Models::AmqpValue{});
+
+      if (request.Node == "$cbs")
+      {
+        return response;
+      }
+
+      auto type = message.ApplicationProperties.find("type");
+      if (type == message.ApplicationProperties.end())
+      {
+        response.ApplicationProperties["status-code"] = 400;
+        response.ApplicationProperties["status-description"] = "Missing operation type.";
+        return response;
+      }
+
+      Azure::Core::Amqp::Models::AmqpMap body;
+      body["name"] = Azure::Core::Amqp::Models::AmqpValue{m_options.EventHubName};
+      if (static_cast<std::string>(type->second) == "com.microsoft:eventhub")
+      {
+        Azure::Core::Amqp::Models::AmqpArray partitionIds;
+        for (std::size_t i = 0; i < m_partitions.size(); i += 1)
+        {
+          partitionIds.push_back(Azure::Core::Amqp::Models::AmqpValue{std::to_string(i)});
+        }
+        body["created_at"]
+            = Azure::Core::Amqp::Models::AmqpTimestamp{std::chrono::milliseconds{0}}.AsAmqpValue();
+        body["partition_ids"] = partitionIds.AsAmqpValue();
+      }
+      else
+      {
+        auto partitionId = message.ApplicationProperties.find("partition");
+        std::size_t partitionIndex = partitionId == message.ApplicationProperties.end()
+            ? m_partitions.size()
+            : GetPartitionIndex("/Partitions/" + static_cast<std::string>(partitionId->second));
+        if (partitionIndex == m_partitions.size())
+        {
+          response.ApplicationProperties["status-code"] = 404;
+          response.ApplicationProperties["status-description"] = "Unknown partition.";
+          return response;
+        }
+
+        Partition& partition = m_partitions[partitionIndex];
+        std::unique_lock<std::mutex> lock(partition.Lock);
+        std::int64_t lastSequenceNumber = partition.FirstSequenceNumber
+            + static_cast<std::int64_t>(partition.Events.size()) - 1;
+        body["partition"] = Azure::Core::Amqp::Models::AmqpValue{std::to_string(partitionIndex)};
+        body["begin_sequence_number"]
+            = Azure::Core::Amqp::Models::AmqpValue{partition.FirstSequenceNumber};
+        body["last_enqueued_sequence_number"]
+            = Azure::Core::Amqp::Models::AmqpValue{lastSequenceNumber};
+        body["last_enqueued_offset"]
+            = Azure::Core::Amqp::Models::AmqpValue{std::to_string(lastSequenceNumber)};
+        body["last_enqueued_time_utc"]
+            = Azure::Core::Amqp::Models::AmqpTimestamp{
+                std::chrono::milliseconds{partition.LastEnqueuedTime}}
+                  .AsAmqpValue();
+        body["is_partition_empty"]
+            = Azure::Core::Amqp::Models::AmqpValue{partition.Events.empty()};
+      }
+      response.SetBody(body.AsAmqpValue());
+      return response;
+    }
+  };
+}}}} // namespace Azure::Messaging::EventHubs::PerfTest
+
+#endif // ENABLE_UAMQP
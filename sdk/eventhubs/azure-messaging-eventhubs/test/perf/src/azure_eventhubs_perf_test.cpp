@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include "azure/messaging/eventhubs/test/eventhubs_batch_perf_test.hpp"
+#include "azure/messaging/eventhubs/test/eventhubs_local_broker_receive_perf_test.hpp"
+#include "azure/messaging/eventhubs/test/eventhubs_local_broker_send_perf_test.hpp"
 
 #include <azure/perf.hpp>
 
@@ -10,7 +12,12 @@ int main(int argc, char** argv)
 
   // Create the test list
   std::vector<Azure::Perf::TestMetadata> tests{
-      Azure::Messaging::EventHubs::PerfTest::Batch::BatchTest::GetTestMetadata()};
+      Azure::Messaging::EventHubs::PerfTest::Batch::BatchTest::GetTestMetadata(),
+#if ENABLE_UAMQP
+      Azure::Messaging::EventHubs::PerfTest::LocalBroker::SendTest::GetTestMetadata(),
+      Azure::Messaging::EventHubs::PerfTest::LocalBroker::ReceiveTest::GetTestMetadata(),
+#endif
+  };
 
   Azure::Perf::Program::Run(Azure::Core::Context{}, tests, argc, argv);
 
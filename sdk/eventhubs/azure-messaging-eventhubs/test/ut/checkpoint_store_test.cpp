@@ -8,6 +8,12 @@
 #include <azure/identity.hpp>
 #include <azure/messaging/eventhubs.hpp>
 
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+
 #include <gtest/gtest.h>
 
 namespace Azure { namespace Messaging { namespace EventHubs { namespace Test {
@@ -90,6 +96,221 @@ namespace Azure { namespace Messaging { namespace EventHubs { namespace Test {
     EXPECT_EQ("102", checkpoints[0].Offset.Value());
   }
 
+  TEST_F(CheckpointStoreTest, TestBufferedCheckpoints)
+  {
+    std::shared_ptr<CheckpointStore> underlyingStore{std::make_shared<TestCheckpointStore>()};
+    auto makeCheckpoint = [](std::string const& partitionId, int64_t sequenceNumber) {
+      return Models::Checkpoint{
+          "$Default",
+          "event-hub-name",
+          "ns.servicebus.windows.net",
+          partitionId,
+          std::to_string(sequenceNumber * 10),
+          sequenceNumber};
+    };
+
+    {
+      BufferedCheckpointStoreOptions options;
+      options.FlushInterval = std::chrono::hours(1);
+      options.MaxPendingUpdates = 0;
+      BufferedCheckpointStore checkpointStore{underlyingStore, options};
+
+      checkpointStore.UpdateCheckpoint(makeCheckpoint("0", 1));
+      checkpointStore.UpdateCheckpoint(makeCheckpoint("0", 2));
+      checkpointStore.UpdateCheckpoint(makeCheckpoint("1", 5));
+      checkpointStore.UpdateCheckpoint(makeCheckpoint("0", 3));
+
+      // Nothing has been written yet, but the pending checkpoints are visible.
+      EXPECT_EQ(
+          0ul,
+          underlyingStore
+              ->ListCheckpoints("ns.servicebus.windows.net", "event-hub-name", "$Default")
+              .size());
+      auto checkpoints = checkpointStore.ListCheckpoints(
+          "ns.servicebus.windows.net", "event-hub-name", "$Default");
+      ASSERT_EQ(2ul, checkpoints.size());
+      for (auto const& checkpoint : checkpoints)
+      {
+        EXPECT_EQ(checkpoint.PartitionId == "0" ? 3 : 5, checkpoint.SequenceNumber.Value());
+      }
+
+      auto metrics = checkpointStore.GetMetrics();
+      EXPECT_EQ(2ul, metrics.PendingCheckpoints);
+      EXPECT_EQ(4ul, metrics.UpdatesReceived);
+      EXPECT_EQ(2ul, metrics.UpdatesCoalesced);
+      EXPECT_EQ(0ul, metrics.CheckpointsWritten);
+
+      checkpointStore.Flush();
+      checkpoints = underlyingStore->ListCheckpoints(
+          "ns.servicebus.windows.net", "event-hub-name", "$Default");
+      ASSERT_EQ(2ul, checkpoints.size());
+      for (auto const& checkpoint : checkpoints)
+      {
+        EXPECT_EQ(checkpoint.PartitionId == "0" ? 3 : 5, checkpoint.SequenceNumber.Value());
+      }
+      metrics = checkpointStore.GetMetrics();
+      EXPECT_EQ(0ul, metrics.PendingCheckpoints);
+      EXPECT_EQ(2ul, metrics.CheckpointsWritten);
+      EXPECT_EQ(0, metrics.MaxCheckpointLag.count());
+
+      // Pending checkpoints are written when the store is destroyed.
+      checkpointStore.UpdateCheckpoint(makeCheckpoint("1", 6));
+    }
+    auto checkpoints = underlyingStore->ListCheckpoints(
+        "ns.servicebus.windows.net", "event-hub-name", "$Default");
+    ASSERT_EQ(2ul, checkpoints.size());
+    for (auto const& checkpoint : checkpoints)
+    {
+      EXPECT_EQ(checkpoint.PartitionId == "0" ? 3 : 6, checkpoint.SequenceNumber.Value());
+    }
+
+    {
+      // Reaching MaxPendingUpdates wakes the background writer.
+      BufferedCheckpointStoreOptions options;
+      options.FlushInterval = std::chrono::hours(1);
+      options.MaxPendingUpdates = 2;
+      BufferedCheckpointStore checkpointStore{underlyingStore, options};
+      checkpointStore.UpdateCheckpoint(makeCheckpoint("0", 7));
+      checkpointStore.UpdateCheckpoint(makeCheckpoint("1", 8));
+
+      auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+      while (checkpointStore.GetMetrics().CheckpointsWritten != 2
+             && std::chrono::steady_clock::now() < deadline)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+      EXPECT_EQ(2ul, checkpointStore.GetMetrics().CheckpointsWritten);
+    }
+  }
+
+  TEST_F(CheckpointStoreTest, TestBufferedCheckpointsInFlight)
+  {
+    // Blocks checkpoint writes until they are released or the context is cancelled.
+    class BlockingCheckpointStore final : public CheckpointStore {
+    public:
+      std::vector<Models::Ownership> ClaimOwnership(
+          std::vector<Models::Ownership> const& partitionOwnership,
+          Core::Context const& context) override
+      {
+        return m_checkpointStore->ClaimOwnership(partitionOwnership, context);
+      }
+
+      std::vector<Models::Checkpoint> ListCheckpoints(
+          std::string const& fullyQualifiedNamespace,
+          std::string const& eventHubName,
+          std::string const& consumerGroup,
+          Core::Context const& context = {}) override
+      {
+        return m_checkpointStore->ListCheckpoints(
+            fullyQualifiedNamespace, eventHubName, consumerGroup, context);
+      }
+
+      std::vector<Models::Ownership> ListOwnership(
+          std::string const& fullyQualifiedNamespace,
+          std::string const& eventHubName,
+          std::string const& consumerGroup,
+          Core::Context const& context) override
+      {
+        return m_checkpointStore->ListOwnership(
+            fullyQualifiedNamespace, eventHubName, consumerGroup, context);
+      }
+
+      void UpdateCheckpoint(Models::Checkpoint const& checkpoint, Core::Context const& context)
+          override
+      {
+        {
+          std::unique_lock<std::mutex> lock(m_lock);
+          m_writeStarted = true;
+          m_condition.notify_all();
+          while (!m_released)
+          {
+            if (context.IsCancelled())
+            {
+              throw Core::OperationCancelledException("Checkpoint write cancelled.");
+            }
+            m_condition.wait_for(lock, std::chrono::milliseconds(10));
+          }
+        }
+        m_checkpointStore->UpdateCheckpoint(checkpoint, context);
+      }
+
+      void WaitForWrite()
+      {
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_condition.wait(lock, [this]() { return m_writeStarted; });
+      }
+
+      void Release()
+      {
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_released = true;
+        m_condition.notify_all();
+      }
+
+    private:
+      std::shared_ptr<CheckpointStore> m_checkpointStore{std::make_shared<TestCheckpointStore>()};
+      std::mutex m_lock;
+      std::condition_variable m_condition;
+      bool m_writeStarted{false};
+      bool m_released{false};
+    };
+
+    auto makeCheckpoint = [](std::string const& partitionId, int64_t sequenceNumber) {
+      return Models::Checkpoint{
+          "$Default",
+          "event-hub-name",
+          "ns.servicebus.windows.net",
+          partitionId,
+          std::to_string(sequenceNumber * 10),
+          sequenceNumber};
+    };
+    BufferedCheckpointStoreOptions options;
+    options.FlushInterval = std::chrono::hours(1);
+    options.MaxPendingUpdates = 0;
+    options.ShutdownTimeout = std::chrono::milliseconds(100);
+
+    {
+      auto underlyingStore{std::make_shared<BlockingCheckpointStore>()};
+      BufferedCheckpointStore checkpointStore{underlyingStore, options};
+      checkpointStore.UpdateCheckpoint(makeCheckpoint("0", 1));
+      checkpointStore.UpdateCheckpoint(makeCheckpoint("1", 2));
+
+      // The checkpoints being written remain visible until they have been written.
+      auto flush = std::async(std::launch::async, [&]() { checkpointStore.Flush(); });
+      underlyingStore->WaitForWrite();
+      checkpointStore.UpdateCheckpoint(makeCheckpoint("1", 3));
+      auto checkpoints = checkpointStore.ListCheckpoints(
+          "ns.servicebus.windows.net", "event-hub-name", "$Default");
+      ASSERT_EQ(2ul, checkpoints.size());
+      for (auto const& checkpoint : checkpoints)
+      {
+        EXPECT_EQ(checkpoint.PartitionId == "0" ? 1 : 3, checkpoint.SequenceNumber.Value());
+      }
+      EXPECT_EQ(2ul, checkpointStore.GetMetrics().PendingCheckpoints);
+
+      underlyingStore->Release();
+      flush.get();
+      EXPECT_EQ(1ul, checkpointStore.GetMetrics().PendingCheckpoints);
+      EXPECT_EQ(2ul, checkpointStore.GetMetrics().CheckpointsWritten);
+    }
+
+    {
+      // The destructor gives up writing checkpoints after ShutdownTimeout.
+      auto underlyingStore{std::make_shared<BlockingCheckpointStore>()};
+      auto start = std::chrono::steady_clock::now();
+      {
+        BufferedCheckpointStore checkpointStore{underlyingStore, options};
+        checkpointStore.UpdateCheckpoint(makeCheckpoint("0", 1));
+      }
+      EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(10));
+      EXPECT_EQ(
+          0ul,
+          underlyingStore
+              ->ListCheckpoints("ns.servicebus.windows.net", "event-hub-name", "$Default")
+              .size());
+    }
+  }
+
   TEST_F(CheckpointStoreTest, TestOwnerships)
   {
     std::string const testName = GetRandomName();
@@ -11,6 +11,10 @@
 #include <azure/identity.hpp>
 #include <azure/messaging/eventhubs.hpp>
 
+#include <future>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 namespace Azure { namespace Messaging { namespace EventHubs { namespace Test {
@@ -162,6 +166,36 @@ namespace Azure { namespace Messaging { namespace EventHubs { namespace Test {
         2);
   }
 
+  TEST_F(ProcessorLoadBalancerTest, Balanced_HasClaimablePartitions)
+  {
+    std::shared_ptr<CheckpointStore> checkpointStore{
+        std::make_shared<Azure::Messaging::EventHubs::Test::TestCheckpointStore>()};
+
+    checkpointStore->ClaimOwnership(std::vector<Azure::Messaging::EventHubs::Models::Ownership>{
+        TestOwnership("0", "some-client"), TestOwnership("3", "some-client")});
+
+    Azure::Messaging::EventHubs::_detail::ProcessorLoadBalancer loadBalancer(
+        checkpointStore,
+        TestConsumerDetails("new-client"),
+        Azure::Messaging::EventHubs::Models::ProcessorStrategy::ProcessorStrategyBalanced,
+        std::chrono::minutes(2));
+    EXPECT_FALSE(loadBalancer.HasClaimablePartitions());
+
+    // The balanced strategy claims one unowned partition per cycle, so a second cycle is needed
+    // to reach the fair share.
+    auto ownerships = loadBalancer.LoadBalance(std::vector<std::string>{"0", "1", "2", "3"});
+    EXPECT_EQ(ownerships.size(), 1ul);
+    EXPECT_TRUE(loadBalancer.HasClaimablePartitions());
+
+    ownerships = loadBalancer.LoadBalance(std::vector<std::string>{"0", "1", "2", "3"});
+    EXPECT_EQ(ownerships.size(), 2ul);
+    EXPECT_FALSE(loadBalancer.HasClaimablePartitions());
+
+    ownerships = loadBalancer.LoadBalance(std::vector<std::string>{"0", "1", "2", "3"});
+    EXPECT_EQ(ownerships.size(), 2ul);
+    EXPECT_FALSE(loadBalancer.HasClaimablePartitions());
+  }
+
   TEST_F(ProcessorLoadBalancerTest, Greedy_ForcedToSteal)
   {
     std::shared_ptr<CheckpointStore> checkpointStore{
@@ -430,4 +464,49 @@ namespace Azure { namespace Messaging { namespace EventHubs { namespace Test {
       }
     }
   }
+  TEST_F(ProcessorLoadBalancerTest, AnyStrategy_ConcurrentStartup)
+  {
+    for (auto strategy :
+         {Azure::Messaging::EventHubs::Models::ProcessorStrategy::ProcessorStrategyBalanced,
+          Azure::Messaging::EventHubs::Models::ProcessorStrategy::ProcessorStrategyGreedy})
+    {
+      std::shared_ptr<CheckpointStore> checkpointStore{
+          std::make_shared<Azure::Messaging::EventHubs::Test::TestCheckpointStore>()};
+      const std::vector<std::string> partitionIds{
+          "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11"};
+      constexpr size_t consumerCount = 4;
+
+      // Every consumer starts load balancing against the empty checkpoint store at the same time,
+      // and claims partitions concurrently with the others.
+      std::promise<void> start;
+      std::shared_future<void> started{start.get_future().share()};
+      std::vector<std::thread> consumers;
+      for (size_t i = 0; i < consumerCount; i += 1)
+      {
+        consumers.emplace_back([&, i]() {
+          Azure::Messaging::EventHubs::_detail::ProcessorLoadBalancer loadBalancer(
+              checkpointStore,
+              TestConsumerDetails("client" + std::to_string(i)),
+              strategy,
+              std::chrono::minutes(2));
+          started.wait();
+          for (int cycle = 0; cycle < 20; cycle += 1)
+          {
+            loadBalancer.LoadBalance(partitionIds);
+            std::this_thread::yield();
+          }
+        });
+      }
+      start.set_value();
+      for (auto& consumer : consumers)
+      {
+        consumer.join();
+      }
+
+      RequireBalanced(
+          checkpointStore->ListOwnership(testEventHubFQDN, testEventHubName, testConsumerGroup),
+          partitionIds.size(),
+          consumerCount);
+    }
+  }
 }}}} // namespace Azure::Messaging::EventHubs::Test
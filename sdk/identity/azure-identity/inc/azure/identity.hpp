@@ -19,4 +19,5 @@
 #include "azure/identity/environment_credential.hpp"
 #include "azure/identity/managed_identity_credential.hpp"
 #include "azure/identity/rtti.hpp"
+#include "azure/identity/token_cache_persistence_options.hpp"
 #include "azure/identity/workload_identity_credential.hpp"
@@ -9,10 +9,12 @@
 #pragma once
 
 #include "azure/identity/detail/token_cache.hpp"
+#include "azure/identity/token_cache_persistence_options.hpp"
 
 #include <azure/core/credentials/credentials.hpp>
 #include <azure/core/credentials/token_credential_options.hpp>
 #include <azure/core/datetime.hpp>
+#include <azure/core/nullable.hpp>
 
 #include <chrono>
 #include <string>
@@ -49,6 +51,12 @@ namespace Azure { namespace Identity {
      * a subscription other than the Azure CLI's current subscription.
      */
     std::string Subscription;
+
+    /**
+     * @brief Options for sharing the tokens of the credential with other processes through an
+     * encrypted file. Tokens are only cached in memory if no value is set.
+     */
+    Nullable<TokenCachePersistenceOptions> TokenCachePersistence;
   };
 
   /**
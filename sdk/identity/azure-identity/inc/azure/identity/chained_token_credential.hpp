@@ -19,6 +19,25 @@ namespace Azure { namespace Identity {
     class ChainedTokenCredentialImpl;
   }
 
+  /**
+   * @brief Options for #Azure::Identity::ChainedTokenCredential.
+   *
+   */
+  struct ChainedTokenCredentialOptions final
+  {
+    /**
+     * @brief Whether to request a token from every source at the same time, instead of one
+     * after the other.
+     *
+     * @details The token of the first source in the chain which succeeds is still returned, but
+     * the time it takes is that of the slowest source before it, rather than the total time of
+     * all the sources which failed before it. The other sources are cancelled once that token is
+     * obtained, and GetToken() returns when they have stopped.
+     *
+     */
+    bool ProbeSourcesConcurrently = false;
+  };
+
   /**
    * @brief Chained Token Credential provides a token credential implementation which chains
    * multiple Azure::Core::Credentials::TokenCredential implementations to be tried in order until
@@ -38,8 +57,11 @@ namespace Azure { namespace Identity {
      *
      * @param sources The ordered chain of Azure::Core::Credentials::TokenCredential implementations
      * to try when calling GetToken().
+     * @param options Options for the credential.
      */
-    explicit ChainedTokenCredential(Sources sources);
+    explicit ChainedTokenCredential(
+        Sources sources,
+        ChainedTokenCredentialOptions const& options = {});
 
     /**
      * @brief Destructs `%ChainedTokenCredential`.
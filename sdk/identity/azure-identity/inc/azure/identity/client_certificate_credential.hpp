@@ -10,10 +10,12 @@
 
 #include "azure/identity/detail/client_credential_core.hpp"
 #include "azure/identity/detail/token_cache.hpp"
+#include "azure/identity/token_cache_persistence_options.hpp"
 
 #include <azure/core/credentials/credentials.hpp>
 #include <azure/core/credentials/token_credential_options.hpp>
 #include <azure/core/internal/unique_handle.hpp>
+#include <azure/core/nullable.hpp>
 #include <azure/core/url.hpp>
 
 #include <memory>
@@ -78,6 +80,12 @@ namespace Azure { namespace Identity {
      *
      */
     bool SendCertificateChain = false;
+
+    /**
+     * @brief Options for sharing the tokens of the credential with other processes through an
+     * encrypted file. Tokens are only cached in memory if no value is set.
+     */
+    Nullable<TokenCachePersistenceOptions> TokenCachePersistence;
   };
 
   /**
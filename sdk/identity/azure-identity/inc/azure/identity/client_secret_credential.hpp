@@ -10,9 +10,11 @@
 
 #include "azure/identity/detail/client_credential_core.hpp"
 #include "azure/identity/detail/token_cache.hpp"
+#include "azure/identity/token_cache_persistence_options.hpp"
 
 #include <azure/core/credentials/credentials.hpp>
 #include <azure/core/credentials/token_credential_options.hpp>
+#include <azure/core/nullable.hpp>
 #include <azure/core/url.hpp>
 
 #include <memory>
@@ -48,6 +50,12 @@ namespace Azure { namespace Identity {
      * for any tenant in which the application is installed.
      */
     std::vector<std::string> AdditionallyAllowedTenants;
+
+    /**
+     * @brief Options for sharing the tokens of the credential with other processes through an
+     * encrypted file. Tokens are only cached in memory if no value is set.
+     */
+    Nullable<TokenCachePersistenceOptions> TokenCachePersistence;
   };
 
   /**
@@ -22,6 +22,22 @@ namespace Azure { namespace Identity {
     class ChainedTokenCredentialImpl;
   }
 
+  /**
+   * @brief Options for configuring the #Azure::Identity::DefaultAzureCredential.
+   */
+  struct DefaultAzureCredentialOptions final : public Core::Credentials::TokenCredentialOptions
+  {
+    /**
+     * @brief Whether to request the first token from every credential in the chain at the same
+     * time, instead of one after the other.
+     *
+     * @details The first credential in the chain which succeeds is still the one selected, but
+     * the first token no longer waits for each of the credentials before it to fail in turn, such
+     * as a managed identity endpoint timing out outside of Azure.
+     */
+    bool ProbeSourcesConcurrently = false;
+  };
+
   /**
    * @brief Default Azure Credential combines multiple credentials that depend on the setup
    * environment and require no parameters into a single chain. If the environment is set up
@@ -61,6 +77,13 @@ namespace Azure { namespace Identity {
      */
     explicit DefaultAzureCredential(Core::Credentials::TokenCredentialOptions const& options);
 
+    /**
+     * @brief Constructs `%DefaultAzureCredential`.
+     *
+     * @param options Options for the credential.
+     */
+    explicit DefaultAzureCredential(DefaultAzureCredentialOptions const& options);
+
     /**
      * @brief Constructs `%DefaultAzureCredential`.
      *
@@ -93,6 +116,11 @@ namespace Azure { namespace Identity {
         Core::Context const& context) const override;
 
   private:
+    DefaultAzureCredential(
+        bool requireCredentialSpecifierEnvVarValue,
+        Core::Credentials::TokenCredentialOptions const& options,
+        bool probeSourcesConcurrently);
+
     std::unique_ptr<_detail::ChainedTokenCredentialImpl> m_impl;
   };
 
@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include "azure/identity/token_cache_persistence_options.hpp"
+
 #include <azure/core/credentials/credentials.hpp>
 
 #include <chrono>
@@ -20,6 +22,8 @@
 #include <tuple>
 
 namespace Azure { namespace Identity { namespace _detail {
+  class PersistentTokenCache;
+
   /**
    * @brief Access token cache.
    *
@@ -64,6 +68,10 @@ namespace Azure { namespace Identity { namespace _detail {
     mutable std::shared_timed_mutex m_cacheMutex;
 
   private:
+    // Tokens shared with other processes, checked when a token is not in m_cache.
+    std::shared_ptr<PersistentTokenCache> m_persistentCache;
+    std::string m_persistentCachePartition;
+
     TokenCache(TokenCache const&) = delete;
     TokenCache& operator=(TokenCache const&) = delete;
 
@@ -82,6 +90,16 @@ namespace Azure { namespace Identity { namespace _detail {
     TokenCache() = default;
     ~TokenCache() = default;
 
+    /**
+     * @brief Shares the cached tokens with other processes through an encrypted file.
+     *
+     * @param options Options for the file.
+     * @param partition Identifies the credential, so that the tokens of different credentials
+     * sharing the file are kept apart.
+     *
+     */
+    void EnablePersistence(TokenCachePersistenceOptions const& options, std::string partition);
+
     /**
      * @brief Attempts to get token from cache, and if not found, gets the token using the function
      * provided, caches it, and returns its value.
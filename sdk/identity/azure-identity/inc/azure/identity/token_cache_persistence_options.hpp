@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Options for persisting the tokens of a credential.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Identity {
+  /**
+   * @brief Options for persisting the tokens of a credential in an encrypted file, so that they
+   * are shared by every process of the user which uses the same file.
+   *
+   * @details The file is locked while it is read or written. A token is read from the file when
+   * the in-memory cache of the credential does not have it, and is only used if it is not about
+   * to expire. Failures to read or write the file are logged, and the token is requested as if
+   * there was no file.
+   *
+   */
+  struct TokenCachePersistenceOptions final
+  {
+    /**
+     * @brief The name of the file, which distinguishes the caches of different applications.
+     *
+     */
+    std::string Name = "azure-identity-cpp.cache";
+
+    /**
+     * @brief The directory of the file.
+     *
+     * @note Defaults to `%LOCALAPPDATA%\.IdentityService` on Windows, and to
+     * `$HOME/.IdentityService` on other platforms. The directory is created if it does not exist.
+     */
+    std::string Directory;
+
+    /**
+     * @brief The 256-bit key used to encrypt the file on platforms other than Windows, where the
+     * file is encrypted for the current user with DPAPI.
+     *
+     * @note The key is required on platforms other than Windows, and is ignored on Windows. It
+     * should come from a secure store, such as the keyring of the user: storing it next to the
+     * file would only obfuscate the tokens.
+     */
+    std::vector<uint8_t> EncryptionKey;
+  };
+}} // namespace Azure::Identity
@@ -105,6 +105,11 @@ AzureCliCredential::AzureCliCredential(AzureCliCredentialOptions const& options)
         options.AdditionallyAllowedTenants,
         options.Subscription)
 {
+  if (options.TokenCachePersistence.HasValue())
+  {
+    m_tokenCache.EnablePersistence(
+        options.TokenCachePersistence.Value(), GetCredentialName() + '|' + m_subscription);
+  }
 }
 
 AzureCliCredential::AzureCliCredential(const Core::Credentials::TokenCredentialOptions& options)
@@ -7,7 +7,9 @@
 #include "private/chained_token_credential_impl.hpp"
 #include "private/identity_log.hpp"
 
+#include <future>
 #include <utility>
+#include <vector>
 
 using namespace Azure::Identity;
 using namespace Azure::Identity::_detail;
@@ -15,9 +17,63 @@ using namespace Azure::Core::Credentials;
 using Azure::Core::Context;
 using Azure::Identity::_detail::IdentityLog;
 
-ChainedTokenCredential::ChainedTokenCredential(ChainedTokenCredential::Sources sources)
+namespace {
+// Token requests sent to several sources at the same time. The requests which are still running
+// when it is destroyed are cancelled, and waited for, since they reference the caller's arguments.
+class ConcurrentProbes final {
+  std::vector<Context> m_contexts;
+  std::vector<std::future<AccessToken>> m_tokens;
+
+public:
+  ConcurrentProbes() = default;
+  ConcurrentProbes(ConcurrentProbes const&) = delete;
+  ConcurrentProbes& operator=(ConcurrentProbes const&) = delete;
+
+  ~ConcurrentProbes()
+  {
+    for (auto& context : m_contexts)
+    {
+      context.Cancel();
+    }
+
+    for (auto& token : m_tokens)
+    {
+      if (token.valid())
+      {
+        token.wait();
+      }
+    }
+  }
+
+  void Start(
+      std::shared_ptr<TokenCredential const> const& source,
+      TokenRequestContext const& tokenRequestContext,
+      Context const& context)
+  {
+    m_contexts.emplace_back(context.WithDeadline((Azure::DateTime::max)()));
+    m_tokens.emplace_back(std::async(
+        std::launch::async,
+        [source, &tokenRequestContext, probeContext = m_contexts.back()]() {
+          return source->GetToken(tokenRequestContext, probeContext);
+        }));
+  }
+
+  bool IsEmpty() const { return m_tokens.empty(); }
+
+  // Waits for a token, or throws the exception its source has thrown.
+  AccessToken Get(std::size_t index) { return m_tokens[index].get(); }
+};
+} // namespace
+
+ChainedTokenCredential::ChainedTokenCredential(
+    ChainedTokenCredential::Sources sources,
+    ChainedTokenCredentialOptions const& options)
     : TokenCredential("ChainedTokenCredential"),
-      m_impl(std::make_unique<ChainedTokenCredentialImpl>(GetCredentialName(), std::move(sources)))
+      m_impl(std::make_unique<ChainedTokenCredentialImpl>(
+          GetCredentialName(),
+          std::move(sources),
+          false,
+          options.ProbeSourcesConcurrently))
 {
 }
 
@@ -33,8 +89,10 @@ AccessToken ChainedTokenCredential::GetToken(
 ChainedTokenCredentialImpl::ChainedTokenCredentialImpl(
     std::string const& credentialName,
     ChainedTokenCredential::Sources&& sources,
-    bool reuseSuccessfulSource)
-    : m_sources(std::move(sources)), m_reuseSuccessfulSource(reuseSuccessfulSource)
+    bool reuseSuccessfulSource,
+    bool probeSourcesConcurrently)
+    : m_sources(std::move(sources)), m_reuseSuccessfulSource(reuseSuccessfulSource),
+      m_probeSourcesConcurrently(probeSourcesConcurrently)
 {
   auto const logLevel
       = m_sources.empty() ? IdentityLog::Level::Warning : IdentityLog::Level::Informational;
@@ -89,12 +147,30 @@ AccessToken ChainedTokenCredentialImpl::GetToken(
     end = m_successfulSourceIndex + 1;
   }
 
+  // The sources are all started at once, but their results are still considered in order, so the
+  // token is the one of the first source which succeeds, as when they are tried one by one.
+  auto const first = i;
+  ConcurrentProbes probes;
+  if (m_probeSourcesConcurrently && end - first > 1)
+  {
+    IdentityLog::Write(
+        IdentityLog::Level::Verbose,
+        credentialName + ": Requesting a token from " + std::to_string(end - first)
+            + " credentials concurrently.");
+
+    for (auto j = first; j < end; ++j)
+    {
+      probes.Start(m_sources[j], tokenRequestContext, context);
+    }
+  }
+
   for (; i < end; ++i)
   {
     auto& source = m_sources[i];
     try
     {
-      auto token = source->GetToken(tokenRequestContext, context);
+      auto token = probes.IsEmpty() ? source->GetToken(tokenRequestContext, context)
+                                    : probes.Get(i - first);
 
       IdentityLog::Write(
           IdentityLog::Level::Informational,
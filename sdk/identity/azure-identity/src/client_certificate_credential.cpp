@@ -666,6 +666,12 @@ ClientCertificateCredential::ClientCertificateCredential(
         options.SendCertificateChain,
         options)
 {
+  if (options.TokenCachePersistence.HasValue())
+  {
+    m_tokenCache.EnablePersistence(
+        options.TokenCachePersistence.Value(),
+        GetCredentialName() + '|' + options.AuthorityHost + '|' + clientId);
+  }
 }
 
 ClientCertificateCredential::ClientCertificateCredential(
@@ -700,6 +706,12 @@ ClientCertificateCredential::ClientCertificateCredential(
         options.SendCertificateChain,
         options)
 {
+  if (options.TokenCachePersistence.HasValue())
+  {
+    m_tokenCache.EnablePersistence(
+        options.TokenCachePersistence.Value(),
+        GetCredentialName() + '|' + options.AuthorityHost + '|' + clientId);
+  }
 }
 
 ClientCertificateCredential::~ClientCertificateCredential() = default;
@@ -46,6 +46,12 @@ ClientSecretCredential::ClientSecretCredential(
         options.AdditionallyAllowedTenants,
         options)
 {
+  if (options.TokenCachePersistence.HasValue())
+  {
+    m_tokenCache.EnablePersistence(
+        options.TokenCachePersistence.Value(),
+        GetCredentialName() + '|' + options.AuthorityHost + '|' + clientId);
+  }
 }
 
 ClientSecretCredential::ClientSecretCredential(
@@ -41,9 +41,22 @@ DefaultAzureCredential::DefaultAzureCredential(
 {
 }
 
+DefaultAzureCredential::DefaultAzureCredential(DefaultAzureCredentialOptions const& options)
+    : DefaultAzureCredential(false, options, options.ProbeSourcesConcurrently)
+{
+}
+
 DefaultAzureCredential::DefaultAzureCredential(
     bool requireCredentialSpecifierEnvVarValue,
     Core::Credentials::TokenCredentialOptions const& options)
+    : DefaultAzureCredential(requireCredentialSpecifierEnvVarValue, options, false)
+{
+}
+
+DefaultAzureCredential::DefaultAzureCredential(
+    bool requireCredentialSpecifierEnvVarValue,
+    Core::Credentials::TokenCredentialOptions const& options,
+    bool probeSourcesConcurrently)
     : TokenCredential("DefaultAzureCredential")
 {
   // Initializing m_credential below and not in the member initializer list to have a specific order
@@ -217,7 +230,7 @@ DefaultAzureCredential::DefaultAzureCredential(
   // DefaultAzureCredential caches the selected credential, so that it can be reused on subsequent
   // calls.
   m_impl = std::make_unique<_detail::ChainedTokenCredentialImpl>(
-      GetCredentialName(), std::move(credentialChain), true);
+      GetCredentialName(), std::move(credentialChain), true, probeSourcesConcurrently);
 }
 
 DefaultAzureCredential::~DefaultAzureCredential() = default;
@@ -0,0 +1,452 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "private/persistent_token_cache.hpp"
+
+#include <azure/core/internal/environment.hpp>
+#include <azure/core/internal/json/json.hpp>
+#include <azure/core/platform.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#if defined(AZ_PLATFORM_WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+
+#include <wincrypt.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if !defined(AZ_PLATFORM_WINDOWS) \
+    || (defined(WINAPI_PARTITION_DESKTOP) && !WINAPI_PARTITION_DESKTOP)
+#define AZ_IDENTITY_CACHE_USE_OPENSSL
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wold-style-cast"
+#endif // __clang__
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif // __clang__
+#endif
+
+using Azure::DateTime;
+using Azure::Core::_internal::Environment;
+using Azure::Core::Credentials::AccessToken;
+using Azure::Core::Json::_internal::json;
+using Azure::Identity::TokenCachePersistenceOptions;
+using Azure::Identity::_detail::PersistentTokenCache;
+
+namespace {
+#if defined(AZ_PLATFORM_WINDOWS)
+constexpr char PathSeparator = '\\';
+constexpr char const PathSeparators[] = "\\/";
+#else
+constexpr char PathSeparator = '/';
+constexpr char const PathSeparators[] = "/";
+#endif
+
+#if defined(AZ_IDENTITY_CACHE_USE_OPENSSL)
+constexpr size_t KeySize = 32;
+constexpr size_t IvSize = 12;
+constexpr size_t TagSize = 16;
+#endif
+
+// Locks a file next to the cache file, for as long as it is in scope.
+class FileLock final {
+#if defined(AZ_PLATFORM_WINDOWS)
+  HANDLE m_handle;
+#else
+  int m_fd;
+#endif
+
+public:
+  FileLock(std::string const& path, bool exclusive)
+  {
+#if defined(AZ_PLATFORM_WINDOWS)
+    m_handle = CreateFileA(
+        path.c_str(),
+        GENERIC_READ | GENERIC_WRITE,
+        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        nullptr,
+        OPEN_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+    if (m_handle == INVALID_HANDLE_VALUE)
+    {
+      throw std::runtime_error("Failed to open '" + path + "'.");
+    }
+
+    OVERLAPPED overlapped{};
+    if (!LockFileEx(
+            m_handle, exclusive ? LOCKFILE_EXCLUSIVE_LOCK : 0, 0, MAXDWORD, MAXDWORD, &overlapped))
+    {
+      CloseHandle(m_handle);
+      throw std::runtime_error("Failed to lock '" + path + "'.");
+    }
+#else
+    m_fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (m_fd < 0)
+    {
+      throw std::runtime_error("Failed to open '" + path + "'.");
+    }
+
+    int result = 0;
+    do
+    {
+      result = flock(m_fd, exclusive ? LOCK_EX : LOCK_SH);
+    } while (result != 0 && errno == EINTR);
+
+    if (result != 0)
+    {
+      close(m_fd);
+      throw std::runtime_error("Failed to lock '" + path + "'.");
+    }
+#endif
+  }
+
+  ~FileLock()
+  {
+#if defined(AZ_PLATFORM_WINDOWS)
+    OVERLAPPED overlapped{};
+    UnlockFileEx(m_handle, 0, MAXDWORD, MAXDWORD, &overlapped);
+    CloseHandle(m_handle);
+#else
+    flock(m_fd, LOCK_UN);
+    close(m_fd);
+#endif
+  }
+
+  FileLock(FileLock const&) = delete;
+  FileLock& operator=(FileLock const&) = delete;
+};
+
+bool ReadCacheFile(std::string const& path, std::vector<uint8_t>& content)
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file)
+  {
+    return false;
+  }
+
+  content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  return true;
+}
+
+// Writes a file which only the current user can read, replacing it atomically.
+void WriteCacheFile(std::string const& path, std::vector<uint8_t> const& content)
+{
+  auto const tempPath = path + ".tmp";
+#if defined(AZ_PLATFORM_WINDOWS)
+  {
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<char const*>(content.data()), content.size());
+    if (!file)
+    {
+      throw std::runtime_error("Failed to write '" + tempPath + "'.");
+    }
+  }
+
+  if (!MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING))
+  {
+    throw std::runtime_error("Failed to replace '" + path + "'.");
+  }
+#else
+  auto const fd
+      = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+  if (fd < 0)
+  {
+    throw std::runtime_error("Failed to open '" + tempPath + "'.");
+  }
+
+  size_t written = 0;
+  while (written < content.size())
+  {
+    auto const result = write(fd, content.data() + written, content.size() - written);
+    if (result < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (result <= 0)
+    {
+      close(fd);
+      throw std::runtime_error("Failed to write '" + tempPath + "'.");
+    }
+    written += static_cast<size_t>(result);
+  }
+
+  close(fd);
+  if (rename(tempPath.c_str(), path.c_str()) != 0)
+  {
+    throw std::runtime_error("Failed to replace '" + path + "'.");
+  }
+#endif
+}
+
+// Returns false if the directory could not be created, and does not exist.
+bool TryCreateDirectory(std::string const& directory)
+{
+#if defined(AZ_PLATFORM_WINDOWS)
+  return CreateDirectoryA(directory.c_str(), nullptr) || GetLastError() == ERROR_ALREADY_EXISTS;
+#else
+  return mkdir(directory.c_str(), S_IRWXU) == 0 || errno == EEXIST;
+#endif
+}
+
+// Creates the directory and its missing parents, which only the current user can access.
+void CreateCacheDirectory(std::string const& directory)
+{
+  // A parent may exist without the current user being allowed to create it, so only the failure
+  // to create the directory itself is an error.
+  for (auto end = directory.find_first_of(PathSeparators, 1); end != std::string::npos;
+       end = directory.find_first_of(PathSeparators, end + 1))
+  {
+    TryCreateDirectory(directory.substr(0, end));
+  }
+  if (!TryCreateDirectory(directory))
+  {
+    throw std::runtime_error("Failed to create directory '" + directory + "'.");
+  }
+}
+
+std::string GetDefaultDirectory()
+{
+#if defined(AZ_PLATFORM_WINDOWS)
+  auto const root = Environment::GetVariable("LOCALAPPDATA");
+#else
+  auto const root = Environment::GetVariable("HOME");
+#endif
+  if (root.empty())
+  {
+    throw std::runtime_error("Failed to find the default token cache directory.");
+  }
+
+  return root + PathSeparator + ".IdentityService";
+}
+
+#if defined(AZ_IDENTITY_CACHE_USE_OPENSSL)
+struct CipherContextDeleter final
+{
+  void operator()(EVP_CIPHER_CTX* context) const { EVP_CIPHER_CTX_free(context); }
+};
+
+using CipherContext = std::unique_ptr<EVP_CIPHER_CTX, CipherContextDeleter>;
+#endif
+} // namespace
+
+PersistentTokenCache::PersistentTokenCache(TokenCachePersistenceOptions const& options)
+    : m_directory(options.Directory.empty() ? GetDefaultDirectory() : options.Directory),
+      m_encryptionKey(options.EncryptionKey)
+{
+  if (options.Name.empty())
+  {
+    throw std::invalid_argument("The token cache name cannot be empty.");
+  }
+
+#if defined(AZ_IDENTITY_CACHE_USE_OPENSSL)
+  if (m_encryptionKey.empty())
+  {
+    throw std::invalid_argument("The token cache requires an encryption key on this platform.");
+  }
+  if (m_encryptionKey.size() != KeySize)
+  {
+    throw std::invalid_argument("The token cache encryption key must be 256 bits long.");
+  }
+#endif
+
+  m_path = m_directory + PathSeparator + options.Name;
+}
+
+bool PersistentTokenCache::TryGetToken(
+    std::string const& key,
+    DateTime::duration minimumExpiration,
+    AccessToken& token) const
+{
+  // Nothing is locked before the file has been written for the first time.
+  if (!std::ifstream(m_path))
+  {
+    return false;
+  }
+
+  FileLock lock(m_path + ".lock", false);
+
+  std::vector<uint8_t> content;
+  if (!ReadCacheFile(m_path, content))
+  {
+    return false;
+  }
+
+  auto const tokens = json::parse(Decrypt(content));
+  auto const found = tokens.find(key);
+  if (found == tokens.end())
+  {
+    return false;
+  }
+
+  auto const expiresOn = DateTime::Parse(
+      found->at("expires_on").get<std::string>(), DateTime::DateFormat::Rfc3339);
+  if (expiresOn - minimumExpiration <= DateTime(std::chrono::system_clock::now()))
+  {
+    return false;
+  }
+
+  token.Token = found->at("token").get<std::string>();
+  token.ExpiresOn = expiresOn;
+  return true;
+}
+
+void PersistentTokenCache::SetToken(std::string const& key, AccessToken const& token) const
+{
+  CreateCacheDirectory(m_directory);
+  FileLock lock(m_path + ".lock", true);
+
+  json tokens = json::object();
+  std::vector<uint8_t> content;
+  if (ReadCacheFile(m_path, content))
+  {
+    try
+    {
+      tokens = json::parse(Decrypt(content));
+    }
+    catch (std::exception const&)
+    {
+      // The file is replaced if it can no longer be read, for example after the key has changed.
+      tokens = json::object();
+    }
+  }
+
+  // Expired tokens are removed, so that the file does not grow.
+  auto const now = DateTime(std::chrono::system_clock::now());
+  for (auto entry = tokens.begin(); entry != tokens.end();)
+  {
+    auto const expiresOn = DateTime::Parse(
+        entry.value().at("expires_on").get<std::string>(), DateTime::DateFormat::Rfc3339);
+    entry = expiresOn <= now ? tokens.erase(entry) : std::next(entry);
+  }
+
+  tokens[key] = json{
+      {"token", token.Token},
+      {"expires_on", token.ExpiresOn.ToString(DateTime::DateFormat::Rfc3339)}};
+
+  WriteCacheFile(m_path, Encrypt(tokens.dump()));
+}
+
+#if defined(AZ_IDENTITY_CACHE_USE_OPENSSL)
+std::vector<uint8_t> PersistentTokenCache::Encrypt(std::string const& plaintext) const
+{
+  auto const& key = m_encryptionKey;
+
+  // The IV, the tag, and then the ciphertext.
+  std::vector<uint8_t> result(IvSize + TagSize + plaintext.size());
+  if (RAND_bytes(result.data(), static_cast<int>(IvSize)) != 1)
+  {
+    throw std::runtime_error("Failed to generate the token cache IV.");
+  }
+
+  CipherContext context(EVP_CIPHER_CTX_new());
+  int length = 0;
+  if (!context
+      || EVP_EncryptInit_ex(context.get(), EVP_aes_256_gcm(), nullptr, key.data(), result.data())
+          != 1
+      || EVP_EncryptUpdate(
+             context.get(),
+             result.data() + IvSize + TagSize,
+             &length,
+             reinterpret_cast<uint8_t const*>(plaintext.data()),
+             static_cast<int>(plaintext.size()))
+          != 1
+      || EVP_EncryptFinal_ex(context.get(), result.data() + IvSize + TagSize + length, &length)
+          != 1
+      || EVP_CIPHER_CTX_ctrl(
+             context.get(), EVP_CTRL_GCM_GET_TAG, static_cast<int>(TagSize), result.data() + IvSize)
+          != 1)
+  {
+    throw std::runtime_error("Failed to encrypt the token cache.");
+  }
+
+  return result;
+}
+
+std::string PersistentTokenCache::Decrypt(std::vector<uint8_t> const& ciphertext) const
+{
+  if (ciphertext.size() < IvSize + TagSize)
+  {
+    throw std::runtime_error("The token cache is corrupted.");
+  }
+
+  auto const& key = m_encryptionKey;
+  std::string result(ciphertext.size() - IvSize - TagSize, '\0');
+  std::vector<uint8_t> tag(ciphertext.begin() + IvSize, ciphertext.begin() + IvSize + TagSize);
+
+  CipherContext context(EVP_CIPHER_CTX_new());
+  int length = 0;
+  if (!context
+      || EVP_DecryptInit_ex(
+             context.get(), EVP_aes_256_gcm(), nullptr, key.data(), ciphertext.data())
+          != 1
+      || EVP_DecryptUpdate(
+             context.get(),
+             reinterpret_cast<uint8_t*>(&result[0]),
+             &length,
+             ciphertext.data() + IvSize + TagSize,
+             static_cast<int>(result.size()))
+          != 1
+      || EVP_CIPHER_CTX_ctrl(
+             context.get(), EVP_CTRL_GCM_SET_TAG, static_cast<int>(TagSize), tag.data())
+          != 1
+      || EVP_DecryptFinal_ex(
+             context.get(), reinterpret_cast<uint8_t*>(&result[0]) + length, &length)
+          != 1)
+  {
+    throw std::runtime_error("Failed to decrypt the token cache.");
+  }
+
+  return result;
+}
+#else
+std::vector<uint8_t> PersistentTokenCache::Encrypt(std::string const& plaintext) const
+{
+  DATA_BLOB input{
+      static_cast<DWORD>(plaintext.size()),
+      reinterpret_cast<BYTE*>(const_cast<char*>(plaintext.data()))};
+  DATA_BLOB output{};
+  if (!CryptProtectData(
+          &input, nullptr, nullptr, nullptr, nullptr, CRYPTPROTECT_UI_FORBIDDEN, &output))
+  {
+    throw std::runtime_error("Failed to encrypt the token cache.");
+  }
+
+  std::vector<uint8_t> result(output.pbData, output.pbData + output.cbData);
+  LocalFree(output.pbData);
+  return result;
+}
+
+std::string PersistentTokenCache::Decrypt(std::vector<uint8_t> const& ciphertext) const
+{
+  DATA_BLOB input{
+      static_cast<DWORD>(ciphertext.size()),
+      reinterpret_cast<BYTE*>(const_cast<uint8_t*>(ciphertext.data()))};
+  DATA_BLOB output{};
+  if (!CryptUnprotectData(
+          &input, nullptr, nullptr, nullptr, nullptr, CRYPTPROTECT_UI_FORBIDDEN, &output))
+  {
+    throw std::runtime_error("Failed to decrypt the token cache.");
+  }
+
+  std::string result(reinterpret_cast<char const*>(output.pbData), output.cbData);
+  LocalFree(output.pbData);
+  return result;
+}
+#endif
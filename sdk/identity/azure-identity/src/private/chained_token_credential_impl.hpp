@@ -26,7 +26,8 @@ namespace Azure { namespace Identity { namespace _detail {
     ChainedTokenCredentialImpl(
         std::string const& credentialName,
         ChainedTokenCredential::Sources&& sources,
-        bool reuseSuccessfulSource = false);
+        bool reuseSuccessfulSource = false,
+        bool probeSourcesConcurrently = false);
 
     Core::Credentials::AccessToken GetToken(
         std::string const& credentialName,
@@ -42,6 +43,7 @@ namespace Azure { namespace Identity { namespace _detail {
     // This needs to be atomic so that sentinel comparison is thread safe.
     mutable std::atomic<std::size_t> m_successfulSourceIndex = {SuccessfulSourceNotSet};
     bool m_reuseSuccessfulSource;
+    bool m_probeSourcesConcurrently;
   };
 
 }}} // namespace Azure::Identity::_detail
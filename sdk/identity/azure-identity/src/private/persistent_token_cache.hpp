@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "azure/identity/token_cache_persistence_options.hpp"
+
+#include <azure/core/credentials/credentials.hpp>
+#include <azure/core/datetime.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Identity { namespace _detail {
+
+  /**
+   * @brief Access tokens stored in an encrypted file, shared by several processes.
+   *
+   * @details Every access locks the file: reads take a shared lock, and writes an exclusive lock
+   * for the duration of the read-modify-write. The file is replaced atomically, so that it is
+   * never seen partially written. Expired tokens are removed when a token is written.
+   *
+   */
+  class PersistentTokenCache final {
+  public:
+    /**
+     * @brief Construct a new PersistentTokenCache.
+     *
+     * @throw std::invalid_argument The name is empty, or the encryption key is missing or is not
+     * 256 bits long on a platform which requires it.
+     */
+    explicit PersistentTokenCache(TokenCachePersistenceOptions const& options);
+
+    /**
+     * @brief Gets a token from the file.
+     *
+     * @return `true` if the file has a token for the \p key which does not expire within
+     * \p minimumExpiration.
+     *
+     * @throw std::runtime_error The file could not be read or decrypted.
+     */
+    bool TryGetToken(
+        std::string const& key,
+        DateTime::duration minimumExpiration,
+        Core::Credentials::AccessToken& token) const;
+
+    /**
+     * @brief Stores a token in the file.
+     *
+     * @throw std::runtime_error The file could not be written.
+     */
+    void SetToken(std::string const& key, Core::Credentials::AccessToken const& token) const;
+
+    std::string const& GetPath() const { return m_path; }
+
+  private:
+    std::vector<uint8_t> Encrypt(std::string const& plaintext) const;
+    std::string Decrypt(std::vector<uint8_t> const& ciphertext) const;
+
+    std::string m_directory;
+    std::string m_path;
+    std::vector<uint8_t> m_encryptionKey;
+  };
+
+}}} // namespace Azure::Identity::_detail
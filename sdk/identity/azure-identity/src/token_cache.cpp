@@ -3,11 +3,18 @@
 
 #include "azure/identity/detail/token_cache.hpp"
 
+#include "private/identity_log.hpp"
+#include "private/persistent_token_cache.hpp"
+
 #include <algorithm>
 #include <array>
+#include <exception>
 #include <limits>
 #include <mutex>
+#include <utility>
 
+using Azure::Identity::_detail::IdentityLog;
+using Azure::Identity::_detail::PersistentTokenCache;
 using Azure::Identity::_detail::TokenCache;
 
 using Azure::DateTime;
@@ -86,6 +93,14 @@ std::shared_ptr<TokenCache::CacheValue> TokenCache::GetOrCreateValue(
   return m_cache[key] = std::make_shared<CacheValue>();
 }
 
+void TokenCache::EnablePersistence(
+    TokenCachePersistenceOptions const& options,
+    std::string partition)
+{
+  m_persistentCache = std::make_shared<PersistentTokenCache>(options);
+  m_persistentCachePartition = std::move(partition);
+}
+
 AccessToken TokenCache::GetToken(
     std::string const& scopeString,
     std::string const& tenantId,
@@ -116,8 +131,46 @@ AccessToken TokenCache::GetToken(
     return item->AccessToken;
   }
 
+  // Another process may have already got the token. Failures to use the file are not fatal, the
+  // token is then requested as if the file did not exist.
+  std::string persistentKey;
+  if (m_persistentCache)
+  {
+    persistentKey = m_persistentCachePartition + '|' + tenantId + '|' + scopeString;
+    try
+    {
+      AccessToken persistedToken;
+      if (m_persistentCache->TryGetToken(persistentKey, minimumExpiration, persistedToken))
+      {
+        item->AccessToken = persistedToken;
+        return persistedToken;
+      }
+    }
+    catch (std::exception const& e)
+    {
+      IdentityLog::Write(
+          IdentityLog::Level::Warning,
+          "Failed to read the token cache '" + m_persistentCache->GetPath() + "': " + e.what());
+    }
+  }
+
   auto const newToken = getNewToken();
   item->AccessToken = newToken;
+
+  if (m_persistentCache)
+  {
+    try
+    {
+      m_persistentCache->SetToken(persistentKey, newToken);
+    }
+    catch (std::exception const& e)
+    {
+      IdentityLog::Write(
+          IdentityLog::Level::Warning,
+          "Failed to write the token cache '" + m_persistentCache->GetPath() + "': " + e.what());
+    }
+  }
+
   return newToken;
 }
 
@@ -5,13 +5,17 @@
 
 #include <azure/core/diagnostics/logger.hpp>
 
+#include <atomic>
+#include <chrono>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include <gtest/gtest.h>
 
 using Azure::Identity::ChainedTokenCredential;
+using Azure::Identity::ChainedTokenCredentialOptions;
 
 using Azure::Core::Context;
 using Azure::Core::Credentials::AccessToken;
@@ -43,6 +47,51 @@ public:
     return token;
   }
 };
+
+// Takes some time to succeed or fail, unless it is cancelled.
+class SlowCredential : public TokenCredential {
+private:
+  std::string m_token;
+  std::chrono::milliseconds m_delay;
+
+public:
+  SlowCredential(std::chrono::milliseconds delay, std::string token = "")
+      : TokenCredential("SlowCredential"), m_token(token), m_delay(delay)
+  {
+  }
+
+  mutable std::atomic<bool> WasCancelled{false};
+
+  AccessToken GetToken(TokenRequestContext const&, Context const& context) const override
+  {
+    auto const end = std::chrono::steady_clock::now() + m_delay;
+    while (std::chrono::steady_clock::now() < end)
+    {
+      if (context.IsCancelled())
+      {
+        WasCancelled = true;
+        throw AuthenticationException("Cancelled");
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    if (m_token.empty())
+    {
+      throw AuthenticationException("Test Error");
+    }
+
+    AccessToken token;
+    token.Token = m_token;
+    return token;
+  }
+};
+
+ChainedTokenCredentialOptions ConcurrentOptions()
+{
+  ChainedTokenCredentialOptions options;
+  options.ProbeSourcesConcurrently = true;
+  return options;
+}
 } // namespace
 
 TEST(ChainedTokenCredential, GetCredentialName)
@@ -211,3 +260,51 @@ TEST(ChainedTokenCredential, Logging)
 
   Logger::SetListener(nullptr);
 }
+
+TEST(ChainedTokenCredential, ConcurrentPrefersFirstSource)
+{
+  using namespace std::chrono_literals;
+  auto c1 = std::make_shared<SlowCredential>(200ms, "Token1");
+  auto c2 = std::make_shared<SlowCredential>(0ms, "Token2");
+  ChainedTokenCredential cred({c1, c2}, ConcurrentOptions());
+
+  EXPECT_EQ(cred.GetToken({}, {}).Token, "Token1");
+}
+
+TEST(ChainedTokenCredential, ConcurrentFailuresOverlap)
+{
+  using namespace std::chrono_literals;
+  auto c1 = std::make_shared<SlowCredential>(300ms);
+  auto c2 = std::make_shared<SlowCredential>(300ms);
+  auto c3 = std::make_shared<SlowCredential>(300ms, "Token3");
+  ChainedTokenCredential cred({c1, c2, c3}, ConcurrentOptions());
+
+  auto const start = std::chrono::steady_clock::now();
+  EXPECT_EQ(cred.GetToken({}, {}).Token, "Token3");
+  // One after the other, the sources would take 900ms.
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 800ms);
+}
+
+TEST(ChainedTokenCredential, ConcurrentCancelsRemainingSources)
+{
+  using namespace std::chrono_literals;
+  auto c1 = std::make_shared<SlowCredential>(0ms, "Token1");
+  auto c2 = std::make_shared<SlowCredential>(10s, "Token2");
+  ChainedTokenCredential cred({c1, c2}, ConcurrentOptions());
+
+  auto const start = std::chrono::steady_clock::now();
+  EXPECT_EQ(cred.GetToken({}, {}).Token, "Token1");
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 5s);
+  EXPECT_TRUE(c2->WasCancelled);
+}
+
+TEST(ChainedTokenCredential, ConcurrentAllErrors)
+{
+  auto c1 = std::make_shared<TestCredential>();
+  auto c2 = std::make_shared<TestCredential>();
+  ChainedTokenCredential cred({c1, c2}, ConcurrentOptions());
+
+  EXPECT_THROW(cred.GetToken({}, {}), AuthenticationException);
+  EXPECT_TRUE(c1->WasInvoked);
+  EXPECT_TRUE(c2->WasInvoked);
+}
@@ -0,0 +1,198 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/identity/detail/token_cache.hpp"
+#include "private/persistent_token_cache.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using Azure::DateTime;
+using Azure::Core::Credentials::AccessToken;
+using Azure::Identity::TokenCachePersistenceOptions;
+using Azure::Identity::_detail::PersistentTokenCache;
+using Azure::Identity::_detail::TokenCache;
+
+using namespace std::chrono_literals;
+
+namespace {
+class PersistentTokenCacheTest : public testing::Test {
+protected:
+  TokenCachePersistenceOptions Options;
+
+  void SetUp() override
+  {
+    auto const* testInfo = testing::UnitTest::GetInstance()->current_test_info();
+    Options.Directory = testing::TempDir();
+    Options.Name = std::string("azure-identity-test-") + testInfo->name() + ".cache";
+    Options.EncryptionKey = std::vector<uint8_t>(32, 0x5A);
+    RemoveFiles();
+  }
+
+  void TearDown() override { RemoveFiles(); }
+
+  void RemoveFiles() const
+  {
+    auto const path = PersistentTokenCache(Options).GetPath();
+    std::remove(path.c_str());
+    std::remove((path + ".lock").c_str());
+  }
+
+  static AccessToken CreateToken(std::string const& value, DateTime::duration lifetime)
+  {
+    AccessToken token;
+    token.Token = value;
+    token.ExpiresOn = std::chrono::system_clock::now() + lifetime;
+    return token;
+  }
+};
+} // namespace
+
+TEST_F(PersistentTokenCacheTest, RoundTrip)
+{
+  AccessToken token;
+  EXPECT_FALSE(PersistentTokenCache(Options).TryGetToken("A", 2min, token));
+
+  auto const expected = CreateToken("T1", 1h);
+  PersistentTokenCache(Options).SetToken("A", expected);
+  PersistentTokenCache(Options).SetToken("B", CreateToken("T2", 1h));
+
+  ASSERT_TRUE(PersistentTokenCache(Options).TryGetToken("A", 2min, token));
+  EXPECT_EQ(token.Token, "T1");
+  EXPECT_EQ(
+      std::chrono::duration_cast<std::chrono::seconds>(token.ExpiresOn - expected.ExpiresOn)
+          .count(),
+      0);
+
+  ASSERT_TRUE(PersistentTokenCache(Options).TryGetToken("B", 2min, token));
+  EXPECT_EQ(token.Token, "T2");
+  EXPECT_FALSE(PersistentTokenCache(Options).TryGetToken("C", 2min, token));
+}
+
+TEST_F(PersistentTokenCacheTest, FileIsEncrypted)
+{
+  PersistentTokenCache cache(Options);
+  cache.SetToken("A", CreateToken("SecretTokenValue", 1h));
+
+  std::ifstream file(cache.GetPath(), std::ios::binary);
+  std::string const content(
+      (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  EXPECT_FALSE(content.empty());
+  EXPECT_EQ(content.find("SecretTokenValue"), std::string::npos);
+}
+
+TEST_F(PersistentTokenCacheTest, ExpiringTokensAreNotRead)
+{
+  PersistentTokenCache cache(Options);
+  cache.SetToken("A", CreateToken("T1", 1min));
+
+  AccessToken token;
+  EXPECT_FALSE(cache.TryGetToken("A", 2min, token));
+  EXPECT_TRUE(cache.TryGetToken("A", 30s, token));
+}
+
+#if !defined(AZ_PLATFORM_WINDOWS)
+TEST_F(PersistentTokenCacheTest, WrongKey)
+{
+  PersistentTokenCache(Options).SetToken("A", CreateToken("T1", 1h));
+
+  auto otherOptions = Options;
+  otherOptions.EncryptionKey = std::vector<uint8_t>(32, 0x33);
+  PersistentTokenCache otherCache(otherOptions);
+
+  AccessToken token;
+  EXPECT_THROW(otherCache.TryGetToken("A", 2min, token), std::runtime_error);
+
+  // A file which cannot be decrypted is replaced.
+  otherCache.SetToken("B", CreateToken("T2", 1h));
+  EXPECT_TRUE(otherCache.TryGetToken("B", 2min, token));
+  EXPECT_FALSE(otherCache.TryGetToken("A", 2min, token));
+}
+
+TEST_F(PersistentTokenCacheTest, InvalidKeySize)
+{
+  auto options = Options;
+  options.EncryptionKey = std::vector<uint8_t>(16, 0x5A);
+  EXPECT_THROW(PersistentTokenCache{options}, std::invalid_argument);
+}
+
+TEST_F(PersistentTokenCacheTest, MissingKey)
+{
+  auto options = Options;
+  options.EncryptionKey.clear();
+  EXPECT_THROW(PersistentTokenCache{options}, std::invalid_argument);
+}
+#endif
+
+TEST_F(PersistentTokenCacheTest, CreatesParentDirectories)
+{
+  auto const root = Options.Directory + "/azure-identity-test-parent";
+  auto options = Options;
+  options.Directory = root + "/nested/";
+  PersistentTokenCache(options).SetToken("A", CreateToken("T1", 1h));
+
+  AccessToken token;
+  ASSERT_TRUE(PersistentTokenCache(options).TryGetToken("A", 2min, token));
+  EXPECT_EQ(token.Token, "T1");
+
+  auto const path = PersistentTokenCache(options).GetPath();
+  std::remove(path.c_str());
+  std::remove((path + ".lock").c_str());
+  std::remove((root + "/nested").c_str());
+  std::remove(root.c_str());
+}
+
+TEST_F(PersistentTokenCacheTest, SharedByTokenCaches)
+{
+  TokenCache cache1;
+  cache1.EnablePersistence(Options, "credential");
+
+  auto const token1 = cache1.GetToken("scope", "tenant", 2min, [] {
+    return CreateToken("T1", 1h);
+  });
+  EXPECT_EQ(token1.Token, "T1");
+
+  TokenCache cache2;
+  cache2.EnablePersistence(Options, "credential");
+
+  auto const token2 = cache2.GetToken("scope", "tenant", 2min, []() -> AccessToken {
+    throw std::runtime_error("The token should have been read from the file.");
+  });
+  EXPECT_EQ(token2.Token, "T1");
+
+  // Tokens of other credentials are not shared.
+  TokenCache cache3;
+  cache3.EnablePersistence(Options, "other");
+
+  auto const token3 = cache3.GetToken("scope", "tenant", 2min, [] {
+    return CreateToken("T3", 1h);
+  });
+  EXPECT_EQ(token3.Token, "T3");
+}
+
+TEST_F(PersistentTokenCacheTest, UnreadableFileIsIgnored)
+{
+  {
+    std::ofstream file(PersistentTokenCache(Options).GetPath(), std::ios::binary);
+    file << "not a token cache";
+  }
+
+  TokenCache cache;
+  cache.EnablePersistence(Options, "credential");
+
+  auto const token = cache.GetToken("scope", "tenant", 2min, [] {
+    return CreateToken("T1", 1h);
+  });
+  EXPECT_EQ(token.Token, "T1");
+
+  AccessToken stored;
+  // The file was replaced with the new token.
+  EXPECT_TRUE(PersistentTokenCache(Options).TryGetToken("credential|tenant|scope", 2min, stored));
+}
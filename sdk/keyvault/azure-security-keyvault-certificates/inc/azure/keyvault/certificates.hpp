@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "azure/keyvault/certificates/cached_certificate_client.hpp"
 #include "azure/keyvault/certificates/certificate_client.hpp"
 #include "azure/keyvault/certificates/certificate_client_models.hpp"
 #include "azure/keyvault/certificates/certificate_client_operations.hpp"
@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Defines a client-side cache of Key Vault certificates.
+ *
+ */
+
+#pragma once
+
+#include "azure/keyvault/certificates/certificate_client.hpp"
+#include "azure/keyvault/certificates/certificate_client_models.hpp"
+#include "azure/keyvault/certificates/certificate_client_options.hpp"
+
+#include <azure/core/context.hpp>
+
+#include <memory>
+#include <string>
+
+namespace Azure { namespace Security { namespace KeyVault { namespace Certificates {
+  namespace _detail {
+    class CertificateCache;
+    class CertificateVersionCache;
+  } // namespace _detail
+
+  /**
+   * @brief The CachedCertificateClient serves certificates from a client-side cache, and gets them
+   * from a CertificateClient when they are not cached.
+   *
+   * @details The latest version of a certificate is cached for TimeToLive, and can be refreshed
+   * in the background every RefreshInterval. A certificate requested with a version never
+   * changes, and is cached until it is invalidated. Concurrent requests for a certificate which
+   * is not cached result in a single request to Key Vault. Errors are not cached.
+   *
+   * The CachedCertificateClient is thread-safe.
+   */
+  class CachedCertificateClient final {
+  public:
+    /**
+     * @brief Construct a new CachedCertificateClient.
+     *
+     * @param client The client used to get certificates which are not cached.
+     * @param options Options controlling how long certificates are cached.
+     */
+    explicit CachedCertificateClient(
+        std::shared_ptr<CertificateClient const> client,
+        CachedCertificateClientOptions const& options = CachedCertificateClientOptions());
+
+    /**
+     * @brief Stops the background refresh and releases the cached certificates.
+     *
+     */
+    ~CachedCertificateClient();
+
+    CachedCertificateClient(CachedCertificateClient const&) = delete;
+    CachedCertificateClient& operator=(CachedCertificateClient const&) = delete;
+
+    /**
+     * @brief Get the latest version of a certificate, along with its policy, from the cache or
+     * from Key Vault if it is not cached or has expired.
+     *
+     * @remark This operation requires the certificates/get permission.
+     *
+     * @param certificateName The name of the certificate.
+     * @param context The context for the operation can be used for request cancellation.
+     * @return The certificate with its policy.
+     */
+    KeyVaultCertificateWithPolicy GetCertificate(
+        std::string const& certificateName,
+        Azure::Core::Context const& context = Azure::Core::Context()) const;
+
+    /**
+     * @brief Get a specific version of a certificate from the cache, or from Key Vault if it is
+     * not cached.
+     *
+     * @remark This operation requires the certificates/get permission.
+     *
+     * @param certificateName The name of the certificate.
+     * @param certificateVersion The version of the certificate.
+     * @param context The context for the operation can be used for request cancellation.
+     * @return The certificate.
+     */
+    KeyVaultCertificate GetCertificateVersion(
+        std::string const& certificateName,
+        std::string const& certificateVersion,
+        Azure::Core::Context const& context = Azure::Core::Context()) const;
+
+    /**
+     * @brief Remove every cached version of a certificate, for instance after it has been
+     * updated.
+     *
+     * @param certificateName The name of the certificate.
+     */
+    void Invalidate(std::string const& certificateName);
+
+    /**
+     * @brief Remove every certificate from the cache.
+     *
+     */
+    void Clear();
+
+  private:
+    std::unique_ptr<_detail::CertificateCache> m_certificates;
+    std::unique_ptr<_detail::CertificateVersionCache> m_certificateVersions;
+  };
+}}}} // namespace Azure::Security::KeyVault::Certificates
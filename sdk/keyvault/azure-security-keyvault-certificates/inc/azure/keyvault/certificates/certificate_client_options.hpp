@@ -14,6 +14,7 @@
 
 #include <azure/core/internal/client_options.hpp>
 
+#include <chrono>
 #include <memory>
 #include <string>
 
@@ -32,4 +33,29 @@ namespace Azure { namespace Security { namespace KeyVault { namespace Certificat
     std::string ApiVersion{"7.6-preview.2"};
   };
 
+  /**
+   * @brief Define the options to create a
+   * #Azure::Security::KeyVault::Certificates::CachedCertificateClient.
+   *
+   */
+  struct CachedCertificateClientOptions final
+  {
+    /**
+     * @brief How long the latest version of a certificate is served from the cache before it is
+     * fetched again.
+     *
+     * @remark Certificates requested with a version never expire.
+     */
+    std::chrono::milliseconds TimeToLive{std::chrono::minutes(5)};
+
+    /**
+     * @brief How often the latest version of the cached certificates is refreshed in the
+     * background.
+     *
+     * @remark Background refresh is disabled if the interval is zero. To avoid waiting for the
+     * service on an expired certificate, use an interval shorter than TimeToLive.
+     */
+    std::chrono::milliseconds RefreshInterval{std::chrono::milliseconds::zero()};
+  };
+
 }}}} // namespace Azure::Security::KeyVault::Certificates
@@ -0,0 +1,87 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/keyvault/certificates/cached_certificate_client.hpp"
+
+#include "azure/keyvault/shared/keyvault_cache.hpp"
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+using namespace Azure::Security::KeyVault::Certificates;
+
+namespace Azure { namespace Security { namespace KeyVault { namespace Certificates {
+  namespace _detail {
+    class CertificateCache final
+        : public KeyVault::_internal::KeyVaultCache<KeyVaultCertificateWithPolicy> {
+    public:
+      using KeyVault::_internal::KeyVaultCache<KeyVaultCertificateWithPolicy>::KeyVaultCache;
+    };
+
+    class CertificateVersionCache final
+        : public KeyVault::_internal::KeyVaultCache<KeyVaultCertificate> {
+    public:
+      using KeyVault::_internal::KeyVaultCache<KeyVaultCertificate>::KeyVaultCache;
+    };
+  } // namespace _detail
+}}}} // namespace Azure::Security::KeyVault::Certificates
+
+CachedCertificateClient::CachedCertificateClient(
+    std::shared_ptr<CertificateClient const> client,
+    CachedCertificateClientOptions const& options)
+{
+  if (!client)
+  {
+    throw std::invalid_argument("client cannot be null.");
+  }
+  m_certificates = std::make_unique<_detail::CertificateCache>(
+      [client](std::string const& name, std::string const&, Azure::Core::Context const& context) {
+        return client->GetCertificate(name, context).Value;
+      },
+      options.TimeToLive,
+      options.RefreshInterval);
+  m_certificateVersions = std::make_unique<_detail::CertificateVersionCache>(
+      [client](
+          std::string const& name,
+          std::string const& version,
+          Azure::Core::Context const& context) {
+        return client->GetCertificateVersion(name, version, context).Value;
+      },
+      options.TimeToLive,
+      // Versions never change, there is nothing to refresh.
+      std::chrono::milliseconds::zero());
+}
+
+CachedCertificateClient::~CachedCertificateClient() = default;
+
+KeyVaultCertificateWithPolicy CachedCertificateClient::GetCertificate(
+    std::string const& certificateName,
+    Azure::Core::Context const& context) const
+{
+  return m_certificates->Get(certificateName, std::string(), context);
+}
+
+KeyVaultCertificate CachedCertificateClient::GetCertificateVersion(
+    std::string const& certificateName,
+    std::string const& certificateVersion,
+    Azure::Core::Context const& context) const
+{
+  if (certificateVersion.empty())
+  {
+    throw std::invalid_argument("certificateVersion cannot be empty.");
+  }
+  return m_certificateVersions->Get(certificateName, certificateVersion, context);
+}
+
+void CachedCertificateClient::Invalidate(std::string const& certificateName)
+{
+  m_certificates->Invalidate(certificateName);
+  m_certificateVersions->Invalidate(certificateName);
+}
+
+void CachedCertificateClient::Clear()
+{
+  m_certificates->Clear();
+  m_certificateVersions->Clear();
+}
@@ -36,6 +36,12 @@ namespace Azure {
      *
      */
     class CryptoClientInternalAccess;
+
+    /**
+     * @brief Performs public key operations in-process.
+     *
+     */
+    class LocalCryptographyProvider;
   } // namespace _detail
 
   /**
@@ -46,6 +52,7 @@ namespace Azure {
     Azure::Core::Url m_keyId;
     std::string m_apiVersion;
     std::shared_ptr<Azure::Core::Http::_internal::HttpPipeline> m_pipeline;
+    std::shared_ptr<_detail::LocalCryptographyProvider> m_localProvider;
 
   private:
     // Provide private-access to the internal layer
@@ -15,6 +15,8 @@
 
 #include <azure/core/internal/client_options.hpp>
 
+#include <chrono>
+
 namespace Azure {
   namespace Security {
     namespace KeyVault {
@@ -37,6 +39,33 @@ namespace Azure {
      */
     std::string Version;
 
+    /**
+     * @brief Perform public key operations locally.
+     *
+     * @details When enabled, the key is fetched from Key Vault on first use and cached by the
+     * client, which then performs Encrypt, WrapKey, Verify and VerifyData in-process for RSA and
+     * EC keys. Private key operations are always performed by Key Vault. Operations are also sent
+     * to Key Vault when the key cannot be fetched (for instance without the `keys/get`
+     * permission), when the key is disabled, not yet valid or expired, when its key operations do
+     * not include the requested operation, or when the algorithm is not supported locally.
+     *
+     * @remark Results of local operations carry a synthesized raw response, since no request is
+     * sent to the service. Changes made to the key after it has been fetched, such as disabling
+     * it, are only observed by local operations once the key is fetched again (see
+     * #LocalKeyTimeToLive).
+     *
+     */
+    bool EnableLocalCryptography = false;
+
+    /**
+     * @brief How long the key fetched for local cryptography is used before it is fetched again.
+     *
+     * @remark This also applies when the key could not be fetched because it does not exist or
+     * the caller is not permitted to get it: operations are sent to Key Vault until the key is
+     * requested again.
+     */
+    std::chrono::milliseconds LocalKeyTimeToLive{std::chrono::minutes(5)};
+
     /**
      * @brief Construct a new Key Client Options object.
      *
@@ -10,6 +10,7 @@
 #include "../private/key_verify_parameters.hpp"
 #include "../private/key_wrap_parameters.hpp"
 #include "../private/keyvault_protocol.hpp"
+#include "../private/local_cryptography_provider.hpp"
 #include "../private/package_version.hpp"
 #include "azure/keyvault/keys/key_client_models.hpp"
 
@@ -61,6 +62,12 @@ inline std::vector<uint8_t> CreateDigest(
   return hashAlgorithm->Final(data.data(), data.size());
 }
 
+// Local operations have no service response, they are returned with a synthesized one.
+inline std::unique_ptr<RawResponse> CreateLocalResponse()
+{
+  return std::make_unique<RawResponse>(1, 1, HttpStatusCode::Ok, "OK");
+}
+
 } // namespace
 
 Request CryptographyClient::CreateRequest(
@@ -116,12 +123,35 @@ CryptographyClient::CryptographyClient(
       PackageVersion::ToString(),
       std::move(perRetryPolicies),
       std::move(perCallPolicies));
+
+  if (options.EnableLocalCryptography)
+  {
+    // Capture the pipeline rather than the client, which can be moved.
+    auto pipeline = m_pipeline;
+    auto keyId = m_keyId;
+    auto apiVersion = m_apiVersion;
+    m_localProvider = std::make_shared<LocalCryptographyProvider>(
+        [pipeline, keyId, apiVersion](Azure::Core::Context const& context) {
+          auto request = Azure::Security::KeyVault::_detail::KeyVaultKeysCommonRequest::
+              CreateRequest(keyId, apiVersion, HttpMethod::Get, {}, nullptr);
+          request.SetHeader(HttpShared::Accept, HttpShared::ApplicationJson);
+          return Azure::Security::KeyVault::_detail::KeyVaultKeysCommonRequest::SendRequest(
+              *pipeline, request, context);
+        },
+        options.LocalKeyTimeToLive);
+  }
 }
 
 Azure::Response<EncryptResult> CryptographyClient::Encrypt(
     EncryptParameters const& parameters,
     Azure::Core::Context const& context)
 {
+  EncryptResult localResult;
+  if (m_localProvider && m_localProvider->TryEncrypt(parameters, localResult, context))
+  {
+    return Azure::Response<EncryptResult>(std::move(localResult), CreateLocalResponse());
+  }
+
   // Send and parse response
   auto rawResponse = SendCryptoRequest(
       {EncryptValue}, EncryptParametersSerializer::EncryptParametersSerialize(parameters), context);
@@ -147,6 +177,12 @@ Azure::Response<WrapResult> CryptographyClient::WrapKey(
     std::vector<uint8_t> const& key,
     Azure::Core::Context const& context)
 {
+  WrapResult localResult;
+  if (m_localProvider && m_localProvider->TryWrapKey(algorithm, key, localResult, context))
+  {
+    return Azure::Response<WrapResult>(std::move(localResult), CreateLocalResponse());
+  }
+
   // Send and parse response
   auto rawResponse = SendCryptoRequest(
       {WrapKeyValue},
@@ -212,6 +248,14 @@ Azure::Response<VerifyResult> CryptographyClient::Verify(
     std::vector<uint8_t> const& signature,
     Azure::Core::Context const& context)
 {
+  VerifyResult localResult;
+  if (m_localProvider
+      && m_localProvider->TryVerify(algorithm, digest, signature, localResult, context))
+  {
+    localResult.KeyId = this->m_keyId.GetAbsoluteUrl();
+    return Azure::Response<VerifyResult>(std::move(localResult), CreateLocalResponse());
+  }
+
   // Send and parse response
   auto rawResponse = SendCryptoRequest(
       {VerifyValue},
@@ -0,0 +1,619 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "../private/local_cryptography_provider.hpp"
+
+#include "../private/key_constants.hpp"
+#include "azure/keyvault/keys/key_client_models.hpp"
+
+#include <azure/core/base64.hpp>
+#include <azure/core/exception.hpp>
+#include <azure/core/internal/json/json.hpp>
+#include <azure/core/internal/json/json_optional.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wold-style-cast"
+#endif // __clang__
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/ecdsa.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/objects.h>
+#include <openssl/rsa.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#include <openssl/param_build.h>
+#endif
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif // __clang__
+
+using namespace Azure::Core::_internal;
+using namespace Azure::Core::Json::_internal;
+using namespace Azure::Security::KeyVault::Keys::_detail;
+
+namespace {
+// RAII wrappers for the OpenSSL types used below.
+template <typename T, void (&Deleter)(T*)> struct OpenSSLDeleter
+{
+  void operator()(T* obj) { Deleter(obj); }
+};
+template <typename T, void (&Deleter)(T*)>
+using OpenSSLUniquePtr = std::unique_ptr<T, OpenSSLDeleter<T, Deleter>>;
+
+using OpenSSLPkey = OpenSSLUniquePtr<EVP_PKEY, EVP_PKEY_free>;
+using OpenSSLPkeyContext = OpenSSLUniquePtr<EVP_PKEY_CTX, EVP_PKEY_CTX_free>;
+using OpenSSLBignum = OpenSSLUniquePtr<BIGNUM, BN_free>;
+using OpenSSLEcdsaSignature = OpenSSLUniquePtr<ECDSA_SIG, ECDSA_SIG_free>;
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+using OpenSSLParamBuilder = OpenSSLUniquePtr<OSSL_PARAM_BLD, OSSL_PARAM_BLD_free>;
+using OpenSSLParams = OpenSSLUniquePtr<OSSL_PARAM, OSSL_PARAM_free>;
+#else
+using OpenSSLRsa = OpenSSLUniquePtr<RSA, RSA_free>;
+using OpenSSLEcKey = OpenSSLUniquePtr<EC_KEY, EC_KEY_free>;
+#endif
+
+std::runtime_error OpenSSLError(std::string const& what)
+{
+  std::string message = what + " failed";
+  unsigned long error = ERR_get_error();
+  if (error != 0)
+  {
+    char buffer[256];
+    ERR_error_string_n(error, buffer, sizeof(buffer));
+    message += ": ";
+    message += buffer;
+  }
+  ERR_clear_error();
+  return std::runtime_error(message);
+}
+
+OpenSSLBignum ToBignum(std::vector<uint8_t> const& value)
+{
+  OpenSSLBignum bignum(BN_bin2bn(value.data(), static_cast<int>(value.size()), nullptr));
+  if (!bignum)
+  {
+    throw OpenSSLError("BN_bin2bn");
+  }
+  return bignum;
+}
+
+struct CurveInfo
+{
+  char const* Name;
+  int Nid;
+  size_t CoordinateSize;
+  char const* Algorithm;
+};
+
+// The curves supported by Key Vault, with the signature algorithm which uses each of them.
+CurveInfo const* FindCurve(std::string const& curveName)
+{
+  static CurveInfo const curves[] = {
+      {P256Value, NID_X9_62_prime256v1, 32, ES256Value},
+      {P256KValue, NID_secp256k1, 32, ES256KValue},
+      {P384Value, NID_secp384r1, 48, ES384Value},
+      {P521Value, NID_secp521r1, 66, ES512Value},
+  };
+  for (auto const& curve : curves)
+  {
+    if (curveName == curve.Name)
+    {
+      return &curve;
+    }
+  }
+  return nullptr;
+}
+
+// Left-pads a big-endian coordinate to the size of the curve field.
+std::vector<uint8_t> PadCoordinate(std::vector<uint8_t> const& value, size_t size)
+{
+  if (value.size() >= size)
+  {
+    return value;
+  }
+  std::vector<uint8_t> padded(size - value.size(), 0);
+  padded.insert(padded.end(), value.begin(), value.end());
+  return padded;
+}
+
+OpenSSLPkey CreateRsaKey(std::vector<uint8_t> const& n, std::vector<uint8_t> const& e)
+{
+  auto modulus = ToBignum(n);
+  auto exponent = ToBignum(e);
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+  OpenSSLParamBuilder builder(OSSL_PARAM_BLD_new());
+  if (!builder || OSSL_PARAM_BLD_push_BN(builder.get(), OSSL_PKEY_PARAM_RSA_N, modulus.get()) != 1
+      || OSSL_PARAM_BLD_push_BN(builder.get(), OSSL_PKEY_PARAM_RSA_E, exponent.get()) != 1)
+  {
+    throw OpenSSLError("OSSL_PARAM_BLD_push_BN");
+  }
+  OpenSSLParams params(OSSL_PARAM_BLD_to_param(builder.get()));
+  OpenSSLPkeyContext context(EVP_PKEY_CTX_new_from_name(nullptr, "RSA", nullptr));
+  EVP_PKEY* key = nullptr;
+  if (!params || !context || EVP_PKEY_fromdata_init(context.get()) != 1
+      || EVP_PKEY_fromdata(context.get(), &key, EVP_PKEY_PUBLIC_KEY, params.get()) != 1)
+  {
+    throw OpenSSLError("EVP_PKEY_fromdata");
+  }
+  return OpenSSLPkey(key);
+#else
+  OpenSSLRsa rsa(RSA_new());
+  if (!rsa || RSA_set0_key(rsa.get(), modulus.get(), exponent.get(), nullptr) != 1)
+  {
+    throw OpenSSLError("RSA_set0_key");
+  }
+  // The RSA key now owns the modulus and exponent.
+  modulus.release();
+  exponent.release();
+
+  OpenSSLPkey key(EVP_PKEY_new());
+  if (!key || EVP_PKEY_assign_RSA(key.get(), rsa.get()) != 1)
+  {
+    throw OpenSSLError("EVP_PKEY_assign_RSA");
+  }
+  rsa.release();
+  return key;
+#endif
+}
+
+OpenSSLPkey CreateEcKey(
+    CurveInfo const& curve,
+    std::vector<uint8_t> const& x,
+    std::vector<uint8_t> const& y)
+{
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+  // Uncompressed point encoding: 0x04 || X || Y.
+  std::vector<uint8_t> point{0x04};
+  auto paddedX = PadCoordinate(x, curve.CoordinateSize);
+  auto paddedY = PadCoordinate(y, curve.CoordinateSize);
+  point.insert(point.end(), paddedX.begin(), paddedX.end());
+  point.insert(point.end(), paddedY.begin(), paddedY.end());
+
+  OpenSSLParamBuilder builder(OSSL_PARAM_BLD_new());
+  if (!builder
+      || OSSL_PARAM_BLD_push_utf8_string(
+             builder.get(), OSSL_PKEY_PARAM_GROUP_NAME, OBJ_nid2sn(curve.Nid), 0)
+          != 1
+      || OSSL_PARAM_BLD_push_octet_string(
+             builder.get(), OSSL_PKEY_PARAM_PUB_KEY, point.data(), point.size())
+          != 1)
+  {
+    throw OpenSSLError("OSSL_PARAM_BLD_push");
+  }
+  OpenSSLParams params(OSSL_PARAM_BLD_to_param(builder.get()));
+  OpenSSLPkeyContext context(EVP_PKEY_CTX_new_from_name(nullptr, "EC", nullptr));
+  EVP_PKEY* key = nullptr;
+  if (!params || !context || EVP_PKEY_fromdata_init(context.get()) != 1
+      || EVP_PKEY_fromdata(context.get(), &key, EVP_PKEY_PUBLIC_KEY, params.get()) != 1)
+  {
+    throw OpenSSLError("EVP_PKEY_fromdata");
+  }
+  return OpenSSLPkey(key);
+#else
+  auto pointX = ToBignum(x);
+  auto pointY = ToBignum(y);
+  OpenSSLEcKey ecKey(EC_KEY_new_by_curve_name(curve.Nid));
+  if (!ecKey
+      || EC_KEY_set_public_key_affine_coordinates(ecKey.get(), pointX.get(), pointY.get()) != 1)
+  {
+    throw OpenSSLError("EC_KEY_set_public_key_affine_coordinates");
+  }
+
+  OpenSSLPkey key(EVP_PKEY_new());
+  if (!key || EVP_PKEY_assign_EC_KEY(key.get(), ecKey.get()) != 1)
+  {
+    throw OpenSSLError("EVP_PKEY_assign_EC_KEY");
+  }
+  ecKey.release();
+  return key;
+#endif
+}
+
+// Converts a JWS signature (R || S) to the DER encoded ECDSA-Sig-Value expected by OpenSSL.
+// Returns an empty vector if the signature does not have the length required by the curve.
+std::vector<uint8_t> ToDerSignature(CurveInfo const& curve, std::vector<uint8_t> const& signature)
+{
+  if (signature.size() != 2 * curve.CoordinateSize)
+  {
+    return {};
+  }
+  auto const half = static_cast<int>(curve.CoordinateSize);
+  OpenSSLBignum r(BN_bin2bn(signature.data(), half, nullptr));
+  OpenSSLBignum s(BN_bin2bn(signature.data() + half, half, nullptr));
+  OpenSSLEcdsaSignature ecdsaSignature(ECDSA_SIG_new());
+  if (!r || !s || !ecdsaSignature || ECDSA_SIG_set0(ecdsaSignature.get(), r.get(), s.get()) != 1)
+  {
+    throw OpenSSLError("ECDSA_SIG_set0");
+  }
+  // The signature now owns R and S.
+  r.release();
+  s.release();
+
+  int length = i2d_ECDSA_SIG(ecdsaSignature.get(), nullptr);
+  if (length <= 0)
+  {
+    throw OpenSSLError("i2d_ECDSA_SIG");
+  }
+  std::vector<uint8_t> der(static_cast<size_t>(length));
+  auto* derPointer = der.data();
+  i2d_ECDSA_SIG(ecdsaSignature.get(), &derPointer);
+  return der;
+}
+
+EVP_MD const* GetRsaSignatureDigest(std::string const& algorithm, bool& pss)
+{
+  pss = algorithm == PS256Value || algorithm == PS384Value || algorithm == PS512Value;
+  if (algorithm == RS256Value || algorithm == PS256Value)
+  {
+    return EVP_sha256();
+  }
+  if (algorithm == RS384Value || algorithm == PS384Value)
+  {
+    return EVP_sha384();
+  }
+  if (algorithm == RS512Value || algorithm == PS512Value)
+  {
+    return EVP_sha512();
+  }
+  return nullptr;
+}
+
+bool IsRsaKeyType(std::string const& keyType)
+{
+  return keyType == RsaValue || keyType == RsaHsmValue;
+}
+
+bool IsEcKeyType(std::string const& keyType)
+{
+  return keyType == EcValue || keyType == EcHsmValue;
+}
+} // namespace
+
+namespace Azure {
+  namespace Security {
+    namespace KeyVault {
+      namespace Keys {
+        namespace Cryptography {
+  namespace _detail {
+
+    class LocalCryptographyKey final {
+    public:
+      std::string KeyId;
+      std::string KeyType;
+      std::string CurveName;
+      Azure::Nullable<std::vector<std::string>> KeyOperations;
+      bool Enabled{true};
+      Azure::Nullable<int64_t> NotBefore;
+      Azure::Nullable<int64_t> ExpiresOn;
+      OpenSSLPkey Key;
+
+      bool CanPerform(std::string const& operation) const
+      {
+        if (!Enabled)
+        {
+          return false;
+        }
+        auto const now = std::chrono::duration_cast<std::chrono::seconds>(
+                             std::chrono::system_clock::now().time_since_epoch())
+                             .count();
+        if ((NotBefore.HasValue() && now < NotBefore.Value())
+            || (ExpiresOn.HasValue() && now >= ExpiresOn.Value()))
+        {
+          return false;
+        }
+        // A key without key_ops permits every operation.
+        return !KeyOperations.HasValue()
+            || std::find(KeyOperations.Value().begin(), KeyOperations.Value().end(), operation)
+            != KeyOperations.Value().end();
+      }
+
+      // Returns false if the algorithm is not supported locally.
+      bool Encrypt(
+          std::string const& algorithm,
+          std::vector<uint8_t> const& plaintext,
+          std::vector<uint8_t>& ciphertext) const
+      {
+        if (!IsRsaKeyType(KeyType))
+        {
+          return false;
+        }
+        int padding;
+        EVP_MD const* oaepDigest = nullptr;
+        if (algorithm == Rsa15Value)
+        {
+          padding = RSA_PKCS1_PADDING;
+        }
+        else if (algorithm == RsaOaepValue)
+        {
+          padding = RSA_PKCS1_OAEP_PADDING;
+          oaepDigest = EVP_sha1();
+        }
+        else if (algorithm == RsaOaep256Value)
+        {
+          padding = RSA_PKCS1_OAEP_PADDING;
+          oaepDigest = EVP_sha256();
+        }
+        else
+        {
+          return false;
+        }
+
+        OpenSSLPkeyContext context(EVP_PKEY_CTX_new(Key.get(), nullptr));
+        if (!context || EVP_PKEY_encrypt_init(context.get()) != 1
+            || EVP_PKEY_CTX_set_rsa_padding(context.get(), padding) != 1)
+        {
+          throw OpenSSLError("EVP_PKEY_encrypt_init");
+        }
+        if (oaepDigest != nullptr
+            && (EVP_PKEY_CTX_set_rsa_oaep_md(context.get(), oaepDigest) != 1
+                || EVP_PKEY_CTX_set_rsa_mgf1_md(context.get(), oaepDigest) != 1))
+        {
+          throw OpenSSLError("EVP_PKEY_CTX_set_rsa_oaep_md");
+        }
+
+        size_t length = 0;
+        if (EVP_PKEY_encrypt(context.get(), nullptr, &length, plaintext.data(), plaintext.size())
+            != 1)
+        {
+          throw OpenSSLError("EVP_PKEY_encrypt");
+        }
+        ciphertext.resize(length);
+        if (EVP_PKEY_encrypt(
+                context.get(), ciphertext.data(), &length, plaintext.data(), plaintext.size())
+            != 1)
+        {
+          throw OpenSSLError("EVP_PKEY_encrypt");
+        }
+        ciphertext.resize(length);
+        return true;
+      }
+
+      // Returns false if the algorithm is not supported locally.
+      bool Verify(
+          std::string const& algorithm,
+          std::vector<uint8_t> const& digest,
+          std::vector<uint8_t> const& signature,
+          bool& isValid) const
+      {
+        std::vector<uint8_t> derSignature;
+        OpenSSLPkeyContext context(EVP_PKEY_CTX_new(Key.get(), nullptr));
+        if (!context || EVP_PKEY_verify_init(context.get()) != 1)
+        {
+          throw OpenSSLError("EVP_PKEY_verify_init");
+        }
+
+        if (IsRsaKeyType(KeyType))
+        {
+          bool pss = false;
+          auto const* md = GetRsaSignatureDigest(algorithm, pss);
+          // Let the service report a digest which does not match the algorithm.
+          if (md == nullptr || digest.size() != static_cast<size_t>(EVP_MD_size(md)))
+          {
+            return false;
+          }
+          if (EVP_PKEY_CTX_set_rsa_padding(
+                  context.get(), pss ? RSA_PKCS1_PSS_PADDING : RSA_PKCS1_PADDING)
+                  != 1
+              || EVP_PKEY_CTX_set_signature_md(context.get(), md) != 1)
+          {
+            throw OpenSSLError("EVP_PKEY_CTX_set_signature_md");
+          }
+          // Key Vault uses a salt as long as the digest.
+          if (pss
+              && (EVP_PKEY_CTX_set_rsa_pss_saltlen(context.get(), RSA_PSS_SALTLEN_DIGEST) != 1
+                  || EVP_PKEY_CTX_set_rsa_mgf1_md(context.get(), md) != 1))
+          {
+            throw OpenSSLError("EVP_PKEY_CTX_set_rsa_pss_saltlen");
+          }
+        }
+        else if (IsEcKeyType(KeyType))
+        {
+          auto const* curve = FindCurve(CurveName);
+          if (curve == nullptr || algorithm != curve->Algorithm)
+          {
+            return false;
+          }
+          derSignature = ToDerSignature(*curve, signature);
+          if (derSignature.empty())
+          {
+            isValid = false;
+            return true;
+          }
+        }
+        else
+        {
+          return false;
+        }
+
+        auto const& verifiedSignature = derSignature.empty() ? signature : derSignature;
+        isValid = EVP_PKEY_verify(
+                      context.get(),
+                      verifiedSignature.data(),
+                      verifiedSignature.size(),
+                      digest.data(),
+                      digest.size())
+            == 1;
+        // A malformed signature leaves an error behind, it is reported as an invalid signature.
+        ERR_clear_error();
+        return true;
+      }
+    };
+
+    LocalCryptographyProvider::LocalCryptographyProvider(
+        KeyFetcher fetchKey,
+        std::chrono::milliseconds timeToLive)
+        : m_fetchKey(std::move(fetchKey)), m_timeToLive(timeToLive)
+    {
+    }
+
+    LocalCryptographyProvider::~LocalCryptographyProvider() = default;
+
+    std::shared_ptr<LocalCryptographyKey const> LocalCryptographyProvider::DeserializeKey(
+        Azure::Core::Http::RawResponse const& rawResponse)
+    {
+      auto const& body = rawResponse.GetBody();
+      auto jsonParser = json::parse(body);
+      if (!jsonParser.contains("key") || !jsonParser["key"].is_object())
+      {
+        return nullptr;
+      }
+      auto const& jsonKey = jsonParser["key"];
+      auto key = std::make_shared<LocalCryptographyKey>();
+
+      auto getString = [&jsonKey](char const* name) {
+        return jsonKey.contains(name) && jsonKey[name].is_string()
+            ? jsonKey[name].get<std::string>()
+            : std::string{};
+      };
+      key->KeyId = getString(KeyIdPropertyName);
+      key->KeyType = getString("kty");
+      key->CurveName = getString("crv");
+      if (jsonKey.contains("key_ops") && jsonKey["key_ops"].is_array())
+      {
+        key->KeyOperations = jsonKey["key_ops"].get<std::vector<std::string>>();
+      }
+
+      if (jsonParser.contains("attributes") && jsonParser["attributes"].is_object())
+      {
+        auto const& attributes = jsonParser["attributes"];
+        if (attributes.contains("enabled") && attributes["enabled"].is_boolean())
+        {
+          key->Enabled = attributes["enabled"].get<bool>();
+        }
+        JsonOptional::SetIfExists(key->NotBefore, attributes, "nbf");
+        JsonOptional::SetIfExists(key->ExpiresOn, attributes, "exp");
+      }
+
+      auto getComponent = [&getString](char const* name) {
+        auto const value = getString(name);
+        return value.empty() ? std::vector<uint8_t>{} : Base64Url::Base64UrlDecode(value);
+      };
+
+      if (IsRsaKeyType(key->KeyType))
+      {
+        auto n = getComponent("n");
+        auto e = getComponent("e");
+        if (n.empty() || e.empty())
+        {
+          return nullptr;
+        }
+        key->Key = CreateRsaKey(n, e);
+      }
+      else if (IsEcKeyType(key->KeyType))
+      {
+        auto const* curve = FindCurve(key->CurveName);
+        auto x = getComponent("x");
+        auto y = getComponent("y");
+        if (curve == nullptr || x.empty() || y.empty())
+        {
+          return nullptr;
+        }
+        key->Key = CreateEcKey(*curve, x, y);
+      }
+      else
+      {
+        // Symmetric keys never leave Key Vault.
+        return nullptr;
+      }
+      return key;
+    }
+
+    std::shared_ptr<LocalCryptographyKey const> LocalCryptographyProvider::GetKey(
+        std::string const& operation,
+        Azure::Core::Context const& context)
+    {
+      std::shared_ptr<LocalCryptographyKey const> key;
+      {
+        std::lock_guard<std::mutex> lock(m_keyMutex);
+        auto const now = std::chrono::steady_clock::now();
+        if (!m_keyFetched || now >= m_keyExpiresOn)
+        {
+          try
+          {
+            m_key = DeserializeKey(*m_fetchKey(context));
+            m_keyFetched = true;
+            m_keyExpiresOn = now + m_timeToLive;
+          }
+          catch (Azure::Core::RequestFailedException const& ex)
+          {
+            // If the caller is not permitted to get the key (or it cannot be found), operations
+            // are sent to the service, which only requires permission for the operation itself,
+            // until the key is requested again. Any other failure may be transient: the key
+            // fetched previously, if any, is used for this operation and the key is requested
+            // again by the next one.
+            if (ex.StatusCode != Azure::Core::Http::HttpStatusCode::Forbidden
+                && ex.StatusCode != Azure::Core::Http::HttpStatusCode::NotFound)
+            {
+              return m_key && m_key->CanPerform(operation) ? m_key : nullptr;
+            }
+            m_key.reset();
+            m_keyFetched = true;
+            m_keyExpiresOn = now + m_timeToLive;
+          }
+        }
+        key = m_key;
+      }
+      return key && key->CanPerform(operation) ? key : nullptr;
+    }
+
+    bool LocalCryptographyProvider::TryEncrypt(
+        EncryptParameters const& parameters,
+        EncryptResult& result,
+        Azure::Core::Context const& context)
+    {
+      auto key = GetKey(KeyOperation::Encrypt.ToString(), context);
+      if (!key
+          || !key->Encrypt(
+              parameters.Algorithm.ToString(), parameters.Plaintext, result.Ciphertext))
+      {
+        return false;
+      }
+      result.KeyId = key->KeyId;
+      result.Algorithm = parameters.Algorithm;
+      return true;
+    }
+
+    bool LocalCryptographyProvider::TryWrapKey(
+        KeyWrapAlgorithm const& algorithm,
+        std::vector<uint8_t> const& key,
+        WrapResult& result,
+        Azure::Core::Context const& context)
+    {
+      auto localKey = GetKey(KeyOperation::WrapKey.ToString(), context);
+      if (!localKey || !localKey->Encrypt(algorithm.ToString(), key, result.EncryptedKey))
+      {
+        return false;
+      }
+      result.KeyId = localKey->KeyId;
+      result.Algorithm = algorithm;
+      return true;
+    }
+
+    bool LocalCryptographyProvider::TryVerify(
+        SignatureAlgorithm const& algorithm,
+        std::vector<uint8_t> const& digest,
+        std::vector<uint8_t> const& signature,
+        VerifyResult& result,
+        Azure::Core::Context const& context)
+    {
+      auto key = GetKey(KeyOperation::Verify.ToString(), context);
+      if (!key || !key->Verify(algorithm.ToString(), digest, signature, result.IsValid))
+      {
+        return false;
+      }
+      result.KeyId = key->KeyId;
+      result.Algorithm = algorithm;
+      return true;
+    }
+}}}}}} // namespace Azure::Security::KeyVault::Keys::Cryptography::_detail
@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Performs public key operations in-process using a cached copy of a Key Vault key.
+ *
+ */
+
+#pragma once
+
+#include "azure/keyvault/keys/cryptography/cryptography_client_models.hpp"
+
+#include <azure/core/context.hpp>
+#include <azure/core/http/raw_response.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Azure {
+  namespace Security {
+    namespace KeyVault {
+      namespace Keys {
+        namespace Cryptography {
+  namespace _detail {
+
+    /**
+     * @brief The public part of a Key Vault key, along with the attributes which govern its use.
+     *
+     */
+    class LocalCryptographyKey;
+
+    /**
+     * @brief Performs the public key operations of a CryptographyClient in-process.
+     *
+     * @details The key is fetched from Key Vault on first use and cached for the given time to
+     * live, after which the next operation fetches it again. Each operation returns `false` when
+     * it cannot be performed locally, in which case the caller sends it to the service. This
+     * happens when the key could not be fetched, is not an RSA or EC key, is disabled or outside
+     * of its validity period, does not permit the operation, or when the algorithm is not
+     * supported locally.
+     *
+     */
+    class LocalCryptographyProvider final {
+    public:
+      /**
+       * @brief Sends the request which gets the key from Key Vault.
+       *
+       */
+      using KeyFetcher = std::function<std::unique_ptr<Azure::Core::Http::RawResponse>(
+          Azure::Core::Context const&)>;
+
+      LocalCryptographyProvider(KeyFetcher fetchKey, std::chrono::milliseconds timeToLive);
+      ~LocalCryptographyProvider();
+
+      LocalCryptographyProvider(LocalCryptographyProvider const&) = delete;
+      LocalCryptographyProvider& operator=(LocalCryptographyProvider const&) = delete;
+
+      bool TryEncrypt(
+          EncryptParameters const& parameters,
+          EncryptResult& result,
+          Azure::Core::Context const& context);
+
+      bool TryWrapKey(
+          KeyWrapAlgorithm const& algorithm,
+          std::vector<uint8_t> const& key,
+          WrapResult& result,
+          Azure::Core::Context const& context);
+
+      bool TryVerify(
+          SignatureAlgorithm const& algorithm,
+          std::vector<uint8_t> const& digest,
+          std::vector<uint8_t> const& signature,
+          VerifyResult& result,
+          Azure::Core::Context const& context);
+
+      /**
+       * @brief Parses a Key Vault key bundle.
+       *
+       * @return The key, or `nullptr` if the key has no public key material usable locally.
+       */
+      static std::shared_ptr<LocalCryptographyKey const> DeserializeKey(
+          Azure::Core::Http::RawResponse const& rawResponse);
+
+    private:
+      // Returns the cached key if it may be used for the operation at this time.
+      std::shared_ptr<LocalCryptographyKey const> GetKey(
+          std::string const& operation,
+          Azure::Core::Context const& context);
+
+      KeyFetcher m_fetchKey;
+      std::chrono::milliseconds m_timeToLive;
+      std::mutex m_keyMutex;
+      bool m_keyFetched{false};
+      std::chrono::steady_clock::time_point m_keyExpiresOn;
+      std::shared_ptr<LocalCryptographyKey const> m_key;
+    };
+}}}}}} // namespace Azure::Security::KeyVault::Keys::Cryptography::_detail
@@ -0,0 +1,321 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+
+#include <azure/core/base64.hpp>
+#include <azure/core/test/test_proxy_manager.hpp>
+#include <azure/core/test/test_transport.hpp>
+#include <azure/keyvault/keys.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Azure::Security::KeyVault::Keys::Cryptography;
+using Azure::Core::_internal::Base64Url;
+using Azure::Core::Http::HttpMethod;
+using Azure::Core::Http::HttpStatusCode;
+using Azure::Core::Http::RawResponse;
+using Azure::Core::Http::Request;
+
+namespace {
+// A 2048-bit RSA key and a P-256 key, with signatures of the same digest created by OpenSSL.
+constexpr char const RsaModulus[]
+    = "mAPo9mnPiIGHKl2ixrI0G9lzRf5SxbcfCHLWXVvV4tRuhiMzEW759ZdFFEJThNar8E2Hnu1Q4uMrclsO1yJ8yUJ9"
+      "Vx3nGm63DkPKZB6wUR79kQtRa1CGtz9A68YsjGvLfvUW86S2e5MiA0GMn17b_dtMUAUZxZjIcM0RwGdOMvVz3P_F"
+      "8PJQWF58OnfSE2TuGkfvHB-fHN1GqXnMrRf3erYNq-RDW0i7yYnjOOyR3lAQb_s4i6cjC6NFilzDslHV3GZHSqI2"
+      "LCXBkuAubEPbqcc2DHCJN8qYH0MxKDMAYf9zjX6TxssxuOS6oXvubBdmkSDR4M5a_dbfAMVxT5wx6Q";
+constexpr char const EcX[] = "Lmgn5kFdG3BbWN9PBRsXvTFmXGaN-kTnnYHn8lUTKas";
+constexpr char const EcY[] = "xqXq482hhyabjMIHgPlQp28H2DyQs-t3gfJeFM2Y0Hs";
+constexpr char const Digest[] = "rMhA4HMrefiul2BunzJPDbyj8ddFYzaxGNP7iWhIWL4";
+constexpr char const Rs256Signature[]
+    = "Psk4CfHoG3RF-Qc_GOIrycQgqmeYJMReZfCy7eyrJS2XGIVNYHFVATfPrPvR3_lqUFSIzbiPTJWjmJzCRvw8xQjs"
+      "_SzfHm7X45RxUFlWeTdgg12ampv5KPz8Aii1xpCRhRP1PqRDK4UE9EHplfUSFdCZ46CQb6CS6whrnn3rQrBQwU9f"
+      "onCKdKYYNF-QfxtD9fkyuAMDos4gHPkOkoIHbkFzTgvVGe1GSOCEaPTZvkHgJqORBvfLsPI1UJyX3oycVAuNoV6y"
+      "HbC3YT-7CSVE5Bx_ai1Lwgi-I6glh1u5u8HUGNEBiw53amjya4hshVsHsodegEKlz_jfaic7tbKBLA";
+constexpr char const Ps256Signature[]
+    = "RlS8N3nJzOYL4ExYtHfy8IE-LkD1pKtmkirWDbNUPsSdPJkB9jhXkpNNiDnLTaFRy8FKUZTNiUYh6lEX_SFPkhDY"
+      "8ePjt4Il5K4jgY-VDJAGUAIXJn3R0ZqnRy0FFtaY3CSahOeSCiE8KwJ5ceIKrG8uvoYU9giFY9jKsk29FD4mT_uf"
+      "1awcpuyLTGH-yLKTMY03DKh7jpPikS99Wo9OCrHAV-VBXq_aM1IvmcLrIibsohk-M9C7tx5iEx8a8ZZpugnS3Sih"
+      "vM6EB9gxTyWEeikj75q7YJ0mdMx0y8JAKfgdlbdDZSn133SGdU_13yo4Qg1m4GSjnlgBqZeMZImp1A";
+constexpr char const Es256Signature[]
+    = "e0XSBvLOGt_9yjNdWU5Xcywlvw4dmHVm3jhdLRvRMtyAhFbPaDvloGIUpJbyarI4e1llyoZB4VgLfM8AZ5cepg";
+
+constexpr char const KeyId[] = "https://myvault.vault.azure.net/keys/mykey/0123456789";
+
+std::string RsaKey(std::string const& keyOps, std::string const& attributes)
+{
+  return std::string("{\"key\":{\"kid\":\"") + KeyId + "\",\"kty\":\"RSA\",\"key_ops\":" + keyOps
+      + ",\"n\":\"" + RsaModulus + "\",\"e\":\"AQAB\"},\"attributes\":" + attributes + "}";
+}
+
+std::string EcKey()
+{
+  return std::string("{\"key\":{\"kid\":\"") + KeyId
+      + "\",\"kty\":\"EC\",\"crv\":\"P-256\",\"key_ops\":[\"sign\",\"verify\"],\"x\":\"" + EcX
+      + "\",\"y\":\"" + EcY + "\"},\"attributes\":{\"enabled\":true}}";
+}
+
+// Answers the key request with the given key bundle, and every operation with a fixed result.
+class TestKeyVaultTransport final : public Azure::Core::Test::TestTransport {
+  std::string m_keyBundle;
+  HttpStatusCode m_keyStatusCode;
+
+public:
+  std::vector<std::string> Requests;
+
+  TestKeyVaultTransport(std::string keyBundle, HttpStatusCode keyStatusCode = HttpStatusCode::Ok)
+      : m_keyBundle(std::move(keyBundle)), m_keyStatusCode(keyStatusCode)
+  {
+  }
+
+  std::unique_ptr<RawResponse> Send(Request& request, Azure::Core::Context const&) override
+  {
+    auto const path = request.GetUrl().GetPath();
+    Requests.emplace_back(request.GetMethod().ToString() + " " + path);
+
+    bool const isKeyRequest = request.GetMethod() == HttpMethod::Get;
+    std::string body = std::string("{\"kid\":\"") + KeyId + "\",\"value\":\"AQID\"}";
+    if (isKeyRequest)
+    {
+      body = m_keyBundle;
+    }
+    else if (path.find("verify") != std::string::npos)
+    {
+      body = "{\"value\":true}";
+    }
+
+    auto response
+        = CreateResponse(isKeyRequest ? m_keyStatusCode : HttpStatusCode::Ok, std::move(body));
+    response->SetHeader("Content-Type", "application/json");
+    return response;
+  }
+};
+
+CryptographyClient CreateClient(
+    std::shared_ptr<TestKeyVaultTransport> transport,
+    std::chrono::milliseconds localKeyTimeToLive = std::chrono::minutes(5))
+{
+  CryptographyClientOptions options;
+  options.EnableLocalCryptography = true;
+  options.LocalKeyTimeToLive = localKeyTimeToLive;
+  options.Retry.MaxRetries = 0;
+  options.Transport.Transport = transport;
+  return CryptographyClient(
+      KeyId, std::make_shared<Azure::Core::Test::TestNonExpiringCredential>(), options);
+}
+} // namespace
+
+TEST(CryptographyClientLocalTest, VerifyRsaLocally)
+{
+  auto transport = std::make_shared<TestKeyVaultTransport>(
+      RsaKey("[\"verify\",\"encrypt\",\"wrapKey\"]", "{\"enabled\":true}"));
+  auto client = CreateClient(transport);
+  auto const digest = Base64Url::Base64UrlDecode(Digest);
+
+  auto result = client.Verify(
+      SignatureAlgorithm::RS256, digest, Base64Url::Base64UrlDecode(Rs256Signature));
+  EXPECT_TRUE(result.Value.IsValid);
+  EXPECT_EQ(result.Value.Algorithm, SignatureAlgorithm::RS256);
+  EXPECT_EQ(result.Value.KeyId, KeyId);
+
+  result = client.Verify(
+      SignatureAlgorithm::PS256, digest, Base64Url::Base64UrlDecode(Ps256Signature));
+  EXPECT_TRUE(result.Value.IsValid);
+
+  auto tampered = Base64Url::Base64UrlDecode(Rs256Signature);
+  tampered[10] ^= 0x01;
+  result = client.Verify(SignatureAlgorithm::RS256, digest, tampered);
+  EXPECT_FALSE(result.Value.IsValid);
+
+  // Only the key was requested from the service, once.
+  ASSERT_EQ(transport->Requests.size(), 1u);
+  EXPECT_EQ(transport->Requests[0], "GET keys/mykey/0123456789");
+}
+
+TEST(CryptographyClientLocalTest, VerifyEcLocally)
+{
+  auto transport = std::make_shared<TestKeyVaultTransport>(EcKey());
+  auto client = CreateClient(transport);
+  auto const digest = Base64Url::Base64UrlDecode(Digest);
+
+  EXPECT_TRUE(client
+                  .Verify(
+                      SignatureAlgorithm::ES256,
+                      digest,
+                      Base64Url::Base64UrlDecode(Es256Signature))
+                  .Value.IsValid);
+
+  auto tampered = Base64Url::Base64UrlDecode(Es256Signature);
+  tampered[40] ^= 0x01;
+  EXPECT_FALSE(client.Verify(SignatureAlgorithm::ES256, digest, tampered).Value.IsValid);
+  EXPECT_EQ(transport->Requests.size(), 1u);
+
+  // ES384 does not use the key's curve, the service reports the error.
+  client.Verify(SignatureAlgorithm::ES384, digest, tampered);
+  ASSERT_EQ(transport->Requests.size(), 2u);
+  EXPECT_EQ(transport->Requests[1], "POST keys/mykey/0123456789/verify");
+}
+
+TEST(CryptographyClientLocalTest, EncryptAndWrapLocally)
+{
+  auto transport = std::make_shared<TestKeyVaultTransport>(
+      RsaKey("[\"verify\",\"encrypt\",\"wrapKey\"]", "{\"enabled\":true}"));
+  auto client = CreateClient(transport);
+
+  auto encrypted = client.Encrypt(EncryptParameters::RsaOaep256Parameters({1, 2, 3}));
+  EXPECT_EQ(encrypted.Value.Ciphertext.size(), 256u);
+  EXPECT_EQ(encrypted.Value.KeyId, KeyId);
+  EXPECT_EQ(encrypted.Value.Algorithm, EncryptionAlgorithm::RsaOaep256);
+
+  // RSA-OAEP is randomized.
+  EXPECT_NE(
+      client.Encrypt(EncryptParameters::RsaOaep256Parameters({1, 2, 3})).Value.Ciphertext,
+      encrypted.Value.Ciphertext);
+
+  auto wrapped = client.WrapKey(KeyWrapAlgorithm::Rsa15, std::vector<uint8_t>(32, 0x42));
+  EXPECT_EQ(wrapped.Value.EncryptedKey.size(), 256u);
+  EXPECT_EQ(wrapped.Value.Algorithm, KeyWrapAlgorithm::Rsa15);
+  EXPECT_EQ(transport->Requests.size(), 1u);
+
+  // Private key operations always go to the service.
+  client.Decrypt(DecryptParameters::RsaOaep256Parameters(encrypted.Value.Ciphertext));
+  client.Sign(SignatureAlgorithm::RS256, Base64Url::Base64UrlDecode(Digest));
+  ASSERT_EQ(transport->Requests.size(), 3u);
+  EXPECT_EQ(transport->Requests[1], "POST keys/mykey/0123456789/decrypt");
+  EXPECT_EQ(transport->Requests[2], "POST keys/mykey/0123456789/sign");
+}
+
+TEST(CryptographyClientLocalTest, KeyOperationsAreHonoured)
+{
+  auto transport
+      = std::make_shared<TestKeyVaultTransport>(RsaKey("[\"verify\"]", "{\"enabled\":true}"));
+  auto client = CreateClient(transport);
+
+  client.Encrypt(EncryptParameters::RsaOaepParameters({1, 2, 3}));
+  ASSERT_EQ(transport->Requests.size(), 2u);
+  EXPECT_EQ(transport->Requests[1], "POST keys/mykey/0123456789/encrypt");
+}
+
+TEST(CryptographyClientLocalTest, ExpiredKeyUsesService)
+{
+  // Expired on 2001-09-09.
+  auto transport = std::make_shared<TestKeyVaultTransport>(
+      RsaKey("[\"verify\"]", "{\"enabled\":true,\"exp\":1000000000}"));
+  auto client = CreateClient(transport);
+
+  EXPECT_TRUE(client
+                  .Verify(
+                      SignatureAlgorithm::RS256,
+                      Base64Url::Base64UrlDecode(Digest),
+                      Base64Url::Base64UrlDecode(Rs256Signature))
+                  .Value.IsValid);
+  ASSERT_EQ(transport->Requests.size(), 2u);
+  EXPECT_EQ(transport->Requests[1], "POST keys/mykey/0123456789/verify");
+}
+
+TEST(CryptographyClientLocalTest, DisabledKeyUsesService)
+{
+  auto transport = std::make_shared<TestKeyVaultTransport>(
+      RsaKey("[\"verify\"]", "{\"enabled\":false}"));
+  auto client = CreateClient(transport);
+
+  client.Verify(
+      SignatureAlgorithm::RS256,
+      Base64Url::Base64UrlDecode(Digest),
+      Base64Url::Base64UrlDecode(Rs256Signature));
+  EXPECT_EQ(transport->Requests.size(), 2u);
+}
+
+TEST(CryptographyClientLocalTest, KeyNotAvailableUsesService)
+{
+  auto transport = std::make_shared<TestKeyVaultTransport>(
+      "{\"error\":{\"code\":\"Forbidden\"}}", HttpStatusCode::Forbidden);
+  auto client = CreateClient(transport);
+  auto const digest = Base64Url::Base64UrlDecode(Digest);
+  auto const signature = Base64Url::Base64UrlDecode(Rs256Signature);
+
+  EXPECT_TRUE(client.Verify(SignatureAlgorithm::RS256, digest, signature).Value.IsValid);
+  EXPECT_TRUE(client.Verify(SignatureAlgorithm::RS256, digest, signature).Value.IsValid);
+
+  // The key is requested once, then every operation is sent to the service.
+  ASSERT_EQ(transport->Requests.size(), 3u);
+  EXPECT_EQ(transport->Requests[0], "GET keys/mykey/0123456789");
+  EXPECT_EQ(transport->Requests[1], "POST keys/mykey/0123456789/verify");
+  EXPECT_EQ(transport->Requests[2], "POST keys/mykey/0123456789/verify");
+}
+
+TEST(CryptographyClientLocalTest, KeyNotAvailableIsRetriedAfterTimeToLive)
+{
+  auto transport = std::make_shared<TestKeyVaultTransport>(
+      "{\"error\":{\"code\":\"NotFound\"}}", HttpStatusCode::NotFound);
+  auto client = CreateClient(transport, std::chrono::milliseconds::zero());
+  auto const digest = Base64Url::Base64UrlDecode(Digest);
+  auto const signature = Base64Url::Base64UrlDecode(Rs256Signature);
+
+  EXPECT_TRUE(client.Verify(SignatureAlgorithm::RS256, digest, signature).Value.IsValid);
+  EXPECT_TRUE(client.Verify(SignatureAlgorithm::RS256, digest, signature).Value.IsValid);
+
+  // The missing key is only cached for its time to live.
+  ASSERT_EQ(transport->Requests.size(), 4u);
+  EXPECT_EQ(transport->Requests[0], "GET keys/mykey/0123456789");
+  EXPECT_EQ(transport->Requests[1], "POST keys/mykey/0123456789/verify");
+  EXPECT_EQ(transport->Requests[2], "GET keys/mykey/0123456789");
+  EXPECT_EQ(transport->Requests[3], "POST keys/mykey/0123456789/verify");
+}
+
+TEST(CryptographyClientLocalTest, KeyIsFetchedAgainAfterTimeToLive)
+{
+  auto transport
+      = std::make_shared<TestKeyVaultTransport>(RsaKey("[\"verify\"]", "{\"enabled\":true}"));
+  auto client = CreateClient(transport, std::chrono::milliseconds::zero());
+  auto const digest = Base64Url::Base64UrlDecode(Digest);
+  auto const signature = Base64Url::Base64UrlDecode(Rs256Signature);
+
+  EXPECT_TRUE(client.Verify(SignatureAlgorithm::RS256, digest, signature).Value.IsValid);
+  EXPECT_TRUE(client.Verify(SignatureAlgorithm::RS256, digest, signature).Value.IsValid);
+
+  // Both operations are performed locally, each with a freshly fetched key.
+  ASSERT_EQ(transport->Requests.size(), 2u);
+  EXPECT_EQ(transport->Requests[0], "GET keys/mykey/0123456789");
+  EXPECT_EQ(transport->Requests[1], "GET keys/mykey/0123456789");
+}
+
+TEST(CryptographyClientLocalTest, TransientKeyFailureIsRetried)
+{
+  auto transport = std::make_shared<TestKeyVaultTransport>(
+      "{\"error\":{\"code\":\"ServiceUnavailable\"}}", HttpStatusCode::ServiceUnavailable);
+  auto client = CreateClient(transport);
+  auto const digest = Base64Url::Base64UrlDecode(Digest);
+  auto const signature = Base64Url::Base64UrlDecode(Rs256Signature);
+
+  EXPECT_TRUE(client.Verify(SignatureAlgorithm::RS256, digest, signature).Value.IsValid);
+  EXPECT_TRUE(client.Verify(SignatureAlgorithm::RS256, digest, signature).Value.IsValid);
+
+  // A transient failure is not cached, the key is requested again by the next operation.
+  ASSERT_EQ(transport->Requests.size(), 4u);
+  EXPECT_EQ(transport->Requests[0], "GET keys/mykey/0123456789");
+  EXPECT_EQ(transport->Requests[1], "POST keys/mykey/0123456789/verify");
+  EXPECT_EQ(transport->Requests[2], "GET keys/mykey/0123456789");
+  EXPECT_EQ(transport->Requests[3], "POST keys/mykey/0123456789/verify");
+}
+
+TEST(CryptographyClientLocalTest, DisabledByDefault)
+{
+  auto transport = std::make_shared<TestKeyVaultTransport>(
+      RsaKey("[\"verify\"]", "{\"enabled\":true}"));
+  CryptographyClientOptions options;
+  options.Transport.Transport = transport;
+  CryptographyClient client(
+      KeyId, std::make_shared<Azure::Core::Test::TestNonExpiringCredential>(), options);
+
+  client.Verify(
+      SignatureAlgorithm::RS256,
+      Base64Url::Base64UrlDecode(Digest),
+      Base64Url::Base64UrlDecode(Rs256Signature));
+  ASSERT_EQ(transport->Requests.size(), 1u);
+  EXPECT_EQ(transport->Requests[0], "POST keys/mykey/0123456789/verify");
+}
@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+/**
+ * @file
+ * @brief Defines a client-side cache of Key Vault secrets.
+ *
+ */
+
+#pragma once
+
+#include "azure/keyvault/secrets/keyvault_options.hpp"
+#include "azure/keyvault/secrets/keyvault_secret.hpp"
+#include "azure/keyvault/secrets/secret_client.hpp"
+
+#include <azure/core/context.hpp>
+
+#include <memory>
+#include <string>
+
+namespace Azure { namespace Security { namespace KeyVault { namespace Secrets {
+  namespace _detail {
+    class SecretCache;
+  }
+
+  /**
+   * @brief The CachedSecretClient serves secrets from a client-side cache, and gets them from a
+   * SecretClient when they are not cached.
+   *
+   * @details The latest version of a secret is cached for TimeToLive, and can be refreshed in the
+   * background every RefreshInterval. A secret requested with a version never changes, and is
+   * cached until it is invalidated. Secrets which are not requested for IdleTimeout are evicted.
+   * Concurrent requests for a secret which is not cached result in a single request to Key Vault,
+   * which a caller cancelling its request does not cancel. Errors are not cached.
+   *
+   * The CachedSecretClient is thread-safe.
+   *
+   * @remark Secrets are held in memory for the lifetime of the CachedSecretClient, or until they
+   * are invalidated or evicted.
+   */
+  class CachedSecretClient final {
+  public:
+    /**
+     * @brief Construct a new CachedSecretClient.
+     *
+     * @param client The client used to get secrets which are not cached.
+     * @param options Options controlling how long secrets are cached.
+     */
+    explicit CachedSecretClient(
+        std::shared_ptr<SecretClient const> client,
+        CachedSecretClientOptions const& options = CachedSecretClientOptions());
+
+    /**
+     * @brief Stops the background refresh and releases the cached secrets.
+     *
+     */
+    ~CachedSecretClient();
+
+    CachedSecretClient(CachedSecretClient const&) = delete;
+    CachedSecretClient& operator=(CachedSecretClient const&) = delete;
+
+    /**
+     * @brief Get a secret from the cache, or from Key Vault if it is not cached or has expired.
+     * This operation requires the secrets/get permission.
+     *
+     * @param name The name of the secret.
+     * @param options The optional parameters for this request.
+     * @param context The context for the operation can be used for request cancellation.
+     * @return The secret.
+     */
+    KeyVaultSecret GetSecret(
+        std::string const& name,
+        GetSecretOptions const& options = GetSecretOptions(),
+        Azure::Core::Context const& context = Azure::Core::Context()) const;
+
+    /**
+     * @brief Remove every cached version of a secret, for instance after it has been updated.
+     *
+     * @param name The name of the secret.
+     */
+    void Invalidate(std::string const& name);
+
+    /**
+     * @brief Remove every secret from the cache.
+     *
+     */
+    void Clear();
+
+  private:
+    std::unique_ptr<_detail::SecretCache> m_cache;
+  };
+}}}} // namespace Azure::Security::KeyVault::Secrets
@@ -9,6 +9,8 @@
 #include "dll_import_export.hpp"
 
 #include <azure/core/internal/client_options.hpp>
+
+#include <chrono>
 namespace Azure { namespace Security { namespace KeyVault { namespace Secrets {
 
   /**
@@ -37,6 +39,39 @@ namespace Azure { namespace Security { namespace KeyVault { namespace Secrets {
     std::string Version;
   };
 
+  /**
+   * @brief Define the options to create a
+   * #Azure::Security::KeyVault::Secrets::CachedSecretClient.
+   *
+   */
+  struct CachedSecretClientOptions final
+  {
+    /**
+     * @brief How long the latest version of a secret is served from the cache before it is
+     * fetched again.
+     *
+     * @remark Secrets requested with a version never expire.
+     */
+    std::chrono::milliseconds TimeToLive{std::chrono::minutes(5)};
+
+    /**
+     * @brief How often the latest version of the cached secrets is refreshed in the background.
+     *
+     * @remark Background refresh is disabled if the interval is zero. To avoid waiting for the
+     * service on an expired secret, use an interval shorter than TimeToLive.
+     */
+    std::chrono::milliseconds RefreshInterval{std::chrono::milliseconds::zero()};
+
+    /**
+     * @brief How long a secret which is not requested is kept in the cache.
+     *
+     * @remark Idle secrets, including pinned versions, are evicted and no longer refreshed in the
+     * background. They are fetched again by the next request. Idle secrets are never evicted if
+     * the timeout is zero.
+     */
+    std::chrono::milliseconds IdleTimeout{std::chrono::hours(1)};
+  };
+
   /**
    * @brief Optional parameters for
    * #Azure::Security::KeyVault::Secrets::SecretClient::UpdateSecretProperties
@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/keyvault/secrets/cached_secret_client.hpp"
+
+#include <azure/keyvault/shared/keyvault_cache.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using namespace Azure::Security::KeyVault::Secrets;
+
+namespace Azure { namespace Security { namespace KeyVault { namespace Secrets { namespace _detail {
+  class SecretCache final : public KeyVault::_internal::KeyVaultCache<KeyVaultSecret> {
+  public:
+    using KeyVault::_internal::KeyVaultCache<KeyVaultSecret>::KeyVaultCache;
+  };
+}}}}} // namespace Azure::Security::KeyVault::Secrets::_detail
+
+CachedSecretClient::CachedSecretClient(
+    std::shared_ptr<SecretClient const> client,
+    CachedSecretClientOptions const& options)
+{
+  if (!client)
+  {
+    throw std::invalid_argument("client cannot be null.");
+  }
+  m_cache = std::make_unique<_detail::SecretCache>(
+      [client](
+          std::string const& name,
+          std::string const& version,
+          Azure::Core::Context const& context) {
+        GetSecretOptions getOptions;
+        getOptions.Version = version;
+        return client->GetSecret(name, getOptions, context).Value;
+      },
+      options.TimeToLive,
+      options.RefreshInterval,
+      options.IdleTimeout);
+}
+
+CachedSecretClient::~CachedSecretClient() = default;
+
+KeyVaultSecret CachedSecretClient::GetSecret(
+    std::string const& name,
+    GetSecretOptions const& options,
+    Azure::Core::Context const& context) const
+{
+  return m_cache->Get(name, options.Version, context);
+}
+
+void CachedSecretClient::Invalidate(std::string const& name) { m_cache->Invalidate(name); }
+
+void CachedSecretClient::Clear() { m_cache->Clear(); }
@@ -30,7 +30,8 @@ namespace Azure { namespace Security { namespace KeyVault { namespace Secrets {
     std::string m_vaultUrl;
     std::string m_secretName;
     std::shared_ptr<const Azure::Core::Credentials::TokenCredential> m_credential;
-    std::unique_ptr<Azure::Security::KeyVault::Secrets::SecretClient> m_client;
+    std::shared_ptr<Azure::Security::KeyVault::Secrets::SecretClient> m_client;
+    std::unique_ptr<Azure::Security::KeyVault::Secrets::CachedSecretClient> m_cachedClient;
 
   public:
     /**
@@ -42,11 +43,17 @@ namespace Azure { namespace Security { namespace KeyVault { namespace Secrets {
       m_vaultUrl = m_options.GetOptionOrDefault<std::string>(
           "vaultUrl", Environment::GetVariable("AZURE_KEYVAULT_URL"));
       m_credential = GetTestCredential();
-      m_client = std::make_unique<Azure::Security::KeyVault::Secrets::SecretClient>(
+      m_client = std::make_shared<Azure::Security::KeyVault::Secrets::SecretClient>(
           m_vaultUrl,
           m_credential,
           InitClientOptions<Azure::Security::KeyVault::Secrets::SecretClientOptions>());
       this->CreateRandomNameKey();
+
+      if (m_options.GetOptionOrDefault<bool>("Cache", false))
+      {
+        m_cachedClient = std::make_unique<Azure::Security::KeyVault::Secrets::CachedSecretClient>(
+            m_client);
+      }
     }
 
     /**
@@ -87,7 +94,14 @@ namespace Azure { namespace Security { namespace KeyVault { namespace Secrets {
     {
       try
       {
-        auto t = m_client->GetSecret(m_secretName);
+        if (m_cachedClient)
+        {
+          auto t = m_cachedClient->GetSecret(m_secretName);
+        }
+        else
+        {
+          auto t = m_client->GetSecret(m_secretName);
+        }
       }
       catch (...)
       {
@@ -106,7 +120,8 @@ namespace Azure { namespace Security { namespace KeyVault { namespace Secrets {
           {"vaultUrl", {"--vaultUrl"}, "The Key Vault Account.", 1, false},
           {"TenantId", {"--tenantId"}, "The tenant Id for the authentication.", 1, false},
           {"ClientId", {"--clientId"}, "The client Id for the authentication.", 1, false},
-          {"Secret", {"--secret"}, "The secret for authentication.", 1, false, true}};
+          {"Secret", {"--secret"}, "The secret for authentication.", 1, false, true},
+          {"Cache", {"--cache"}, "Get the secret through a CachedSecretClient.", 1, false}};
     }
 
     /**
@@ -0,0 +1,235 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/keyvault/shared/keyvault_cache.hpp"
+
+#include <azure/keyvault/secrets/cached_secret_client.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using Azure::Core::Context;
+using Azure::Security::KeyVault::_internal::KeyVaultCache;
+
+namespace {
+// Returns "<name>/<version>/<fetch count>" so tests can tell cached values from fetched ones.
+KeyVaultCache<std::string>::Fetcher CountingFetcher(std::atomic<int>& fetches)
+{
+  return [&fetches](std::string const& name, std::string const& version, Context const&) {
+    return name + "/" + version + "/" + std::to_string(++fetches);
+  };
+}
+} // namespace
+
+TEST(KeyVaultCache, LatestVersionExpires)
+{
+  std::atomic<int> fetches{0};
+  KeyVaultCache<std::string> cache(
+      CountingFetcher(fetches), std::chrono::milliseconds(50), std::chrono::milliseconds::zero());
+
+  EXPECT_EQ(cache.Get("secret", "", Context()), "secret//1");
+  EXPECT_EQ(cache.Get("secret", "", Context()), "secret//1");
+  EXPECT_EQ(cache.Get("other", "", Context()), "other//2");
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(cache.Get("secret", "", Context()), "secret//3");
+}
+
+TEST(KeyVaultCache, PinnedVersionNeverExpires)
+{
+  std::atomic<int> fetches{0};
+  KeyVaultCache<std::string> cache(
+      CountingFetcher(fetches), std::chrono::milliseconds(1), std::chrono::milliseconds::zero());
+
+  EXPECT_EQ(cache.Get("secret", "v1", Context()), "secret/v1/1");
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(cache.Get("secret", "v1", Context()), "secret/v1/1");
+  EXPECT_EQ(fetches, 1);
+}
+
+TEST(KeyVaultCache, Invalidate)
+{
+  std::atomic<int> fetches{0};
+  KeyVaultCache<std::string> cache(
+      CountingFetcher(fetches), std::chrono::minutes(5), std::chrono::milliseconds::zero());
+
+  cache.Get("secret", "", Context());
+  cache.Get("secret", "v1", Context());
+  cache.Get("other", "", Context());
+  cache.Invalidate("secret");
+
+  EXPECT_EQ(cache.Get("other", "", Context()), "other//3");
+  EXPECT_EQ(cache.Get("secret", "", Context()), "secret//4");
+  EXPECT_EQ(cache.Get("secret", "v1", Context()), "secret/v1/5");
+
+  cache.Clear();
+  EXPECT_EQ(cache.Get("other", "", Context()), "other//6");
+}
+
+TEST(KeyVaultCache, ConcurrentMissesFetchOnce)
+{
+  std::atomic<int> fetches{0};
+  KeyVaultCache<std::string> cache(
+      [&fetches](std::string const& name, std::string const&, Context const&) {
+        ++fetches;
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        return name;
+      },
+      std::chrono::minutes(5),
+      std::chrono::milliseconds::zero());
+
+  std::vector<std::thread> threads;
+  std::atomic<int> results{0};
+  for (int i = 0; i < 8; ++i)
+  {
+    threads.emplace_back([&]() {
+      if (cache.Get("secret", "", Context()) == "secret")
+      {
+        ++results;
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  EXPECT_EQ(fetches, 1);
+  EXPECT_EQ(results, 8);
+}
+
+TEST(KeyVaultCache, ErrorsAreNotCached)
+{
+  std::atomic<int> fetches{0};
+  KeyVaultCache<std::string> cache(
+      [&fetches](std::string const& name, std::string const&, Context const&) {
+        if (++fetches == 1)
+        {
+          throw std::runtime_error("Service unavailable");
+        }
+        return name;
+      },
+      std::chrono::minutes(5),
+      std::chrono::milliseconds::zero());
+
+  EXPECT_THROW(cache.Get("secret", "", Context()), std::runtime_error);
+  EXPECT_EQ(cache.Get("secret", "", Context()), "secret");
+  EXPECT_EQ(fetches, 2);
+}
+
+TEST(KeyVaultCache, BackgroundRefresh)
+{
+  std::atomic<int> fetches{0};
+  KeyVaultCache<std::string> cache(
+      CountingFetcher(fetches), std::chrono::minutes(5), std::chrono::milliseconds(20));
+
+  EXPECT_EQ(cache.Get("secret", "v1", Context()), "secret/v1/1");
+  EXPECT_EQ(cache.Get("secret", "", Context()), "secret//2");
+
+  for (int i = 0; i < 100 && cache.Get("secret", "", Context()) == "secret//2"; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_NE(cache.Get("secret", "", Context()), "secret//2");
+  // Pinned versions are not refreshed.
+  EXPECT_EQ(cache.Get("secret", "v1", Context()), "secret/v1/1");
+}
+
+TEST(KeyVaultCache, CancelledCallerDoesNotCancelFetch)
+{
+  std::atomic<int> fetches{0};
+  std::atomic<bool> fetchCancelled{false};
+  KeyVaultCache<std::string> cache(
+      [&](std::string const& name, std::string const&, Context const& context) {
+        ++fetches;
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        fetchCancelled = context.IsCancelled();
+        return name;
+      },
+      std::chrono::minutes(5),
+      std::chrono::milliseconds::zero());
+
+  auto const start = std::chrono::steady_clock::now();
+  EXPECT_THROW(
+      cache.Get(
+          "secret",
+          "",
+          Context().WithDeadline(std::chrono::system_clock::now() + std::chrono::milliseconds(20))),
+      Azure::Core::OperationCancelledException);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(200));
+
+  // A caller with its own context shares the fetch, which was not cancelled.
+  EXPECT_EQ(cache.Get("secret", "", Context()), "secret");
+  EXPECT_EQ(fetches, 1);
+  EXPECT_FALSE(fetchCancelled);
+
+  Context cancelled;
+  cancelled.Cancel();
+  EXPECT_THROW(cache.Get("other", "", cancelled), Azure::Core::OperationCancelledException);
+}
+
+TEST(KeyVaultCache, IdleObjectsAreEvicted)
+{
+  std::atomic<int> fetches{0};
+  KeyVaultCache<std::string> cache(
+      CountingFetcher(fetches),
+      std::chrono::minutes(5),
+      std::chrono::milliseconds(20),
+      std::chrono::milliseconds(50));
+
+  EXPECT_EQ(cache.Get("secret", "v1", Context()), "secret/v1/1");
+  EXPECT_EQ(cache.Get("secret", "", Context()), "secret//2");
+
+  // Once idle, the latest version is no longer refreshed.
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  int const idleFetches = fetches;
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(fetches, idleFetches);
+
+  // Both versions were evicted, and are fetched again.
+  EXPECT_EQ(cache.Get("secret", "v1", Context()), "secret/v1/" + std::to_string(idleFetches + 1));
+  EXPECT_EQ(cache.Get("secret", "", Context()), "secret//" + std::to_string(idleFetches + 2));
+}
+
+TEST(KeyVaultCache, DestructionCancelsRefresh)
+{
+  std::atomic<int> fetches{0};
+  auto cache = std::make_unique<KeyVaultCache<std::string>>(
+      [&fetches](std::string const& name, std::string const&, Context const& context) {
+        // Only the first fetch returns, the refreshes wait until they are cancelled.
+        if (++fetches > 1)
+        {
+          for (int i = 0; i < 1000 && !context.IsCancelled(); ++i)
+          {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+          }
+          context.ThrowIfCancelled();
+        }
+        return name;
+      },
+      std::chrono::minutes(5),
+      std::chrono::milliseconds(10));
+
+  EXPECT_EQ(cache->Get("secret", "", Context()), "secret");
+  for (int i = 0; i < 100 && fetches < 2; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(fetches, 2);
+
+  auto const start = std::chrono::steady_clock::now();
+  cache.reset();
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
+
+TEST(CachedSecretClient, NullClient)
+{
+  using Azure::Security::KeyVault::Secrets::CachedSecretClient;
+  EXPECT_THROW(CachedSecretClient(nullptr), std::invalid_argument);
+}
@@ -0,0 +1,321 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Client-side cache of Key Vault objects shared between Key Vault services.
+ *
+ */
+
+#pragma once
+
+#include <azure/core/context.hpp>
+#include <azure/core/datetime.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Azure { namespace Security { namespace KeyVault { namespace _internal {
+
+  /**
+   * @brief Caches Key Vault objects by name and version.
+   *
+   * @details An object requested with an empty version is the latest version. It is fetched
+   * again once it is older than the time to live and, if a refresh interval is set, refreshed
+   * in the background so that callers rarely wait for the service. An object requested with a
+   * version never changes, and is kept until it is invalidated. If an idle timeout is set, any
+   * object which has not been requested for that long is evicted, and is no longer refreshed.
+   *
+   * Concurrent requests for an object which is not cached result in a single fetch, the result
+   * of which is shared by all the callers. The fetch runs on its own thread with a context which
+   * is only cancelled by the destruction of the cache, so a caller giving up does not fail the
+   * fetch for the others. Failed fetches are not cached.
+   *
+   * @tparam T The type of the cached objects, which must be copyable.
+   */
+  template <class T> class KeyVaultCache {
+  public:
+    /**
+     * @brief Gets an object from Key Vault.
+     *
+     * @remark The version is empty for the latest version.
+     */
+    using Fetcher = std::function<
+        T(std::string const& name, std::string const& version, Azure::Core::Context const&)>;
+
+    /**
+     * @brief Construct a new cache.
+     *
+     * @param fetch Gets an object from Key Vault.
+     * @param timeToLive How long the latest version of an object is cached.
+     * @param refreshInterval How often the latest version of the cached objects are refreshed in
+     * the background. Background refresh is disabled if the interval is zero.
+     * @param idleTimeout How long an object which is not requested is kept in the cache. Objects
+     * are never evicted if the timeout is zero.
+     */
+    KeyVaultCache(
+        Fetcher fetch,
+        std::chrono::milliseconds timeToLive,
+        std::chrono::milliseconds refreshInterval,
+        std::chrono::milliseconds idleTimeout = std::chrono::milliseconds::zero())
+        : m_fetch(std::move(fetch)), m_timeToLive(timeToLive), m_refreshInterval(refreshInterval),
+          m_idleTimeout(idleTimeout)
+    {
+      if (m_refreshInterval > std::chrono::milliseconds::zero())
+      {
+        m_refreshThread = std::thread([this]() { RunRefresh(); });
+      }
+    }
+
+    ~KeyVaultCache()
+    {
+      {
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_stopRefresh = true;
+      }
+      m_context.Cancel();
+      m_refreshCondition.notify_all();
+      if (m_refreshThread.joinable())
+      {
+        m_refreshThread.join();
+      }
+      // The fetches still in flight use the cache, they return once they see the cancellation.
+      std::unique_lock<std::mutex> lock(m_lock);
+      m_refreshCondition.wait(lock, [this]() { return m_activeFetches == 0; });
+    }
+
+    KeyVaultCache(KeyVaultCache const&) = delete;
+    KeyVaultCache& operator=(KeyVaultCache const&) = delete;
+
+    /**
+     * @brief Gets an object from the cache, fetching it from Key Vault if it is not cached or has
+     * expired.
+     *
+     * @param name The name of the object.
+     * @param version The version of the object, empty for the latest version.
+     * @param context The context for cancelling the operation. Cancelling it stops waiting for
+     * the object, but does not cancel the fetch, whose result is still cached.
+     */
+    T Get(std::string const& name, std::string const& version, Azure::Core::Context const& context)
+    {
+      Key key{name, version};
+      std::shared_future<T> result;
+      {
+        std::unique_lock<std::mutex> lock(m_lock);
+        auto const now = std::chrono::steady_clock::now();
+        EvictIdle(now);
+        auto entry = m_entries.find(key);
+        if (entry != m_entries.end()
+            && (!version.empty() || now - entry->second.FetchedOn < m_timeToLive))
+        {
+          entry->second.LastUsedOn = now;
+          return entry->second.Value;
+        }
+
+        // Join a fetch which is already in flight.
+        auto pending = m_pendingFetches.find(key);
+        result = pending != m_pendingFetches.end() ? pending->second : StartFetch(key);
+      }
+      return Wait(result, context);
+    }
+
+    /**
+     * @brief Removes every version of an object from the cache.
+     *
+     */
+    void Invalidate(std::string const& name)
+    {
+      std::unique_lock<std::mutex> lock(m_lock);
+      for (auto entry = m_entries.begin(); entry != m_entries.end();)
+      {
+        entry = entry->first.first == name ? m_entries.erase(entry) : std::next(entry);
+      }
+      ++m_generation;
+    }
+
+    /**
+     * @brief Removes every object from the cache.
+     *
+     */
+    void Clear()
+    {
+      std::unique_lock<std::mutex> lock(m_lock);
+      m_entries.clear();
+      ++m_generation;
+    }
+
+  private:
+    // Name and version.
+    using Key = std::pair<std::string, std::string>;
+
+    struct Entry final
+    {
+      T Value;
+      std::chrono::steady_clock::time_point FetchedOn;
+      std::chrono::steady_clock::time_point LastUsedOn;
+    };
+
+    // Waits for a fetch, for as long as the caller's context allows.
+    static T Wait(std::shared_future<T> const& result, Azure::Core::Context const& context)
+    {
+      // A context cannot be waited on, so only its deadline bounds the wait. A cancelled
+      // context's deadline cannot be converted to a time point, so it is checked first.
+      auto const deadline = context.GetDeadline();
+      if (deadline == (Azure::DateTime::max)())
+      {
+        result.wait();
+      }
+      else if (
+          context.IsCancelled()
+          || result.wait_until(static_cast<std::chrono::system_clock::time_point>(deadline))
+              != std::future_status::ready)
+      {
+        throw Azure::Core::OperationCancelledException("Request was cancelled by context.");
+      }
+      return result.get();
+    }
+
+    // Starts fetching an object on its own thread. Called with m_lock held.
+    std::shared_future<T> StartFetch(Key const& key)
+    {
+      auto promise = std::make_shared<std::promise<T>>();
+      auto result = promise->get_future().share();
+      auto const generation = m_generation;
+      std::thread([this, key, generation, promise]() { RunFetch(key, generation, *promise); })
+          .detach();
+      m_pendingFetches.emplace(key, result);
+      ++m_activeFetches;
+      return result;
+    }
+
+    void RunFetch(Key const& key, std::uint64_t generation, std::promise<T>& promise)
+    {
+      try
+      {
+        T value = m_fetch(key.first, key.second, m_context);
+        {
+          std::unique_lock<std::mutex> lock(m_lock);
+          m_pendingFetches.erase(key);
+          // Do not resurrect an object invalidated while it was being fetched.
+          if (generation == m_generation)
+          {
+            auto const now = std::chrono::steady_clock::now();
+            m_entries[key] = Entry{value, now, now};
+          }
+        }
+        promise.set_value(std::move(value));
+      }
+      catch (...)
+      {
+        {
+          std::unique_lock<std::mutex> lock(m_lock);
+          m_pendingFetches.erase(key);
+        }
+        promise.set_exception(std::current_exception());
+      }
+
+      // The cache cannot be destroyed before the fetch is accounted for, so notify with the lock
+      // held.
+      std::unique_lock<std::mutex> lock(m_lock);
+      --m_activeFetches;
+      m_refreshCondition.notify_all();
+    }
+
+    // Evicts the objects which have not been requested for the idle timeout. Objects are only
+    // scanned once per idle timeout, so they are evicted up to twice the timeout after their last
+    // use. Called with m_lock held.
+    void EvictIdle(std::chrono::steady_clock::time_point now)
+    {
+      if (m_idleTimeout == std::chrono::milliseconds::zero() || now < m_nextIdleEviction)
+      {
+        return;
+      }
+      m_nextIdleEviction = now + m_idleTimeout;
+      for (auto entry = m_entries.begin(); entry != m_entries.end();)
+      {
+        entry = now - entry->second.LastUsedOn >= m_idleTimeout ? m_entries.erase(entry)
+                                                                : std::next(entry);
+      }
+    }
+
+    void RunRefresh()
+    {
+      std::unique_lock<std::mutex> lock(m_lock);
+      while (!m_stopRefresh)
+      {
+        m_refreshCondition.wait_for(lock, m_refreshInterval, [this]() { return m_stopRefresh; });
+
+        // Idle objects are evicted rather than refreshed.
+        EvictIdle(std::chrono::steady_clock::now());
+        std::vector<std::string> names;
+        for (auto const& entry : m_entries)
+        {
+          if (entry.first.second.empty())
+          {
+            names.push_back(entry.first.first);
+          }
+        }
+
+        for (auto const& name : names)
+        {
+          if (m_stopRefresh)
+          {
+            break;
+          }
+          auto const generation = m_generation;
+          lock.unlock();
+          try
+          {
+            T value = m_fetch(name, std::string(), m_context);
+            lock.lock();
+            auto entry = m_entries.find(Key{name, std::string()});
+            if (entry != m_entries.end() && generation == m_generation)
+            {
+              entry->second.Value = std::move(value);
+              entry->second.FetchedOn = std::chrono::steady_clock::now();
+            }
+          }
+          catch (std::exception const&)
+          {
+            // The cached object is kept until it expires, the next Get fetches it again.
+            lock.lock();
+          }
+        }
+      }
+    }
+
+    Fetcher m_fetch;
+    std::chrono::milliseconds m_timeToLive;
+    std::chrono::milliseconds m_refreshInterval;
+    std::chrono::milliseconds m_idleTimeout;
+    // The context of every fetch, cancelled when the cache is destroyed.
+    Azure::Core::Context m_context;
+
+    std::mutex m_lock;
+    std::map<Key, Entry> m_entries;
+    std::map<Key, std::shared_future<T>> m_pendingFetches;
+    // Incremented when objects are invalidated, so that fetches started earlier are discarded.
+    std::uint64_t m_generation{};
+    std::chrono::steady_clock::time_point m_nextIdleEviction;
+
+    // Signaled to stop the background refresh, and when a fetch completes.
+    std::condition_variable m_refreshCondition;
+    bool m_stopRefresh{false};
+    std::thread m_refreshThread;
+    std::size_t m_activeFetches{};
+  };
+
+}}}} // namespace Azure::Security::KeyVault::_internal
@@ -49,6 +49,9 @@ namespace Azure { namespace Storage { namespace Blobs {
       virtual ~BatchSubrequest() = 0;
 
       BatchSubrequestType Type;
+      // Set once the response or exception of the subrequest is available, which is kept if the
+      // batch request is retried.
+      bool HasResponse = false;
     };
 
     class BlobBatchAccessHelper;
@@ -6,11 +6,26 @@
 #include "azure/storage/blobs/blob_client.hpp"
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace Azure { namespace Storage { namespace Blobs {
 
+  namespace _detail {
+    /**
+     * Returns the name at which the rest of a range of blob names is split by ListBlobsParallel,
+     * after a page of blobs from first to last, or an empty string if there is none. Names are
+     * interpolated as numbers in base 95 of the printable ASCII characters.
+     */
+    AZ_STORAGE_BLOBS_DLLEXPORT std::string GetSplitName(
+        const std::string& first,
+        const std::string& last,
+        const Azure::Nullable<std::string>& upper,
+        const std::string& prefix);
+  } // namespace _detail
+
   class BlobLeaseClient;
   class BlobContainerBatch;
 
@@ -212,6 +227,52 @@ namespace Azure { namespace Storage { namespace Blobs {
         const ListBlobsOptions& options = ListBlobsOptions(),
         const Azure::Core::Context& context = Azure::Core::Context()) const;
 
+    /**
+     * @brief Lists the blobs in this container with a continuation chain per range of blob
+     * names, listing the ranges in parallel.
+     *
+     * @param onBlobs Called with the blobs of each page. The pages of a range are passed in order,
+     * and the pages of different ranges are interleaved. Calls are not concurrent.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     */
+    void ListBlobsParallel(
+        const std::function<void(const std::vector<Models::BlobItem>&)>& onBlobs,
+        const ListBlobsParallelOptions& options = ListBlobsParallelOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
+    /**
+     * @brief Uploads the files of a local directory and its subdirectories to block blobs. The
+     * requests of all the files share one pool of connections, and smaller files are uploaded
+     * first.
+     *
+     * @param localDirectory The local directory to upload.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A TransferDirectoryResult describing the files which were uploaded or failed.
+     * Failing files do not stop the other files from being uploaded.
+     */
+    Models::TransferDirectoryResult UploadDirectory(
+        const std::string& localDirectory,
+        const UploadDirectoryOptions& options = UploadDirectoryOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
+    /**
+     * @brief Downloads the blobs of this container to a local directory, creating subdirectories
+     * for the '/' separated blob names. The requests of all the blobs share one pool of
+     * connections, and smaller blobs are downloaded first.
+     *
+     * @param localDirectory The local directory to download to.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A TransferDirectoryResult describing the blobs which were downloaded or failed.
+     * Failing blobs do not stop the other blobs from being downloaded.
+     */
+    Models::TransferDirectoryResult DownloadDirectory(
+        const std::string& localDirectory,
+        const DownloadDirectoryOptions& options = DownloadDirectoryOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
     /**
      * @brief Returns a collection of blobs in this container. Enumerating the blobs may make
      * multiple requests to the service while fetching all the values. Blobs are ordered
@@ -326,6 +387,40 @@ namespace Azure { namespace Storage { namespace Blobs {
         const SubmitBlobBatchOptions& options = SubmitBlobBatchOptions(),
         const Core::Context& context = Core::Context()) const;
 
+    /**
+     * @brief Submits any number of delete and set access tier operations on the blobs of this
+     * container, as batches of up to MaxSubrequests subrequests submitted concurrently.
+     *
+     * @details Operations are read from \p getNextOperation as batches are submitted, so that they
+     * do not need to be held in memory at once. The failure of an operation, or of a batch
+     * request as a whole, is reported in the result. Operations in different batches may be
+     * executed in any order.
+     *
+     * @param getNextOperation Sets its argument to the next operation and returns `true`, or
+     * returns `false` when there are no more operations.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A SubmitBulkBatchResult describing the submitted operations.
+     */
+    Models::SubmitBulkBatchResult SubmitBulkBatch(
+        const std::function<bool(BlobBatchOperation&)>& getNextOperation,
+        const SubmitBulkBatchOptions& options = SubmitBulkBatchOptions(),
+        const Core::Context& context = Core::Context()) const;
+
+    /**
+     * @brief Submits any number of delete and set access tier operations on the blobs of this
+     * container, as batches of up to MaxSubrequests subrequests submitted concurrently.
+     *
+     * @param operations The operations to submit.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A SubmitBulkBatchResult describing the submitted operations.
+     */
+    Models::SubmitBulkBatchResult SubmitBulkBatch(
+        const std::vector<BlobBatchOperation>& operations,
+        const SubmitBulkBatchOptions& options = SubmitBulkBatchOptions(),
+        const Core::Context& context = Core::Context()) const;
+
     /**
      * @brief Returns the sku name and account kind for the specified account.
      *
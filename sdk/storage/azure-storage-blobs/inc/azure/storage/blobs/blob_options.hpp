@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <chrono>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <numeric>
 #include <string>
@@ -540,6 +541,163 @@ namespace Azure { namespace Storage { namespace Blobs {
     StorageResponseFormat ResponseFormat = StorageResponseFormat::Auto;
   };
 
+  /**
+   * @brief Optional parameters for #Azure::Storage::Blobs::BlobContainerClient::ListBlobsParallel.
+   */
+  struct ListBlobsParallelOptions final
+  {
+    /**
+     * @brief Specifies a string that filters the results to return only blobs whose
+     * name begins with the specified prefix.
+     */
+    Azure::Nullable<std::string> Prefix;
+
+    /**
+     * @brief Specifies the maximum number of blobs to return in each page.
+     */
+    Azure::Nullable<int32_t> PageSizeHint;
+
+    /**
+     * @brief Specifies one or more datasets to include in the response.
+     */
+    Models::ListBlobsIncludeFlags Include = Models::ListBlobsIncludeFlags::None;
+
+    /**
+     * @brief Blob names at which the name space is split into ranges, in ascending order. Each
+     * range starts at a split point and ends before the next one.
+     *
+     * @note Ranges are also split while they are listed, when they prove to have more than a page
+     * of blobs and a range is not waiting to be listed.
+     */
+    std::vector<std::string> SplitPoints;
+
+    /**
+     * @brief The maximum number of ranges listed at the same time.
+     */
+    int32_t Concurrency = 8;
+  };
+
+  namespace Models {
+    /**
+     * @brief Progress of #Azure::Storage::Blobs::BlobContainerClient::UploadDirectory and
+     * #Azure::Storage::Blobs::BlobContainerClient::DownloadDirectory.
+     */
+    struct TransferDirectoryProgress final
+    {
+      /**
+       * Number of bytes transferred.
+       */
+      int64_t TransferredBytes = 0;
+
+      /**
+       * Total size of the files to transfer, excluding the ones which are skipped. For a
+       * download, it grows while the blobs are listed.
+       */
+      int64_t TotalBytes = 0;
+
+      /**
+       * Number of files transferred.
+       */
+      int64_t TransferredFiles = 0;
+
+      /**
+       * Number of files which failed to transfer.
+       */
+      int64_t FailedFiles = 0;
+
+      /**
+       * Number of files to transfer, excluding the ones which are skipped. For a download, it
+       * grows while the blobs are listed.
+       */
+      int64_t TotalFiles = 0;
+    };
+  } // namespace Models
+
+  /**
+   * @brief Optional parameters for #Azure::Storage::Blobs::BlobContainerClient::UploadDirectory.
+   */
+  struct UploadDirectoryOptions final
+  {
+    /**
+     * @brief Prepended to the relative paths of the files to name the blobs, for example
+     * "folder/".
+     */
+    Azure::Nullable<std::string> Prefix;
+
+    /**
+     * @brief Indicates the tier to be set on the blobs.
+     */
+    Azure::Nullable<Models::AccessTier> AccessTier;
+
+    /**
+     * @brief Options for parallel transfer.
+     */
+    struct
+    {
+      /**
+       * @brief Files larger than this are uploaded in blocks of this size, which may be raised
+       * for a file which would otherwise have more than 50000 blocks.
+       */
+      int64_t ChunkSize = 8 * 1024 * 1024;
+
+      /**
+       * @brief The maximum number of requests sent in parallel, across all the files.
+       */
+      int32_t Concurrency = (std::min)(96, (std::max)(8, _internal::GetHardwareConcurrency()));
+    } TransferOptions;
+
+    /**
+     * @brief Called as the transfer progresses. Calls are not concurrent.
+     */
+    std::function<void(const Models::TransferDirectoryProgress&)> ProgressHandler;
+
+    /**
+     * @brief A file where each uploaded file is recorded. The files recorded with their current
+     * size and last write time are skipped, which allows an interrupted upload to be resumed.
+     */
+    Azure::Nullable<std::string> JournalPath;
+  };
+
+  /**
+   * @brief Optional parameters for #Azure::Storage::Blobs::BlobContainerClient::DownloadDirectory.
+   */
+  struct DownloadDirectoryOptions final
+  {
+    /**
+     * @brief Only the blobs whose name begins with the prefix are downloaded, and the prefix is
+     * removed from their name to make the relative path of the files. A prefix naming a
+     * directory may end with '/' or not, for example "folder/" or "folder".
+     */
+    Azure::Nullable<std::string> Prefix;
+
+    /**
+     * @brief Options for parallel transfer.
+     */
+    struct
+    {
+      /**
+       * @brief Blobs larger than this are downloaded in ranges of this size.
+       */
+      int64_t ChunkSize = 8 * 1024 * 1024;
+
+      /**
+       * @brief The maximum number of requests sent in parallel, across all the blobs.
+       */
+      int32_t Concurrency = (std::min)(96, (std::max)(8, _internal::GetHardwareConcurrency()));
+    } TransferOptions;
+
+    /**
+     * @brief Called as the transfer progresses. Calls are not concurrent.
+     */
+    std::function<void(const Models::TransferDirectoryProgress&)> ProgressHandler;
+
+    /**
+     * @brief A file where each downloaded blob is recorded. The blobs recorded with their
+     * current size and ETag are skipped, which allows an interrupted download to be resumed.
+     */
+    Azure::Nullable<std::string> JournalPath;
+  };
+
   /**
    * @brief Optional parameters for #Azure::Storage::Blobs::BlobContainerClient::GetAccessPolicy.
    */
@@ -1180,6 +1338,146 @@ namespace Azure { namespace Storage { namespace Blobs {
     Azure::Nullable<EncryptionKey> SourceCustomerProvidedKey;
   };
 
+  /**
+   * @brief Optional parameters for #Azure::Storage::Blobs::BlockBlobClient::CopyFromUriInBlocks.
+   */
+  struct CopyBlobFromUriInBlocksOptions final
+  {
+    /**
+     * @brief The standard HTTP header system properties to set.
+     */
+    Models::BlobHttpHeaders HttpHeaders;
+
+    /**
+     * @brief Name-value pairs associated with the blob as metadata.
+     */
+    Storage::Metadata Metadata;
+
+    /**
+     * @brief The tags to set for this blob.
+     */
+    std::map<std::string, std::string> Tags;
+
+    /**
+     * @brief Indicates the tier to be set on blob.
+     */
+    Azure::Nullable<Models::AccessTier> AccessTier;
+
+    /**
+     * @brief Optional conditions that must be met to commit the blob. Only the lease is used for
+     * the blocks.
+     */
+    BlobAccessConditions AccessConditions;
+
+    struct : public Azure::ModifiedConditions, public Azure::MatchConditions
+    {
+    } /**
+       * @brief Optional conditions that the source must meet to perform this operation.
+       * @remarks Set IfMatch to the ETag of the source to resume an interrupted copy. The blocks
+       * it staged are only reused when they were staged from the same version of the source.
+       */
+    SourceAccessConditions;
+
+    /**
+     * @brief Optional. Source authorization used to access the source file.
+     * The format is: \<scheme\> \<signature\>
+     * Only Bearer type is supported. Credentials should be a valid OAuth access token to copy
+     * source.
+     */
+    std::string SourceAuthorization;
+
+    /**
+     * Optional, only applicable (but required) when the source is Azure Storage Files and using
+     * token authentication. Used to indicate the intent of the request.
+     */
+    Azure::Nullable<Models::FileShareTokenIntent> FileRequestIntent;
+
+    /**
+     * Optional. Specifies the source customer provided key to use to encrypt the source blob.
+     * Applicable only for service version 2026-02-06 or later.
+     */
+    Azure::Nullable<EncryptionKey> SourceCustomerProvidedKey;
+
+    /**
+     * @brief Options for parallel transfer.
+     */
+    struct
+    {
+      /**
+       * @brief The number of bytes of the source copied by a single request. This value cannot be
+       * larger than 4000 MiB.
+       */
+      Azure::Nullable<int64_t> ChunkSize;
+
+      /**
+       * @brief The maximum number of requests that may be executed concurrently.
+       */
+      int32_t Concurrency = (std::min)(96, (std::max)(8, _internal::GetHardwareConcurrency()));
+    } TransferOptions;
+
+    /**
+     * @brief Callback for progress handling, called with the number of bytes copied and the size
+     * of the source each time a block is staged. Calls are not concurrent.
+     */
+    std::function<void(int64_t, int64_t)> ProgressHandler;
+  };
+
+  /**
+   * @brief Optional parameters for #Azure::Storage::Blobs::BlockBlobWriter.
+   */
+  struct BlockBlobWriterOptions final
+  {
+    /**
+     * @brief The standard HTTP header system properties to set.
+     */
+    Models::BlobHttpHeaders HttpHeaders;
+
+    /**
+     * @brief Name-value pairs associated with the blob as metadata.
+     */
+    Storage::Metadata Metadata;
+
+    /**
+     * @brief The tags to set for this blob.
+     */
+    std::map<std::string, std::string> Tags;
+
+    /**
+     * @brief Indicates the tier to be set on blob.
+     */
+    Azure::Nullable<Models::AccessTier> AccessTier;
+
+    /**
+     * @brief Optional conditions that must be met to commit the blob. Only the lease is used for
+     * the blocks.
+     */
+    BlobAccessConditions AccessConditions;
+
+    /**
+     * @brief Options for parallel transfer.
+     */
+    struct
+    {
+      /**
+       * @brief The size of the first blocks. The block size doubles every 10000 blocks, up to
+       * 4000 MiB, so that the data written is not limited to 50000 blocks of this size.
+       */
+      int64_t BlockSize = 8 * 1024 * 1024;
+
+      /**
+       * @brief The maximum number of blocks staged concurrently. At most Concurrency + 1 blocks
+       * are buffered in memory.
+       */
+      int32_t Concurrency = 4;
+    } TransferOptions;
+
+    /**
+     * @brief Hash algorithm used to compute a hash of each block, which the service verifies
+     * when the block is staged.
+     */
+    Azure::Nullable<HashAlgorithm> BlockHashAlgorithm;
+  };
+
   /**
    * @brief Optional parameters for #Azure::Storage::Blobs::BlockBlobClient::StageBlock.
    */
@@ -1459,6 +1757,12 @@ namespace Azure { namespace Storage { namespace Blobs {
      * will ignore all non-fatal errors and throw for fatal errors.
      */
     std::function<void(BlobQueryError)> ErrorHandler;
+    /**
+     * @brief If true, the query response is decoded on a worker thread while the data decoded
+     * before is read from the body stream. The progress and error handlers are then called on the
+     * worker thread.
+     */
+    bool DecodeInBackground = false;
   };
 
   /**
@@ -1773,6 +2077,106 @@ namespace Azure { namespace Storage { namespace Blobs {
     BlobAccessConditions AccessConditions;
   };
 
+  /**
+   * @brief Optional parameters for #Azure::Storage::Blobs::PageBlobClient::DownloadPagesTo.
+   */
+  struct DownloadPagesToOptions final
+  {
+    /**
+     * @brief If specified, the file must hold the content of this snapshot of the blob. Only the
+     * pages changed since the snapshot are downloaded, and the cleared pages are zeroed in the
+     * file.
+     */
+    Azure::Nullable<std::string> PreviousSnapshot;
+
+    /**
+     * @brief Optional conditions that must be met to perform this operation.
+     */
+    BlobAccessConditions AccessConditions;
+
+    /**
+     * @brief Options for parallel transfer.
+     */
+    struct
+    {
+      /**
+       * @brief The maximum number of bytes in a single request.
+       */
+      int64_t ChunkSize = 4 * 1024 * 1024;
+
+      /**
+       * @brief The maximum number of threads that may be used in a parallel transfer.
+       */
+      int32_t Concurrency = (std::min)(96, (std::max)(8, _internal::GetHardwareConcurrency()));
+    } TransferOptions;
+
+    /**
+     * @brief Optional. Configures whether to do content validation for blob downloads.
+     */
+    Azure::Nullable<TransferValidationOptions> ValidationOptions;
+  };
+
+  /**
+   * @brief Optional parameters for #Azure::Storage::Blobs::PageBlobClient::UploadPagesFrom.
+   */
+  struct UploadPagesFromOptions final
+  {
+    /**
+     * @brief If true, the pages are written to the existing blob, which is resized to the size of
+     * the file, and the pages which are all zeros in the file are cleared. Otherwise a new blob is
+     * created and these pages are skipped.
+     */
+    bool UpdateExisting = false;
+
+    /**
+     * @brief The standard HTTP header system properties to set, if a new blob is created.
+     */
+    Models::BlobHttpHeaders HttpHeaders;
+
+    /**
+     * @brief Name-value pairs associated with the blob as metadata, if a new blob is created.
+     */
+    Storage::Metadata Metadata;
+
+    /**
+     * @brief The tags to set for this blob, if a new blob is created.
+     */
+    std::map<std::string, std::string> Tags;
+
+    /**
+     * @brief Indicates the tier to be set on blob, if a new blob is created.
+     */
+    Azure::Nullable<Models::AccessTier> AccessTier;
+
+    /**
+     * @brief Optional conditions that must be met to create or resize the blob. Only the lease is
+     * used for the pages.
+     */
+    BlobAccessConditions AccessConditions;
+
+    /**
+     * @brief Options for parallel transfer.
+     */
+    struct
+    {
+      /**
+       * @brief The maximum number of bytes in a single request. This value must be a multiple of
+       * 512 and cannot be larger than 4 MiB.
+       */
+      int64_t ChunkSize = 4 * 1024 * 1024;
+
+      /**
+       * @brief The maximum number of threads that may be used in a parallel transfer.
+       */
+      int32_t Concurrency = (std::min)(96, (std::max)(8, _internal::GetHardwareConcurrency()));
+    } TransferOptions;
+
+    /**
+     * @brief Optional. Configures whether to do content validation for blob uploads.
+     */
+    Azure::Nullable<TransferValidationOptions> ValidationOptions;
+  };
+
   /**
    * @brief Optional parameters for #Azure::Storage::Blobs::BlobClient::SetLegalHold.
    */
@@ -1812,6 +2216,49 @@ namespace Azure { namespace Storage { namespace Blobs {
   {
   };
 
+  /**
+   * @brief An operation submitted by
+   * #Azure::Storage::Blobs::BlobServiceClient::SubmitBulkBatch.
+   */
+  struct BlobBatchOperation final
+  {
+    /**
+     * @brief Url of the blob.
+     */
+    std::string BlobUrl;
+
+    /**
+     * @brief The tier to set on the blob. If not specified, the blob is deleted.
+     */
+    Azure::Nullable<Models::AccessTier> AccessTier;
+
+    /**
+     * @brief Optional parameters to execute the delete operation.
+     */
+    DeleteBlobOptions DeleteOptions;
+
+    /**
+     * @brief Optional parameters to execute the set access tier operation.
+     */
+    SetBlobAccessTierOptions SetAccessTierOptions;
+  };
+
+  /**
+   * @brief Optional parameters for #Azure::Storage::Blobs::BlobServiceClient::SubmitBulkBatch.
+   */
+  struct SubmitBulkBatchOptions final
+  {
+    /**
+     * @brief The maximum number of subrequests in a batch. The service accepts up to 256.
+     */
+    int32_t MaxSubrequests = 256;
+
+    /**
+     * @brief The maximum number of batches submitted concurrently.
+     */
+    int32_t Concurrency = (std::min)(96, (std::max)(8, _internal::GetHardwareConcurrency()));
+  };
+
   namespace _detail {
     inline std::string TagsToString(const std::map<std::string, std::string>& tags)
     {
@@ -62,6 +62,103 @@ namespace Azure { namespace Storage {
 
       using UploadBlockBlobFromResult = UploadBlockBlobResult;
 
+      /**
+       * @brief Response type for #Azure::Storage::Blobs::BlockBlobClient::CopyFromUriInBlocks.
+       */
+      using CopyBlobFromUriInBlocksResult = UploadBlockBlobResult;
+
+      /**
+       * @brief Response type for #Azure::Storage::Blobs::PageBlobClient::DownloadPagesTo.
+       */
+      struct DownloadPagesToResult final
+      {
+        /**
+         * The ETag contains a value that you can use to perform operations conditionally.
+         */
+        Azure::ETag ETag;
+
+        /**
+         * The date/time that the blob was last modified. The date format follows RFC 1123.
+         */
+        Azure::DateTime LastModified;
+
+        /**
+         * Size of the blob.
+         */
+        int64_t BlobSize = 0;
+
+        /**
+         * Number of bytes downloaded, which excludes the pages that were not written or did not
+         * change.
+         */
+        int64_t TransferredSize = 0;
+      };
+
+      /**
+       * @brief Response type for #Azure::Storage::Blobs::PageBlobClient::UploadPagesFrom.
+       */
+      struct UploadPagesFromResult final
+      {
+        /**
+         * The ETag contains a value that you can use to perform operations conditionally.
+         */
+        Azure::ETag ETag;
+
+        /**
+         * The date/time that the blob was last modified. The date format follows RFC 1123.
+         */
+        Azure::DateTime LastModified;
+
+        /**
+         * Number of bytes uploaded, which excludes the pages which are all zeros.
+         */
+        int64_t TransferredSize = 0;
+      };
+
+      /**
+       * @brief A file which failed to transfer.
+       */
+      struct TransferDirectoryFailure final
+      {
+        /**
+         * Path of the file, relative to the local directory.
+         */
+        std::string Path;
+
+        /**
+         * Description of the error.
+         */
+        std::string Message;
+      };
+
+      /**
+       * @brief Response type for #Azure::Storage::Blobs::BlobContainerClient::UploadDirectory and
+       * #Azure::Storage::Blobs::BlobContainerClient::DownloadDirectory.
+       */
+      struct TransferDirectoryResult final
+      {
+        /**
+         * Number of files transferred.
+         */
+        int64_t TransferredFiles = 0;
+
+        /**
+         * Number of files which were skipped, because the journal shows they were already
+         * transferred.
+         */
+        int64_t SkippedFiles = 0;
+
+        /**
+         * Number of bytes transferred.
+         */
+        int64_t TransferredBytes = 0;
+
+        /**
+         * The files which failed to transfer.
+         */
+        std::vector<TransferDirectoryFailure> Failures;
+      };
+
       /**
        * @brief Response type for #Azure::Storage::Blobs::BlobLeaseClient::Acquire.
        */
@@ -213,6 +310,54 @@ namespace Azure { namespace Storage {
       {
       };
 
+      /**
+       * @brief An operation which failed in
+       * #Azure::Storage::Blobs::BlobServiceClient::SubmitBulkBatch.
+       */
+      struct BulkBatchFailure final
+      {
+        /**
+         * The failed operation.
+         */
+        BlobBatchOperation Operation;
+
+        /**
+         * The HTTP status code of the subrequest, or of the batch request if it failed as a whole.
+         */
+        Core::Http::HttpStatusCode StatusCode = Core::Http::HttpStatusCode::None;
+
+        /**
+         * The error code returned by the service.
+         */
+        std::string ErrorCode;
+
+        /**
+         * The error message.
+         */
+        std::string Message;
+      };
+
+      /**
+       * @brief Response type for #Azure::Storage::Blobs::BlobServiceClient::SubmitBulkBatch.
+       */
+      struct SubmitBulkBatchResult final
+      {
+        /**
+         * Number of operations which succeeded.
+         */
+        int64_t SucceededCount = 0;
+
+        /**
+         * Number of batch requests submitted.
+         */
+        int64_t BatchCount = 0;
+
+        /**
+         * The operations which failed.
+         */
+        std::vector<BulkBatchFailure> Failures;
+      };
+
     } // namespace Models
 
     /**
@@ -268,6 +268,40 @@ namespace Azure { namespace Storage { namespace Blobs {
         const SubmitBlobBatchOptions& options = SubmitBlobBatchOptions(),
         const Core::Context& context = Core::Context()) const;
 
+    /**
+     * @brief Submits any number of delete and set access tier operations on the blobs of this
+     * account, as batches of up to MaxSubrequests subrequests submitted concurrently.
+     *
+     * @details Operations are read from \p getNextOperation as batches are submitted, so that they
+     * do not need to be held in memory at once. The failure of an operation, or of a batch
+     * request as a whole, is reported in the result. Operations in different batches may be
+     * executed in any order.
+     *
+     * @param getNextOperation Sets its argument to the next operation and returns `true`, or
+     * returns `false` when there are no more operations.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A SubmitBulkBatchResult describing the submitted operations.
+     */
+    Models::SubmitBulkBatchResult SubmitBulkBatch(
+        const std::function<bool(BlobBatchOperation&)>& getNextOperation,
+        const SubmitBulkBatchOptions& options = SubmitBulkBatchOptions(),
+        const Core::Context& context = Core::Context()) const;
+
+    /**
+     * @brief Submits any number of delete and set access tier operations on the blobs of this
+     * account, as batches of up to MaxSubrequests subrequests submitted concurrently.
+     *
+     * @param operations The operations to submit.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A SubmitBulkBatchResult describing the submitted operations.
+     */
+    Models::SubmitBulkBatchResult SubmitBulkBatch(
+        const std::vector<BlobBatchOperation>& operations,
+        const SubmitBulkBatchOptions& options = SubmitBulkBatchOptions(),
+        const Core::Context& context = Core::Context()) const;
+
   private:
     Azure::Core::Url m_serviceUrl;
     std::shared_ptr<Azure::Core::Http::_internal::HttpPipeline> m_pipeline;
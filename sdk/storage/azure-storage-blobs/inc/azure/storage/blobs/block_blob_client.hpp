@@ -170,6 +170,28 @@ namespace Azure { namespace Storage { namespace Blobs {
         const UploadBlockBlobFromUriOptions& options = UploadBlockBlobFromUriOptions(),
         const Azure::Core::Context& context = Azure::Core::Context()) const;
 
+    /**
+     * @brief Creates a new block blob from the content of a source blob of any size, by copying
+     * ranges of the source as blocks concurrently on the service side and committing them. The
+     * content is not transferred through the client.
+     *
+     * @remarks The IDs of the blocks are derived from the source, its size, the block size and the
+     * ETag in the source IfMatch condition. When that condition is set, a copy which was
+     * interrupted is resumed by calling this function again with the same arguments, which only
+     * stages the blocks that are missing. Otherwise every block is staged again.
+     *
+     * @param sourceUri Specifies the URL of the source blob.
+     * @param sourceSize The size of the source blob in bytes.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A CopyBlobFromUriInBlocksResult describing the state of the updated block blob.
+     */
+    Azure::Response<Models::CopyBlobFromUriInBlocksResult> CopyFromUriInBlocks(
+        const std::string& sourceUri,
+        int64_t sourceSize,
+        const CopyBlobFromUriInBlocksOptions& options = CopyBlobFromUriInBlocksOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
     /**
      * @brief Creates a new block as part of a block blob's staging area to be eventually
      * committed via the CommitBlockList operation.
@@ -0,0 +1,87 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "azure/storage/blobs/block_blob_client.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace Blobs {
+
+  /**
+   * @brief BlockBlobWriter uploads data of unknown length to a block blob as it is written. Full
+   * blocks are staged concurrently while more data is written, and the blob is committed by
+   * #Azure::Storage::Blobs::BlockBlobWriter::Commit.
+   */
+  class BlockBlobWriter final {
+  public:
+    /**
+     * @brief Initializes a new instance of the BlockBlobWriter.
+     *
+     * @param blockBlobClient A BlockBlobClient representing the blob to write.
+     * @param options Optional parameters to write the blob.
+     */
+    explicit BlockBlobWriter(
+        BlockBlobClient blockBlobClient,
+        BlockBlobWriterOptions options = BlockBlobWriterOptions());
+
+    BlockBlobWriter(const BlockBlobWriter&) = delete;
+    BlockBlobWriter& operator=(const BlockBlobWriter&) = delete;
+
+    /**
+     * @brief Waits for the blocks being staged. The blob is not changed if it was not committed.
+     */
+    ~BlockBlobWriter();
+
+    /**
+     * @brief Writes data at the end of the blob. Returns when the data is buffered, which may
+     * wait for blocks to be staged. An error staging a previous block is thrown.
+     *
+     * @param buffer A memory buffer containing the data to write.
+     * @param bufferSize Size of the memory buffer.
+     * @param context Context for cancelling long running operations. It applies to the staging of
+     * the blocks which are filled by this call.
+     */
+    void Write(
+        const uint8_t* buffer,
+        size_t bufferSize,
+        const Azure::Core::Context& context = Azure::Core::Context());
+
+    /**
+     * @brief Stages the remaining data, and commits the blocks written as the content of the blob.
+     * No data can be written after.
+     *
+     * @param context Context for cancelling long running operations.
+     * @return A CommitBlockListResult describing the state of the updated block blob.
+     */
+    Azure::Response<Models::CommitBlockListResult> Commit(
+        const Azure::Core::Context& context = Azure::Core::Context());
+
+  private:
+    int64_t GetBlockSize(size_t blockIndex) const;
+    std::vector<uint8_t> GetBuffer(size_t size);
+    void StageBlock(const Azure::Core::Context& context);
+
+    BlockBlobClient m_blockBlobClient;
+    BlockBlobWriterOptions m_options;
+    std::vector<uint8_t> m_block;
+    size_t m_blockLength = 0;
+    std::vector<std::string> m_blockIds;
+    bool m_committed = false;
+
+    std::mutex m_mutex;
+    std::condition_variable m_blockStaged;
+    int32_t m_stagingBlocks = 0;
+    std::vector<std::vector<uint8_t>> m_freeBuffers;
+    std::vector<std::future<void>> m_stagingTasks;
+    std::exception_ptr m_exception;
+  };
+
+}}} // namespace Azure::Storage::Blobs
@@ -285,6 +285,37 @@ namespace Azure { namespace Storage { namespace Blobs {
         const StartBlobCopyIncrementalOptions& options = StartBlobCopyIncrementalOptions(),
         const Azure::Core::Context& context = Azure::Core::Context()) const;
 
+    /**
+     * @brief Downloads the valid pages of this page blob to a file, in parallel. The unallocated
+     * ranges of the blob are not transferred, and are left as holes in the file where the file
+     * system supports sparse files.
+     *
+     * @param fileName A file path to write the downloaded content to. The file is overwritten,
+     * unless a previous snapshot is specified in the options.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A DownloadPagesToResult describing the downloaded page blob.
+     */
+    Azure::Response<Models::DownloadPagesToResult> DownloadPagesTo(
+        const std::string& fileName,
+        const DownloadPagesToOptions& options = DownloadPagesToOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
+    /**
+     * @brief Uploads the content of a file to this page blob, in parallel. The pages which are all
+     * zeros in the file are not transferred.
+     *
+     * @param fileName A file containing the content to upload. The size of the file must be a
+     * multiple of 512 bytes.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return An UploadPagesFromResult describing the state of the updated page blob.
+     */
+    Azure::Response<Models::UploadPagesFromResult> UploadPagesFrom(
+        const std::string& fileName,
+        const UploadPagesFromOptions& options = UploadPagesFromOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
   private:
     explicit PageBlobClient(BlobClient blobClient);
 
@@ -12,11 +12,13 @@
 #include <azure/storage/common/crypt.hpp>
 #include <azure/storage/common/internal/constants.hpp>
 #include <azure/storage/common/internal/shared_key_policy.hpp>
+#include <azure/storage/common/storage_exception.hpp>
 
 #include <algorithm>
 #include <cstring>
 #include <functional>
 #include <future>
+#include <mutex>
 #include <stdexcept>
 
 namespace Azure { namespace Storage { namespace Blobs {
@@ -50,16 +52,17 @@ namespace Azure { namespace Storage { namespace Blobs {
     static Core::Context::Key s_subrequestKey;
     static Core::Context::Key s_subresponseKey;
 
+    // A part of a multipart body, which is not copied out of the buffer it was read into.
+    struct BodyPart final
+    {
+      const char* Begin = nullptr;
+      const char* End = nullptr;
+    };
+
     struct Parser final
     {
-      explicit Parser(const std::string& str)
-          : startPos(str.data()), currPos(startPos), endPos(startPos + str.length())
-      {
-      }
-      explicit Parser(const std::vector<uint8_t>& str)
-          : startPos(reinterpret_cast<const char*>(str.data())),
-            currPos(reinterpret_cast<const char*>(startPos)),
-            endPos(reinterpret_cast<const char*>(startPos) + str.size())
+      explicit Parser(const BodyPart& part)
+          : startPos(part.Begin), currPos(startPos), endPos(part.End)
       {
       }
       const char* startPos;
@@ -115,7 +118,7 @@ namespace Azure { namespace Storage { namespace Blobs {
       }
     };
 
-    std::unique_ptr<Core::Http::RawResponse> ParseRawResponse(const std::string& responseText)
+    std::unique_ptr<Core::Http::RawResponse> ParseRawResponse(const BodyPart& responseText)
     {
       Parser parser(responseText);
 
@@ -147,6 +150,90 @@ namespace Azure { namespace Storage { namespace Blobs {
       return rawResponse;
     }
 
+    // Reads the parts of a multipart body from a stream. Only the part being read is held in
+    // memory, so subresponses are handled as they arrive.
+    class MultipartReader final {
+    public:
+      MultipartReader(Core::IO::BodyStream& stream, const std::string& boundary)
+          : m_stream(stream), m_delimiter("--" + boundary)
+      {
+      }
+
+      // Reads the next part, which is valid until the next call. Returns false once the close
+      // delimiter is reached.
+      bool ReadNextPart(BodyPart& part, const Core::Context& context)
+      {
+        // The buffer starts with the delimiter preceding the part.
+        while (m_end - m_begin < m_delimiter.length() + 2)
+        {
+          if (!Fill(context))
+          {
+            throw std::runtime_error("failed to parse response body");
+          }
+        }
+        if (std::memcmp(&m_buffer[m_begin], m_delimiter.data(), m_delimiter.length()) != 0)
+        {
+          throw std::runtime_error("failed to parse response body");
+        }
+        m_begin += m_delimiter.length();
+        if (m_buffer[m_begin] == '-' && m_buffer[m_begin + 1] == '-')
+        {
+          return false;
+        }
+
+        size_t searchedLength = 0;
+        while (true)
+        {
+          const char* searchStart = &m_buffer[m_begin] + searchedLength;
+          const char* bufferEnd = m_buffer.data() + m_end;
+          auto delimiterPos
+              = std::search(searchStart, bufferEnd, m_delimiter.begin(), m_delimiter.end());
+          if (delimiterPos != bufferEnd)
+          {
+            part.Begin = &m_buffer[m_begin];
+            part.End = delimiterPos;
+            m_begin = static_cast<size_t>(delimiterPos - m_buffer.data());
+            return true;
+          }
+          // A delimiter may start in the last bytes that were searched.
+          const size_t bufferedLength = m_end - m_begin;
+          searchedLength = bufferedLength < m_delimiter.length()
+              ? 0
+              : bufferedLength - m_delimiter.length() + 1;
+          if (!Fill(context))
+          {
+            throw std::runtime_error("failed to parse response body");
+          }
+        }
+      }
+
+    private:
+      bool Fill(const Core::Context& context)
+      {
+        constexpr size_t ReadSize = 64 * 1024;
+        if (m_begin != 0)
+        {
+          std::memmove(m_buffer.data(), &m_buffer[m_begin], m_end - m_begin);
+          m_end -= m_begin;
+          m_begin = 0;
+        }
+        if (m_buffer.size() - m_end < ReadSize)
+        {
+          m_buffer.resize(m_end + ReadSize);
+        }
+        const size_t bytesRead = m_stream.Read(
+            reinterpret_cast<uint8_t*>(&m_buffer[m_end]), m_buffer.size() - m_end, context);
+        m_end += bytesRead;
+        return bytesRead != 0;
+      }
+
+      Core::IO::BodyStream& m_stream;
+      const std::string m_delimiter;
+      std::vector<char> m_buffer;
+      size_t m_begin = 0;
+      size_t m_end = 0;
+    };
+
     class RemoveXMsVersionPolicy final : public Core::Http::Policies::HttpPolicy {
     public:
       ~RemoveXMsVersionPolicy() override {}
@@ -200,7 +287,7 @@ namespace Azure { namespace Storage { namespace Blobs {
           return rawResponse;
         }
 
-        std::string* subresponseText = nullptr;
+        const BodyPart* subresponseText = nullptr;
         context.TryGetValue(s_subresponseKey, subresponseText);
         if (subresponseText)
         {
@@ -365,58 +452,73 @@ namespace Azure { namespace Storage { namespace Blobs {
           _internal::HttpHeaderContentLength, std::to_string(request.GetBodyStream()->Length()));
     }
 
-    void ParseSubresponses(
-        std::unique_ptr<Core::Http::RawResponse>& rawResponse,
-        const Core::Context& context)
+    // Sets the response of a subrequest parsed from its subresponse, or the exception if the
+    // subresponse is missing.
+    void SetSubresponse(_detail::BatchSubrequest& subrequestBase, const BodyPart* subresponse)
     {
-      if (rawResponse->GetStatusCode() != Core::Http::HttpStatusCode::Accepted
-          || rawResponse->GetHeaders().count(_internal::HttpHeaderContentType) == 0)
+      if (subrequestBase.HasResponse)
       {
         return;
       }
+      subrequestBase.HasResponse = true;
 
-      const std::string boundary = rawResponse->GetHeaders()
-                                       .at(std::string(_internal::HttpHeaderContentType))
-                                       .substr(BatchContentTypePrefix.length());
-
-      const std::vector<uint8_t>& responseBody
-          = rawResponse->ExtractBodyStream()->ReadToEnd(context);
-      Parser parser(responseBody);
-
-      std::vector<std::string> subresponses;
-      while (true)
+      if (subrequestBase.Type == _detail::BatchSubrequestType::DeleteBlob)
       {
-        parser.Consume("--" + boundary);
-        if (parser.LookAhead("--"))
+        auto& subrequest = static_cast<DeleteBlobSubrequest&>(subrequestBase);
+        try
         {
-          parser.Consume("--");
+          if (!subresponse)
+          {
+            throw Azure::Core::RequestFailedException("Subresponse is missing.");
+          }
+          auto response = subrequest.Client.Delete(
+              subrequest.Options, Core::Context().WithValue(s_subresponseKey, subresponse));
+          subrequest.Promise.set_value(std::move(response));
         }
-        if (parser.IsEnd())
+        catch (...)
         {
-          break;
+          subrequest.Promise.set_exception(std::current_exception());
         }
-        auto contentIdPos = parser.AfterNext("Content-ID: ");
-        auto responseStartPos = parser.AfterNext(LineEnding + LineEnding);
-        auto responseEndPos = parser.FindNext("--" + boundary);
-        if (contentIdPos != parser.endPos)
-        {
-          parser.currPos = contentIdPos;
-          auto idEndPos = parser.FindNext(LineEnding);
-          size_t id = static_cast<size_t>(std::stoi(std::string(parser.currPos, idEndPos)));
-          if (subresponses.size() < id + 1)
+      }
+      else if (subrequestBase.Type == _detail::BatchSubrequestType::SetBlobAccessTier)
+      {
+        auto& subrequest = static_cast<SetBlobAccessTierSubrequest&>(subrequestBase);
+        try
+        {
+          if (!subresponse)
           {
-            subresponses.resize(id + 1);
+            throw Azure::Core::RequestFailedException("Subresponse is missing.");
           }
-          subresponses[id] = std::string(responseStartPos, responseEndPos);
-          parser.currPos = responseEndPos;
+          auto response = subrequest.Client.SetAccessTier(
+              subrequest.Tier,
+              subrequest.Options,
+              Core::Context().WithValue(s_subresponseKey, subresponse));
+          subrequest.Promise.set_value(std::move(response));
         }
-        else
+        catch (...)
         {
-          rawResponse = ParseRawResponse(std::string(responseStartPos, responseEndPos));
-          parser.currPos = responseEndPos;
-          return;
+          subrequest.Promise.set_exception(std::current_exception());
         }
       }
+      else
+      {
+        AZURE_UNREACHABLE_CODE();
+      }
+    }
+
+    void ParseSubresponses(
+        std::unique_ptr<Core::Http::RawResponse>& rawResponse,
+        const Core::Context& context)
+    {
+      if (rawResponse->GetStatusCode() != Core::Http::HttpStatusCode::Accepted
+          || rawResponse->GetHeaders().count(_internal::HttpHeaderContentType) == 0)
+      {
+        return;
+      }
+
+      const std::string boundary = rawResponse->GetHeaders()
+                                       .at(std::string(_internal::HttpHeaderContentType))
+                                       .substr(BatchContentTypePrefix.length());
 
       std::unique_ptr<_detail::BlobBatchAccessHelper> batchAccessHelper;
       {
@@ -435,46 +537,218 @@ namespace Azure { namespace Storage { namespace Blobs {
           batchAccessHelper = std::make_unique<_detail::BlobBatchAccessHelper>(*batch);
         }
       }
+      const auto& subrequests = batchAccessHelper->Subrequests();
 
-      size_t subresponseCounter = 0;
-      for (const auto& subrequestPtr : batchAccessHelper->Subrequests())
+      // Each subresponse is parsed as soon as it is read, without copying it.
+      auto responseBody = rawResponse->ExtractBodyStream();
+      MultipartReader reader(*responseBody, boundary);
+      BodyPart part;
+      while (reader.ReadNextPart(part, context))
       {
-        if (subrequestPtr->Type == _detail::BatchSubrequestType::DeleteBlob)
+        Parser parser(part);
+        auto contentIdPos = parser.AfterNext("Content-ID: ");
+        BodyPart subresponse;
+        subresponse.Begin = parser.AfterNext(LineEnding + LineEnding);
+        subresponse.End = part.End;
+        if (contentIdPos == parser.endPos)
         {
-          auto& subrequest = *static_cast<DeleteBlobSubrequest*>(subrequestPtr.get());
-          try
+          // The batch request failed as a whole.
+          rawResponse = ParseRawResponse(subresponse);
+          return;
+        }
+        parser.currPos = contentIdPos;
+        const size_t id
+            = static_cast<size_t>(std::stoi(parser.GetBeforeNextAndConsume(LineEnding)));
+        if (id >= subrequests.size())
+        {
+          throw std::runtime_error("failed to parse response body");
+        }
+        SetSubresponse(*subrequests[id], &subresponse);
+      }
+
+      for (const auto& subrequest : subrequests)
+      {
+        SetSubresponse(*subrequest, nullptr);
+      }
+    }
+
+    void AddFailure(
+        Models::SubmitBulkBatchResult& result,
+        const BlobBatchOperation& operation,
+        const Core::RequestFailedException& e)
+    {
+      Models::BulkBatchFailure failure;
+      failure.Operation = operation;
+      failure.StatusCode = e.StatusCode;
+      failure.ErrorCode = e.ErrorCode;
+      // An exception which was not created from a response only has a description.
+      failure.Message = e.Message.empty() ? e.what() : e.Message;
+      result.Failures.push_back(std::move(failure));
+    }
+
+    // Submits the operations as a batch, adding their outcome to the result.
+    template <class Client>
+    void SubmitOperations(
+        const Client& client,
+        const std::vector<BlobBatchOperation>& operations,
+        Models::SubmitBulkBatchResult& result,
+        const Core::Context& context)
+    {
+      auto batch = client.CreateBatch();
+      std::vector<DeferredResponse<Models::DeleteBlobResult>> deleteResponses;
+      std::vector<DeferredResponse<Models::SetBlobAccessTierResult>> setAccessTierResponses;
+      for (const auto& operation : operations)
+      {
+        if (operation.AccessTier.HasValue())
+        {
+          setAccessTierResponses.push_back(batch.SetBlobAccessTierUrl(
+              operation.BlobUrl, operation.AccessTier.Value(), operation.SetAccessTierOptions));
+        }
+        else
+        {
+          deleteResponses.push_back(
+              batch.DeleteBlobUrl(operation.BlobUrl, operation.DeleteOptions));
+        }
+      }
+
+      try
+      {
+        client.SubmitBatch(batch, SubmitBlobBatchOptions(), context);
+      }
+      catch (const StorageException& e)
+      {
+        for (const auto& operation : operations)
+        {
+          AddFailure(result, operation, e);
+        }
+        return;
+      }
+
+      size_t deleteIndex = 0;
+      size_t setAccessTierIndex = 0;
+      for (const auto& operation : operations)
+      {
+        try
+        {
+          if (operation.AccessTier.HasValue())
           {
-            auto response = subrequest.Client.Delete(
-                subrequest.Options,
-                Core::Context().WithValue(s_subresponseKey, &subresponses[subresponseCounter++]));
-            subrequest.Promise.set_value(std::move(response));
+            setAccessTierResponses[setAccessTierIndex++].GetResponse();
           }
-          catch (...)
+          else
           {
-            subrequest.Promise.set_exception(std::current_exception());
+            deleteResponses[deleteIndex++].GetResponse();
           }
+          ++result.SucceededCount;
         }
-        else if (subrequestPtr->Type == _detail::BatchSubrequestType::SetBlobAccessTier)
+        catch (const Core::RequestFailedException& e)
         {
-          auto& subrequest = *static_cast<SetBlobAccessTierSubrequest*>(subrequestPtr.get());
+          // Either the service rejected the subrequest, or its subresponse is missing.
+          AddFailure(result, operation, e);
+        }
+      }
+    }
+
+    template <class Client>
+    Models::SubmitBulkBatchResult SubmitOperationsInBatches(
+        const Client& client,
+        const std::function<bool(BlobBatchOperation&)>& getNextOperation,
+        const SubmitBulkBatchOptions& options,
+        const Core::Context& context)
+    {
+      AZURE_ASSERT_MSG(
+          options.MaxSubrequests > 0 && options.MaxSubrequests <= 256,
+          "MaxSubrequests must be between 1 and 256.");
+      AZURE_ASSERT_MSG(options.Concurrency > 0, "Concurrency must be greater than 0.");
+
+      std::mutex mutex;
+      Models::SubmitBulkBatchResult result;
+      bool noMoreOperations = false;
+      std::exception_ptr exception;
+
+      // Each worker reads the operations of a batch and submits it, until there are no more
+      // operations or something failed.
+      auto worker = [&]() {
+        while (true)
+        {
+          std::vector<BlobBatchOperation> operations;
+          {
+            std::lock_guard<std::mutex> guard(mutex);
+            try
+            {
+              while (!noMoreOperations && !exception
+                     && operations.size() < static_cast<size_t>(options.MaxSubrequests))
+              {
+                operations.emplace_back();
+                if (!getNextOperation(operations.back()))
+                {
+                  operations.pop_back();
+                  noMoreOperations = true;
+                }
+              }
+            }
+            catch (...)
+            {
+              exception = std::current_exception();
+            }
+            if (exception || operations.empty())
+            {
+              return;
+            }
+            ++result.BatchCount;
+          }
+
+          Models::SubmitBulkBatchResult batchResult;
           try
           {
-            auto response = subrequest.Client.SetAccessTier(
-                subrequest.Tier,
-                subrequest.Options,
-                Core::Context().WithValue(s_subresponseKey, &subresponses[subresponseCounter++]));
-            subrequest.Promise.set_value(std::move(response));
+            SubmitOperations(client, operations, batchResult, context);
           }
           catch (...)
           {
-            subrequest.Promise.set_exception(std::current_exception());
+            std::lock_guard<std::mutex> guard(mutex);
+            if (!exception)
+            {
+              exception = std::current_exception();
+            }
+            return;
           }
+
+          std::lock_guard<std::mutex> guard(mutex);
+          result.SucceededCount += batchResult.SucceededCount;
+          result.Failures.insert(
+              result.Failures.end(),
+              std::make_move_iterator(batchResult.Failures.begin()),
+              std::make_move_iterator(batchResult.Failures.end()));
         }
-        else
+      };
+
+      std::vector<std::future<void>> workers;
+      for (int32_t i = 1; i < options.Concurrency; ++i)
+      {
+        workers.push_back(std::async(std::launch::async, worker));
+      }
+      worker();
+      for (auto& w : workers)
+      {
+        w.get();
+      }
+      if (exception)
+      {
+        std::rethrow_exception(exception);
+      }
+      return result;
+    }
+
+    std::function<bool(BlobBatchOperation&)> ReadOperations(
+        const std::vector<BlobBatchOperation>& operations)
+    {
+      return [&operations, next = operations.begin()](BlobBatchOperation& operation) mutable {
+        if (next == operations.end())
         {
-          AZURE_UNREACHABLE_CODE();
+          return false;
         }
-      }
+        operation = *next++;
+        return true;
+      };
     }
   } // namespace
 
@@ -697,4 +971,36 @@ namespace Azure { namespace Storage { namespace Blobs {
     m_subrequests.push_back(std::move(op));
     return deferredResponse;
   }
+
+  Models::SubmitBulkBatchResult BlobServiceClient::SubmitBulkBatch(
+      const std::function<bool(BlobBatchOperation&)>& getNextOperation,
+      const SubmitBulkBatchOptions& options,
+      const Core::Context& context) const
+  {
+    return SubmitOperationsInBatches(*this, getNextOperation, options, context);
+  }
+
+  Models::SubmitBulkBatchResult BlobServiceClient::SubmitBulkBatch(
+      const std::vector<BlobBatchOperation>& operations,
+      const SubmitBulkBatchOptions& options,
+      const Core::Context& context) const
+  {
+    return SubmitOperationsInBatches(*this, ReadOperations(operations), options, context);
+  }
+
+  Models::SubmitBulkBatchResult BlobContainerClient::SubmitBulkBatch(
+      const std::function<bool(BlobBatchOperation&)>& getNextOperation,
+      const SubmitBulkBatchOptions& options,
+      const Core::Context& context) const
+  {
+    return SubmitOperationsInBatches(*this, getNextOperation, options, context);
+  }
+
+  Models::SubmitBulkBatchResult BlobContainerClient::SubmitBulkBatch(
+      const std::vector<BlobBatchOperation>& operations,
+      const SubmitBulkBatchOptions& options,
+      const Core::Context& context) const
+  {
+    return SubmitOperationsInBatches(*this, ReadOperations(operations), options, context);
+  }
 }}} // namespace Azure::Storage::Blobs
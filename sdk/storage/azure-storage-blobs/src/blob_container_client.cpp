@@ -9,22 +9,38 @@
 #include "azure/storage/blobs/page_blob_client.hpp"
 #include "private/package_version.hpp"
 
+#include <azure/core/azure_assert.hpp>
 #include <azure/core/http/policies/policy.hpp>
+#include <azure/core/internal/json/json.hpp>
+#include <azure/core/io/body_stream.hpp>
+#include <azure/core/platform.hpp>
 #include <azure/storage/common/crypt.hpp>
 #include <azure/storage/common/internal/constants.hpp>
+#include <azure/storage/common/internal/file_io.hpp>
 #include <azure/storage/common/internal/shared_key_policy.hpp>
 #include <azure/storage/common/internal/storage_bearer_token_auth.hpp>
 #include <azure/storage/common/internal/storage_per_retry_policy.hpp>
 #include <azure/storage/common/internal/storage_pipeline.hpp>
 #include <azure/storage/common/internal/storage_service_version_policy.hpp>
 #include <azure/storage/common/internal/storage_switch_to_secondary_policy.hpp>
+#include <azure/storage/common/internal/transfer_scheduler.hpp>
 #include <azure/storage/common/internal/xml_wrapper.hpp>
 #include <azure/storage/common/storage_common.hpp>
 #include <azure/storage/common/storage_exception.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
+#include <limits>
 #include <map>
+#include <mutex>
+#include <set>
+#include <stdexcept>
 #include <unordered_map>
+#include <vector>
 
 #if defined(_MSC_VER)
 #pragma warning(push)
@@ -1601,6 +1617,754 @@ namespace Azure { namespace Storage { namespace Blobs {
     return pagedResponse;
   }
 
+  namespace {
+    // Blob names are interpolated as numbers in base 95 of printable ASCII characters, with the
+    // first character as the most significant digit. The split points are then valid in URLs and
+    // in any encoding of the names listed.
+    constexpr char MinNameChar = ' ';
+    constexpr char MaxNameChar = '~';
+    constexpr int NameBase = MaxNameChar - MinNameChar + 1;
+
+    std::vector<int> NameToDigits(const std::string& name, size_t length)
+    {
+      std::vector<int> digits(length, 0);
+      for (size_t i = 0; i < length && i < name.size(); ++i)
+      {
+        // Bytes of multi-byte UTF-8 characters are past the printable range, also where char is
+        // signed.
+        const int c = static_cast<unsigned char>(name[i]);
+        digits[i] = (std::min)((std::max)(c, int(MinNameChar)), int(MaxNameChar)) - MinNameChar;
+      }
+      return digits;
+    }
+
+    std::string DigitsToName(const std::vector<int>& digits)
+    {
+      std::string name;
+      for (auto digit : digits)
+      {
+        name += static_cast<char>(MinNameChar + digit);
+      }
+      while (!name.empty() && name.back() == MinNameChar)
+      {
+        name.pop_back();
+      }
+      return name;
+    }
+
+    // Computes a * factor + b, returning false on overflow.
+    bool MultiplyAdd(std::vector<int>& a, int factor, const std::vector<int>& b)
+    {
+      int carry = 0;
+      for (size_t i = a.size(); i > 0; --i)
+      {
+        const int value = a[i - 1] * factor + b[i - 1] + carry;
+        a[i - 1] = value % NameBase;
+        carry = value / NameBase;
+      }
+      return carry == 0;
+    }
+
+    // Computes a - b, when a >= b.
+    void Subtract(std::vector<int>& a, const std::vector<int>& b)
+    {
+      int borrow = 0;
+      for (size_t i = a.size(); i > 0; --i)
+      {
+        int value = a[i - 1] - b[i - 1] - borrow;
+        borrow = value < 0 ? 1 : 0;
+        a[i - 1] = value + borrow * NameBase;
+      }
+    }
+
+    void Halve(std::vector<int>& a)
+    {
+      int remainder = 0;
+      for (auto& digit : a)
+      {
+        const int value = remainder * NameBase + digit;
+        digit = value / 2;
+        remainder = value % 2;
+      }
+    }
+
+  } // namespace
+
+  namespace _detail {
+    // A bounded range is split in the middle. An unbounded range is split after two more pages as
+    // dense as the last one, and the unbounded part is split again when it proves dense.
+    std::string GetSplitName(
+        const std::string& first,
+        const std::string& last,
+        const Azure::Nullable<std::string>& upper,
+        const std::string& prefix)
+    {
+      // Without an upper bound, the names of the range are assumed to be below the prefix followed
+      // by the largest printable character.
+      const std::string upperName = upper.HasValue() ? upper.Value() : prefix + MaxNameChar;
+      const size_t length
+          = (std::max)((std::max)(first.size(), last.size()), upperName.size()) + 1;
+      const auto lastDigits = NameToDigits(last, length);
+      const auto upperDigits = NameToDigits(upperName, length);
+
+      std::vector<int> split;
+      if (!upper.HasValue())
+      {
+        split = lastDigits;
+        Subtract(split, NameToDigits(first, length));
+        if (!MultiplyAdd(split, 2, lastDigits) || split >= upperDigits)
+        {
+          split.clear();
+        }
+      }
+      if (split.empty())
+      {
+        // The sum takes an extra digit for the carry.
+        split = lastDigits;
+        split.insert(split.begin(), 0);
+        auto upperSum = upperDigits;
+        upperSum.insert(upperSum.begin(), 0);
+        MultiplyAdd(split, 1, upperSum);
+        Halve(split);
+        split.erase(split.begin());
+      }
+
+      auto splitName = DigitsToName(split);
+      if (splitName <= last || (upper.HasValue() && splitName >= upper.Value()))
+      {
+        return std::string();
+      }
+      return splitName;
+    }
+  } // namespace _detail
+
+  namespace {
+    struct BlobNameRange final
+    {
+      Azure::Nullable<std::string> StartFrom;
+      Azure::Nullable<std::string> EndBefore;
+    };
+  } // namespace
+
+  void BlobContainerClient::ListBlobsParallel(
+      const std::function<void(const std::vector<Models::BlobItem>&)>& onBlobs,
+      const ListBlobsParallelOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    AZURE_ASSERT_MSG(
+        std::is_sorted(options.SplitPoints.begin(), options.SplitPoints.end()),
+        "Split points must be in ascending order.");
+
+    const std::string prefix = options.Prefix.ValueOr(std::string());
+    std::deque<BlobNameRange> ranges;
+    for (size_t i = 0; i <= options.SplitPoints.size(); ++i)
+    {
+      BlobNameRange range;
+      if (i > 0)
+      {
+        range.StartFrom = options.SplitPoints[i - 1];
+      }
+      if (i < options.SplitPoints.size())
+      {
+        range.EndBefore = options.SplitPoints[i];
+      }
+      ranges.push_back(std::move(range));
+    }
+
+    std::mutex mutex;
+    std::condition_variable rangesChanged;
+    std::mutex callbackMutex;
+    int activeWorkers = 0;
+    std::exception_ptr error;
+
+    auto listRanges = [&]() {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (true)
+      {
+        rangesChanged.wait(
+            lock, [&]() { return error || !ranges.empty() || activeWorkers == 0; });
+        if (error || ranges.empty())
+        {
+          return;
+        }
+        BlobNameRange range = std::move(ranges.front());
+        ranges.pop_front();
+        ++activeWorkers;
+        lock.unlock();
+
+        try
+        {
+          ListBlobsOptions listOptions;
+          listOptions.Prefix = options.Prefix;
+          listOptions.PageSizeHint = options.PageSizeHint;
+          listOptions.Include = options.Include;
+          listOptions.StartFrom = range.StartFrom;
+          listOptions.EndBefore = range.EndBefore;
+          if (range.EndBefore.HasValue())
+          {
+            // The service only supports an end of the listing for this format.
+            listOptions.ResponseFormat = StorageResponseFormat::Arrow;
+          }
+
+          for (auto page = ListBlobs(listOptions, context); page.HasPage();
+               page.MoveToNextPage(context))
+          {
+            // The end of the range may have been moved by a split, after the listing started.
+            bool endReached = false;
+            if (range.EndBefore.HasValue())
+            {
+              auto end = std::find_if(
+                  page.Blobs.begin(), page.Blobs.end(), [&](const Models::BlobItem& blob) {
+                    return blob.Name >= range.EndBefore.Value();
+                  });
+              endReached = end != page.Blobs.end();
+              page.Blobs.erase(end, page.Blobs.end());
+            }
+            {
+              std::lock_guard<std::mutex> callbackLock(callbackMutex);
+              onBlobs(page.Blobs);
+            }
+            if (endReached || !page.NextPageToken.HasValue())
+            {
+              break;
+            }
+            if (page.Blobs.empty())
+            {
+              continue;
+            }
+
+            // The range has more blobs than a page. The rest of it is split, when another worker
+            // would otherwise wait.
+            std::lock_guard<std::mutex> rangesLock(mutex);
+            if (ranges.empty() && activeWorkers < options.Concurrency)
+            {
+              auto splitName = _detail::GetSplitName(
+                  page.Blobs.front().Name, page.Blobs.back().Name, range.EndBefore, prefix);
+              if (!splitName.empty())
+              {
+                BlobNameRange upperRange;
+                upperRange.StartFrom = splitName;
+                upperRange.EndBefore = std::move(range.EndBefore);
+                range.EndBefore = std::move(splitName);
+                ranges.push_back(std::move(upperRange));
+                rangesChanged.notify_one();
+              }
+            }
+          }
+        }
+        catch (...)
+        {
+          lock.lock();
+          if (!error)
+          {
+            error = std::current_exception();
+          }
+          --activeWorkers;
+          rangesChanged.notify_all();
+          return;
+        }
+
+        lock.lock();
+        --activeWorkers;
+        rangesChanged.notify_all();
+      }
+    };
+
+    std::vector<std::future<void>> workers;
+    for (int32_t i = 1; i < options.Concurrency; ++i)
+    {
+      workers.push_back(std::async(std::launch::async, listRanges));
+    }
+    listRanges();
+    for (auto& worker : workers)
+    {
+      worker.get();
+    }
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+
+  namespace {
+    constexpr int64_t MaxDirectoryTransferBlockSize = 4000 * 1024 * 1024ULL;
+    constexpr int64_t ListingPriority = (std::numeric_limits<int64_t>::min)();
+
+    struct FileTransfer final
+    {
+      std::string Path;
+      std::string BlobName;
+      int64_t Size = 0;
+      int64_t ChunkSize = 0;
+      // The version of the source of a download.
+      Azure::ETag ETag;
+      // The version of the source of an upload.
+      int64_t LastWriteTime = 0;
+      std::atomic<int64_t> RemainingChunks{0};
+      std::atomic<bool> Failed{false};
+      // The reader of an upload is opened by the first chunk to run.
+      std::mutex ReaderMutex;
+      std::unique_ptr<_internal::FileReader> Reader;
+      std::unique_ptr<_internal::FileWriter> Writer;
+
+      int64_t GetChunkCount() const { return (Size + ChunkSize - 1) / ChunkSize; }
+    };
+
+    // Records the transferred files, one JSON object per line, so that they can be skipped when
+    // the transfer is run again.
+    class TransferJournal final {
+    public:
+      explicit TransferJournal(const Azure::Nullable<std::string>& path)
+      {
+        if (!path.HasValue())
+        {
+          return;
+        }
+        std::vector<uint8_t> content;
+        try
+        {
+          Azure::Core::IO::FileBodyStream journalStream(path.Value());
+          content = journalStream.ReadToEnd();
+        }
+        catch (std::runtime_error&)
+        {
+          // The journal doesn't exist yet.
+          m_writer = std::make_unique<_internal::FileWriter>(path.Value());
+          return;
+        }
+        size_t lineStart = 0;
+        for (size_t i = 0; i < content.size(); ++i)
+        {
+          if (content[i] != '\n')
+          {
+            continue;
+          }
+          try
+          {
+            auto entry = Azure::Core::Json::_internal::json::parse(
+                content.begin() + lineStart, content.begin() + i);
+            m_entries.insert(GetKey(
+                entry["path"].get<std::string>(),
+                entry["size"].get<int64_t>(),
+                entry.contains("etag") ? entry["etag"].get<std::string>() : std::string(),
+                entry.contains("lastWriteTime") ? entry["lastWriteTime"].get<int64_t>() : 0));
+          }
+          catch (Azure::Core::Json::_internal::json::exception&)
+          {
+          }
+          lineStart = i + 1;
+        }
+        // A line which is not complete was interrupted while it was written, and is overwritten.
+        m_offset = static_cast<int64_t>(lineStart);
+        m_writer = std::make_unique<_internal::FileWriter>(path.Value(), false);
+        m_writer->SetSize(m_offset);
+      }
+
+      bool Contains(const FileTransfer& file) const
+      {
+        return m_entries.count(GetKey(file.Path, file.Size, GetETag(file), file.LastWriteTime))
+            != 0;
+      }
+
+      void Add(const FileTransfer& file)
+      {
+        if (!m_writer)
+        {
+          return;
+        }
+        Azure::Core::Json::_internal::json entry;
+        entry["path"] = file.Path;
+        entry["size"] = file.Size;
+        if (file.ETag.HasValue())
+        {
+          entry["etag"] = file.ETag.ToString();
+        }
+        if (file.LastWriteTime != 0)
+        {
+          entry["lastWriteTime"] = file.LastWriteTime;
+        }
+        const std::string line = entry.dump() + "\n";
+        m_writer->Write(reinterpret_cast<const uint8_t*>(line.data()), line.size(), m_offset);
+        m_offset += static_cast<int64_t>(line.size());
+      }
+
+    private:
+      static std::string GetETag(const FileTransfer& file)
+      {
+        return file.ETag.HasValue() ? file.ETag.ToString() : std::string();
+      }
+
+      static std::string GetKey(
+          const std::string& path,
+          int64_t size,
+          const std::string& eTag,
+          int64_t lastWriteTime)
+      {
+        return path + '\n' + std::to_string(size) + '\n' + eTag + '\n'
+            + std::to_string(lastWriteTime);
+      }
+
+      std::set<std::string> m_entries;
+      std::unique_ptr<_internal::FileWriter> m_writer;
+      int64_t m_offset = 0;
+    };
+
+    class DirectoryTransfer final {
+    public:
+      DirectoryTransfer(
+          const std::function<void(const Models::TransferDirectoryProgress&)>& progressHandler,
+          const Azure::Nullable<std::string>& journalPath)
+          : m_progressHandler(progressHandler), m_journal(journalPath)
+      {
+      }
+
+      // Returns false if the file was already transferred.
+      bool AddFile(const FileTransfer& file)
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if (m_journal.Contains(file))
+        {
+          ++m_result.SkippedFiles;
+          return false;
+        }
+        ++m_progress.TotalFiles;
+        m_progress.TotalBytes += file.Size;
+        return true;
+      }
+
+      // Runs a step of a file transfer, unless the file transfer has already failed. Returns false
+      // if the file transfer failed.
+      bool TryRun(FileTransfer& file, const std::function<void()>& step)
+      {
+        if (file.Failed)
+        {
+          return false;
+        }
+        try
+        {
+          step();
+          return true;
+        }
+        catch (Azure::Core::OperationCancelledException&)
+        {
+          throw;
+        }
+        catch (std::exception& e)
+        {
+          if (!file.Failed.exchange(true))
+          {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_result.Failures.push_back(Models::TransferDirectoryFailure{file.Path, e.what()});
+            ++m_progress.FailedFiles;
+            ReportProgress();
+          }
+          return false;
+        }
+      }
+
+      void OnBytesTransferred(int64_t bytes)
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_result.TransferredBytes += bytes;
+        m_progress.TransferredBytes += bytes;
+        ReportProgress();
+      }
+
+      void OnFileTransferred(const FileTransfer& file)
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_journal.Add(file);
+        ++m_result.TransferredFiles;
+        ++m_progress.TransferredFiles;
+        ReportProgress();
+      }
+
+      Models::TransferDirectoryResult GetResult()
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        return std::move(m_result);
+      }
+
+    private:
+      void ReportProgress()
+      {
+        if (m_progressHandler)
+        {
+          m_progressHandler(m_progress);
+        }
+      }
+
+      std::mutex m_mutex;
+      const std::function<void(const Models::TransferDirectoryProgress&)>& m_progressHandler;
+      TransferJournal m_journal;
+      Models::TransferDirectoryProgress m_progress;
+      Models::TransferDirectoryResult m_result;
+    };
+
+    bool IsRelativePath(const std::string& path)
+    {
+      size_t segmentStart = 0;
+      for (size_t i = 0; i <= path.size(); ++i)
+      {
+        if (i < path.size() && path[i] != '/')
+        {
+#if defined(AZ_PLATFORM_WINDOWS)
+          if (path[i] == '\\' || path[i] == ':')
+          {
+            return false;
+          }
+#endif
+          continue;
+        }
+        const std::string segment = path.substr(segmentStart, i - segmentStart);
+        if (segment.empty() || segment == "." || segment == "..")
+        {
+          return false;
+        }
+        segmentStart = i + 1;
+      }
+      return true;
+    }
+  } // namespace
+
+  Models::TransferDirectoryResult BlobContainerClient::UploadDirectory(
+      const std::string& localDirectory,
+      const UploadDirectoryOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    constexpr int64_t MaxBlockNumber = 50000;
+    constexpr int64_t BlockGrainSize = 1 * 1024 * 1024;
+
+    AZURE_ASSERT_MSG(options.TransferOptions.ChunkSize > 0, "Chunk size must be positive.");
+    AZURE_ASSERT_MSG(
+        options.TransferOptions.Concurrency > 0, "Concurrency must be greater than 0.");
+    if (options.TransferOptions.ChunkSize > MaxDirectoryTransferBlockSize)
+    {
+      throw Azure::Core::RequestFailedException("Block size is too big.");
+    }
+
+    auto getBlockId = [](int64_t id) {
+      constexpr size_t BlockIdLength = 64;
+      std::string blockId = std::to_string(id);
+      blockId = std::string(BlockIdLength - blockId.length(), '0') + blockId;
+      return Azure::Core::Convert::Base64Encode(
+          std::vector<uint8_t>(blockId.begin(), blockId.end()));
+    };
+
+    const std::string prefix = options.Prefix.ValueOr(std::string());
+    DirectoryTransfer transfer(options.ProgressHandler, options.JournalPath);
+    _internal::TransferScheduler scheduler(options.TransferOptions.Concurrency);
+
+    auto uploadChunk = [&](std::shared_ptr<FileTransfer> file, int64_t chunkId) {
+      auto blockBlobClient = GetBlockBlobClient(file->BlobName);
+      const int64_t offset = chunkId * file->ChunkSize;
+      const int64_t length = (std::min)(file->ChunkSize, file->Size - offset);
+      if (transfer.TryRun(*file, [&]() {
+            {
+              std::lock_guard<std::mutex> guard(file->ReaderMutex);
+              if (!file->Reader)
+              {
+                auto reader
+                    = std::make_unique<_internal::FileReader>(localDirectory + "/" + file->Path);
+                if (reader->GetFileSize() != file->Size)
+                {
+                  throw std::runtime_error("The file was changed during the upload.");
+                }
+                file->Reader = std::move(reader);
+              }
+            }
+            Azure::Core::IO::_internal::RandomAccessFileBodyStream contentStream(
+                file->Reader->GetHandle(), offset, length);
+            blockBlobClient.StageBlock(
+                getBlockId(chunkId), contentStream, StageBlockOptions(), context);
+          }))
+      {
+        transfer.OnBytesTransferred(length);
+      }
+      if (--file->RemainingChunks != 0)
+      {
+        return;
+      }
+      file->Reader.reset();
+      if (transfer.TryRun(*file, [&]() {
+            std::vector<std::string> blockIds;
+            for (int64_t i = 0; i < file->GetChunkCount(); ++i)
+            {
+              blockIds.push_back(getBlockId(i));
+            }
+            CommitBlockListOptions commitOptions;
+            commitOptions.AccessTier = options.AccessTier;
+            blockBlobClient.CommitBlockList(blockIds, commitOptions, context);
+          }))
+      {
+        transfer.OnFileTransferred(*file);
+      }
+    };
+
+    auto uploadFile = [&](std::shared_ptr<FileTransfer> file) {
+      const std::string fileName = localDirectory + "/" + file->Path;
+      if (file->Size <= file->ChunkSize)
+      {
+        if (transfer.TryRun(*file, [&]() {
+              Azure::Core::IO::FileBodyStream contentStream(fileName);
+              UploadBlockBlobOptions uploadOptions;
+              uploadOptions.AccessTier = options.AccessTier;
+              GetBlockBlobClient(file->BlobName).Upload(contentStream, uploadOptions, context);
+            }))
+        {
+          transfer.OnBytesTransferred(file->Size);
+          transfer.OnFileTransferred(*file);
+        }
+        return;
+      }
+      // The file is opened when its first chunk runs, so that the files waiting for their chunks
+      // to be scheduled are not held open.
+      file->RemainingChunks = file->GetChunkCount();
+      for (int64_t i = 0; i < file->GetChunkCount(); ++i)
+      {
+        scheduler.Schedule(file->Size, [&uploadChunk, file, i]() { uploadChunk(file, i); });
+      }
+    };
+
+    for (auto& localFile : _internal::ListFilesRecursively(localDirectory))
+    {
+      auto file = std::make_shared<FileTransfer>();
+      file->Path = std::move(localFile.RelativePath);
+      file->BlobName = prefix + file->Path;
+      file->Size = localFile.Size;
+      file->LastWriteTime = localFile.LastWriteTime;
+      int64_t minChunkSize = (file->Size + MaxBlockNumber - 1) / MaxBlockNumber;
+      minChunkSize = (minChunkSize + BlockGrainSize - 1) / BlockGrainSize * BlockGrainSize;
+      file->ChunkSize = (std::max)(options.TransferOptions.ChunkSize, minChunkSize);
+      if (transfer.AddFile(*file))
+      {
+        // Smaller files are uploaded first, so that most files are done early and the requests
+        // of the larger files keep the connections busy at the end.
+        scheduler.Schedule(file->Size, [&uploadFile, file]() { uploadFile(file); });
+      }
+    }
+    scheduler.Run();
+    return transfer.GetResult();
+  }
+
+  Models::TransferDirectoryResult BlobContainerClient::DownloadDirectory(
+      const std::string& localDirectory,
+      const DownloadDirectoryOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    AZURE_ASSERT_MSG(options.TransferOptions.ChunkSize > 0, "Chunk size must be positive.");
+    AZURE_ASSERT_MSG(
+        options.TransferOptions.Concurrency > 0, "Concurrency must be greater than 0.");
+
+    const std::string prefix = options.Prefix.ValueOr(std::string());
+    DirectoryTransfer transfer(options.ProgressHandler, options.JournalPath);
+    _internal::TransferScheduler scheduler(options.TransferOptions.Concurrency);
+
+    auto downloadChunk = [&](std::shared_ptr<FileTransfer> file, int64_t chunkId) {
+      const int64_t offset = chunkId * file->ChunkSize;
+      const int64_t length = (std::min)(file->ChunkSize, file->Size - offset);
+      if (transfer.TryRun(*file, [&]() {
+            DownloadBlobOptions chunkOptions;
+            chunkOptions.Range = Core::Http::HttpRange();
+            chunkOptions.Range.Value().Offset = offset;
+            chunkOptions.Range.Value().Length = length;
+            chunkOptions.AccessConditions.IfMatch = file->ETag;
+            auto chunk = GetBlobClient(file->BlobName).Download(chunkOptions, context);
+            std::vector<uint8_t> buffer(static_cast<size_t>(length));
+            if (chunk.Value.BodyStream->ReadToCount(buffer.data(), buffer.size(), context)
+                != buffer.size())
+            {
+              throw Azure::Core::RequestFailedException("Error when reading body stream.");
+            }
+            file->Writer->Write(buffer.data(), buffer.size(), offset);
+          }))
+      {
+        transfer.OnBytesTransferred(length);
+      }
+      if (--file->RemainingChunks != 0)
+      {
+        return;
+      }
+      file->Writer.reset();
+      if (!file->Failed)
+      {
+        transfer.OnFileTransferred(*file);
+      }
+    };
+
+    auto downloadFile = [&](std::shared_ptr<FileTransfer> file) {
+      if (!transfer.TryRun(*file, [&]() {
+            if (!IsRelativePath(file->Path))
+            {
+              throw std::runtime_error("The blob name cannot be used as a relative path.");
+            }
+            const std::string fileName = localDirectory + "/" + file->Path;
+            _internal::CreateDirectories(fileName.substr(0, fileName.rfind('/')));
+            file->Writer = std::make_unique<_internal::FileWriter>(fileName);
+          }))
+      {
+        return;
+      }
+      file->RemainingChunks = file->GetChunkCount();
+      if (file->Size == 0)
+      {
+        file->Writer.reset();
+        transfer.OnFileTransferred(*file);
+        return;
+      }
+      downloadChunk(file, 0);
+      for (int64_t i = 1; i < file->GetChunkCount(); ++i)
+      {
+        scheduler.Schedule(file->Size, [&downloadChunk, file, i]() { downloadChunk(file, i); });
+      }
+    };
+
+    // The blobs are listed one page at a time, ahead of the downloads, so that downloads start
+    // before the listing is done.
+    std::function<void(Azure::Nullable<std::string>)> listBlobs
+        = [&](Azure::Nullable<std::string> continuationToken) {
+            ListBlobsOptions listOptions;
+            listOptions.Prefix = options.Prefix;
+            listOptions.ContinuationToken = std::move(continuationToken);
+            auto page = ListBlobs(listOptions, context);
+            for (auto& blob : page.Blobs)
+            {
+              // Directory markers have no content.
+              if (blob.Name.size() == prefix.size() || blob.Name.back() == '/')
+              {
+                continue;
+              }
+              auto file = std::make_shared<FileTransfer>();
+              file->Path = blob.Name.substr(prefix.size());
+              // A prefix naming a directory may not end with its '/'.
+              if (file->Path.front() == '/')
+              {
+                file->Path.erase(0, 1);
+              }
+              file->BlobName = std::move(blob.Name);
+              file->Size = blob.BlobSize;
+              file->ChunkSize = options.TransferOptions.ChunkSize;
+              file->ETag = std::move(blob.Details.ETag);
+              if (transfer.AddFile(*file))
+              {
+                scheduler.Schedule(file->Size, [&downloadFile, file]() { downloadFile(file); });
+              }
+            }
+            if (page.NextPageToken.HasValue())
+            {
+              scheduler.Schedule(
+                  ListingPriority, [&listBlobs, token = std::move(page.NextPageToken)]() {
+                    listBlobs(token);
+                  });
+            }
+          };
+
+    scheduler.Schedule(
+        ListingPriority, [&listBlobs]() { listBlobs(Azure::Nullable<std::string>()); });
+    scheduler.Run();
+    return transfer.GetResult();
+  }
+
   Azure::Response<Models::BlobContainerAccessPolicy> BlobContainerClient::GetAccessPolicy(
       const GetBlobContainerAccessPolicyOptions& options,
       const Azure::Core::Context& context) const
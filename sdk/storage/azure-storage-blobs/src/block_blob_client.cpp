@@ -17,6 +17,7 @@
 
 #include "private/avro_parser.hpp"
 
+#include <azure/core/cryptography/hash.hpp>
 #include <azure/core/io/body_stream.hpp>
 #include <azure/storage/common/crypt.hpp>
 #include <azure/storage/common/internal/concurrent_transfer.hpp>
@@ -27,6 +28,9 @@
 #include <azure/storage/common/storage_common.hpp>
 #include <azure/storage/common/storage_exception.hpp>
 
+#include <map>
+#include <mutex>
+
 namespace Azure { namespace Storage { namespace Blobs {
 
   BlockBlobClient BlockBlobClient::CreateFromConnectionString(
@@ -452,6 +456,160 @@ namespace Azure { namespace Storage { namespace Blobs {
     return response;
   }
 
+  Azure::Response<Models::CopyBlobFromUriInBlocksResult> BlockBlobClient::CopyFromUriInBlocks(
+      const std::string& sourceUri,
+      int64_t sourceSize,
+      const CopyBlobFromUriInBlocksOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    constexpr int64_t DefaultStageBlockSize = 32 * 1024 * 1024ULL;
+    constexpr int64_t MaxStageBlockSize = 4000 * 1024 * 1024ULL;
+    constexpr int64_t MaxBlockNumber = 50000;
+    constexpr int64_t BlockGrainSize = 1 * 1024 * 1024;
+
+    int64_t chunkSize;
+    if (options.TransferOptions.ChunkSize.HasValue())
+    {
+      chunkSize = options.TransferOptions.ChunkSize.Value();
+    }
+    else
+    {
+      int64_t minChunkSize = (sourceSize + MaxBlockNumber - 1) / MaxBlockNumber;
+      minChunkSize = (minChunkSize + BlockGrainSize - 1) / BlockGrainSize * BlockGrainSize;
+      chunkSize = (std::max)(DefaultStageBlockSize, minChunkSize);
+    }
+    if (chunkSize > MaxStageBlockSize)
+    {
+      throw Azure::Core::RequestFailedException("Block size is too big.");
+    }
+    const int64_t numBlocks = (sourceSize + chunkSize - 1) / chunkSize;
+
+    // Block IDs are the same for the same source, so that the blocks staged by an interrupted
+    // copy are found again. The query of the source URL is left out, as a SAS may be renewed.
+    // Blocks are only reused when the source is pinned to an ETag, which is part of the IDs:
+    // otherwise they may have been staged from another version of the source.
+    std::vector<uint8_t> blockIdPrefix;
+    {
+      Azure::Core::Url sourceUrl(sourceUri);
+      const std::string key = sourceUrl.GetScheme() + "://" + sourceUrl.GetHost() + "/"
+          + sourceUrl.GetPath() + "\n" + std::to_string(sourceSize) + "\n"
+          + std::to_string(chunkSize) + "\n"
+          + (options.SourceAccessConditions.IfMatch.HasValue()
+                 ? options.SourceAccessConditions.IfMatch.ToString()
+                 : std::string());
+      Azure::Core::Cryptography::Md5Hash keyHash;
+      blockIdPrefix = keyHash.Final(reinterpret_cast<const uint8_t*>(key.data()), key.size());
+      blockIdPrefix.resize(12);
+    }
+    auto getBlockId = [&blockIdPrefix](int64_t id) {
+      std::vector<uint8_t> blockId = blockIdPrefix;
+      for (int shift = 24; shift >= 0; shift -= 8)
+      {
+        blockId.push_back(static_cast<uint8_t>(static_cast<uint64_t>(id) >> shift));
+      }
+      return Azure::Core::Convert::Base64Encode(blockId);
+    };
+
+    std::vector<std::string> blockIds;
+    for (int64_t i = 0; i < numBlocks; ++i)
+    {
+      blockIds.push_back(getBlockId(i));
+    }
+
+    std::vector<bool> isBlockStaged(static_cast<size_t>(numBlocks), false);
+    int64_t copiedSize = 0;
+    if (numBlocks != 0 && options.SourceAccessConditions.IfMatch.HasValue())
+    {
+      try
+      {
+        GetBlockListOptions getBlockListOptions;
+        getBlockListOptions.ListType = Models::BlockListType::Uncommitted;
+        getBlockListOptions.AccessConditions.LeaseId = options.AccessConditions.LeaseId;
+        auto blockList = GetBlockList(getBlockListOptions, context);
+        std::map<std::string, int64_t> uncommittedBlocks;
+        for (const auto& block : blockList.Value.UncommittedBlocks)
+        {
+          uncommittedBlocks[block.Name] = block.Size;
+        }
+        for (int64_t i = 0; i < numBlocks; ++i)
+        {
+          const int64_t blockSize = (std::min)(chunkSize, sourceSize - chunkSize * i);
+          auto block = uncommittedBlocks.find(blockIds[static_cast<size_t>(i)]);
+          if (block != uncommittedBlocks.end() && block->second == blockSize)
+          {
+            isBlockStaged[static_cast<size_t>(i)] = true;
+            copiedSize += blockSize;
+          }
+        }
+      }
+      catch (StorageException& e)
+      {
+        if (!(e.StatusCode == Core::Http::HttpStatusCode::NotFound
+              && e.ErrorCode == "BlobNotFound"))
+        {
+          throw;
+        }
+      }
+    }
+
+    if (options.ProgressHandler && copiedSize != 0)
+    {
+      options.ProgressHandler(copiedSize, sourceSize);
+    }
+
+    std::mutex progressMutex;
+    auto stageBlockFunc = [&](int64_t offset, int64_t length, int64_t chunkId, int64_t) {
+      if (isBlockStaged[static_cast<size_t>(chunkId)])
+      {
+        return;
+      }
+      StageBlockFromUriOptions chunkOptions;
+      chunkOptions.SourceRange = Core::Http::HttpRange();
+      chunkOptions.SourceRange.Value().Offset = offset;
+      chunkOptions.SourceRange.Value().Length = length;
+      chunkOptions.AccessConditions.LeaseId = options.AccessConditions.LeaseId;
+      chunkOptions.SourceAccessConditions.IfModifiedSince
+          = options.SourceAccessConditions.IfModifiedSince;
+      chunkOptions.SourceAccessConditions.IfUnmodifiedSince
+          = options.SourceAccessConditions.IfUnmodifiedSince;
+      chunkOptions.SourceAccessConditions.IfMatch = options.SourceAccessConditions.IfMatch;
+      chunkOptions.SourceAccessConditions.IfNoneMatch = options.SourceAccessConditions.IfNoneMatch;
+      chunkOptions.SourceAuthorization = options.SourceAuthorization;
+      chunkOptions.FileRequestIntent = options.FileRequestIntent;
+      chunkOptions.SourceCustomerProvidedKey = options.SourceCustomerProvidedKey;
+      StageBlockFromUri(
+          blockIds[static_cast<size_t>(chunkId)], sourceUri, chunkOptions, context);
+
+      if (options.ProgressHandler)
+      {
+        std::lock_guard<std::mutex> guard(progressMutex);
+        copiedSize += length;
+        options.ProgressHandler(copiedSize, sourceSize);
+      }
+    };
+
+    _internal::ConcurrentTransfer(
+        0, sourceSize, chunkSize, options.TransferOptions.Concurrency, stageBlockFunc);
+
+    CommitBlockListOptions commitBlockListOptions;
+    commitBlockListOptions.HttpHeaders = options.HttpHeaders;
+    commitBlockListOptions.Metadata = options.Metadata;
+    commitBlockListOptions.Tags = options.Tags;
+    commitBlockListOptions.AccessTier = options.AccessTier;
+    commitBlockListOptions.AccessConditions = options.AccessConditions;
+    auto commitBlockListResponse = CommitBlockList(blockIds, commitBlockListOptions, context);
+
+    Models::CopyBlobFromUriInBlocksResult result;
+    result.ETag = commitBlockListResponse.Value.ETag;
+    result.LastModified = commitBlockListResponse.Value.LastModified;
+    result.VersionId = commitBlockListResponse.Value.VersionId;
+    result.IsServerEncrypted = commitBlockListResponse.Value.IsServerEncrypted;
+    result.EncryptionKeySha256 = commitBlockListResponse.Value.EncryptionKeySha256;
+    result.EncryptionScope = commitBlockListResponse.Value.EncryptionScope;
+    return Azure::Response<Models::CopyBlobFromUriInBlocksResult>(
+        std::move(result), std::move(commitBlockListResponse.RawResponse));
+  }
+
   Azure::Response<Models::StageBlockResult> BlockBlobClient::StageBlock(
       const std::string& blockId,
       Azure::Core::IO::BodyStream& content,
@@ -791,7 +949,8 @@ namespace Azure { namespace Storage { namespace Blobs {
     response.Value.BodyStream = std::make_unique<_detail::AvroStreamParser>(
         std::move(response.Value.BodyStream),
         options.ProgressHandler,
-        options.ErrorHandler ? options.ErrorHandler : defaultErrorHandler);
+        options.ErrorHandler ? options.ErrorHandler : defaultErrorHandler,
+        options.DecodeInBackground);
     return response;
   }
 
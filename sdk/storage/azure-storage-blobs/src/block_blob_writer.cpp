@@ -0,0 +1,216 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/storage/blobs/block_blob_writer.hpp"
+
+#include <azure/core/azure_assert.hpp>
+#include <azure/core/base64.hpp>
+#include <azure/core/cryptography/hash.hpp>
+#include <azure/core/io/body_stream.hpp>
+#include <azure/storage/common/crypt.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+namespace Azure { namespace Storage { namespace Blobs {
+
+  namespace {
+    constexpr int64_t MaxStageBlockSize = 4000 * 1024 * 1024ULL;
+    constexpr size_t MaxBlockNumber = 50000;
+    constexpr size_t BlocksPerBlockSize = 10000;
+
+    std::string GetBlockId(size_t blockIndex)
+    {
+      constexpr size_t BlockIdLength = 64;
+      std::string blockId = std::to_string(blockIndex);
+      blockId = std::string(BlockIdLength - blockId.length(), '0') + blockId;
+      return Azure::Core::Convert::Base64Encode(
+          std::vector<uint8_t>(blockId.begin(), blockId.end()));
+    }
+  } // namespace
+
+  BlockBlobWriter::BlockBlobWriter(BlockBlobClient blockBlobClient, BlockBlobWriterOptions options)
+      : m_blockBlobClient(std::move(blockBlobClient)), m_options(std::move(options))
+  {
+    AZURE_ASSERT_MSG(m_options.TransferOptions.BlockSize > 0, "Block size must be positive.");
+    AZURE_ASSERT_MSG(
+        m_options.TransferOptions.Concurrency > 0, "Concurrency must be greater than 0.");
+    if (m_options.TransferOptions.BlockSize > MaxStageBlockSize)
+    {
+      throw Azure::Core::RequestFailedException("Block size is too big.");
+    }
+  }
+
+  BlockBlobWriter::~BlockBlobWriter()
+  {
+    // The staging tasks use this writer until they are done.
+    m_stagingTasks.clear();
+  }
+
+  int64_t BlockBlobWriter::GetBlockSize(size_t blockIndex) const
+  {
+    int64_t blockSize = m_options.TransferOptions.BlockSize;
+    for (size_t i = BlocksPerBlockSize; i <= blockIndex; i += BlocksPerBlockSize)
+    {
+      blockSize = (std::min)(blockSize * 2, MaxStageBlockSize);
+    }
+    return blockSize;
+  }
+
+  std::vector<uint8_t> BlockBlobWriter::GetBuffer(size_t size)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    while (!m_freeBuffers.empty())
+    {
+      auto buffer = std::move(m_freeBuffers.back());
+      m_freeBuffers.pop_back();
+      // Buffers of a smaller block size are not used anymore.
+      if (buffer.size() == size)
+      {
+        return buffer;
+      }
+    }
+    return std::vector<uint8_t>(size);
+  }
+
+  void BlockBlobWriter::Write(
+      const uint8_t* buffer,
+      size_t bufferSize,
+      const Azure::Core::Context& context)
+  {
+    AZURE_ASSERT_MSG(!m_committed, "The blob was already committed.");
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      if (m_exception)
+      {
+        std::rethrow_exception(m_exception);
+      }
+    }
+
+    while (bufferSize > 0)
+    {
+      if (m_block.empty())
+      {
+        if (m_blockIds.size() == MaxBlockNumber)
+        {
+          throw Azure::Core::RequestFailedException("The blob cannot have more blocks.");
+        }
+        m_block = GetBuffer(static_cast<size_t>(GetBlockSize(m_blockIds.size())));
+      }
+      const size_t copySize = (std::min)(bufferSize, m_block.size() - m_blockLength);
+      std::memcpy(m_block.data() + m_blockLength, buffer, copySize);
+      m_blockLength += copySize;
+      buffer += copySize;
+      bufferSize -= copySize;
+      if (m_blockLength == m_block.size())
+      {
+        StageBlock(context);
+      }
+    }
+  }
+
+  void BlockBlobWriter::StageBlock(const Azure::Core::Context& context)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_blockStaged.wait(lock, [this]() {
+        return m_exception || m_stagingBlocks < m_options.TransferOptions.Concurrency;
+      });
+      if (m_exception)
+      {
+        std::rethrow_exception(m_exception);
+      }
+      ++m_stagingBlocks;
+    }
+
+    m_stagingTasks.erase(
+        std::remove_if(
+            m_stagingTasks.begin(),
+            m_stagingTasks.end(),
+            [](const std::future<void>& task) {
+              return task.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            }),
+        m_stagingTasks.end());
+
+    auto block = std::make_shared<std::vector<uint8_t>>(std::move(m_block));
+    m_block = std::vector<uint8_t>();
+    const size_t blockLength = m_blockLength;
+    m_blockLength = 0;
+    std::string blockId = GetBlockId(m_blockIds.size());
+    m_blockIds.push_back(blockId);
+
+    m_stagingTasks.push_back(
+        std::async(std::launch::async, [this, block, blockLength, blockId, context]() {
+          std::exception_ptr exception;
+          try
+          {
+            StageBlockOptions stageBlockOptions;
+            stageBlockOptions.AccessConditions.LeaseId = m_options.AccessConditions.LeaseId;
+            if (m_options.BlockHashAlgorithm.HasValue())
+            {
+              ContentHash hash;
+              hash.Algorithm = m_options.BlockHashAlgorithm.Value();
+              if (hash.Algorithm == HashAlgorithm::Md5)
+              {
+                hash.Value = Azure::Core::Cryptography::Md5Hash().Final(block->data(), blockLength);
+              }
+              else
+              {
+                hash.Value = Crc64Hash().Final(block->data(), blockLength);
+              }
+              stageBlockOptions.TransactionalContentHash = std::move(hash);
+            }
+            Azure::Core::IO::MemoryBodyStream content(block->data(), blockLength);
+            m_blockBlobClient.StageBlock(blockId, content, stageBlockOptions, context);
+          }
+          catch (...)
+          {
+            exception = std::current_exception();
+          }
+
+          std::lock_guard<std::mutex> guard(m_mutex);
+          --m_stagingBlocks;
+          if (exception && !m_exception)
+          {
+            m_exception = exception;
+          }
+          m_freeBuffers.push_back(std::move(*block));
+          m_blockStaged.notify_all();
+        }));
+  }
+
+  Azure::Response<Models::CommitBlockListResult> BlockBlobWriter::Commit(
+      const Azure::Core::Context& context)
+  {
+    AZURE_ASSERT_MSG(!m_committed, "The blob was already committed.");
+    if (m_blockLength > 0)
+    {
+      StageBlock(context);
+    }
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_blockStaged.wait(lock, [this]() { return m_stagingBlocks == 0; });
+      if (m_exception)
+      {
+        std::rethrow_exception(m_exception);
+      }
+      m_freeBuffers.clear();
+    }
+    m_stagingTasks.clear();
+    m_block = std::vector<uint8_t>();
+
+    CommitBlockListOptions commitBlockListOptions;
+    commitBlockListOptions.HttpHeaders = m_options.HttpHeaders;
+    commitBlockListOptions.Metadata = m_options.Metadata;
+    commitBlockListOptions.Tags = m_options.Tags;
+    commitBlockListOptions.AccessTier = m_options.AccessTier;
+    commitBlockListOptions.AccessConditions = m_options.AccessConditions;
+    auto response = m_blockBlobClient.CommitBlockList(m_blockIds, commitBlockListOptions, context);
+    m_committed = true;
+    return response;
+  }
+
+}}} // namespace Azure::Storage::Blobs
@@ -3,6 +3,8 @@
 
 #include "azure/storage/blobs/page_blob_client.hpp"
 
+#include <azure/core/azure_assert.hpp>
+#include <azure/core/io/body_stream.hpp>
 #include <azure/storage/common/crypt.hpp>
 #include <azure/storage/common/internal/concurrent_transfer.hpp>
 #include <azure/storage/common/internal/constants.hpp>
@@ -12,8 +14,23 @@
 #include <azure/storage/common/storage_common.hpp>
 #include <azure/storage/common/storage_exception.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
 namespace Azure { namespace Storage { namespace Blobs {
 
+  namespace {
+    constexpr int64_t PageSize = 512;
+
+    bool IsZeroPage(const uint8_t* page)
+    {
+      return page[0] == 0 && std::memcmp(page, page + 1, PageSize - 1) == 0;
+    }
+  } // namespace
+
   PageBlobClient PageBlobClient::CreateFromConnectionString(
       const std::string& connectionString,
       const std::string& blobContainerName,
@@ -522,4 +539,174 @@ namespace Azure { namespace Storage { namespace Blobs {
     return res;
   }
 
+  Azure::Response<Models::DownloadPagesToResult> PageBlobClient::DownloadPagesTo(
+      const std::string& fileName,
+      const DownloadPagesToOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    AZURE_ASSERT_MSG(options.TransferOptions.ChunkSize > 0, "ChunkSize must be positive.");
+
+    Models::DownloadPagesToResult result;
+    std::unique_ptr<Azure::Core::Http::RawResponse> rawResponse;
+    std::vector<Azure::Core::Http::HttpRange> pageRanges;
+    std::vector<Azure::Core::Http::HttpRange> clearRanges;
+
+    // All the pages of ranges and the content are read from the version of the blob of the first
+    // page.
+    GetPageRangesOptions getPageRangesOptions;
+    getPageRangesOptions.AccessConditions = options.AccessConditions;
+    do
+    {
+      Azure::Nullable<std::string> nextPageToken;
+      if (options.PreviousSnapshot.HasValue())
+      {
+        auto page = GetPageRangesDiff(
+            options.PreviousSnapshot.Value(), getPageRangesOptions, context);
+        pageRanges.insert(pageRanges.end(), page.PageRanges.begin(), page.PageRanges.end());
+        clearRanges.insert(clearRanges.end(), page.ClearRanges.begin(), page.ClearRanges.end());
+        if (!rawResponse)
+        {
+          result.ETag = page.ETag;
+          result.LastModified = page.LastModified;
+          result.BlobSize = page.BlobSize;
+          rawResponse = std::move(page.RawResponse);
+        }
+        nextPageToken = page.NextPageToken;
+      }
+      else
+      {
+        auto page = GetPageRanges(getPageRangesOptions, context);
+        pageRanges.insert(pageRanges.end(), page.PageRanges.begin(), page.PageRanges.end());
+        if (!rawResponse)
+        {
+          result.ETag = page.ETag;
+          result.LastModified = page.LastModified;
+          result.BlobSize = page.BlobSize;
+          rawResponse = std::move(page.RawResponse);
+        }
+        nextPageToken = page.NextPageToken;
+      }
+      getPageRangesOptions.AccessConditions.IfMatch = result.ETag;
+      getPageRangesOptions.ContinuationToken = std::move(nextPageToken);
+    } while (getPageRangesOptions.ContinuationToken.HasValue()
+             && !getPageRangesOptions.ContinuationToken.Value().empty());
+
+    // A new file is extended without allocating it, which leaves the unallocated ranges of the
+    // blob as holes.
+    _internal::FileWriter fileWriter(fileName, !options.PreviousSnapshot.HasValue());
+    result.TransferredSize = _internal::DownloadRangesTo(
+        fileWriter,
+        result.BlobSize,
+        pageRanges,
+        clearRanges,
+        options.TransferOptions.ChunkSize,
+        options.TransferOptions.Concurrency,
+        [&](const Azure::Core::Http::HttpRange& chunkRange) {
+          DownloadBlobOptions chunkOptions;
+          chunkOptions.Range = chunkRange;
+          chunkOptions.AccessConditions.IfMatch = result.ETag;
+          chunkOptions.AccessConditions.LeaseId = options.AccessConditions.LeaseId;
+          chunkOptions.ValidationOptions = options.ValidationOptions;
+          return std::move(Download(chunkOptions, context).Value.BodyStream);
+        },
+        context);
+
+    return Azure::Response<Models::DownloadPagesToResult>(
+        std::move(result), std::move(rawResponse));
+  }
+
+  Azure::Response<Models::UploadPagesFromResult> PageBlobClient::UploadPagesFrom(
+      const std::string& fileName,
+      const UploadPagesFromOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    constexpr int64_t MaxUploadPagesSize = 4 * 1024 * 1024;
+    const int64_t chunkSize = options.TransferOptions.ChunkSize;
+    AZURE_ASSERT_MSG(
+        chunkSize > 0 && chunkSize % PageSize == 0 && chunkSize <= MaxUploadPagesSize,
+        "ChunkSize must be a multiple of 512 and cannot be larger than 4 MiB.");
+
+    _internal::FileReader fileReader(fileName);
+    const int64_t fileSize = fileReader.GetFileSize();
+    if (fileSize % PageSize != 0)
+    {
+      throw std::invalid_argument("The size of the file must be a multiple of 512 bytes.");
+    }
+
+    if (options.UpdateExisting)
+    {
+      ResizePageBlobOptions resizeOptions;
+      resizeOptions.AccessConditions = options.AccessConditions;
+      Resize(fileSize, resizeOptions, context);
+    }
+    else
+    {
+      CreatePageBlobOptions createOptions;
+      createOptions.HttpHeaders = options.HttpHeaders;
+      createOptions.Metadata = options.Metadata;
+      createOptions.Tags = options.Tags;
+      createOptions.AccessTier = options.AccessTier;
+      createOptions.AccessConditions = options.AccessConditions;
+      Create(fileSize, createOptions, context);
+    }
+
+    std::atomic<int64_t> transferredSize{0};
+    auto uploadChunkFunc = [&](int64_t offset, int64_t length, int64_t, int64_t) {
+      std::vector<uint8_t> buffer(static_cast<size_t>(length));
+      Azure::Core::IO::_internal::RandomAccessFileBodyStream fileStream(
+          fileReader.GetHandle(), offset, length);
+      if (fileStream.ReadToCount(buffer.data(), buffer.size(), context) != buffer.size())
+      {
+        throw std::runtime_error("Failed to read file.");
+      }
+
+      // Each run of pages which are all zeros, or none of which is, is a request.
+      int64_t runStart = 0;
+      while (runStart < length)
+      {
+        const bool isZero = IsZeroPage(&buffer[static_cast<size_t>(runStart)]);
+        int64_t runEnd = runStart + PageSize;
+        while (runEnd < length && IsZeroPage(&buffer[static_cast<size_t>(runEnd)]) == isZero)
+        {
+          runEnd += PageSize;
+        }
+        if (!isZero)
+        {
+          Azure::Core::IO::MemoryBodyStream pages(
+              &buffer[static_cast<size_t>(runStart)], static_cast<size_t>(runEnd - runStart));
+          UploadPagesOptions uploadPagesOptions;
+          uploadPagesOptions.AccessConditions.LeaseId = options.AccessConditions.LeaseId;
+          uploadPagesOptions.ValidationOptions = options.ValidationOptions;
+          UploadPages(offset + runStart, pages, uploadPagesOptions, context);
+          transferredSize += runEnd - runStart;
+        }
+        else if (options.UpdateExisting)
+        {
+          Azure::Core::Http::HttpRange range;
+          range.Offset = offset + runStart;
+          range.Length = runEnd - runStart;
+          ClearPagesOptions clearPagesOptions;
+          clearPagesOptions.AccessConditions.LeaseId = options.AccessConditions.LeaseId;
+          ClearPages(range, clearPagesOptions, context);
+        }
+        runStart = runEnd;
+      }
+    };
+
+    _internal::ConcurrentTransfer(
+        0, fileSize, chunkSize, options.TransferOptions.Concurrency, uploadChunkFunc);
+
+    // The pages are written concurrently, so the state of the blob is read once they all are.
+    GetBlobPropertiesOptions getPropertiesOptions;
+    getPropertiesOptions.AccessConditions.LeaseId = options.AccessConditions.LeaseId;
+    auto properties = GetProperties(getPropertiesOptions, context);
+
+    Models::UploadPagesFromResult result;
+    result.ETag = std::move(properties.Value.ETag);
+    result.LastModified = std::move(properties.Value.LastModified);
+    result.TransferredSize = transferredSize;
+    return Azure::Response<Models::UploadPagesFromResult>(
+        std::move(result), std::move(properties.RawResponse));
+  }
+
 }}} // namespace Azure::Storage::Blobs
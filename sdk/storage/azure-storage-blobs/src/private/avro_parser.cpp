@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <utility>
 
 namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
 
@@ -175,26 +176,46 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     {
       return availableBytes;
     }
+    // The buffer grows up to its size as needed, and beyond that only to hold a datum that doesn't
+    // fit in it.
     const size_t MinRead = 4096;
-    size_t tryReadSize = (std::max)(n, MinRead);
-    size_t currSize = m_streambuffer.size();
-    m_streambuffer.resize(m_streambuffer.size() + tryReadSize);
-    size_t actualReadSize = m_stream->Read(m_streambuffer.data() + currSize, tryReadSize, context);
-    m_streambuffer.resize(currSize + actualReadSize);
+    const size_t requiredSize = m_pos.Offset + n;
+    if (m_streambuffer.size() < requiredSize
+        || (m_streambuffer.size() < m_bufferSize && m_streambuffer.size() - m_dataEnd < MinRead))
+    {
+      m_streambuffer.resize((std::max)(
+          requiredSize,
+          (std::min)((std::max)(m_dataEnd + MinRead, m_streambuffer.size() * 2), m_bufferSize)));
+    }
+    // Reads as much as the buffer can hold, so that few reads are issued to m_stream.
+    size_t actualReadSize = m_stream->Read(
+        m_streambuffer.data() + m_dataEnd, m_streambuffer.size() - m_dataEnd, context);
+    m_dataEnd += actualReadSize;
     return AvailableBytes();
   }
 
   void AvroStreamReader::Discard()
   {
-    constexpr size_t MinimumReleaseMemory = 128 * 1024;
-    if (m_pos.Offset < MinimumReleaseMemory)
+    const size_t availableBytes = AvailableBytes();
+    if (availableBytes == 0)
     {
-      return;
+      m_pos.Offset = 0;
+      m_dataEnd = 0;
+    }
+    else if (
+        m_pos.Offset >= m_streambuffer.size() / 2
+        || (m_streambuffer.size() > m_bufferSize && m_pos.Offset != 0))
+    {
+      std::memmove(&m_streambuffer[0], &m_streambuffer[m_pos.Offset], availableBytes);
+      m_pos.Offset = 0;
+      m_dataEnd = availableBytes;
+    }
+    // Releases the memory taken by a datum larger than the buffer size.
+    if (m_streambuffer.size() > m_bufferSize && m_dataEnd <= m_bufferSize)
+    {
+      m_streambuffer.resize(m_bufferSize);
+      m_streambuffer.shrink_to_fit();
     }
-    const size_t availableBytes = AvailableBytes();
-    std::memmove(&m_streambuffer[0], &m_streambuffer[m_pos.Offset], availableBytes);
-    m_streambuffer.resize(availableBytes);
-    m_pos.Offset = 0;
   }
 
   const AvroSchema AvroSchema::StringSchema(AvroDatumType::String);
@@ -257,41 +278,41 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
   void AvroDatum::Fill(AvroStreamReader& reader, const Core::Context& context)
   {
     m_data = reader.m_pos;
-    if (m_schema.Type() == AvroDatumType::String || m_schema.Type() == AvroDatumType::Bytes)
+    if (m_schema->Type() == AvroDatumType::String || m_schema->Type() == AvroDatumType::Bytes)
     {
       int64_t stringSize = reader.ParseInt(context);
       reader.Advance(static_cast<size_t>(stringSize), context);
     }
     else if (
-        m_schema.Type() == AvroDatumType::Int || m_schema.Type() == AvroDatumType::Long
-        || m_schema.Type() == AvroDatumType::Enum)
+        m_schema->Type() == AvroDatumType::Int || m_schema->Type() == AvroDatumType::Long
+        || m_schema->Type() == AvroDatumType::Enum)
     {
       reader.ParseInt(context);
     }
-    else if (m_schema.Type() == AvroDatumType::Float)
+    else if (m_schema->Type() == AvroDatumType::Float)
     {
       reader.Advance(4, context);
     }
-    else if (m_schema.Type() == AvroDatumType::Double)
+    else if (m_schema->Type() == AvroDatumType::Double)
     {
       reader.Advance(8, context);
     }
-    else if (m_schema.Type() == AvroDatumType::Bool)
+    else if (m_schema->Type() == AvroDatumType::Bool)
     {
       reader.Advance(1, context);
     }
-    else if (m_schema.Type() == AvroDatumType::Null)
+    else if (m_schema->Type() == AvroDatumType::Null)
     {
       reader.Advance(0, context);
     }
-    else if (m_schema.Type() == AvroDatumType::Record)
+    else if (m_schema->Type() == AvroDatumType::Record)
     {
-      for (const auto& s : m_schema.FieldSchemas())
+      for (const auto& s : m_schema->FieldSchemas())
       {
         AvroDatum(s).Fill(reader, context);
       }
     }
-    else if (m_schema.Type() == AvroDatumType::Array)
+    else if (m_schema->Type() == AvroDatumType::Array)
     {
       while (true)
       {
@@ -309,12 +330,12 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
         {
           for (auto i = 0; i < numElementsInBlock; ++i)
           {
-            AvroDatum(m_schema.ItemSchema()).Fill(reader, context);
+            AvroDatum(m_schema->ItemSchema()).Fill(reader, context);
           }
         }
       }
     }
-    else if (m_schema.Type() == AvroDatumType::Map)
+    else if (m_schema->Type() == AvroDatumType::Map)
     {
       while (true)
       {
@@ -333,19 +354,19 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
           for (int64_t i = 0; i < numElementsInBlock; ++i)
           {
             AvroDatum(AvroSchema::StringSchema).Fill(reader, context);
-            AvroDatum(m_schema.ItemSchema()).Fill(reader, context);
+            AvroDatum(m_schema->ItemSchema()).Fill(reader, context);
           }
         }
       }
     }
-    else if (m_schema.Type() == AvroDatumType::Union)
+    else if (m_schema->Type() == AvroDatumType::Union)
     {
       int64_t i = reader.ParseInt(context);
-      AvroDatum(m_schema.FieldSchemas()[static_cast<size_t>(i)]).Fill(reader, context);
+      AvroDatum(m_schema->FieldSchemas()[static_cast<size_t>(i)]).Fill(reader, context);
     }
-    else if (m_schema.Type() == AvroDatumType::Fixed)
+    else if (m_schema->Type() == AvroDatumType::Fixed)
     {
-      reader.Advance(m_schema.Size(), context);
+      reader.Advance(m_schema->Size(), context);
     }
     else
     {
@@ -356,41 +377,41 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
   void AvroDatum::Fill(AvroStreamReader::ReaderPos& data)
   {
     m_data = data;
-    if (m_schema.Type() == AvroDatumType::String || m_schema.Type() == AvroDatumType::Bytes)
+    if (m_schema->Type() == AvroDatumType::String || m_schema->Type() == AvroDatumType::Bytes)
     {
       int64_t stringSize = parseInt(data);
       data.Offset += static_cast<size_t>(stringSize);
     }
     else if (
-        m_schema.Type() == AvroDatumType::Int || m_schema.Type() == AvroDatumType::Long
-        || m_schema.Type() == AvroDatumType::Enum)
+        m_schema->Type() == AvroDatumType::Int || m_schema->Type() == AvroDatumType::Long
+        || m_schema->Type() == AvroDatumType::Enum)
     {
       parseInt(data);
     }
-    else if (m_schema.Type() == AvroDatumType::Float)
+    else if (m_schema->Type() == AvroDatumType::Float)
     {
       data.Offset += 4;
     }
-    else if (m_schema.Type() == AvroDatumType::Double)
+    else if (m_schema->Type() == AvroDatumType::Double)
     {
       data.Offset += 8;
     }
-    else if (m_schema.Type() == AvroDatumType::Bool)
+    else if (m_schema->Type() == AvroDatumType::Bool)
     {
       data.Offset += 1;
     }
-    else if (m_schema.Type() == AvroDatumType::Null)
+    else if (m_schema->Type() == AvroDatumType::Null)
     {
       data.Offset += 0;
     }
-    else if (m_schema.Type() == AvroDatumType::Record)
+    else if (m_schema->Type() == AvroDatumType::Record)
     {
-      for (const auto& s : m_schema.FieldSchemas())
+      for (const auto& s : m_schema->FieldSchemas())
       {
         AvroDatum(s).Fill(data);
       }
     }
-    else if (m_schema.Type() == AvroDatumType::Array)
+    else if (m_schema->Type() == AvroDatumType::Array)
     {
       while (true)
       {
@@ -408,12 +429,12 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
         {
           for (auto i = 0; i < numElementsInBlock; ++i)
           {
-            AvroDatum(m_schema.ItemSchema()).Fill(data);
+            AvroDatum(m_schema->ItemSchema()).Fill(data);
           }
         }
       }
     }
-    else if (m_schema.Type() == AvroDatumType::Map)
+    else if (m_schema->Type() == AvroDatumType::Map)
     {
       while (true)
       {
@@ -432,19 +453,19 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
           for (int64_t i = 0; i < numElementsInBlock; ++i)
           {
             AvroDatum(AvroSchema::StringSchema).Fill(data);
-            AvroDatum(m_schema.ItemSchema()).Fill(data);
+            AvroDatum(m_schema->ItemSchema()).Fill(data);
           }
         }
       }
     }
-    else if (m_schema.Type() == AvroDatumType::Union)
+    else if (m_schema->Type() == AvroDatumType::Union)
     {
       int64_t i = parseInt(data);
-      AvroDatum(m_schema.FieldSchemas()[static_cast<size_t>(i)]).Fill(data);
+      AvroDatum(m_schema->FieldSchemas()[static_cast<size_t>(i)]).Fill(data);
     }
-    else if (m_schema.Type() == AvroDatumType::Fixed)
+    else if (m_schema->Type() == AvroDatumType::Fixed)
     {
-      data.Offset += m_schema.Size();
+      data.Offset += m_schema->Size();
     }
     else
     {
@@ -455,7 +476,7 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
   template <> AvroDatum::StringView AvroDatum::Value() const
   {
     auto data = m_data;
-    if (m_schema.Type() == AvroDatumType::String || m_schema.Type() == AvroDatumType::Bytes)
+    if (m_schema->Type() == AvroDatumType::String || m_schema->Type() == AvroDatumType::Bytes)
     {
       const int64_t length = parseInt(data);
       const uint8_t* start = &(*data.BufferPtr)[data.Offset];
@@ -463,9 +484,9 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
       data.Offset += static_cast<size_t>(length);
       return ret;
     }
-    if (m_schema.Type() == AvroDatumType::Fixed)
+    if (m_schema->Type() == AvroDatumType::Fixed)
     {
-      const size_t fixedSize = m_schema.Size();
+      const size_t fixedSize = m_schema->Size();
       const uint8_t* start = &(*data.BufferPtr)[data.Offset];
       StringView ret{start, fixedSize};
       data.Offset += fixedSize;
@@ -503,8 +524,8 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     auto data = m_data;
 
     AvroRecord r;
-    r.m_keys = &m_schema.FieldNames();
-    for (const auto& schema : m_schema.FieldSchemas())
+    r.m_keys = &m_schema->FieldNames();
+    for (const auto& schema : m_schema->FieldSchemas())
     {
       auto datum = AvroDatum(schema);
       datum.Fill(data);
@@ -535,7 +556,7 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
       {
         auto keyDatum = AvroDatum(AvroSchema::StringSchema);
         keyDatum.Fill(data);
-        auto valueDatum = AvroDatum(m_schema.ItemSchema());
+        auto valueDatum = AvroDatum(m_schema->ItemSchema());
         valueDatum.Fill(data);
         m[keyDatum.Value<std::string>()] = valueDatum;
       }
@@ -546,18 +567,20 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
   template <> AvroDatum AvroDatum::Value() const
   {
     auto data = m_data;
-    if (m_schema.Type() == AvroDatumType::Union)
+    if (m_schema->Type() == AvroDatumType::Union)
     {
       int64_t i = parseInt(data);
-      auto datum = AvroDatum(m_schema.FieldSchemas()[static_cast<size_t>(i)]);
+      auto datum = AvroDatum(m_schema->FieldSchemas()[static_cast<size_t>(i)]);
       datum.Fill(data);
       return datum;
     }
     AZURE_UNREACHABLE_CODE();
   }
 
-  AvroObjectContainerReader::AvroObjectContainerReader(Core::IO::BodyStream& stream)
-      : m_reader(std::make_unique<AvroStreamReader>(stream))
+  AvroObjectContainerReader::AvroObjectContainerReader(
+      Core::IO::BodyStream& stream,
+      size_t bufferSize)
+      : m_reader(std::make_unique<AvroStreamReader>(stream, bufferSize))
   {
   }
 
@@ -600,12 +623,13 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
       schema = m_objectSchema.get();
     }
 
+    // The objects are decoded one at a time, so that the memory used doesn't depend on the size of
+    // a block.
+    m_reader->Discard();
     if (m_remainingObjectInCurrentBlock == 0)
     {
-      m_reader->Discard();
       m_remainingObjectInCurrentBlock = m_reader->ParseInt(context);
-      int64_t ObjectsSize = m_reader->ParseInt(context);
-      m_reader->Preload(static_cast<size_t>(ObjectsSize), context);
+      m_reader->ParseInt(context);
     }
 
     auto objectDatum = AvroDatum(*m_objectSchema);
@@ -624,7 +648,36 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     return objectDatum;
   }
 
-  size_t AvroStreamParser::OnRead(
+  AvroStreamParser::RecordType AvroStreamParser::GetRecordType(const AvroSchema& schema)
+  {
+    for (const auto& recordType : m_recordTypes)
+    {
+      if (recordType.first == &schema)
+      {
+        return recordType.second;
+      }
+    }
+    RecordType recordType = RecordType::Other;
+    if (schema.Type() == AvroDatumType::Record)
+    {
+      if (schema.Name() == "com.microsoft.azure.storage.queryBlobContents.resultData")
+      {
+        recordType = RecordType::ResultData;
+      }
+      else if (schema.Name() == "com.microsoft.azure.storage.queryBlobContents.progress")
+      {
+        recordType = RecordType::Progress;
+      }
+      else if (schema.Name() == "com.microsoft.azure.storage.queryBlobContents.error")
+      {
+        recordType = RecordType::Error;
+      }
+    }
+    m_recordTypes.emplace_back(&schema, recordType);
+    return recordType;
+  }
+
+  size_t AvroStreamParser::Decode(
       uint8_t* buffer,
       size_t count,
       Azure::Core::Context const& context)
@@ -644,27 +697,22 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
       {
         datum = datum.Value<AvroDatum>();
       }
-      if (datum.Schema().Type() != AvroDatumType::Record)
-      {
-        continue;
-      }
-      if (datum.Schema().Name() == "com.microsoft.azure.storage.queryBlobContents.resultData")
+      const RecordType recordType = GetRecordType(datum.Schema());
+      if (recordType == RecordType::ResultData)
       {
         auto record = datum.Value<AvroRecord>();
         auto dataDatum = record.Field("data");
         m_parserBuffer = dataDatum.Value<AvroDatum::StringView>();
-        return OnRead(buffer, count, context);
+        return Decode(buffer, count, context);
       }
-      if (datum.Schema().Name() == "com.microsoft.azure.storage.queryBlobContents.progress"
-          && m_progressCallback)
+      if (recordType == RecordType::Progress && m_progressCallback)
       {
         auto record = datum.Value<AvroRecord>();
         auto bytesScanned = record.Field("bytesScanned").Value<int64_t>();
         auto totalBytes = record.Field("totalBytes").Value<int64_t>();
         m_progressCallback(bytesScanned, totalBytes);
       }
-      if (datum.Schema().Name() == "com.microsoft.azure.storage.queryBlobContents.error"
-          && m_errorCallback)
+      if (recordType == RecordType::Error && m_errorCallback)
       {
         auto record = datum.Value<AvroRecord>();
         BlobQueryError e;
@@ -677,4 +725,78 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     }
     return 0;
   }
+
+  void AvroStreamParser::DecodeNextChunk(const Azure::Core::Context& context)
+  {
+    m_nextChunk.resize(DecodedChunkSize);
+    m_nextChunkLength = std::async(std::launch::async, [this, context]() {
+      size_t length = 0;
+      while (length < m_nextChunk.size())
+      {
+        const size_t decodedBytes
+            = Decode(m_nextChunk.data() + length, m_nextChunk.size() - length, context);
+        if (decodedBytes == 0)
+        {
+          break;
+        }
+        length += decodedBytes;
+      }
+      return length;
+    });
+  }
+
+  size_t AvroStreamParser::OnRead(
+      uint8_t* buffer,
+      size_t count,
+      Azure::Core::Context const& context)
+  {
+    if (!m_decodeInBackground)
+    {
+      return Decode(buffer, count, context);
+    }
+
+    if (m_chunkOffset == m_chunkLength)
+    {
+      if (m_endOfStream)
+      {
+        return 0;
+      }
+      if (!m_nextChunkLength.valid())
+      {
+        DecodeNextChunk(context);
+      }
+      // Rethrows the exception thrown on the worker thread, if any.
+      m_chunkLength = m_nextChunkLength.get();
+      m_chunkOffset = 0;
+      std::swap(m_chunk, m_nextChunk);
+      if (m_chunkLength < m_chunk.size())
+      {
+        m_endOfStream = true;
+      }
+      else
+      {
+        // The next chunk is decoded while this one is read.
+        DecodeNextChunk(context);
+      }
+    }
+
+    const size_t bytesToCopy = (std::min)(m_chunkLength - m_chunkOffset, count);
+    std::memcpy(buffer, m_chunk.data() + m_chunkOffset, bytesToCopy);
+    m_chunkOffset += bytesToCopy;
+    return bytesToCopy;
+  }
+
+  void AvroStreamParser::Rewind()
+  {
+    if (m_nextChunkLength.valid())
+    {
+      m_nextChunkLength.wait();
+      m_nextChunkLength = std::future<size_t>();
+    }
+    m_chunkOffset = 0;
+    m_chunkLength = 0;
+    m_endOfStream = false;
+    m_inner->Rewind();
+  }
+
 }}}} // namespace Azure::Storage::Blobs::_detail
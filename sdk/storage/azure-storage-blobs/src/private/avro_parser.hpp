@@ -7,6 +7,7 @@
 
 #include <azure/core/io/body_stream.hpp>
 
+#include <future>
 #include <map>
 #include <memory>
 #include <type_traits>
@@ -38,8 +39,9 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
       const std::vector<uint8_t>* BufferPtr = nullptr;
       size_t Offset = 0;
     };
-    explicit AvroStreamReader(Core::IO::BodyStream& stream)
-        : m_stream(&stream), m_pos{&m_streambuffer, 0}
+    // The buffer holds at most bufferSize bytes, unless a single datum is larger than that.
+    explicit AvroStreamReader(Core::IO::BodyStream& stream, size_t bufferSize = DefaultBufferSize)
+        : m_stream(&stream), m_pos{&m_streambuffer, 0}, m_bufferSize(bufferSize)
     {
     }
     AvroStreamReader(const AvroStreamReader&) = delete;
@@ -51,16 +53,23 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     // available in m_streambuffer;
     size_t Preload(size_t n, const Core::Context& context);
     size_t TryPreload(size_t n, const Core::Context& context);
-    // discards data that's before m_pos
+    // discards data that's before m_pos, which invalidates all ReaderPos pointing to it
     void Discard();
+    // The size of the buffer, which only exceeds bufferSize while it holds a larger datum.
+    size_t Capacity() const { return m_streambuffer.size(); }
+
+    static constexpr size_t DefaultBufferSize = 4 * 1024 * 1024;
 
   private:
-    size_t AvailableBytes() const { return m_streambuffer.size() - m_pos.Offset; }
+    size_t AvailableBytes() const { return m_dataEnd - m_pos.Offset; }
 
   private:
     Core::IO::BodyStream* m_stream;
+    // Only the first m_dataEnd bytes of m_streambuffer hold data read from m_stream.
     std::vector<uint8_t> m_streambuffer;
+    size_t m_dataEnd = 0;
     ReaderPos m_pos;
+    size_t m_bufferSize;
 
     friend class AvroDatum;
   };
@@ -86,7 +95,7 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     const std::string& Name() const { return m_name; }
     AvroDatumType Type() const { return m_type; }
     const std::vector<std::string>& FieldNames() const { return m_status->m_keys; }
-    AvroSchema ItemSchema() const { return m_status->m_schemas[0]; }
+    const AvroSchema& ItemSchema() const { return m_status->m_schemas[0]; }
     const std::vector<AvroSchema>& FieldSchemas() const { return m_status->m_schemas; }
     size_t Size() const { return static_cast<size_t>(m_status->m_size); }
 
@@ -106,15 +115,18 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     std::shared_ptr<SharedStatus> m_status;
   };
 
+  // A datum refers to the data in the buffer of an AvroStreamReader and to its schema, neither of
+  // which is copied, so both must outlive the datum.
   class AvroDatum final {
   public:
-    AvroDatum() : m_schema(AvroSchema::NullSchema) {}
-    explicit AvroDatum(AvroSchema schema) : m_schema(std::move(schema)) {}
+    AvroDatum() : m_schema(&AvroSchema::NullSchema) {}
+    explicit AvroDatum(const AvroSchema& schema) : m_schema(&schema) {}
+    explicit AvroDatum(AvroSchema&&) = delete;
 
     void Fill(AvroStreamReader& reader, const Core::Context& context);
     void Fill(AvroStreamReader::ReaderPos& data);
 
-    const AvroSchema& Schema() const { return m_schema; }
+    const AvroSchema& Schema() const { return *m_schema; }
 
     template <class T> T Value() const;
     struct StringView
@@ -124,7 +136,7 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     };
 
   private:
-    AvroSchema m_schema;
+    const AvroSchema* m_schema;
     AvroStreamReader::ReaderPos m_data;
   };
 
@@ -152,7 +164,9 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
 
   class AvroObjectContainerReader final {
   public:
-    explicit AvroObjectContainerReader(Core::IO::BodyStream& stream);
+    explicit AvroObjectContainerReader(
+        Core::IO::BodyStream& stream,
+        size_t bufferSize = AvroStreamReader::DefaultBufferSize);
 
     bool End() const { return m_eof; }
     // Calling Next() will invalidates the previous AvroDatum returned by this function and all
@@ -172,20 +186,38 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
 
   class AvroStreamParser final : public Core::IO::BodyStream {
   public:
+    // If decodeInBackground is true, the next chunk of data is decoded on a worker thread while the
+    // previous one is read. bufferSize is the buffer size of the AvroStreamReader.
     explicit AvroStreamParser(
         std::unique_ptr<Azure::Core::IO::BodyStream> inner,
         std::function<void(int64_t, int64_t)> progressCallback,
-        std::function<void(BlobQueryError)> errorCallback)
-        : m_inner(std::move(inner)), m_parser(*m_inner),
-          m_progressCallback(std::move(progressCallback)), m_errorCallback(std::move(errorCallback))
+        std::function<void(BlobQueryError)> errorCallback,
+        bool decodeInBackground = false,
+        size_t bufferSize = AvroStreamReader::DefaultBufferSize)
+        : m_inner(std::move(inner)), m_parser(*m_inner, bufferSize),
+          m_progressCallback(std::move(progressCallback)),
+          m_errorCallback(std::move(errorCallback)), m_decodeInBackground(decodeInBackground)
     {
     }
 
     int64_t Length() const override { return -1; }
-    void Rewind() override { this->m_inner->Rewind(); }
+    void Rewind() override;
+
+    static constexpr size_t DecodedChunkSize = 1024 * 1024;
 
   private:
+    enum class RecordType
+    {
+      ResultData,
+      Progress,
+      Error,
+      Other,
+    };
+
     size_t OnRead(uint8_t* buffer, size_t count, const Azure::Core::Context& context) override;
+    size_t Decode(uint8_t* buffer, size_t count, const Azure::Core::Context& context);
+    void DecodeNextChunk(const Azure::Core::Context& context);
+    RecordType GetRecordType(const AvroSchema& schema);
 
   private:
     std::unique_ptr<Azure::Core::IO::BodyStream> m_inner;
@@ -193,6 +225,17 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     std::function<void(int64_t, int64_t)> m_progressCallback;
     std::function<void(BlobQueryError)> m_errorCallback;
     AvroDatum::StringView m_parserBuffer;
+    // The record types are looked up by name once for each schema.
+    std::vector<std::pair<const AvroSchema*, RecordType>> m_recordTypes;
+
+    bool m_decodeInBackground;
+    std::vector<uint8_t> m_chunk;
+    size_t m_chunkOffset = 0;
+    size_t m_chunkLength = 0;
+    bool m_endOfStream = false;
+    std::vector<uint8_t> m_nextChunk;
+    // Declared last, so that the worker is waited for before the members it uses are destroyed.
+    std::future<size_t> m_nextChunkLength;
   };
 
 }}}} // namespace Azure::Storage::Blobs::_detail
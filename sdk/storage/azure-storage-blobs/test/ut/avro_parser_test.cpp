@@ -0,0 +1,242 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "../../src/private/avro_parser.hpp"
+
+#include <azure/core/io/body_stream.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace Azure { namespace Storage { namespace Test {
+
+  namespace {
+    void AppendLong(std::string& out, int64_t value)
+    {
+      uint64_t n = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+      while (n >= 0x80)
+      {
+        out.push_back(static_cast<char>((n & 0x7f) | 0x80));
+        n >>= 7;
+      }
+      out.push_back(static_cast<char>(n));
+    }
+
+    void AppendString(std::string& out, const std::string& value)
+    {
+      AppendLong(out, static_cast<int64_t>(value.size()));
+      out += value;
+    }
+
+    // Returns at most maxReadSize bytes per read, and records the size of every read requested.
+    class RecordingBodyStream final : public Core::IO::BodyStream {
+    public:
+      RecordingBodyStream(std::string content, size_t maxReadSize)
+          : m_content(std::move(content)), m_maxReadSize(maxReadSize)
+      {
+      }
+
+      int64_t Length() const override { return static_cast<int64_t>(m_content.size()); }
+      void Rewind() override { m_offset = 0; }
+
+      std::vector<size_t> ReadSizes;
+
+    private:
+      size_t OnRead(uint8_t* buffer, size_t count, const Core::Context&) override
+      {
+        ReadSizes.push_back(count);
+        const size_t readSize = (std::min)({count, m_maxReadSize, m_content.size() - m_offset});
+        std::memcpy(buffer, m_content.data() + m_offset, readSize);
+        m_offset += readSize;
+        return readSize;
+      }
+
+      std::string m_content;
+      size_t m_maxReadSize;
+      size_t m_offset = 0;
+    };
+
+    // The schema of the records returned by Query.
+    const std::string QuerySchema = R"json([
+{"type":"record","name":"com.microsoft.azure.storage.queryBlobContents.resultData",
+ "fields":[{"name":"data","type":"bytes"}]},
+{"type":"record","name":"com.microsoft.azure.storage.queryBlobContents.error",
+ "fields":[{"name":"fatal","type":"boolean"},{"name":"name","type":"string"},
+           {"name":"description","type":"string"},{"name":"position","type":"long"}]},
+{"type":"record","name":"com.microsoft.azure.storage.queryBlobContents.progress",
+ "fields":[{"name":"bytesScanned","type":"long"},{"name":"totalBytes","type":"long"}]},
+{"type":"record","name":"com.microsoft.azure.storage.queryBlobContents.end",
+ "fields":[{"name":"totalBytes","type":"long"}]}])json";
+
+    std::string CreateObjectContainer(
+        const std::vector<std::string>& objects,
+        size_t objectsPerBlock)
+    {
+      const std::string syncMarker(16, 'S');
+      std::string container = "Obj\x01";
+      AppendLong(container, 2);
+      AppendString(container, "avro.schema");
+      AppendString(container, QuerySchema);
+      AppendString(container, "avro.codec");
+      AppendString(container, "null");
+      AppendLong(container, 0);
+      container += syncMarker;
+      for (size_t i = 0; i < objects.size(); i += objectsPerBlock)
+      {
+        const size_t objectCount = (std::min)(objectsPerBlock, objects.size() - i);
+        std::string block;
+        for (size_t j = i; j < i + objectCount; ++j)
+        {
+          block += objects[j];
+        }
+        AppendLong(container, static_cast<int64_t>(objectCount));
+        AppendLong(container, static_cast<int64_t>(block.size()));
+        container += block;
+        container += syncMarker;
+      }
+      return container;
+    }
+  } // namespace
+
+  TEST(AvroStreamReaderTest, BufferCompactsGrowsAndShrinks)
+  {
+    constexpr size_t BufferSize = 64;
+    std::vector<std::string> values;
+    for (int i = 0; i < 100; ++i)
+    {
+      values.push_back("value " + std::to_string(i));
+    }
+    const size_t oversizedIndex = 50;
+    values[oversizedIndex] = std::string(1000, 'x');
+
+    std::string content;
+    for (const auto& value : values)
+    {
+      AppendString(content, value);
+    }
+    RecordingBodyStream stream(content, 13);
+    Blobs::_detail::AvroStreamReader reader(stream, BufferSize);
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      reader.Discard();
+      Blobs::_detail::AvroDatum datum(Blobs::_detail::AvroSchema::StringSchema);
+      datum.Fill(reader, Core::Context());
+      EXPECT_EQ(datum.Value<std::string>(), values[i]);
+      if (i == oversizedIndex)
+      {
+        // The buffer grows to hold the datum larger than itself.
+        EXPECT_GT(reader.Capacity(), BufferSize);
+      }
+      else
+      {
+        // The consumed data is compacted away instead of growing the buffer, which shrinks back
+        // once the oversized datum is discarded.
+        EXPECT_LE(reader.Capacity(), BufferSize);
+      }
+    }
+    EXPECT_EQ(reader.TryPreload(1, Core::Context()), 0U);
+  }
+
+  TEST(AvroStreamParserTest, DecodeInBackgroundWithSmallBuffer)
+  {
+    constexpr size_t BufferSize = 256;
+    std::mt19937 random(0);
+    std::vector<std::string> objects;
+    std::string expectedData;
+    int expectedProgressCount = 0;
+    int expectedErrorCount = 0;
+    // The decoded data spans several chunks decoded in the background.
+    for (int i = 0;
+         expectedData.size() < Blobs::_detail::AvroStreamParser::DecodedChunkSize * 5 / 2;
+         ++i)
+    {
+      // One record is larger than the buffer.
+      const size_t dataSize = i == 1000 ? BufferSize * 10 : 1 + random() % (BufferSize / 2);
+      std::string data(dataSize, static_cast<char>('a' + random() % 26));
+      expectedData += data;
+
+      std::string resultData;
+      AppendLong(resultData, 0);
+      AppendString(resultData, data);
+      objects.push_back(std::move(resultData));
+      if (i % 100 == 99)
+      {
+        std::string progress;
+        AppendLong(progress, 2);
+        AppendLong(progress, static_cast<int64_t>(expectedData.size()));
+        AppendLong(progress, 0);
+        objects.push_back(std::move(progress));
+        ++expectedProgressCount;
+      }
+      if (i % 1000 == 999)
+      {
+        std::string error;
+        AppendLong(error, 1);
+        error.push_back(0);
+        AppendString(error, "ParseError");
+        AppendString(error, "Unexpected token.");
+        AppendLong(error, static_cast<int64_t>(expectedData.size()));
+        objects.push_back(std::move(error));
+        ++expectedErrorCount;
+      }
+    }
+    std::string end;
+    AppendLong(end, 3);
+    AppendLong(end, static_cast<int64_t>(expectedData.size()));
+    objects.push_back(std::move(end));
+
+    auto streamOwner = std::make_unique<RecordingBodyStream>(CreateObjectContainer(objects, 7), 99);
+    auto& stream = *streamOwner;
+    // The callbacks are called on the worker thread. They are checked after the last chunk is
+    // waited for.
+    int progressCount = 0;
+    int errorCount = 0;
+    int64_t lastBytesScanned = 0;
+    Blobs::_detail::AvroStreamParser parser(
+        std::move(streamOwner),
+        [&](int64_t bytesScanned, int64_t) {
+          EXPECT_GT(bytesScanned, lastBytesScanned);
+          lastBytesScanned = bytesScanned;
+          ++progressCount;
+        },
+        [&](Blobs::BlobQueryError error) {
+          EXPECT_EQ(error.Name, "ParseError");
+          EXPECT_FALSE(error.IsFatal);
+          ++errorCount;
+        },
+        true,
+        BufferSize);
+
+    std::string data;
+    std::vector<uint8_t> buffer(4099);
+    while (true)
+    {
+      const size_t bytesRead = parser.Read(buffer.data(), buffer.size());
+      if (bytesRead == 0)
+      {
+        break;
+      }
+      data.append(buffer.begin(), buffer.begin() + bytesRead);
+    }
+    EXPECT_EQ(data, expectedData);
+    EXPECT_EQ(progressCount, expectedProgressCount);
+    EXPECT_EQ(errorCount, expectedErrorCount);
+
+    // The buffer grew for the oversized record and the file header, and shrank back afterwards.
+    const auto oversizedReadCount = std::count_if(
+        stream.ReadSizes.begin(), stream.ReadSizes.end(), [&](size_t readSize) {
+          return readSize > BufferSize;
+        });
+    EXPECT_GT(oversizedReadCount, 0);
+    EXPECT_LT(oversizedReadCount, 100);
+    EXPECT_LE(stream.ReadSizes.back(), BufferSize);
+  }
+
+}}} // namespace Azure::Storage::Test
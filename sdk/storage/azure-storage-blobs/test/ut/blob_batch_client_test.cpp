@@ -3,10 +3,131 @@
 
 #include "blob_container_client_test.hpp"
 
+#include <azure/core/http/transport.hpp>
 #include <azure/storage/blobs.hpp>
 
+#include <algorithm>
+#include <cstring>
+
 namespace Azure { namespace Storage { namespace Test {
 
+  namespace {
+    // Returns at most readSize bytes per read, so that the delimiters of a multipart body are split
+    // across reads.
+    class TrickleBodyStream final : public Core::IO::BodyStream {
+    public:
+      TrickleBodyStream(std::string content, size_t readSize)
+          : m_content(std::move(content)), m_readSize(readSize)
+      {
+      }
+
+      int64_t Length() const override { return static_cast<int64_t>(m_content.size()); }
+
+      void Rewind() override { m_offset = 0; }
+
+    private:
+      size_t OnRead(uint8_t* buffer, size_t count, const Core::Context&) override
+      {
+        const size_t readSize = (std::min)({count, m_readSize, m_content.size() - m_offset});
+        std::memcpy(buffer, m_content.data() + m_offset, readSize);
+        m_offset += readSize;
+        return readSize;
+      }
+
+      std::string m_content;
+      size_t m_readSize;
+      size_t m_offset = 0;
+    };
+
+    // Answers a batch of three subrequests: the first succeeds, the subresponse of the second is
+    // missing and the third fails. The third subresponse is larger than the buffer of the reader.
+    class BatchResponseTransport final : public Core::Http::HttpTransport {
+    public:
+      explicit BatchResponseTransport(size_t readSize) : m_readSize(readSize) {}
+
+      std::unique_ptr<Core::Http::RawResponse> Send(Core::Http::Request&, const Core::Context&)
+          override
+      {
+        const std::string boundary = "batchresponse_66925647-d0cb-4109-b6d3-28efe3e1e5ed";
+        std::string body;
+        body += "--" + boundary
+            + "\r\nContent-Type: application/http\r\nContent-ID: 0\r\n\r\n"
+              "HTTP/1.1 202 Accepted\r\nx-ms-delete-type-permanent: true\r\n"
+              "x-ms-request-id: 0\r\n\r\n";
+        body += "--" + boundary
+            + "\r\nContent-Type: application/http\r\nContent-ID: 2\r\n\r\n"
+              "HTTP/1.1 404 The specified blob does not exist.\r\nx-ms-error-code: BlobNotFound\r\n"
+              "x-ms-client-request-id: "
+            + std::string(100 * 1024, 'a') + "\r\nx-ms-request-id: 2\r\nContent-Length: 0\r\n\r\n";
+        body += "--" + boundary + "--\r\n";
+
+        auto response = std::make_unique<Core::Http::RawResponse>(
+            1, 1, Core::Http::HttpStatusCode::Accepted, "Accepted");
+        response->SetHeader("Content-Type", "multipart/mixed; boundary=" + boundary);
+        response->SetBodyStream(std::make_unique<TrickleBodyStream>(std::move(body), m_readSize));
+        return response;
+      }
+
+    private:
+      size_t m_readSize;
+    };
+
+    Blobs::BlobContainerClient GetBatchResponseClient(size_t readSize)
+    {
+      Blobs::BlobClientOptions options;
+      options.Transport.Transport = std::make_shared<BatchResponseTransport>(readSize);
+      options.Retry.MaxRetries = 0;
+      return Blobs::BlobContainerClient("https://account.blob.core.windows.net/container", options);
+    }
+  } // namespace
+
+  TEST(BlobBatchResponseTest, DelimiterSplitAcrossReads)
+  {
+    for (size_t readSize : {1, 2, 3, 7, 13, 53, 4099})
+    {
+      auto containerClient = GetBatchResponseClient(readSize);
+      auto batch = containerClient.CreateBatch();
+      auto deleted = batch.DeleteBlob("b0");
+      auto missing = batch.DeleteBlob("b1");
+      auto notFound = batch.DeleteBlob("b2");
+      containerClient.SubmitBatch(batch);
+
+      EXPECT_TRUE(deleted.GetResponse().Value.Deleted) << readSize;
+      EXPECT_THROW(missing.GetResponse(), Core::RequestFailedException) << readSize;
+      try
+      {
+        notFound.GetResponse();
+        ADD_FAILURE() << readSize;
+      }
+      catch (const StorageException& e)
+      {
+        EXPECT_EQ(e.ErrorCode, "BlobNotFound") << readSize;
+        EXPECT_EQ(e.RequestId, "2") << readSize;
+      }
+    }
+  }
+
+  TEST(BlobBatchResponseTest, BulkBatchMissingSubresponse)
+  {
+    std::vector<Blobs::BlobBatchOperation> operations(3);
+    for (size_t i = 0; i < operations.size(); ++i)
+    {
+      operations[i].BlobUrl
+          = "https://account.blob.core.windows.net/container/b" + std::to_string(i);
+    }
+    auto result = GetBatchResponseClient(5).SubmitBulkBatch(operations);
+
+    EXPECT_EQ(result.BatchCount, 1);
+    EXPECT_EQ(result.SucceededCount, 1);
+    ASSERT_EQ(result.Failures.size(), static_cast<size_t>(2));
+    EXPECT_EQ(result.Failures[0].Operation.BlobUrl, operations[1].BlobUrl);
+    EXPECT_EQ(result.Failures[0].StatusCode, Core::Http::HttpStatusCode::None);
+    EXPECT_EQ(result.Failures[0].Message, "Subresponse is missing.");
+    EXPECT_EQ(result.Failures[1].Operation.BlobUrl, operations[2].BlobUrl);
+    EXPECT_EQ(result.Failures[1].StatusCode, Core::Http::HttpStatusCode::NotFound);
+    EXPECT_EQ(result.Failures[1].ErrorCode, "BlobNotFound");
+  }
+
   TEST_F(BlobContainerClientTest, ServiceBatchSubmitDelete_LIVEONLY_)
   {
     const std::string containerNamePrefix = LowercaseRandomString();
@@ -161,6 +282,43 @@ namespace Azure { namespace Storage { namespace Test {
         blob2Client.GetProperties().Value.AccessTier.Value(), Blobs::Models::AccessTier::Cold);
   }
 
+  TEST_F(BlobContainerClientTest, SubmitBulkBatch_LIVEONLY_)
+  {
+    auto containerClient = *m_blobContainerClient;
+    std::vector<Blobs::BlobBatchOperation> operations;
+    for (int i = 0; i < 30; ++i)
+    {
+      auto blobClient = containerClient.GetBlockBlobClient("b" + std::to_string(i));
+      blobClient.UploadFrom(nullptr, 0);
+      Blobs::BlobBatchOperation operation;
+      operation.BlobUrl = blobClient.GetUrl();
+      if (i % 2 == 0)
+      {
+        operation.AccessTier = Blobs::Models::AccessTier::Cool;
+      }
+      operations.push_back(std::move(operation));
+    }
+    Blobs::BlobBatchOperation missingBlobOperation;
+    missingBlobOperation.BlobUrl = containerClient.GetBlobClient("missing").GetUrl();
+    operations.push_back(missingBlobOperation);
+
+    Blobs::SubmitBulkBatchOptions options;
+    options.MaxSubrequests = 8;
+    options.Concurrency = 2;
+    auto result = containerClient.SubmitBulkBatch(operations, options);
+    EXPECT_EQ(result.BatchCount, 4);
+    EXPECT_EQ(result.SucceededCount, 30);
+    ASSERT_EQ(result.Failures.size(), static_cast<size_t>(1));
+    EXPECT_EQ(result.Failures[0].Operation.BlobUrl, missingBlobOperation.BlobUrl);
+    EXPECT_EQ(result.Failures[0].StatusCode, Core::Http::HttpStatusCode::NotFound);
+    EXPECT_EQ(result.Failures[0].ErrorCode, "BlobNotFound");
+
+    EXPECT_EQ(
+        containerClient.GetBlobClient("b0").GetProperties().Value.AccessTier.Value(),
+        Blobs::Models::AccessTier::Cool);
+    EXPECT_THROW(containerClient.GetBlobClient("b1").GetProperties(), StorageException);
+  }
+
   TEST_F(BlobContainerClientTest, ContainerBatchSubmitSetTier_LIVEONLY_)
   {
     const std::string blob1Name = "b1";
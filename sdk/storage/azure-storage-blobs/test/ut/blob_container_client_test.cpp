@@ -7,9 +7,14 @@
 #include <azure/storage/blobs/blob_lease_client.hpp>
 #include <azure/storage/blobs/blob_sas_builder.hpp>
 #include <azure/storage/common/crypt.hpp>
+#include <azure/storage/common/internal/file_io.hpp>
 
 #include <chrono>
+#include <map>
+#include <mutex>
+#include <set>
 #include <thread>
+#include <vector>
 
 namespace Azure { namespace Storage { namespace Blobs { namespace Models {
 
@@ -380,6 +385,156 @@ namespace Azure { namespace Storage { namespace Test {
     EXPECT_EQ(listBlobs, startFromBlobs);
   }
 
+  TEST_F(BlobContainerClientTest, ListBlobsParallel_LIVEONLY_)
+  {
+    auto containerClient = *m_blobContainerClient;
+    const std::string baseName = RandomString();
+
+    std::set<std::string> blobs;
+    for (int i = 0; i < 20; ++i)
+    {
+      std::string blobName = baseName + std::to_string(i);
+      auto blobClient = containerClient.GetBlockBlobClient(blobName);
+      auto emptyContent = Azure::Core::IO::MemoryBodyStream(nullptr, 0);
+      blobClient.Upload(emptyContent);
+      blobs.insert(blobName);
+    }
+
+    Azure::Storage::Blobs::ListBlobsParallelOptions options;
+    options.Prefix = baseName;
+    options.PageSizeHint = 2;
+    options.Concurrency = 3;
+    std::mutex listBlobsMutex;
+    std::vector<std::string> listBlobs;
+    containerClient.ListBlobsParallel(
+        [&](const std::vector<Blobs::Models::BlobItem>& page) {
+          std::lock_guard<std::mutex> guard(listBlobsMutex);
+          for (const auto& blob : page)
+          {
+            EXPECT_TRUE(blob.Details.ETag.HasValue());
+            listBlobs.push_back(blob.Name);
+          }
+        },
+        options);
+    EXPECT_EQ(listBlobs.size(), blobs.size());
+    EXPECT_EQ(std::set<std::string>(listBlobs.begin(), listBlobs.end()), blobs);
+
+    // Blobs are listed in order with a single range.
+    options.SplitPoints = {baseName + "15"};
+    options.Concurrency = 1;
+    listBlobs.clear();
+    containerClient.ListBlobsParallel(
+        [&](const std::vector<Blobs::Models::BlobItem>& page) {
+          for (const auto& blob : page)
+          {
+            listBlobs.push_back(blob.Name);
+          }
+        },
+        options);
+    EXPECT_EQ(listBlobs, std::vector<std::string>(blobs.begin(), blobs.end()));
+  }
+
+  TEST_F(BlobContainerClientTest, UploadDownloadDirectory_LIVEONLY_)
+  {
+    auto containerClient = *m_blobContainerClient;
+    const std::string prefix = RandomString() + "/";
+    const std::string sourceDirectory = "dir" + RandomString();
+    const std::string destinationDirectory = "dir" + RandomString();
+    const std::string journalFilename = "journal" + RandomString();
+
+    std::map<std::string, std::vector<uint8_t>> files;
+    for (int i = 0; i < 10; ++i)
+    {
+      files["f" + std::to_string(i)] = RandomBuffer(static_cast<size_t>(i * 100));
+    }
+    files["a/b/large"] = RandomBuffer(3_KB + 1);
+    _internal::CreateDirectories(sourceDirectory + "/a/b");
+    for (const auto& file : files)
+    {
+      WriteFile(sourceDirectory + "/" + file.first, file.second);
+    }
+
+    Blobs::UploadDirectoryOptions uploadOptions;
+    uploadOptions.Prefix = prefix;
+    uploadOptions.TransferOptions.ChunkSize = 1_KB;
+    uploadOptions.TransferOptions.Concurrency = 4;
+    uploadOptions.JournalPath = journalFilename;
+    Blobs::Models::TransferDirectoryProgress progress;
+    uploadOptions.ProgressHandler
+        = [&](const Blobs::Models::TransferDirectoryProgress& p) { progress = p; };
+    auto uploadResult = containerClient.UploadDirectory(sourceDirectory, uploadOptions);
+    EXPECT_EQ(uploadResult.TransferredFiles, 11);
+    EXPECT_TRUE(uploadResult.Failures.empty());
+    EXPECT_EQ(progress.TransferredFiles, 11);
+    EXPECT_EQ(progress.TransferredBytes, progress.TotalBytes);
+    EXPECT_EQ(
+        containerClient.GetBlobClient(prefix + "a/b/large").GetProperties().Value.BlobSize,
+        static_cast<int64_t>(3_KB + 1));
+
+    // Files in the journal are skipped.
+    uploadResult = containerClient.UploadDirectory(sourceDirectory, uploadOptions);
+    EXPECT_EQ(uploadResult.TransferredFiles, 0);
+    EXPECT_EQ(uploadResult.SkippedFiles, 11);
+    DeleteFile(journalFilename);
+
+    Blobs::DownloadDirectoryOptions downloadOptions;
+    // The '/' ending the prefix is not needed.
+    downloadOptions.Prefix = prefix.substr(0, prefix.size() - 1);
+    downloadOptions.TransferOptions.ChunkSize = 1_KB;
+    downloadOptions.TransferOptions.Concurrency = 4;
+    auto downloadResult = containerClient.DownloadDirectory(destinationDirectory, downloadOptions);
+    EXPECT_EQ(downloadResult.TransferredFiles, 11);
+    EXPECT_TRUE(downloadResult.Failures.empty());
+    for (const auto& file : files)
+    {
+      EXPECT_EQ(ReadFile(destinationDirectory + "/" + file.first), file.second);
+      DeleteFile(sourceDirectory + "/" + file.first);
+      DeleteFile(destinationDirectory + "/" + file.first);
+    }
+  }
+
+  TEST(ListBlobsParallelTest, SplitBoundedRange)
+  {
+    // A bounded range is split in the middle of the last listed name and its end.
+    EXPECT_EQ(Blobs::_detail::GetSplitName("a", "a", std::string("c"), ""), "b");
+    EXPECT_EQ(
+        Blobs::_detail::GetSplitName("pre/a", "pre/b", std::string("pre/d"), "pre/"), "pre/c");
+    // Names of different lengths are compared digit by digit, the shorter one padded with the
+    // smallest character.
+    EXPECT_EQ(Blobs::_detail::GetSplitName("a", "ab", std::string("ac"), ""), "abO");
+    EXPECT_EQ(Blobs::_detail::GetSplitName("a", "a", std::string("b"), ""), "aO");
+  }
+
+  TEST(ListBlobsParallelTest, SplitAdjacentNames)
+  {
+    // There is no name between the last listed name and the end of the range.
+    EXPECT_EQ(Blobs::_detail::GetSplitName("a", "a", std::string("a "), ""), "");
+    EXPECT_EQ(Blobs::_detail::GetSplitName("a", "a", std::string("a"), ""), "");
+    EXPECT_EQ(Blobs::_detail::GetSplitName("a", "ab", std::string("ab "), ""), "");
+  }
+
+  TEST(ListBlobsParallelTest, SplitUnboundedRange)
+  {
+    // The rest of an unbounded range is split after two more pages as dense as the last one.
+    EXPECT_EQ(Blobs::_detail::GetSplitName("a", "b", {}, ""), "d");
+    EXPECT_EQ(Blobs::_detail::GetSplitName("pre/a", "pre/b", {}, "pre/"), "pre/d");
+    // Past the names below the prefix, the range is split in the middle instead.
+    EXPECT_EQ(Blobs::_detail::GetSplitName("a", "x", {}, ""), "{");
+    EXPECT_EQ(Blobs::_detail::GetSplitName("pre/a", "pre/x", {}, "pre/"), "pre/{");
+  }
+
+  TEST(ListBlobsParallelTest, SplitAtEndOfCharacterRange)
+  {
+    EXPECT_EQ(Blobs::_detail::GetSplitName("a", "}", std::string("~"), ""), "}O");
+    EXPECT_EQ(Blobs::_detail::GetSplitName("a", "~", {}, ""), "");
+    EXPECT_EQ(Blobs::_detail::GetSplitName("~", "~~", {}, "~"), "");
+    // Characters past the printable range, including the bytes of multi-byte UTF-8 characters,
+    // are interpolated as the largest printable one.
+    EXPECT_EQ(Blobs::_detail::GetSplitName("a", "\x7f", {}, ""), "");
+    EXPECT_EQ(Blobs::_detail::GetSplitName("a", "}\xc3\xa9", std::string("~"), ""), "");
+    EXPECT_EQ(Blobs::_detail::GetSplitName("a", "a", std::string("\xc3\xa9"), ""), "o~O");
+  }
+
   TEST_F(BlobContainerClientTest, ListBlobsFlat_WithEndBefore)
   {
     auto containerClient = *m_blobContainerClient;
@@ -3,6 +3,7 @@
 
 #include "block_blob_client_test.hpp"
 
+#include <atomic>
 #include <future>
 #include <random>
 #include <vector>
@@ -370,6 +371,53 @@ xx
     }
   }
 
+  TEST_F(BlockBlobClientTest, QueryDecodeInBackground_LIVEONLY_)
+  {
+    auto blobClient = *m_blockBlobClient;
+
+    constexpr size_t DataSize = static_cast<size_t>(8_MB);
+    std::string csvData;
+    std::string jsonData;
+    for (int recordCounter = 0; csvData.size() < DataSize; ++recordCounter)
+    {
+      std::string counter = std::to_string(recordCounter);
+      std::string record = RandomString(static_cast<size_t>(RandomInt(1, 3000)));
+      csvData += counter + "," + record + "\n";
+      jsonData += "{\"_1\":\"" + counter + "\",\"_2\":\"" + record + "\"}\n";
+    }
+    blobClient.UploadFrom(reinterpret_cast<const uint8_t*>(csvData.data()), csvData.size());
+
+    Blobs::QueryBlobOptions queryOptions;
+    queryOptions.InputTextConfiguration = Blobs::BlobQueryInputTextOptions::CreateCsvTextOptions();
+    queryOptions.OutputTextConfiguration
+        = Blobs::BlobQueryOutputTextOptions::CreateJsonTextOptions();
+    queryOptions.DecodeInBackground = true;
+    std::atomic<int64_t> bytesScanned{0};
+    queryOptions.ProgressHandler = [&bytesScanned](int64_t offset, int64_t) {
+      bytesScanned = offset;
+    };
+    auto queryResponse = blobClient.Query("SELECT * FROM BlobStorage;", queryOptions);
+    auto data = queryResponse.Value.BodyStream->ReadToEnd();
+    EXPECT_EQ(std::string(data.begin(), data.end()), jsonData);
+    EXPECT_GT(bytesScanned.load(), 0);
+    EXPECT_LE(bytesScanned.load(), static_cast<int64_t>(csvData.size()));
+
+    const std::string malformedData = R"json(
+{"id": 100, "name": "oranges", "price": 100}
+xx
+)json";
+    blobClient.UploadFrom(
+        reinterpret_cast<const uint8_t*>(malformedData.data()), malformedData.size());
+    Blobs::QueryBlobOptions malformedQueryOptions;
+    malformedQueryOptions.InputTextConfiguration
+        = Blobs::BlobQueryInputTextOptions::CreateJsonTextOptions();
+    malformedQueryOptions.OutputTextConfiguration
+        = Blobs::BlobQueryOutputTextOptions::CreateJsonTextOptions();
+    malformedQueryOptions.DecodeInBackground = true;
+    queryResponse = blobClient.Query("SELECT * FROM BlobStorage;", malformedQueryOptions);
+    EXPECT_THROW(queryResponse.Value.BodyStream->ReadToEnd(), StorageException);
+  }
+
   TEST_F(BlockBlobClientTest, QueryBlobAccessConditionLeaseId)
   {
     auto blobClient = *m_blockBlobClient;
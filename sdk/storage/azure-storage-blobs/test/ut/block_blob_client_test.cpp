@@ -1559,6 +1559,71 @@ namespace Azure { namespace Storage { namespace Test {
     EXPECT_EQ(destBlobClient.GetTags().Value, srcTags);
   }
 
+  TEST_F(BlockBlobClientTest, CopyFromUriInBlocks_LIVEONLY_)
+  {
+    auto srcBlobClient = *m_blockBlobClient;
+    std::vector<uint8_t> blobContent = RandomBuffer(static_cast<size_t>(3_KB + 100));
+    srcBlobClient.UploadFrom(blobContent.data(), blobContent.size());
+    const auto srcETag = srcBlobClient.GetProperties().Value.ETag;
+
+    auto destBlobClient = GetBlockBlobClientForTest(RandomString() + "dest");
+    Blobs::CopyBlobFromUriInBlocksOptions options;
+    options.TransferOptions.ChunkSize = 1_KB;
+    options.TransferOptions.Concurrency = 2;
+    options.SourceAccessConditions.IfMatch = srcETag;
+    options.Metadata["k"] = "v";
+    std::vector<int64_t> progress;
+    options.ProgressHandler = [&](int64_t copiedSize, int64_t totalSize) {
+      EXPECT_EQ(totalSize, static_cast<int64_t>(blobContent.size()));
+      progress.push_back(copiedSize);
+    };
+
+    auto copyResult = destBlobClient.CopyFromUriInBlocks(
+        srcBlobClient.GetUrl() + GetSas(), static_cast<int64_t>(blobContent.size()), options);
+    EXPECT_TRUE(copyResult.Value.ETag.HasValue());
+    EXPECT_TRUE(IsValidTime(copyResult.Value.LastModified));
+    ASSERT_EQ(progress.size(), static_cast<size_t>(4));
+    EXPECT_EQ(progress.back(), static_cast<int64_t>(blobContent.size()));
+
+    auto downloadResult = destBlobClient.Download();
+    EXPECT_EQ(ReadBodyStream(downloadResult.Value.BodyStream), blobContent);
+    EXPECT_EQ(destBlobClient.GetProperties().Value.Metadata, options.Metadata);
+    EXPECT_EQ(
+        destBlobClient.GetBlockList().Value.CommittedBlocks.size(), static_cast<size_t>(4));
+
+    options.SourceAccessConditions.IfMatch = DummyETag;
+    EXPECT_THROW(
+        destBlobClient.CopyFromUriInBlocks(
+            srcBlobClient.GetUrl() + GetSas(), static_cast<int64_t>(blobContent.size()), options),
+        StorageException);
+  }
+
+  TEST_F(BlockBlobClientTest, BlockBlobWriter_LIVEONLY_)
+  {
+    auto blockBlobClient = *m_blockBlobClient;
+    const std::vector<uint8_t> blobContent = RandomBuffer(static_cast<size_t>(10_KB + 100));
+
+    Blobs::BlockBlobWriterOptions options;
+    options.TransferOptions.BlockSize = 1_KB;
+    options.TransferOptions.Concurrency = 3;
+    options.BlockHashAlgorithm = HashAlgorithm::Crc64;
+    options.Metadata = RandomMetadata();
+    Blobs::BlockBlobWriter writer(blockBlobClient, options);
+    for (size_t offset = 0; offset < blobContent.size(); offset += 700)
+    {
+      writer.Write(
+          blobContent.data() + offset, (std::min)(blobContent.size() - offset, size_t(700)));
+    }
+    auto commitResult = writer.Commit();
+    EXPECT_TRUE(commitResult.Value.ETag.HasValue());
+
+    auto downloadResult = blockBlobClient.Download();
+    EXPECT_EQ(ReadBodyStream(downloadResult.Value.BodyStream), blobContent);
+    EXPECT_EQ(downloadResult.Value.Details.Metadata, options.Metadata);
+    auto blockList = blockBlobClient.GetBlockList().Value;
+    EXPECT_EQ(blockList.CommittedBlocks.size(), static_cast<size_t>(11));
+  }
+
   TEST_F(BlockBlobClientTest, OAuthUploadFromUri)
   {
     auto srcBlobClient = *m_blockBlobClient;
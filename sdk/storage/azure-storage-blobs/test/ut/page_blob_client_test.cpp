@@ -9,6 +9,7 @@
 #include <azure/storage/common/internal/file_io.hpp>
 #include <azure/storage/files/shares.hpp>
 
+#include <algorithm>
 #include <future>
 #include <vector>
 
@@ -269,6 +270,60 @@ namespace Azure { namespace Storage { namespace Test {
     EXPECT_EQ(numItems, 1);
   }
 
+  TEST_F(PageBlobClientTest, UploadDownloadPages_LIVEONLY_)
+  {
+    auto pageBlobClient = *m_pageBlobClient;
+
+    std::vector<uint8_t> blobContent(64_KB, 0);
+    RandomBuffer(blobContent.data(), 1_KB);
+    RandomBuffer(blobContent.data() + 8_KB, 4_KB);
+    const std::string tempFilename = "file" + RandomString();
+    WriteFile(tempFilename, blobContent);
+
+    Blobs::UploadPagesFromOptions uploadOptions;
+    uploadOptions.TransferOptions.ChunkSize = 2_KB;
+    uploadOptions.TransferOptions.Concurrency = 4;
+    auto uploadResult = pageBlobClient.UploadPagesFrom(tempFilename, uploadOptions);
+    EXPECT_EQ(uploadResult.Value.TransferredSize, static_cast<int64_t>(5_KB));
+    EXPECT_TRUE(uploadResult.Value.ETag.HasValue());
+
+    size_t numRanges = 0;
+    for (auto pageResult = pageBlobClient.GetPageRanges(); pageResult.HasPage();
+         pageResult.MoveToNextPage())
+    {
+      numRanges += pageResult.PageRanges.size();
+    }
+    EXPECT_EQ(numRanges, static_cast<size_t>(2));
+
+    Blobs::DownloadPagesToOptions downloadOptions;
+    downloadOptions.TransferOptions.ChunkSize = 1_KB;
+    downloadOptions.TransferOptions.Concurrency = 4;
+    auto downloadResult = pageBlobClient.DownloadPagesTo(tempFilename, downloadOptions);
+    EXPECT_EQ(downloadResult.Value.BlobSize, static_cast<int64_t>(64_KB));
+    EXPECT_EQ(downloadResult.Value.TransferredSize, static_cast<int64_t>(5_KB));
+    EXPECT_EQ(downloadResult.Value.ETag, uploadResult.Value.ETag);
+    EXPECT_EQ(ReadFile(tempFilename), blobContent);
+
+    // Only the pages written since a snapshot are transferred to update a copy of it.
+    auto snapshot = pageBlobClient.CreateSnapshot().Value.Snapshot;
+    std::fill(blobContent.begin() + 8_KB, blobContent.begin() + 10_KB, uint8_t(0));
+    RandomBuffer(blobContent.data() + 32_KB, 512);
+    WriteFile(tempFilename, blobContent);
+    uploadOptions.UpdateExisting = true;
+    uploadResult = pageBlobClient.UploadPagesFrom(tempFilename, uploadOptions);
+    EXPECT_EQ(uploadResult.Value.TransferredSize, static_cast<int64_t>(3_KB + 512));
+
+    const std::string snapshotFilename = "file" + RandomString();
+    pageBlobClient.WithSnapshot(snapshot).DownloadPagesTo(snapshotFilename);
+    downloadOptions.PreviousSnapshot = snapshot;
+    downloadResult = pageBlobClient.DownloadPagesTo(snapshotFilename, downloadOptions);
+    EXPECT_EQ(downloadResult.Value.TransferredSize, static_cast<int64_t>(3_KB + 512));
+    EXPECT_EQ(ReadFile(snapshotFilename), blobContent);
+
+    DeleteFile(tempFilename);
+    DeleteFile(snapshotFilename);
+  }
+
   TEST_F(PageBlobClientTest, UploadFromUri)
   {
     auto pageBlobClient = *m_pageBlobClient;
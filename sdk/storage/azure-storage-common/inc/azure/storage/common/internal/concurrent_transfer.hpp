@@ -3,11 +3,18 @@
 
 #pragma once
 
+#include "azure/storage/common/internal/file_io.hpp"
+
+#include <azure/core/context.hpp>
+#include <azure/core/http/http.hpp>
+#include <azure/core/io/body_stream.hpp>
+
 #include <algorithm>
 #include <atomic>
 #include <cstdlib>
 #include <functional>
 #include <future>
+#include <memory>
 #include <stdexcept>
 #include <vector>
 
@@ -67,4 +74,22 @@ namespace Azure { namespace Storage { namespace _internal {
     }
   }
 
+  /**
+   * Sets the size of a file, clears clearRanges and downloads ranges into it concurrently, in
+   * chunks of at most chunkSize bytes. Ranges are truncated to the size of the file.
+   *
+   * @param downloadChunkFunc Returns the content of a chunk.
+   * @return The number of bytes downloaded.
+   */
+  int64_t DownloadRangesTo(
+      FileWriter& fileWriter,
+      int64_t fileSize,
+      const std::vector<Azure::Core::Http::HttpRange>& ranges,
+      const std::vector<Azure::Core::Http::HttpRange>& clearRanges,
+      int64_t chunkSize,
+      int concurrency,
+      const std::function<std::unique_ptr<Azure::Core::IO::BodyStream>(
+          const Azure::Core::Http::HttpRange&)>& downloadChunkFunc,
+      const Azure::Core::Context& context);
+
 }}} // namespace Azure::Storage::_internal
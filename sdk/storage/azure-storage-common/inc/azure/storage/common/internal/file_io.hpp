@@ -7,6 +7,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace Azure { namespace Storage { namespace _internal {
 
@@ -35,14 +36,41 @@ namespace Azure { namespace Storage { namespace _internal {
   public:
     FileWriter(const std::string& filename);
 
+    // Opens an existing file without truncating it, unless truncate is true.
+    FileWriter(const std::string& filename, bool truncate);
+
     ~FileWriter();
 
     FileHandle GetHandle() const { return m_handle; }
 
     void Write(const uint8_t* buffer, size_t length, int64_t offset);
 
+    // Extends or truncates the file. The ranges which are not written are left unallocated where
+    // the file system supports sparse files.
+    void SetSize(int64_t size);
+
+    // Zeroes a range of the file, deallocating it where the file system supports sparse files.
+    void Clear(int64_t offset, int64_t length);
+
   private:
     FileHandle m_handle;
   };
 
+  struct LocalFile final
+  {
+    // Path relative to the listed directory, with '/' as separator.
+    std::string RelativePath;
+    int64_t Size = 0;
+    // Time of the last write, in units which depend on the platform. It is only compared with
+    // times listed on the same platform.
+    int64_t LastWriteTime = 0;
+  };
+
+  // Lists the regular files in a directory and its subdirectories. Symbolic links to directories
+  // are not followed.
+  std::vector<LocalFile> ListFilesRecursively(const std::string& directory);
+
+  // Creates a directory and its missing parents.
+  void CreateDirectories(const std::string& path);
+
 }}} // namespace Azure::Storage::_internal
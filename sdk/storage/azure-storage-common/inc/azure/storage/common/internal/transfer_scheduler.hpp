@@ -0,0 +1,65 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace _internal {
+
+  /**
+   * Runs the tasks of a transfer of many objects on a bounded number of threads. Tasks with a
+   * smaller priority value run first, and tasks with the same priority run in the order they were
+   * scheduled. Tasks may schedule more tasks.
+   */
+  class TransferScheduler final {
+  public:
+    explicit TransferScheduler(int concurrency) : m_concurrency(concurrency) {}
+
+    TransferScheduler(const TransferScheduler&) = delete;
+    TransferScheduler& operator=(const TransferScheduler&) = delete;
+
+    void Schedule(int64_t priority, std::function<void()> task);
+
+    /**
+     * Runs the tasks on the calling thread and up to concurrency - 1 other threads, until no task
+     * is left. If a task throws, no other task is started, and the exception is rethrown once the
+     * running tasks are done.
+     */
+    void Run();
+
+  private:
+    struct Task final
+    {
+      int64_t Priority;
+      int64_t Sequence;
+      std::function<void()> Function;
+    };
+
+    struct TaskOrder final
+    {
+      bool operator()(const Task& lhs, const Task& rhs) const
+      {
+        return lhs.Priority != rhs.Priority ? lhs.Priority > rhs.Priority
+                                            : lhs.Sequence > rhs.Sequence;
+      }
+    };
+
+    void RunTasks();
+
+    int m_concurrency;
+    std::mutex m_mutex;
+    std::condition_variable m_taskChanged;
+    std::priority_queue<Task, std::vector<Task>, TaskOrder> m_tasks;
+    int64_t m_nextSequence = 0;
+    int m_runningTasks = 0;
+    std::exception_ptr m_exception;
+  };
+
+}}} // namespace Azure::Storage::_internal
@@ -3,6 +3,9 @@
 
 #include "azure/storage/common/internal/concurrent_transfer.hpp"
 
+#include <azure/core/exception.hpp>
+
+#include <cstdint>
 #include <thread>
 
 namespace Azure { namespace Storage { namespace _internal {
@@ -13,4 +16,67 @@ namespace Azure { namespace Storage { namespace _internal {
     return c;
   }
 
+  int64_t DownloadRangesTo(
+      FileWriter& fileWriter,
+      int64_t fileSize,
+      const std::vector<Azure::Core::Http::HttpRange>& ranges,
+      const std::vector<Azure::Core::Http::HttpRange>& clearRanges,
+      int64_t chunkSize,
+      int concurrency,
+      const std::function<std::unique_ptr<Azure::Core::IO::BodyStream>(
+          const Azure::Core::Http::HttpRange&)>& downloadChunkFunc,
+      const Azure::Core::Context& context)
+  {
+    fileWriter.SetSize(fileSize);
+    for (const auto& range : clearRanges)
+    {
+      const int64_t rangeEnd = (std::min)(range.Offset + range.Length.Value(), fileSize);
+      if (range.Offset < rangeEnd)
+      {
+        fileWriter.Clear(range.Offset, rangeEnd - range.Offset);
+      }
+    }
+
+    int64_t downloadedSize = 0;
+    std::vector<Azure::Core::Http::HttpRange> chunks;
+    for (const auto& range : ranges)
+    {
+      const int64_t rangeEnd = (std::min)(range.Offset + range.Length.Value(), fileSize);
+      for (int64_t offset = range.Offset; offset < rangeEnd; offset += chunkSize)
+      {
+        Azure::Core::Http::HttpRange chunk;
+        chunk.Offset = offset;
+        chunk.Length = (std::min)(chunkSize, rangeEnd - offset);
+        downloadedSize += chunk.Length.Value();
+        chunks.push_back(std::move(chunk));
+      }
+    }
+
+    auto downloadFunc = [&](int64_t chunkId, int64_t, int64_t, int64_t) {
+      const auto& chunkRange = chunks[static_cast<size_t>(chunkId)];
+      auto bodyStream = downloadChunkFunc(chunkRange);
+
+      constexpr int64_t BufferSize = 4 * 1024 * 1024;
+      int64_t offset = chunkRange.Offset;
+      int64_t length = chunkRange.Length.Value();
+      std::vector<uint8_t> buffer(static_cast<size_t>((std::min)(BufferSize, length)));
+      while (length > 0)
+      {
+        const size_t readSize = static_cast<size_t>((std::min)(BufferSize, length));
+        const size_t bytesRead = bodyStream->ReadToCount(buffer.data(), readSize, context);
+        if (bytesRead != readSize)
+        {
+          throw Azure::Core::RequestFailedException("Error when reading body stream.");
+        }
+        fileWriter.Write(buffer.data(), bytesRead, offset);
+        length -= bytesRead;
+        offset += bytesRead;
+      }
+    };
+
+    // Each chunk is a unit of the transfer.
+    ConcurrentTransfer(0, static_cast<int64_t>(chunks.size()), 1, concurrency, downloadFunc);
+    return downloadedSize;
+  }
+
 }}} // namespace Azure::Storage::_internal
@@ -6,6 +6,8 @@
 #include <azure/core/platform.hpp>
 
 #if defined(AZ_PLATFORM_POSIX)
+#include <dirent.h>
+#include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
 
@@ -21,13 +23,32 @@
 #define NOMINMAX
 #endif
 #include <windows.h>
+#include <winioctl.h>
 #endif
 
+#include <algorithm>
 #include <limits>
+#include <memory>
 #include <stdexcept>
+#include <vector>
 
 namespace Azure { namespace Storage { namespace _internal {
 
+  namespace {
+    void WriteZeros(FileWriter& fileWriter, int64_t offset, int64_t length)
+    {
+      constexpr int64_t BufferSize = 4 * 1024 * 1024;
+      const std::vector<uint8_t> zeros(static_cast<size_t>((std::min)(length, BufferSize)));
+      while (length > 0)
+      {
+        const size_t writeSize = static_cast<size_t>((std::min)(length, BufferSize));
+        fileWriter.Write(zeros.data(), writeSize, offset);
+        offset += writeSize;
+        length -= writeSize;
+      }
+    }
+  } // namespace
+
 #if defined(AZ_PLATFORM_WINDOWS)
   FileReader::FileReader(const std::string& filename)
   {
@@ -88,7 +109,9 @@ namespace Azure { namespace Storage { namespace _internal {
 
   FileReader::~FileReader() { CloseHandle(static_cast<HANDLE>(m_handle)); }
 
-  FileWriter::FileWriter(const std::string& filename)
+  FileWriter::FileWriter(const std::string& filename) : FileWriter(filename, true) {}
+
+  FileWriter::FileWriter(const std::string& filename, bool truncate)
   {
     int sizeNeeded = MultiByteToWideChar(
         CP_UTF8,
@@ -123,12 +146,16 @@ namespace Azure { namespace Storage { namespace _internal {
         GENERIC_WRITE,
         FILE_SHARE_READ | FILE_SHARE_WRITE,
         nullptr,
-        CREATE_ALWAYS,
+        truncate ? CREATE_ALWAYS : OPEN_EXISTING,
         FILE_ATTRIBUTE_NORMAL,
         NULL);
 #else
     fileHandle = CreateFile2(
-        filenameW.data(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, CREATE_ALWAYS, NULL);
+        filenameW.data(),
+        GENERIC_WRITE,
+        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        truncate ? CREATE_ALWAYS : OPEN_EXISTING,
+        NULL);
 #endif
     if (fileHandle == INVALID_HANDLE_VALUE)
     {
@@ -163,6 +190,195 @@ namespace Azure { namespace Storage { namespace _internal {
       throw std::runtime_error("Failed to write file.");
     }
   }
+
+  namespace {
+    void SetSparse(HANDLE handle)
+    {
+#if !defined(WINAPI_PARTITION_DESKTOP) \
+    || WINAPI_PARTITION_DESKTOP // See azure/core/platform.hpp for explanation.
+      // The file may not support sparse ranges, in which case it is allocated as it is written.
+      DWORD bytesReturned;
+      DeviceIoControl(handle, FSCTL_SET_SPARSE, nullptr, 0, nullptr, 0, &bytesReturned, nullptr);
+#else
+      (void)handle;
+#endif
+    }
+  } // namespace
+
+  void FileWriter::SetSize(int64_t size)
+  {
+    // Without the sparse attribute, the ranges below the size which are not written are
+    // allocated and zeroed when a range past them is written.
+    SetSparse(static_cast<HANDLE>(m_handle));
+    FILE_END_OF_FILE_INFO endOfFileInfo;
+    endOfFileInfo.EndOfFile.QuadPart = size;
+    if (!SetFileInformationByHandle(
+            static_cast<HANDLE>(m_handle),
+            FileEndOfFileInfo,
+            &endOfFileInfo,
+            sizeof(endOfFileInfo)))
+    {
+      throw std::runtime_error("Failed to resize file.");
+    }
+  }
+
+  void FileWriter::Clear(int64_t offset, int64_t length)
+  {
+#if !defined(WINAPI_PARTITION_DESKTOP) \
+    || WINAPI_PARTITION_DESKTOP // See azure/core/platform.hpp for explanation.
+    // The file may not support sparse ranges, in which case the range is only zeroed.
+    SetSparse(static_cast<HANDLE>(m_handle));
+    DWORD bytesReturned;
+    FILE_ZERO_DATA_INFORMATION zeroDataInfo;
+    zeroDataInfo.FileOffset.QuadPart = offset;
+    zeroDataInfo.BeyondFinalZero.QuadPart = offset + length;
+    if (DeviceIoControl(
+            static_cast<HANDLE>(m_handle),
+            FSCTL_SET_ZERO_DATA,
+            &zeroDataInfo,
+            sizeof(zeroDataInfo),
+            nullptr,
+            0,
+            &bytesReturned,
+            nullptr))
+    {
+      return;
+    }
+#endif
+    WriteZeros(*this, offset, length);
+  }
+
+  namespace {
+    std::wstring ToWideString(const std::string& path)
+    {
+      if (path.empty())
+      {
+        return std::wstring();
+      }
+      int sizeNeeded = MultiByteToWideChar(
+          CP_UTF8, MB_ERR_INVALID_CHARS, path.data(), static_cast<int>(path.length()), nullptr, 0);
+      if (sizeNeeded == 0)
+      {
+        throw std::runtime_error("Invalid filename.");
+      }
+      std::wstring pathW(sizeNeeded, L'\0');
+      if (MultiByteToWideChar(
+              CP_UTF8,
+              MB_ERR_INVALID_CHARS,
+              path.data(),
+              static_cast<int>(path.length()),
+              &pathW[0],
+              sizeNeeded)
+          == 0)
+      {
+        throw std::runtime_error("Invalid filename.");
+      }
+      return pathW;
+    }
+
+    std::string ToUtf8String(const std::wstring& pathW)
+    {
+      if (pathW.empty())
+      {
+        return std::string();
+      }
+      int sizeNeeded = WideCharToMultiByte(
+          CP_UTF8,
+          WC_ERR_INVALID_CHARS,
+          pathW.data(),
+          static_cast<int>(pathW.length()),
+          nullptr,
+          0,
+          nullptr,
+          nullptr);
+      if (sizeNeeded == 0)
+      {
+        throw std::runtime_error("Invalid filename.");
+      }
+      std::string path(sizeNeeded, '\0');
+      WideCharToMultiByte(
+          CP_UTF8,
+          WC_ERR_INVALID_CHARS,
+          pathW.data(),
+          static_cast<int>(pathW.length()),
+          &path[0],
+          sizeNeeded,
+          nullptr,
+          nullptr);
+      return path;
+    }
+
+    void ListFiles(
+        const std::wstring& directoryW,
+        const std::string& relativeDirectory,
+        std::vector<LocalFile>& files)
+    {
+      WIN32_FIND_DATAW findData;
+      HANDLE handle = FindFirstFileExW(
+          (directoryW + L"\\*").data(),
+          FindExInfoBasic,
+          &findData,
+          FindExSearchNameMatch,
+          nullptr,
+          0);
+      if (handle == INVALID_HANDLE_VALUE)
+      {
+        throw std::runtime_error("Failed to list directory.");
+      }
+      std::unique_ptr<void, decltype(&FindClose)> findHandle(handle, &FindClose);
+      do
+      {
+        const std::wstring nameW = findData.cFileName;
+        if (nameW == L"." || nameW == L"..")
+        {
+          continue;
+        }
+        const std::string relativePath = relativeDirectory + ToUtf8String(nameW);
+        if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+        {
+          if (!(findData.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT))
+          {
+            ListFiles(directoryW + L"\\" + nameW, relativePath + "/", files);
+          }
+        }
+        else
+        {
+          LocalFile file;
+          file.RelativePath = relativePath;
+          file.Size = static_cast<int64_t>(
+              (static_cast<uint64_t>(findData.nFileSizeHigh) << 32) | findData.nFileSizeLow);
+          file.LastWriteTime = static_cast<int64_t>(
+              (static_cast<uint64_t>(findData.ftLastWriteTime.dwHighDateTime) << 32)
+              | findData.ftLastWriteTime.dwLowDateTime);
+          files.push_back(std::move(file));
+        }
+      } while (FindNextFileW(findHandle.get(), &findData));
+    }
+  } // namespace
+
+  std::vector<LocalFile> ListFilesRecursively(const std::string& directory)
+  {
+    std::vector<LocalFile> files;
+    ListFiles(ToWideString(directory), std::string(), files);
+    return files;
+  }
+
+  void CreateDirectories(const std::string& path)
+  {
+    const std::wstring pathW = ToWideString(path);
+    for (size_t i = 1; i <= pathW.size(); ++i)
+    {
+      if (i == pathW.size() || pathW[i] == L'/' || pathW[i] == L'\\')
+      {
+        CreateDirectoryW(pathW.substr(0, i).data(), nullptr);
+      }
+    }
+    DWORD attributes = GetFileAttributesW(pathW.data());
+    if (attributes == INVALID_FILE_ATTRIBUTES || !(attributes & FILE_ATTRIBUTE_DIRECTORY))
+    {
+      throw std::runtime_error("Failed to create directory.");
+    }
+  }
 #elif defined(AZ_PLATFORM_POSIX)
   FileReader::FileReader(const std::string& filename)
   {
@@ -181,10 +397,15 @@ namespace Azure { namespace Storage { namespace _internal {
 
   FileReader::~FileReader() { close(m_handle); }
 
-  FileWriter::FileWriter(const std::string& filename)
+  FileWriter::FileWriter(const std::string& filename) : FileWriter(filename, true) {}
+
+  FileWriter::FileWriter(const std::string& filename, bool truncate)
   {
-    m_handle = open(
-        filename.data(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    m_handle = truncate ? open(
+                   filename.data(),
+                   O_WRONLY | O_CREAT | O_TRUNC,
+                   S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH)
+                        : open(filename.data(), O_WRONLY);
     if (m_handle == -1)
     {
       throw std::runtime_error("Failed to open file.");
@@ -205,6 +426,119 @@ namespace Azure { namespace Storage { namespace _internal {
       throw std::runtime_error("Failed to write file.");
     }
   }
+
+  void FileWriter::SetSize(int64_t size)
+  {
+    if (size > static_cast<int64_t>((std::numeric_limits<off_t>::max)())
+        || ftruncate(m_handle, static_cast<off_t>(size)) != 0)
+    {
+      throw std::runtime_error("Failed to resize file.");
+    }
+  }
+
+  void FileWriter::Clear(int64_t offset, int64_t length)
+  {
+#if defined(FALLOC_FL_PUNCH_HOLE)
+    if (offset <= static_cast<int64_t>((std::numeric_limits<off_t>::max)())
+        && length <= static_cast<int64_t>((std::numeric_limits<off_t>::max)())
+        && fallocate(
+               m_handle,
+               FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+               static_cast<off_t>(offset),
+               static_cast<off_t>(length))
+            == 0)
+    {
+      return;
+    }
+#endif
+    // The file system does not support sparse files.
+    WriteZeros(*this, offset, length);
+  }
+
+  namespace {
+    void ListFiles(
+        const std::string& directory,
+        const std::string& relativeDirectory,
+        std::vector<LocalFile>& files)
+    {
+      std::unique_ptr<DIR, decltype(&closedir)> dir(opendir(directory.data()), &closedir);
+      if (!dir)
+      {
+        throw std::runtime_error("Failed to list directory.");
+      }
+      std::vector<std::string> subdirectories;
+      while (const dirent* entry = readdir(dir.get()))
+      {
+        const std::string name = entry->d_name;
+        if (name == "." || name == "..")
+        {
+          continue;
+        }
+        const std::string path = directory + "/" + name;
+        struct stat fileStat;
+        if (lstat(path.data(), &fileStat) != 0)
+        {
+          continue;
+        }
+        if (S_ISDIR(fileStat.st_mode))
+        {
+          subdirectories.push_back(name);
+          continue;
+        }
+        if (S_ISLNK(fileStat.st_mode) && stat(path.data(), &fileStat) != 0)
+        {
+          continue;
+        }
+        if (S_ISREG(fileStat.st_mode))
+        {
+          LocalFile file;
+          file.RelativePath = relativeDirectory + name;
+          file.Size = static_cast<int64_t>(fileStat.st_size);
+#if defined(__APPLE__)
+          const timespec& lastWriteTime = fileStat.st_mtimespec;
+#else
+          const timespec& lastWriteTime = fileStat.st_mtim;
+#endif
+          file.LastWriteTime = static_cast<int64_t>(lastWriteTime.tv_sec) * 1000000000
+              + static_cast<int64_t>(lastWriteTime.tv_nsec);
+          files.push_back(std::move(file));
+        }
+      }
+      // The directory is closed before its subdirectories are listed.
+      dir.reset();
+      for (const auto& name : subdirectories)
+      {
+        ListFiles(directory + "/" + name, relativeDirectory + name + "/", files);
+      }
+    }
+  } // namespace
+
+  std::vector<LocalFile> ListFilesRecursively(const std::string& directory)
+  {
+    std::vector<LocalFile> files;
+    ListFiles(directory, std::string(), files);
+    return files;
+  }
+
+  void CreateDirectories(const std::string& path)
+  {
+    for (size_t i = 1; i <= path.size(); ++i)
+    {
+      if (i == path.size() || path[i] == '/')
+      {
+        if (mkdir(path.substr(0, i).data(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) != 0
+            && errno != EEXIST)
+        {
+          throw std::runtime_error("Failed to create directory.");
+        }
+      }
+    }
+    struct stat fileStat;
+    if (stat(path.data(), &fileStat) != 0 || !S_ISDIR(fileStat.st_mode))
+    {
+      throw std::runtime_error("Failed to create directory.");
+    }
+  }
 #endif
 
 }}} // namespace Azure::Storage::_internal
@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/storage/common/internal/transfer_scheduler.hpp"
+
+#include <future>
+#include <utility>
+
+namespace Azure { namespace Storage { namespace _internal {
+
+  void TransferScheduler::Schedule(int64_t priority, std::function<void()> task)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_tasks.push(Task{priority, m_nextSequence++, std::move(task)});
+    m_taskChanged.notify_one();
+  }
+
+  void TransferScheduler::Run()
+  {
+    std::vector<std::future<void>> threadHandles;
+    for (int i = 0; i < m_concurrency - 1; ++i)
+    {
+      threadHandles.emplace_back(std::async(std::launch::async, [this]() { RunTasks(); }));
+    }
+    RunTasks();
+    for (auto& handle : threadHandles)
+    {
+      handle.get();
+    }
+    if (m_exception)
+    {
+      std::rethrow_exception(m_exception);
+    }
+  }
+
+  void TransferScheduler::RunTasks()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+      // Tasks which are running may still schedule more tasks.
+      m_taskChanged.wait(
+          lock, [this]() { return m_exception || !m_tasks.empty() || m_runningTasks == 0; });
+      if (m_exception || m_tasks.empty())
+      {
+        break;
+      }
+      auto task = m_tasks.top().Function;
+      m_tasks.pop();
+      ++m_runningTasks;
+      lock.unlock();
+      std::exception_ptr exception;
+      try
+      {
+        task();
+      }
+      catch (...)
+      {
+        exception = std::current_exception();
+      }
+      lock.lock();
+      --m_runningTasks;
+      if (exception && !m_exception)
+      {
+        m_exception = exception;
+      }
+      m_taskChanged.notify_all();
+    }
+  }
+
+}}} // namespace Azure::Storage::_internal
@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <azure/storage/common/internal/transfer_scheduler.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace Azure { namespace Storage { namespace Test {
+
+  TEST(TransferSchedulerTest, Priority)
+  {
+    _internal::TransferScheduler scheduler(1);
+    std::vector<int> order;
+    scheduler.Schedule(3, [&]() { order.push_back(3); });
+    scheduler.Schedule(1, [&]() {
+      order.push_back(1);
+      // Scheduled tasks run before the tasks with a larger priority value.
+      scheduler.Schedule(2, [&]() { order.push_back(2); });
+    });
+    scheduler.Schedule(1, [&]() { order.push_back(10); });
+    scheduler.Run();
+    EXPECT_EQ(order, std::vector<int>({1, 10, 2, 3}));
+  }
+
+  TEST(TransferSchedulerTest, Concurrency)
+  {
+    _internal::TransferScheduler scheduler(4);
+    std::atomic<int> running{0};
+    std::atomic<int> maxRunning{0};
+    std::atomic<int> completed{0};
+    std::function<void(int)> task = [&](int depth) {
+      const int current = ++running;
+      int max = maxRunning;
+      while (current > max && !maxRunning.compare_exchange_weak(max, current))
+      {
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      if (depth < 2)
+      {
+        scheduler.Schedule(depth, [&task, depth]() { task(depth + 1); });
+      }
+      --running;
+      ++completed;
+    };
+    for (int i = 0; i < 20; ++i)
+    {
+      scheduler.Schedule(0, [&task]() { task(0); });
+    }
+    scheduler.Run();
+    EXPECT_EQ(completed, 60);
+    EXPECT_LE(maxRunning, 4);
+    EXPECT_GT(maxRunning, 1);
+  }
+
+  TEST(TransferSchedulerTest, Exception)
+  {
+    _internal::TransferScheduler scheduler(2);
+    std::atomic<int> completed{0};
+    scheduler.Schedule(0, []() { throw std::runtime_error("Failed to transfer."); });
+    for (int i = 0; i < 100; ++i)
+    {
+      scheduler.Schedule(1, [&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ++completed;
+      });
+    }
+    EXPECT_THROW(scheduler.Run(), std::runtime_error);
+    // No task is started after the failure.
+    EXPECT_LE(completed, 1);
+  }
+
+}}} // namespace Azure::Storage::Test
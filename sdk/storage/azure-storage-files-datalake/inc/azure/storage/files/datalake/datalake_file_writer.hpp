@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "azure/storage/files/datalake/datalake_file_client.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace Files { namespace DataLake {
+
+  /**
+   * @brief DataLakeFileWriter writes a stream of data to a file with append requests sent
+   * concurrently, each at its own position, while more data is written.
+   */
+  class DataLakeFileWriter final {
+  public:
+    /**
+     * @brief Initializes a new instance of the DataLakeFileWriter.
+     *
+     * @param fileClient A DataLakeFileClient representing the file to write, which must exist.
+     * @param position The position in the file where the data is written, which is usually the
+     * size of the file.
+     * @param options Optional parameters to write the file.
+     */
+    explicit DataLakeFileWriter(
+        DataLakeFileClient fileClient,
+        int64_t position,
+        DataLakeFileWriterOptions options = DataLakeFileWriterOptions());
+
+    DataLakeFileWriter(const DataLakeFileWriter&) = delete;
+    DataLakeFileWriter& operator=(const DataLakeFileWriter&) = delete;
+
+    /**
+     * @brief Waits for the append requests being sent. The data which is not flushed is not part
+     * of the file.
+     */
+    ~DataLakeFileWriter();
+
+    /**
+     * @brief Writes data after the data previously written. Returns when the data is buffered,
+     * which may wait for append requests to complete. An error from a previous append or flush is
+     * thrown.
+     *
+     * @param buffer A memory buffer containing the data to write.
+     * @param bufferSize Size of the memory buffer.
+     * @param context Context for cancelling long running operations. It applies to the requests
+     * for the buffers which are filled by this call.
+     */
+    void Write(
+        const uint8_t* buffer,
+        size_t bufferSize,
+        const Azure::Core::Context& context = Azure::Core::Context());
+
+    /**
+     * @brief Appends the remaining data, and flushes all the data written. More data can be
+     * written after.
+     *
+     * @param context Context for cancelling long running operations.
+     * @return A FlushFileResult describing the file.
+     */
+    Azure::Response<Models::FlushFileResult> Flush(
+        const Azure::Core::Context& context = Azure::Core::Context());
+
+  private:
+    std::vector<uint8_t> GetBuffer();
+    void Append(const Azure::Core::Context& context);
+    void OnAppended(
+        std::shared_ptr<std::vector<uint8_t>> buffer,
+        int64_t offset,
+        int64_t length,
+        std::exception_ptr exception,
+        const Azure::Core::Context& context);
+
+    DataLakeFileClient m_fileClient;
+    DataLakeFileWriterOptions m_options;
+    std::vector<uint8_t> m_buffer;
+    size_t m_bufferLength = 0;
+    // The position of the next append.
+    int64_t m_position;
+
+    std::mutex m_mutex;
+    std::condition_variable m_requestCompleted;
+    int32_t m_appendingBuffers = 0;
+    bool m_flushing = false;
+    // The data is appended without a gap up to this position.
+    int64_t m_appendedPosition;
+    int64_t m_flushedPosition;
+    // The appended ranges after a gap, by offset.
+    std::map<int64_t, int64_t> m_appendedRanges;
+    std::vector<std::vector<uint8_t>> m_freeBuffers;
+    std::vector<std::future<void>> m_appendTasks;
+    std::exception_ptr m_exception;
+  };
+
+}}}} // namespace Azure::Storage::Files::DataLake
@@ -605,6 +605,46 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
     Azure::Nullable<std::chrono::seconds> LeaseDuration;
   };
 
+  /**
+   * @brief Optional parameters for #Azure::Storage::Files::DataLake::DataLakeFileWriter.
+   */
+  struct DataLakeFileWriterOptions final
+  {
+    /**
+     * @brief The standard HTTP header system properties to set, each time the file is flushed.
+     */
+    Models::PathHttpHeaders HttpHeaders;
+
+    /**
+     * @brief Specify the lease access conditions.
+     */
+    LeaseAccessConditions AccessConditions;
+
+    /**
+     * @brief Options for parallel transfer.
+     */
+    struct
+    {
+      /**
+       * @brief The number of bytes sent by each append request.
+       */
+      int64_t BufferSize = 8 * 1024 * 1024;
+
+      /**
+       * @brief The maximum number of append requests sent concurrently. At most Concurrency + 1
+       * buffers are held in memory.
+       */
+      int32_t Concurrency = 4;
+    } TransferOptions;
+
+    /**
+     * @brief The appended data is flushed each time this many more bytes are appended without a
+     * gap, so that readers see the data before the writer is flushed. The data is only flushed
+     * by #Azure::Storage::Files::DataLake::DataLakeFileWriter::Flush if no value is set.
+     */
+    Azure::Nullable<int64_t> FlushThreshold;
+  };
+
   /**
    * @brief Optional parameters for
    * #Azure::Storage::Files::DataLake::DataLakePathClient::SetAccessControlList.
@@ -1087,6 +1127,12 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
      * will ignore all non-fatal errors and throw for fatal errors.
      */
     std::function<void(FileQueryError)> ErrorHandler;
+    /**
+     * @brief If true, the query response is decoded on a worker thread while the data decoded
+     * before is read from the body stream. The progress and error handlers are then called on the
+     * worker thread.
+     */
+    bool DecodeInBackground = false;
   };
 
   using SetPathTagsOptions = Blobs::SetBlobTagsOptions;
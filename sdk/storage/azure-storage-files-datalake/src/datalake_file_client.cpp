@@ -442,6 +442,7 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
     blobOptions.OutputTextConfiguration = options.OutputTextConfiguration;
     blobOptions.ErrorHandler = options.ErrorHandler;
     blobOptions.ProgressHandler = options.ProgressHandler;
+    blobOptions.DecodeInBackground = options.DecodeInBackground;
     blobOptions.AccessConditions.IfMatch = options.AccessConditions.IfMatch;
     blobOptions.AccessConditions.IfNoneMatch = options.AccessConditions.IfNoneMatch;
     blobOptions.AccessConditions.IfModifiedSince = options.AccessConditions.IfModifiedSince;
@@ -0,0 +1,224 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/storage/files/datalake/datalake_file_writer.hpp"
+
+#include <azure/core/azure_assert.hpp>
+#include <azure/core/io/body_stream.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+namespace Azure { namespace Storage { namespace Files { namespace DataLake {
+
+  DataLakeFileWriter::DataLakeFileWriter(
+      DataLakeFileClient fileClient,
+      int64_t position,
+      DataLakeFileWriterOptions options)
+      : m_fileClient(std::move(fileClient)), m_options(std::move(options)), m_position(position),
+        m_appendedPosition(position), m_flushedPosition(position)
+  {
+    AZURE_ASSERT_MSG(position >= 0, "Position must not be negative.");
+    AZURE_ASSERT_MSG(m_options.TransferOptions.BufferSize > 0, "Buffer size must be positive.");
+    AZURE_ASSERT_MSG(
+        m_options.TransferOptions.Concurrency > 0, "Concurrency must be greater than 0.");
+    AZURE_ASSERT_MSG(
+        !m_options.FlushThreshold.HasValue() || m_options.FlushThreshold.Value() > 0,
+        "Flush threshold must be positive.");
+  }
+
+  DataLakeFileWriter::~DataLakeFileWriter()
+  {
+    // The append tasks use this writer until they are done.
+    m_appendTasks.clear();
+  }
+
+  std::vector<uint8_t> DataLakeFileWriter::GetBuffer()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_freeBuffers.empty())
+    {
+      return std::vector<uint8_t>(static_cast<size_t>(m_options.TransferOptions.BufferSize));
+    }
+    auto buffer = std::move(m_freeBuffers.back());
+    m_freeBuffers.pop_back();
+    return buffer;
+  }
+
+  void DataLakeFileWriter::Write(
+      const uint8_t* buffer,
+      size_t bufferSize,
+      const Azure::Core::Context& context)
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      if (m_exception)
+      {
+        std::rethrow_exception(m_exception);
+      }
+    }
+
+    while (bufferSize > 0)
+    {
+      if (m_buffer.empty())
+      {
+        m_buffer = GetBuffer();
+      }
+      const size_t copySize = (std::min)(bufferSize, m_buffer.size() - m_bufferLength);
+      std::memcpy(m_buffer.data() + m_bufferLength, buffer, copySize);
+      m_bufferLength += copySize;
+      buffer += copySize;
+      bufferSize -= copySize;
+      if (m_bufferLength == m_buffer.size())
+      {
+        Append(context);
+      }
+    }
+  }
+
+  void DataLakeFileWriter::Append(const Azure::Core::Context& context)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_requestCompleted.wait(lock, [this]() {
+        return m_exception || m_appendingBuffers < m_options.TransferOptions.Concurrency;
+      });
+      if (m_exception)
+      {
+        std::rethrow_exception(m_exception);
+      }
+      ++m_appendingBuffers;
+    }
+
+    m_appendTasks.erase(
+        std::remove_if(
+            m_appendTasks.begin(),
+            m_appendTasks.end(),
+            [](const std::future<void>& task) {
+              return task.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            }),
+        m_appendTasks.end());
+
+    auto buffer = std::make_shared<std::vector<uint8_t>>(std::move(m_buffer));
+    m_buffer = std::vector<uint8_t>();
+    const int64_t length = static_cast<int64_t>(m_bufferLength);
+    m_bufferLength = 0;
+    const int64_t offset = m_position;
+    m_position += length;
+
+    m_appendTasks.push_back(
+        std::async(std::launch::async, [this, buffer, offset, length, context]() {
+          std::exception_ptr exception;
+          try
+          {
+            // Appends are idempotent, because each one has its own position, so they are
+            // retried independently by the retry policy of the client.
+            AppendFileOptions appendOptions;
+            appendOptions.AccessConditions.LeaseId = m_options.AccessConditions.LeaseId;
+            Azure::Core::IO::MemoryBodyStream content(
+                buffer->data(), static_cast<size_t>(length));
+            m_fileClient.Append(content, offset, appendOptions, context);
+          }
+          catch (...)
+          {
+            exception = std::current_exception();
+          }
+
+          OnAppended(buffer, offset, length, exception, context);
+        }));
+  }
+
+  void DataLakeFileWriter::OnAppended(
+      std::shared_ptr<std::vector<uint8_t>> buffer,
+      int64_t offset,
+      int64_t length,
+      std::exception_ptr exception,
+      const Azure::Core::Context& context)
+  {
+    int64_t flushPosition;
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      --m_appendingBuffers;
+      m_freeBuffers.push_back(std::move(*buffer));
+      m_requestCompleted.notify_all();
+      if (exception)
+      {
+        if (!m_exception)
+        {
+          m_exception = exception;
+        }
+        return;
+      }
+      m_appendedRanges.emplace(offset, offset + length);
+      while (!m_appendedRanges.empty() && m_appendedRanges.begin()->first == m_appendedPosition)
+      {
+        m_appendedPosition = m_appendedRanges.begin()->second;
+        m_appendedRanges.erase(m_appendedRanges.begin());
+      }
+      if (!m_options.FlushThreshold.HasValue() || m_flushing || m_exception
+          || m_appendedPosition - m_flushedPosition < m_options.FlushThreshold.Value())
+      {
+        return;
+      }
+      m_flushing = true;
+      flushPosition = m_appendedPosition;
+    }
+
+    try
+    {
+      // The data appended after the position is kept for the next flush.
+      FlushFileOptions flushOptions;
+      flushOptions.RetainUncommittedData = true;
+      flushOptions.HttpHeaders = m_options.HttpHeaders;
+      flushOptions.AccessConditions.LeaseId = m_options.AccessConditions.LeaseId;
+      m_fileClient.Flush(flushPosition, flushOptions, context);
+    }
+    catch (...)
+    {
+      exception = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_flushing = false;
+    if (!exception)
+    {
+      m_flushedPosition = (std::max)(m_flushedPosition, flushPosition);
+    }
+    else if (!m_exception)
+    {
+      m_exception = exception;
+    }
+    m_requestCompleted.notify_all();
+  }
+
+  Azure::Response<Models::FlushFileResult> DataLakeFileWriter::Flush(
+      const Azure::Core::Context& context)
+  {
+    if (m_bufferLength > 0)
+    {
+      Append(context);
+    }
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_requestCompleted.wait(
+          lock, [this]() { return m_appendingBuffers == 0 && !m_flushing; });
+      if (m_exception)
+      {
+        std::rethrow_exception(m_exception);
+      }
+    }
+    m_appendTasks.clear();
+
+    FlushFileOptions flushOptions;
+    flushOptions.HttpHeaders = m_options.HttpHeaders;
+    flushOptions.AccessConditions.LeaseId = m_options.AccessConditions.LeaseId;
+    auto response = m_fileClient.Flush(m_position, flushOptions, context);
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_flushedPosition = m_position;
+    return response;
+  }
+
+}}}} // namespace Azure::Storage::Files::DataLake
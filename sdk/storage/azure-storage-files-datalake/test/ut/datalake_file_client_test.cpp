@@ -1080,6 +1080,45 @@ namespace Azure { namespace Storage { namespace Test {
     }
   }
 
+  TEST_F(DataLakeFileClientTest, DataLakeFileWriter_LIVEONLY_)
+  {
+    const auto content = RandomBuffer(static_cast<size_t>(3_MB + 123));
+
+    auto fileClient = m_fileSystemClient->GetFileClient(RandomString());
+    fileClient.Create();
+
+    Files::DataLake::DataLakeFileWriterOptions options;
+    options.TransferOptions.BufferSize = 256_KB;
+    options.TransferOptions.Concurrency = 4;
+    options.FlushThreshold = 1_MB;
+    options.HttpHeaders.ContentType = "application/x-binary";
+    Files::DataLake::DataLakeFileWriter writer(fileClient, 0, options);
+    for (size_t offset = 0; offset < content.size();)
+    {
+      const size_t writeSize
+          = std::min(content.size() - offset, static_cast<size_t>(RandomInt(1, 100_KB)));
+      writer.Write(content.data() + offset, writeSize);
+      offset += writeSize;
+    }
+    auto flushResult = writer.Flush();
+    EXPECT_EQ(flushResult.Value.FileSize, static_cast<int64_t>(content.size()));
+
+    auto properties = fileClient.GetProperties().Value;
+    EXPECT_EQ(properties.FileSize, static_cast<int64_t>(content.size()));
+    EXPECT_EQ(properties.HttpHeaders.ContentType, options.HttpHeaders.ContentType);
+    std::vector<uint8_t> downloadBuffer(content.size());
+    fileClient.DownloadTo(downloadBuffer.data(), downloadBuffer.size());
+    EXPECT_EQ(downloadBuffer, content);
+
+    // Data written after a flush is appended to the file.
+    const std::vector<uint8_t> moreContent(10, 'a');
+    writer.Write(moreContent.data(), moreContent.size());
+    writer.Flush();
+    EXPECT_EQ(
+        fileClient.GetProperties().Value.FileSize,
+        static_cast<int64_t>(content.size() + moreContent.size()));
+  }
+
   TEST_F(DataLakeFileClientTest, StructuredMessageTest)
   {
     const size_t contentSize = 2 * 1024 + 512;
@@ -168,6 +168,26 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
         const DownloadFileToOptions& options = DownloadFileToOptions(),
         const Azure::Core::Context& context = Azure::Core::Context()) const;
 
+    /**
+     * @brief Applies the changes of the file since a previous share snapshot to a local copy of
+     * it, in place. Only the ranges changed since the snapshot are downloaded, in parallel, and the
+     * cleared ranges are zeroed in the local file.
+     *
+     * @param fileName A file path holding the content of the file in the previous share snapshot.
+     * @param previousShareSnapshot Specifies the previous snapshot.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return Azure::Response<Models::DownloadFileChangesToResult> describing the downloaded
+     * file.
+     * @remarks The file must not be modified during the operation, which is guaranteed when this
+     * client refers to a share snapshot.
+     */
+    Azure::Response<Models::DownloadFileChangesToResult> DownloadChangesTo(
+        const std::string& fileName,
+        std::string previousShareSnapshot,
+        const DownloadFileChangesToOptions& options = DownloadFileChangesToOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
     /**
      * @brief Creates a new file, or updates the content of an existing file. Updating
      * an existing file overwrites any existing metadata on the file.
@@ -200,6 +220,27 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
         const UploadFileFromOptions& options = UploadFileFromOptions(),
         const Azure::Core::Context& context = Azure::Core::Context()) const;
 
+    /**
+     * @brief Applies the changes of a local file to the file, in place. The local file is compared
+     * with a local copy of the content of the file, only the chunks that differ are uploaded, in
+     * parallel, and the chunks which became zero are cleared.
+     *
+     * @param fileName A file containing the content to upload.
+     * @param previousFileName A file holding the current content of the file, for example the
+     * local file as it was when it was last uploaded.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return Azure::Response<Models::UploadFileChangesFromResult> describing the uploaded
+     * changes.
+     * @remarks The local files must not be modified during the operation, and the file must hold
+     * the content of previousFileName, which is only checked for its size.
+     */
+    Azure::Response<Models::UploadFileChangesFromResult> UploadChangesFrom(
+        const std::string& fileName,
+        const std::string& previousFileName,
+        const UploadFileChangesFromOptions& options = UploadFileChangesFromOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
     /**
      * @brief Starts copy the file specified from source URI to the file this client points to.
      * @param copySource Specifies the URL of the source file or file, up to 2 KB in length. To copy
@@ -1409,6 +1409,46 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     } TransferOptions;
   };
 
+  /**
+   * @brief Optional parameters for
+   * #Azure::Storage::Files::Shares::ShareFileClient::DownloadChangesTo.
+   */
+  struct DownloadFileChangesToOptions final
+  {
+    /**
+     * Determines whether the changed ranges of a file that has been renamed or moved since the
+     * previous snapshot should be downloaded. If the value is false, the operation fails for such
+     * a file.
+     */
+    Azure::Nullable<bool> IncludeRenames;
+
+    /**
+     * The operation will only succeed if the access condition is met.
+     */
+    LeaseAccessConditions AccessConditions;
+
+    /**
+     * @brief Optional. Configures whether to do content validation for file downloads.
+     */
+    Azure::Nullable<TransferValidationOptions> ValidationOptions;
+
+    /**
+     * @brief Options for parallel transfer.
+     */
+    struct
+    {
+      /**
+       * The maximum number of bytes in a single request.
+       */
+      int64_t ChunkSize = 4 * 1024 * 1024;
+
+      /**
+       * The maximum number of threads that may be used in a parallel transfer.
+       */
+      int32_t Concurrency = (std::min)(96, (std::max)(8, _internal::GetHardwareConcurrency()));
+    } TransferOptions;
+  };
+
   /**
    * @brief Optional parameters for #Azure::Storage::Files::Shares::ShareFileClient::UploadFrom.
    */
@@ -1478,6 +1518,39 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     } TransferOptions;
   };
 
+  /**
+   * @brief Optional parameters for
+   * #Azure::Storage::Files::Shares::ShareFileClient::UploadChangesFrom.
+   */
+  struct UploadFileChangesFromOptions final
+  {
+    /**
+     * The operation will only succeed if the access condition is met.
+     */
+    LeaseAccessConditions AccessConditions;
+
+    /**
+     * @brief Optional. Configures whether to do content validation for file uploads.
+     */
+    Azure::Nullable<TransferValidationOptions> ValidationOptions;
+
+    /**
+     * @brief Options for parallel transfer.
+     */
+    struct
+    {
+      /**
+       * The size of the chunks compared and uploaded. This value cannot be larger than 4 MiB.
+       */
+      int64_t ChunkSize = 4 * 1024 * 1024;
+
+      /**
+       * The maximum number of threads that may be used in a parallel transfer.
+       */
+      int32_t Concurrency = (std::min)(96, (std::max)(8, _internal::GetHardwareConcurrency()));
+    } TransferOptions;
+  };
+
   /**
    * @brief Optional parameters for #Azure::Storage::Files::Shares::ShareLeaseClient::Acquire.
    */
@@ -196,6 +196,32 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
       DownloadFileDetails Details;
     };
 
+    /**
+     * @brief The information returned when downloading the changes of a file to a destination.
+     */
+    struct DownloadFileChangesToResult final
+    {
+      /**
+       * The ETag contains a value which represents the version of the file, in quotes.
+       */
+      Azure::ETag ETag;
+
+      /**
+       * The date/time that the file was last modified.
+       */
+      DateTime LastModified;
+
+      /**
+       * The size of the file.
+       */
+      int64_t FileSize = 0;
+
+      /**
+       * Number of bytes downloaded, which excludes the ranges that did not change.
+       */
+      int64_t TransferredSize = 0;
+    };
+
     /**
      * @brief The information returned when forcing a file handle to close.
      */
@@ -214,6 +240,22 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
       bool IsServerEncrypted = false;
     };
 
+    /**
+     * @brief The information returned when uploading the changes of a file from a source.
+     */
+    struct UploadFileChangesFromResult final
+    {
+      /**
+       * The size of the file.
+       */
+      int64_t FileSize = 0;
+
+      /**
+       * Number of bytes uploaded, which excludes the chunks that did not change or were cleared.
+       */
+      int64_t TransferredSize = 0;
+    };
+
     /**
      * @brief Response type for #Azure::Storage::Files::Shares::ShareLeaseClient::Acquire.
      */
@@ -7,6 +7,7 @@
 #include "azure/storage/files/shares/share_responses.hpp"
 #include "private/package_version.hpp"
 
+#include <azure/core/azure_assert.hpp>
 #include <azure/core/credentials/credentials.hpp>
 #include <azure/core/http/policies/policy.hpp>
 #include <azure/core/internal/io/null_body_stream.hpp>
@@ -1407,6 +1408,70 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     return ret;
   }
 
+  Azure::Response<Models::DownloadFileChangesToResult> ShareFileClient::DownloadChangesTo(
+      const std::string& fileName,
+      std::string previousShareSnapshot,
+      const DownloadFileChangesToOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    AZURE_ASSERT_MSG(options.TransferOptions.ChunkSize > 0, "ChunkSize must be positive.");
+
+    Models::DownloadFileChangesToResult result;
+    std::unique_ptr<Azure::Core::Http::RawResponse> rawResponse;
+    std::vector<Core::Http::HttpRange> ranges;
+    std::vector<Core::Http::HttpRange> clearRanges;
+
+    GetFileRangeListOptions getRangeListOptions;
+    getRangeListOptions.AccessConditions = options.AccessConditions;
+    getRangeListOptions.IncludeRenames = options.IncludeRenames;
+    for (auto page = GetAllRangeListDiff(
+             std::move(previousShareSnapshot), getRangeListOptions, context);
+         page.HasPage();
+         page.MoveToNextPage(context))
+    {
+      if (!rawResponse)
+      {
+        result.ETag = page.ETag;
+        result.LastModified = page.LastModified;
+        result.FileSize = page.FileSize;
+        rawResponse = std::move(page.RawResponse);
+      }
+      else if (page.ETag != result.ETag)
+      {
+        throw Azure::Core::RequestFailedException(
+            "File was modified in the middle of download.");
+      }
+      ranges.insert(ranges.end(), page.Ranges.begin(), page.Ranges.end());
+      clearRanges.insert(clearRanges.end(), page.ClearRanges.begin(), page.ClearRanges.end());
+    }
+
+    _internal::FileWriter fileWriter(fileName, false);
+    result.TransferredSize = _internal::DownloadRangesTo(
+        fileWriter,
+        result.FileSize,
+        ranges,
+        clearRanges,
+        options.TransferOptions.ChunkSize,
+        options.TransferOptions.Concurrency,
+        [&](const Core::Http::HttpRange& chunkRange) {
+          DownloadFileOptions chunkOptions;
+          chunkOptions.Range = chunkRange;
+          chunkOptions.AccessConditions = options.AccessConditions;
+          chunkOptions.ValidationOptions = options.ValidationOptions;
+          auto chunk = Download(chunkOptions, context);
+          if (chunk.Value.Details.ETag != result.ETag)
+          {
+            throw Azure::Core::RequestFailedException(
+                "File was modified in the middle of download.");
+          }
+          return std::move(chunk.Value.BodyStream);
+        },
+        context);
+
+    return Azure::Response<Models::DownloadFileChangesToResult>(
+        std::move(result), std::move(rawResponse));
+  }
+
   Azure::Response<Models::UploadFileFromResult> ShareFileClient::UploadFrom(
       const uint8_t* buffer,
       size_t bufferSize,
@@ -1636,6 +1701,104 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
         std::move(result), std::move(createResult.RawResponse));
   }
 
+  Azure::Response<Models::UploadFileChangesFromResult> ShareFileClient::UploadChangesFrom(
+      const std::string& fileName,
+      const std::string& previousFileName,
+      const UploadFileChangesFromOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    AZURE_ASSERT_MSG(options.TransferOptions.ChunkSize > 0, "ChunkSize must be positive.");
+    AZURE_ASSERT_MSG(
+        options.TransferOptions.ChunkSize <= 4 * 1024 * 1024, "ChunkSize cannot exceed 4 MiB.");
+
+    _internal::FileReader fileReader(fileName);
+    _internal::FileReader previousFileReader(previousFileName);
+    const int64_t fileSize = fileReader.GetFileSize();
+    const int64_t previousFileSize = previousFileReader.GetFileSize();
+
+    GetFilePropertiesOptions getPropertiesOptions;
+    getPropertiesOptions.AccessConditions = options.AccessConditions;
+    auto properties = GetProperties(getPropertiesOptions, context);
+    if (properties.Value.FileSize != previousFileSize)
+    {
+      throw Azure::Core::RequestFailedException(
+          "File does not hold the content of the previous file.");
+    }
+
+    // The bytes added by growing the file are zero, so that they are compared with zeros.
+    if (fileSize != previousFileSize)
+    {
+      SetFilePropertiesOptions setPropertiesOptions;
+      setPropertiesOptions.Size = fileSize;
+      setPropertiesOptions.AccessConditions = options.AccessConditions;
+      SetProperties(
+          properties.Value.HttpHeaders,
+          properties.Value.SmbProperties,
+          setPropertiesOptions,
+          context);
+    }
+
+    auto readChunk = [&](_internal::FileReader& reader,
+                         int64_t offset,
+                         int64_t length,
+                         std::vector<uint8_t>& buffer) {
+      Azure::Core::IO::_internal::RandomAccessFileBodyStream contentStream(
+          reader.GetHandle(), offset, length);
+      if (contentStream.ReadToCount(buffer.data(), static_cast<size_t>(length), context)
+          != static_cast<size_t>(length))
+      {
+        throw std::runtime_error("Error when reading file.");
+      }
+    };
+
+    std::atomic<int64_t> transferredSize{0};
+    auto uploadChangedChunkFunc
+        = [&](int64_t offset, int64_t length, int64_t chunkId, int64_t numChunks) {
+            (void)chunkId;
+            (void)numChunks;
+            std::vector<uint8_t> chunk(static_cast<size_t>(length));
+            readChunk(fileReader, offset, length, chunk);
+            std::vector<uint8_t> previousChunk(static_cast<size_t>(length));
+            const int64_t previousLength
+                = (std::max)(int64_t(0), (std::min)(length, previousFileSize - offset));
+            readChunk(previousFileReader, offset, previousLength, previousChunk);
+            if (chunk == previousChunk)
+            {
+              return;
+            }
+
+            if (std::all_of(chunk.begin(), chunk.end(), [](uint8_t b) { return b == 0; }))
+            {
+              ClearFileRangeOptions clearRangeOptions;
+              clearRangeOptions.AccessConditions = options.AccessConditions;
+              ClearRange(offset, length, clearRangeOptions, context);
+              return;
+            }
+            Azure::Core::IO::MemoryBodyStream contentStream(chunk);
+            UploadFileRangeOptions uploadRangeOptions;
+            uploadRangeOptions.AccessConditions = options.AccessConditions;
+            uploadRangeOptions.ValidationOptions = options.ValidationOptions;
+            UploadRange(offset, contentStream, uploadRangeOptions, context);
+            transferredSize += length;
+          };
+
+    if (fileSize > 0)
+    {
+      _internal::ConcurrentTransfer(
+          0,
+          fileSize,
+          options.TransferOptions.ChunkSize,
+          options.TransferOptions.Concurrency,
+          uploadChangedChunkFunc);
+    }
+
+    Models::UploadFileChangesFromResult result;
+    result.FileSize = fileSize;
+    result.TransferredSize = transferredSize;
+    return Azure::Response<Models::UploadFileChangesFromResult>(
+        std::move(result), std::move(properties.RawResponse));
+  }
+
   Azure::Response<Models::UploadFileRangeFromUriResult> ShareFileClient::UploadRangeFromUri(
       int64_t destinationOffset,
       const std::string& sourceUri,
@@ -1334,6 +1334,72 @@ namespace Azure { namespace Storage { namespace Test {
     EXPECT_EQ(1536, result.ClearRanges[1].Length.Value());
   }
 
+  TEST_F(FileShareFileClientTest, DownloadChangesTo_LIVEONLY_)
+  {
+    std::vector<uint8_t> fileContent = RandomBuffer(static_cast<size_t>(64_KB));
+    auto fileClient = m_shareClient->GetRootDirectoryClient().GetFileClient(RandomString());
+    fileClient.UploadFrom(fileContent.data(), fileContent.size());
+    auto snapshot = m_shareClient->CreateSnapshot().Value.Snapshot;
+    const std::string tempFilename = "file" + RandomString();
+    fileClient.WithShareSnapshot(snapshot).DownloadTo(tempFilename);
+
+    // Write, clear and shrink the file after the snapshot.
+    auto changedContent = RandomBuffer(static_cast<size_t>(4_KB));
+    auto changedStream = Core::IO::MemoryBodyStream(changedContent);
+    fileClient.UploadRange(8_KB, changedStream);
+    fileClient.ClearRange(16_KB, 8_KB);
+    Files::Shares::SetFilePropertiesOptions setPropertiesOptions;
+    setPropertiesOptions.Size = 48_KB;
+    fileClient.SetProperties(
+        Files::Shares::Models::FileHttpHeaders(),
+        Files::Shares::Models::FileSmbProperties(),
+        setPropertiesOptions);
+    std::copy(changedContent.begin(), changedContent.end(), fileContent.begin() + 8_KB);
+    std::fill(fileContent.begin() + 16_KB, fileContent.begin() + 24_KB, uint8_t(0));
+    fileContent.resize(static_cast<size_t>(48_KB));
+    auto snapshot2 = m_shareClient->CreateSnapshot().Value.Snapshot;
+
+    Files::Shares::DownloadFileChangesToOptions options;
+    options.TransferOptions.ChunkSize = 1_KB;
+    options.TransferOptions.Concurrency = 4;
+    auto result = fileClient.WithShareSnapshot(snapshot2).DownloadChangesTo(
+        tempFilename, snapshot, options);
+    EXPECT_EQ(result.Value.FileSize, static_cast<int64_t>(48_KB));
+    EXPECT_LT(result.Value.TransferredSize, static_cast<int64_t>(48_KB));
+    EXPECT_TRUE(result.Value.ETag.HasValue());
+    EXPECT_EQ(ReadFile(tempFilename), fileContent);
+    DeleteFile(tempFilename);
+  }
+
+  TEST_F(FileShareFileClientTest, UploadChangesFrom_LIVEONLY_)
+  {
+    std::vector<uint8_t> fileContent = RandomBuffer(static_cast<size_t>(64_KB));
+    auto fileClient = m_shareClient->GetRootDirectoryClient().GetFileClient(RandomString());
+    fileClient.UploadFrom(fileContent.data(), fileContent.size());
+    const std::string previousFilename = "file" + RandomString();
+    WriteFile(previousFilename, fileContent);
+
+    // Write, clear and grow the local file.
+    auto changedContent = RandomBuffer(static_cast<size_t>(4_KB));
+    std::copy(changedContent.begin(), changedContent.end(), fileContent.begin() + 8_KB);
+    std::fill(fileContent.begin() + 16_KB, fileContent.begin() + 24_KB, uint8_t(0));
+    auto appendedContent = RandomBuffer(static_cast<size_t>(4_KB));
+    fileContent.insert(fileContent.end(), appendedContent.begin(), appendedContent.end());
+    const std::string tempFilename = "file" + RandomString();
+    WriteFile(tempFilename, fileContent);
+
+    Files::Shares::UploadFileChangesFromOptions options;
+    options.TransferOptions.ChunkSize = 1_KB;
+    options.TransferOptions.Concurrency = 4;
+    auto result = fileClient.UploadChangesFrom(tempFilename, previousFilename, options);
+    EXPECT_EQ(result.Value.FileSize, static_cast<int64_t>(68_KB));
+    EXPECT_EQ(result.Value.TransferredSize, static_cast<int64_t>(8_KB));
+    auto downloadResult = fileClient.Download();
+    EXPECT_EQ(downloadResult.Value.BodyStream->ReadToEnd(), fileContent);
+    DeleteFile(previousFilename);
+    DeleteFile(tempFilename);
+  }
+
   TEST_F(FileShareFileClientTest, StorageExceptionAdditionalInfo)
   {
     auto options = InitStorageClientOptions<Azure::Storage::Files::Shares::ShareClientOptions>();
@@ -14,6 +14,7 @@
 #include <azure/core/credentials/credentials.hpp>
 #include <azure/storage/common/storage_credential.hpp>
 
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -245,6 +246,31 @@ namespace Azure { namespace Storage { namespace Queues {
         const ClearMessagesOptions& options = ClearMessagesOptions(),
         const Azure::Core::Context& context = Azure::Core::Context()) const;
 
+    /**
+     * @brief Receives messages from the queue and passes each of them to a handler. Messages are
+     * prefetched with concurrent receive requests, handled concurrently, and deleted once their
+     * handler returns. The visibility of the messages is renewed until they are deleted, so
+     * handlers can take longer than the visibility timeout. A message whose handler throws is not
+     * deleted, and becomes visible again when its visibility timeout expires. The exception is
+     * logged as a warning and passed to ProcessMessagesOptions::ErrorHandler.
+     *
+     * When the context is cancelled, no more messages are received or dispatched, the running
+     * handlers are waited for and their messages are deleted, the prefetched messages are made
+     * visible again, and then Azure::Core::OperationCancelledException is thrown. Deletes and
+     * visibility renewals aren't cancelled by the context.
+     *
+     * @param handler The function called for each message. It's called concurrently from multiple
+     * threads, and receives the context of this function.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A ProcessMessagesResult describing the processed messages.
+     */
+    Models::ProcessMessagesResult ProcessMessages(
+        const std::function<void(const Models::QueueMessage&, const Azure::Core::Context&)>&
+            handler,
+        const ProcessMessagesOptions& options = ProcessMessagesOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
   private:
     explicit QueueClient(
         Azure::Core::Url queueUrl,
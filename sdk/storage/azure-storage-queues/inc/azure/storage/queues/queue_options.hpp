@@ -15,6 +15,8 @@
 #include <azure/storage/common/storage_common.hpp>
 
 #include <chrono>
+#include <exception>
+#include <functional>
 #include <string>
 
 namespace Azure { namespace Storage { namespace Queues {
@@ -335,4 +337,54 @@ namespace Azure { namespace Storage { namespace Queues {
   {
   };
 
+  /**
+   * Optional parameters for #Azure::Storage::Queues::QueueClient::ProcessMessages.
+   */
+  struct ProcessMessagesOptions final
+  {
+    /**
+     * The maximum number of messages handled concurrently.
+     */
+    int32_t Concurrency = 16;
+
+    /**
+     * The maximum number of received messages waiting for a free handler. Messages are received
+     * ahead of time so that handlers don't wait for a round-trip.
+     */
+    int32_t PrefetchCount = 32;
+
+    /**
+     * The maximum number of concurrent receive requests.
+     */
+    int32_t ReceiveConcurrency = 2;
+
+    /**
+     * The maximum number of concurrent delete requests.
+     */
+    int32_t DeleteConcurrency = 4;
+
+    /**
+     * The visibility timeout of the received messages. The visibility of a message is renewed
+     * every half of this interval until the message is deleted.
+     */
+    std::chrono::seconds VisibilityTimeout{30};
+
+    /**
+     * The maximum interval between receive requests while the queue is empty.
+     */
+    std::chrono::milliseconds MaxPollingInterval{10000};
+
+    /**
+     * If true, the function returns once the queue is found empty and all received messages are
+     * processed. Otherwise, it runs until the context is cancelled.
+     */
+    bool StopWhenEmpty = false;
+
+    /**
+     * Called with the message and the exception when a handler throws. Calls are concurrent. An
+     * exception thrown by this function is ignored.
+     */
+    std::function<void(const Models::QueueMessage&, std::exception_ptr)> ErrorHandler;
+  };
+
 }}} // namespace Azure::Storage::Queues
@@ -44,6 +44,23 @@ namespace Azure { namespace Storage { namespace Queues {
        */
       std::int64_t ApproximateMessageCountLong = std::int64_t();
     };
+
+    /**
+     * @brief Response type for #Azure::Storage::Queues::QueueClient::ProcessMessages.
+     */
+    struct ProcessMessagesResult final
+    {
+      /**
+       * The number of messages that were handled and deleted.
+       */
+      std::int64_t SucceededCount = 0;
+      /**
+       * The number of messages whose handler threw, or that were received by another client before
+       * they could be deleted. These messages become visible again when their visibility timeout
+       * expires.
+       */
+      std::int64_t FailedCount = 0;
+    };
   } // namespace Models
 
   /**
@@ -0,0 +1,544 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/storage/queues/queue_client.hpp"
+
+#include <azure/core/azure_assert.hpp>
+#include <azure/core/internal/diagnostics/log.hpp>
+#include <azure/storage/common/storage_exception.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace Queues {
+
+  namespace {
+    constexpr int32_t MaxMessagesPerReceive = 32;
+    constexpr std::chrono::milliseconds MinPollingInterval{100};
+    // How often the cancellation of the context is checked while nothing else happens.
+    constexpr std::chrono::milliseconds CancellationCheckInterval{100};
+
+    bool IsMessageLost(const StorageException& e)
+    {
+      // The pop receipt is invalidated when the message is received by another client after its
+      // visibility timeout expired, or when the message is gone.
+      return e.StatusCode == Core::Http::HttpStatusCode::NotFound
+          || e.ErrorCode == "PopReceiptMismatch";
+    }
+
+    std::string GetExceptionMessage(std::exception_ptr exception)
+    {
+      try
+      {
+        std::rethrow_exception(exception);
+      }
+      catch (const std::exception& e)
+      {
+        return e.what();
+      }
+      catch (...)
+      {
+        return "unknown exception";
+      }
+    }
+
+    class MessageProcessor final {
+    public:
+      MessageProcessor(
+          const QueueClient& queueClient,
+          const std::function<void(const Models::QueueMessage&, const Azure::Core::Context&)>&
+              handler,
+          const ProcessMessagesOptions& options,
+          const Azure::Core::Context& context)
+          : m_queueClient(queueClient), m_handler(handler), m_options(options), m_context(context)
+      {
+      }
+
+      Models::ProcessMessagesResult Run()
+      {
+        std::vector<std::future<void>> workers;
+        for (int32_t i = 0; i < m_options.ReceiveConcurrency; ++i)
+        {
+          workers.push_back(std::async(std::launch::async, [this]() { Receive(); }));
+        }
+        for (int32_t i = 0; i < m_options.Concurrency; ++i)
+        {
+          workers.push_back(std::async(std::launch::async, [this]() { Handle(); }));
+        }
+        for (int32_t i = 0; i < m_options.DeleteConcurrency; ++i)
+        {
+          workers.push_back(std::async(std::launch::async, [this]() { Delete(); }));
+        }
+        Renew();
+        for (auto& worker : workers)
+        {
+          worker.get();
+        }
+
+        if (m_exception)
+        {
+          std::rethrow_exception(m_exception);
+        }
+        m_context.ThrowIfCancelled();
+        return m_result;
+      }
+
+    private:
+      enum class MessageState
+      {
+        Buffered,
+        Handling,
+        Completed,
+        Deleting,
+        Releasing,
+        Abandoned,
+      };
+
+      struct InFlightMessage final
+      {
+        Models::QueueMessage Message;
+        MessageState State = MessageState::Buffered;
+        std::chrono::steady_clock::time_point RenewAt;
+        bool Renewing = false;
+        bool Lost = false;
+      };
+
+      using MessageIterator = std::list<InFlightMessage>::iterator;
+
+      std::chrono::milliseconds RenewalInterval() const
+      {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(m_options.VisibilityTimeout)
+            / 2;
+      }
+
+      // Called without the mutex held.
+      void OnHandlerFailed(const Models::QueueMessage& message, std::exception_ptr exception)
+      {
+        using Azure::Core::Diagnostics::Logger;
+        using Azure::Core::Diagnostics::_internal::Log;
+        if (Log::ShouldWrite(Logger::Level::Warning))
+        {
+          Log::Write(
+              Logger::Level::Warning,
+              "Handler of queue message " + message.MessageId
+                  + " failed: " + GetExceptionMessage(exception));
+        }
+        if (m_options.ErrorHandler)
+        {
+          try
+          {
+            m_options.ErrorHandler(message, exception);
+          }
+          catch (...)
+          {
+          }
+        }
+      }
+
+      // The functions below are called with the mutex held, unless stated otherwise.
+
+      void Stop()
+      {
+        m_stopping = true;
+        m_stateChanged.notify_all();
+      }
+
+      void Fail(std::exception_ptr exception)
+      {
+        if (!m_exception)
+        {
+          m_exception = exception;
+        }
+        Stop();
+      }
+
+      void Remove(MessageIterator message)
+      {
+        // A message being renewed is removed by the renewal once it's done.
+        if (message->Renewing)
+        {
+          message->State = MessageState::Abandoned;
+        }
+        else
+        {
+          m_messages.erase(message);
+        }
+      }
+
+      static bool TakeFirstIdle(std::deque<MessageIterator>& messages, MessageIterator& message)
+      {
+        auto ite = std::find_if(messages.begin(), messages.end(), [](const MessageIterator& m) {
+          return !m->Renewing;
+        });
+        if (ite == messages.end())
+        {
+          return false;
+        }
+        message = *ite;
+        messages.erase(ite);
+        return true;
+      }
+
+      // Called without the mutex held.
+      void Receive()
+      {
+        auto pollingInterval = (std::min)(
+            std::chrono::milliseconds(MinPollingInterval), m_options.MaxPollingInterval);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+          m_stateChanged.wait(lock, [this]() {
+            return m_stopping
+                || static_cast<int32_t>(m_buffered.size()) + m_requestedCount
+                < m_options.PrefetchCount;
+          });
+          if (m_stopping)
+          {
+            return;
+          }
+          const int32_t count = (std::min)(
+              MaxMessagesPerReceive,
+              m_options.PrefetchCount - static_cast<int32_t>(m_buffered.size())
+                  - m_requestedCount);
+          m_requestedCount += count;
+          lock.unlock();
+
+          std::vector<Models::QueueMessage> messages;
+          std::exception_ptr exception;
+          try
+          {
+            ReceiveMessagesOptions receiveOptions;
+            receiveOptions.MaxMessages = count;
+            receiveOptions.VisibilityTimeout = m_options.VisibilityTimeout;
+            messages = m_queueClient.ReceiveMessages(receiveOptions, m_context).Value.Messages;
+          }
+          catch (...)
+          {
+            exception = std::current_exception();
+          }
+
+          lock.lock();
+          m_requestedCount -= count;
+          if (exception)
+          {
+            if (m_context.IsCancelled())
+            {
+              Stop();
+            }
+            else
+            {
+              Fail(exception);
+            }
+            return;
+          }
+
+          // The messages are prefetched even if processing is stopping, so that they are released.
+          const auto renewAt = std::chrono::steady_clock::now() + RenewalInterval();
+          for (auto& message : messages)
+          {
+            InFlightMessage inFlightMessage;
+            inFlightMessage.Message = std::move(message);
+            inFlightMessage.RenewAt = renewAt;
+            m_messages.push_back(std::move(inFlightMessage));
+            m_buffered.push_back(std::prev(m_messages.end()));
+          }
+          m_stateChanged.notify_all();
+          if (!messages.empty())
+          {
+            pollingInterval = (std::min)(
+                std::chrono::milliseconds(MinPollingInterval), m_options.MaxPollingInterval);
+            continue;
+          }
+
+          if (m_options.StopWhenEmpty && m_messages.empty() && m_requestedCount == 0)
+          {
+            Stop();
+            return;
+          }
+          // When stopping on an empty queue, it's checked again as soon as all messages are done.
+          const auto messageCount = m_messages.size();
+          m_stateChanged.wait_for(lock, pollingInterval, [&]() {
+            return m_stopping
+                || (m_options.StopWhenEmpty && messageCount != 0 && m_messages.empty());
+          });
+          pollingInterval = (std::min)(pollingInterval * 2, m_options.MaxPollingInterval);
+        }
+      }
+
+      // Called without the mutex held.
+      void Handle()
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+          m_stateChanged.wait(lock, [this]() { return m_stopping || !m_buffered.empty(); });
+          if (m_stopping)
+          {
+            return;
+          }
+          auto message = m_buffered.front();
+          m_buffered.pop_front();
+          message->State = MessageState::Handling;
+          ++m_handlingCount;
+          // Renewals update the pop receipt, so the handler gets a copy.
+          const auto queueMessage = message->Message;
+          m_stateChanged.notify_all();
+          lock.unlock();
+
+          bool succeeded = false;
+          try
+          {
+            m_handler(queueMessage, m_context);
+            succeeded = true;
+          }
+          catch (...)
+          {
+            OnHandlerFailed(queueMessage, std::current_exception());
+          }
+
+          lock.lock();
+          --m_handlingCount;
+          if (succeeded && !message->Lost)
+          {
+            message->State = MessageState::Completed;
+            m_completed.push_back(message);
+          }
+          else
+          {
+            ++m_result.FailedCount;
+            Remove(message);
+          }
+          m_stateChanged.notify_all();
+        }
+      }
+
+      // Called without the mutex held.
+      void Delete()
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+          MessageIterator message;
+          bool taken = false;
+          bool release = false;
+          m_stateChanged.wait(lock, [&]() {
+            if (m_exception)
+            {
+              return true;
+            }
+            if (TakeFirstIdle(m_completed, message))
+            {
+              taken = true;
+              return true;
+            }
+            // Once stopping, the prefetched messages are made visible again.
+            if (m_stopping && TakeFirstIdle(m_buffered, message))
+            {
+              taken = release = true;
+              return true;
+            }
+            return m_stopping && m_handlingCount == 0 && m_requestedCount == 0
+                && m_completed.empty() && m_buffered.empty();
+          });
+          if (!taken)
+          {
+            return;
+          }
+          message->State = release ? MessageState::Releasing : MessageState::Deleting;
+          const auto messageId = message->Message.MessageId;
+          const auto popReceipt = message->Message.PopReceipt;
+          lock.unlock();
+
+          // Deletes aren't cancelled by the context, so that handled messages aren't processed
+          // again.
+          std::exception_ptr exception;
+          bool lost = false;
+          try
+          {
+            if (release)
+            {
+              m_queueClient.UpdateMessage(messageId, popReceipt, std::chrono::seconds(0));
+            }
+            else
+            {
+              m_queueClient.DeleteMessage(messageId, popReceipt);
+            }
+          }
+          catch (StorageException& e)
+          {
+            lost = IsMessageLost(e);
+            if (!lost)
+            {
+              exception = std::current_exception();
+            }
+          }
+          catch (...)
+          {
+            exception = std::current_exception();
+          }
+
+          lock.lock();
+          if (exception)
+          {
+            Fail(exception);
+          }
+          else if (!release)
+          {
+            ++(lost ? m_result.FailedCount : m_result.SucceededCount);
+          }
+          m_messages.erase(message);
+          m_stateChanged.notify_all();
+        }
+      }
+
+      // Runs on the calling thread, and also stops processing when the context is cancelled.
+      void Renew()
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+          if (!m_stopping && m_context.IsCancelled())
+          {
+            Stop();
+          }
+          if (m_stopping && m_handlingCount == 0 && (m_exception || m_messages.empty()))
+          {
+            return;
+          }
+
+          const auto now = std::chrono::steady_clock::now();
+          auto wakeUpAt = now + CancellationCheckInterval;
+          auto message = m_messages.end();
+          for (auto ite = m_messages.begin(); ite != m_messages.end(); ++ite)
+          {
+            if (ite->Renewing || ite->Lost
+                || (ite->State != MessageState::Buffered && ite->State != MessageState::Handling
+                    && ite->State != MessageState::Completed))
+            {
+              continue;
+            }
+            if (ite->RenewAt <= now)
+            {
+              message = ite;
+              break;
+            }
+            wakeUpAt = (std::min)(wakeUpAt, ite->RenewAt);
+          }
+          if (message == m_messages.end())
+          {
+            m_stateChanged.wait_until(lock, wakeUpAt);
+            continue;
+          }
+
+          message->Renewing = true;
+          const auto messageId = message->Message.MessageId;
+          const auto popReceipt = message->Message.PopReceipt;
+          lock.unlock();
+
+          // Renewals aren't cancelled by the context, so that the running handlers keep their
+          // messages.
+          std::exception_ptr exception;
+          bool lost = false;
+          Models::UpdateMessageResult result;
+          try
+          {
+            result = m_queueClient
+                         .UpdateMessage(messageId, popReceipt, m_options.VisibilityTimeout)
+                         .Value;
+          }
+          catch (StorageException& e)
+          {
+            lost = IsMessageLost(e);
+            if (!lost)
+            {
+              exception = std::current_exception();
+            }
+          }
+          catch (...)
+          {
+            exception = std::current_exception();
+          }
+
+          lock.lock();
+          message->Renewing = false;
+          if (exception)
+          {
+            Fail(exception);
+          }
+          else if (!lost)
+          {
+            message->Message.PopReceipt = std::move(result.PopReceipt);
+            message->Message.NextVisibleOn = result.NextVisibleOn;
+            message->RenewAt = std::chrono::steady_clock::now() + RenewalInterval();
+          }
+          else
+          {
+            message->Lost = true;
+          }
+
+          if (message->State == MessageState::Abandoned)
+          {
+            m_messages.erase(message);
+          }
+          else if (message->Lost && message->State == MessageState::Buffered)
+          {
+            m_buffered.erase(std::find(m_buffered.begin(), m_buffered.end(), message));
+            m_messages.erase(message);
+          }
+          else if (message->Lost && message->State == MessageState::Completed)
+          {
+            m_completed.erase(std::find(m_completed.begin(), m_completed.end(), message));
+            ++m_result.FailedCount;
+            m_messages.erase(message);
+          }
+          m_stateChanged.notify_all();
+        }
+      }
+
+      const QueueClient& m_queueClient;
+      const std::function<void(const Models::QueueMessage&, const Azure::Core::Context&)>&
+          m_handler;
+      const ProcessMessagesOptions& m_options;
+      const Azure::Core::Context& m_context;
+
+      std::mutex m_mutex;
+      std::condition_variable m_stateChanged;
+      std::list<InFlightMessage> m_messages;
+      std::deque<MessageIterator> m_buffered;
+      std::deque<MessageIterator> m_completed;
+      int32_t m_requestedCount = 0;
+      int32_t m_handlingCount = 0;
+      bool m_stopping = false;
+      std::exception_ptr m_exception;
+      Models::ProcessMessagesResult m_result;
+    };
+  } // namespace
+
+  Models::ProcessMessagesResult QueueClient::ProcessMessages(
+      const std::function<void(const Models::QueueMessage&, const Azure::Core::Context&)>& handler,
+      const ProcessMessagesOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    AZURE_ASSERT_MSG(options.Concurrency > 0, "Concurrency must be greater than 0.");
+    AZURE_ASSERT_MSG(options.PrefetchCount > 0, "Prefetch count must be greater than 0.");
+    AZURE_ASSERT_MSG(
+        options.ReceiveConcurrency > 0, "Receive concurrency must be greater than 0.");
+    AZURE_ASSERT_MSG(options.DeleteConcurrency > 0, "Delete concurrency must be greater than 0.");
+    AZURE_ASSERT_MSG(
+        options.VisibilityTimeout.count() > 0, "Visibility timeout must be greater than 0.");
+    AZURE_ASSERT_MSG(
+        options.MaxPollingInterval.count() > 0, "Polling interval must be greater than 0.");
+
+    MessageProcessor processor(*this, handler, options, context);
+    return processor.Run();
+  }
+
+}}} // namespace Azure::Storage::Queues
@@ -4,7 +4,13 @@
 #include "queue_client_test.hpp"
 
 #include <chrono>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace Azure { namespace Storage { namespace Test {
 
@@ -242,4 +248,64 @@ namespace Azure { namespace Storage { namespace Test {
     EXPECT_EQ(peekedMessage.MessageText, message);
   }
 
+  TEST_F(QueueClientTest, ProcessMessages_LIVEONLY_)
+  {
+    auto queueClient = *m_queueClient;
+
+    const size_t numMessages = 50;
+    for (size_t i = 0; i < numMessages; ++i)
+    {
+      queueClient.EnqueueMessage("message " + std::to_string(i));
+    }
+
+    std::mutex mutex;
+    std::map<std::string, int> handledMessages;
+    Queues::ProcessMessagesOptions options;
+    options.Concurrency = 8;
+    options.PrefetchCount = 16;
+    options.VisibilityTimeout = std::chrono::seconds(2);
+    options.StopWhenEmpty = true;
+    auto result = queueClient.ProcessMessages(
+        [&](const Queues::Models::QueueMessage& message, const Azure::Core::Context&) {
+          // Handling the first message takes longer than the visibility timeout, which is renewed.
+          if (message.MessageText == "message 0")
+          {
+            TestSleep(std::chrono::seconds(5));
+          }
+          std::lock_guard<std::mutex> guard(mutex);
+          ++handledMessages[message.MessageText];
+        },
+        options);
+    EXPECT_EQ(result.SucceededCount, static_cast<int64_t>(numMessages));
+    EXPECT_EQ(result.FailedCount, 0);
+    EXPECT_EQ(handledMessages.size(), numMessages);
+    for (const auto& p : handledMessages)
+    {
+      EXPECT_EQ(p.second, 1);
+    }
+    EXPECT_TRUE(queueClient.PeekMessages().Value.Messages.empty());
+
+    queueClient.EnqueueMessage("failed message");
+    std::vector<std::string> failedMessages;
+    options.ErrorHandler = [&](const Queues::Models::QueueMessage& message,
+                               std::exception_ptr exception) {
+      std::lock_guard<std::mutex> guard(mutex);
+      failedMessages.push_back(message.MessageText);
+      EXPECT_THROW(std::rethrow_exception(exception), std::runtime_error);
+    };
+    result = queueClient.ProcessMessages(
+        [](const Queues::Models::QueueMessage&, const Azure::Core::Context&) {
+          throw std::runtime_error("Failed to handle the message.");
+        },
+        options);
+    EXPECT_EQ(result.SucceededCount, 0);
+    EXPECT_EQ(result.FailedCount, 1);
+    ASSERT_EQ(failedMessages.size(), 1U);
+    EXPECT_EQ(failedMessages[0], "failed message");
+    TestSleep(std::chrono::seconds(3));
+    auto peekedMessages = queueClient.PeekMessages().Value.Messages;
+    ASSERT_EQ(peekedMessages.size(), 1U);
+    EXPECT_EQ(peekedMessages[0].MessageText, "failed message");
+  }
+
 }}} // namespace Azure::Storage::Test
@@ -628,6 +628,43 @@ namespace Azure { namespace Data { namespace Tables {
       Azure::Nullable<std::string> Filter;
     };
 
+    /**
+     * @brief Parallel Query Entities options.
+     *
+     */
+    struct ParallelQueryEntitiesOptions final
+    {
+      /**
+       * @brief The partition keys at which the key space is split into ranges which are queried
+       * in parallel, in ascending order. Each range starts at a split point, and ends before the
+       * next one.
+       *
+       */
+      std::vector<std::string> PartitionKeySplitPoints;
+      /**
+       * @brief The number of ranges to split the key space into when no split points are given.
+       * The split points are then chosen among partition keys sampled from the table, with at
+       * most 256 single-entity queries.
+       *
+       */
+      int32_t RangeCount = 16;
+      /**
+       * @brief The maximum number of ranges queried at the same time.
+       *
+       */
+      int32_t Concurrency = 5;
+      /**
+       * @brief The select query.
+       *
+       */
+      std::string SelectColumns;
+      /**
+       * @brief The filter expression, which is applied in addition to the range of each query.
+       *
+       */
+      Azure::Nullable<std::string> Filter;
+    };
+
     /**
      * @brief Query Entities result.
      *
@@ -724,5 +761,66 @@ namespace Azure { namespace Data { namespace Tables {
        */
       Azure::Nullable<TransactionError> Error;
     };
+
+    /**
+     * @brief Bulk operation options.
+     *
+     */
+    struct BulkOperationOptions final
+    {
+      /**
+       * @brief The maximum number of transactions submitted at the same time.
+       *
+       */
+      int32_t Concurrency = 5;
+
+      /**
+       * @brief The maximum number of steps held in partially filled transactions. When it is
+       * reached, the partially filled transactions are submitted.
+       *
+       */
+      int64_t MaxBufferedSteps = 100000;
+    };
+
+    /**
+     * @brief A step of a bulk operation which failed.
+     *
+     */
+    struct BulkOperationFailure final
+    {
+      /**
+       * The step which failed.
+       */
+      TransactionStep Step;
+      /**
+       * Status Code, empty when the transaction failed without a response, for instance because
+       * of a transport error.
+       */
+      std::string StatusCode;
+      /**
+       * Error.
+       */
+      TransactionError Error;
+    };
+
+    /**
+     * @brief Bulk operation result.
+     *
+     */
+    struct BulkOperationResult final
+    {
+      /**
+       * The number of steps which succeeded.
+       */
+      int64_t SucceededCount = 0;
+      /**
+       * The number of transactions which were submitted.
+       */
+      int64_t TransactionCount = 0;
+      /**
+       * The steps which failed.
+       */
+      std::vector<BulkOperationFailure> Failures;
+    };
   } // namespace Models
 }}} // namespace Azure::Data::Tables
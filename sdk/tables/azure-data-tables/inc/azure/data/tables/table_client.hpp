@@ -14,6 +14,7 @@
 #include <azure/core/response.hpp>
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -169,6 +170,24 @@ namespace Azure { namespace Data { namespace Tables {
         Models::QueryEntitiesOptions const& options = {},
         Core::Context const& context = {}) const;
 
+    /**
+     * @brief Queries the entities of a table with a query per range of partition keys, running
+     * the queries in parallel.
+     *
+     * @details Sampling the partition keys takes a small query per printable character, and
+     * favors ranges with the same number of distinct key prefixes rather than the same number of
+     * entities. Split points should be given when the distribution of the keys is known.
+     *
+     * @param onEntities Called with the entities of each page of results. Calls are not
+     * concurrent, and the order of the pages of different ranges is not defined.
+     * @param options Optional parameters to execute this function.
+     * @param context for canceling long running operations.
+     */
+    void QueryEntitiesParallel(
+        std::function<void(std::vector<Models::TableEntity> const&)> const& onEntities,
+        Models::ParallelQueryEntitiesOptions const& options = {},
+        Core::Context const& context = {}) const;
+
     /**
      * @brief Queries a single entity in a table.
      *
@@ -193,6 +212,41 @@ namespace Azure { namespace Data { namespace Tables {
         std::vector<Models::TransactionStep> const& steps,
         Core::Context const& context = {}) const;
 
+    /**
+     * @brief Submits steps which may be for any number of partitions, as transactions of up to
+     * 100 steps and 4 MiB, submitted in parallel.
+     *
+     * @details Steps are grouped by partition key, in the order in which they are returned by
+     * \p getNextStep. A transaction is submitted as soon as it is full, so that the steps do not
+     * need to be held in memory at once. When a step fails, the other steps of its transaction
+     * are submitted again without it, and the failure is reported in the result. Steps for the
+     * same entity are placed in different transactions, which may be submitted in any order.
+     *
+     * @param getNextStep Sets its argument to the next step and returns `true`, or returns
+     * `false` when there are no more steps.
+     * @param options Optional parameters to execute this function.
+     * @param context for canceling long running operations.
+     * @return Bulk operation result.
+     */
+    Models::BulkOperationResult SubmitBulkOperation(
+        std::function<bool(Models::TransactionStep&)> const& getNextStep,
+        Models::BulkOperationOptions const& options = {},
+        Core::Context const& context = {}) const;
+
+    /**
+     * @brief Submits steps which may be for any number of partitions, as transactions of up to
+     * 100 steps and 4 MiB, submitted in parallel.
+     *
+     * @param steps The steps to execute.
+     * @param options Optional parameters to execute this function.
+     * @param context for canceling long running operations.
+     * @return Bulk operation result.
+     */
+    Models::BulkOperationResult SubmitBulkOperation(
+        std::vector<Models::TransactionStep> const& steps,
+        Models::BulkOperationOptions const& options = {},
+        Core::Context const& context = {}) const;
+
   private:
 #ifdef _azure_TABLES_TESTING_BUILD
     friend class Azure::Data::Tables::StressTest::TransactionStressTest;
@@ -218,6 +272,18 @@ namespace Azure { namespace Data { namespace Tables {
         std::string const& batchId,
         std::string const& changesetId,
         std::vector<Models::TransactionStep> const& steps) const;
+    std::vector<std::string> SamplePartitionKeySplitPoints(
+        int32_t rangeCount,
+        int32_t concurrency,
+        Core::Context const& context) const;
+    Azure::Nullable<std::string> GetFirstPartitionKey(
+        std::string const& lowerBound,
+        Core::Context const& context) const;
+    std::string PrepStep(std::string const& changesetId, Models::TransactionStep const& step) const;
+    Response<Models::SubmitTransactionResult> SubmitTransactionPayload(
+        std::string const& batchId,
+        std::string const& body,
+        Core::Context const& context) const;
     std::string PrepAddEntity(std::string const& changesetId, Models::TableEntity entity) const;
     std::string PrepDeleteEntity(std::string const& changesetId, Models::TableEntity entity) const;
     std::string PrepMergeEntity(std::string const& changesetId, Models::TableEntity entity) const;
@@ -10,8 +10,23 @@
 #include "private/serializers.hpp"
 #include "private/tables_constants.hpp"
 
+#include <azure/core/uuid.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <set>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
 
 using namespace Azure::Data::Tables;
 using namespace Azure::Data::Tables::_detail::Policies;
@@ -691,6 +706,7 @@ Models::QueryEntitiesPagedResponse TableClient::QueryEntities(
   }
 
   Models::QueryEntitiesPagedResponse response(std::make_shared<TableClient>(*this));
+  response.m_operationOptions = options;
   {
     const auto& responseBody = rawResponse->GetBody();
 
@@ -729,16 +745,280 @@ Models::QueryEntitiesPagedResponse TableClient::QueryEntities(
   return response;
 }
 
+namespace {
+std::string QuoteODataString(std::string const& value)
+{
+  std::string quoted = "'";
+  for (auto c : value)
+  {
+    quoted += c;
+    if (c == '\'')
+    {
+      quoted += c;
+    }
+  }
+  return quoted + "'";
+}
+
+// Calls `function` for each index below `count` on up to `concurrency` threads. The first
+// exception stops the calls which have not started yet, cancels the context passed to the calls
+// in progress, and is rethrown.
+void RunConcurrently(
+    size_t count,
+    int32_t concurrency,
+    Azure::Core::Context const& context,
+    std::function<void(size_t, Azure::Core::Context const&)> const& function)
+{
+  auto cancellableContext = context.WithDeadline((Azure::DateTime::max)());
+  std::atomic<size_t> nextIndex{0};
+  std::atomic<bool> failed{false};
+  std::exception_ptr error;
+  std::mutex errorMutex;
+
+  auto const run = [&]() {
+    for (auto index = nextIndex++; index < count && !failed; index = nextIndex++)
+    {
+      try
+      {
+        function(index, cancellableContext);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error)
+        {
+          error = std::current_exception();
+          cancellableContext.Cancel();
+        }
+        failed = true;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int32_t i = 1; i < concurrency && static_cast<size_t>(i) < count; ++i)
+  {
+    threads.emplace_back(run);
+  }
+  run();
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+}
+} // namespace
+
+Azure::Nullable<std::string> TableClient::GetFirstPartitionKey(
+    std::string const& lowerBound,
+    Core::Context const& context) const
+{
+  std::string nextPartitionKey;
+  std::string nextRowKey;
+  // The service may return an empty page with a continuation when the query times out.
+  do
+  {
+    auto url = m_url;
+    url.AppendPath(Azure::Core::Url::Encode(m_tableName) + "()");
+    url.AppendQueryParameter(
+        "$filter", Azure::Core::Url::Encode("PartitionKey ge " + QuoteODataString(lowerBound)));
+    url.AppendQueryParameter("$select", "PartitionKey");
+    url.AppendQueryParameter("$top", "1");
+    if (!nextPartitionKey.empty())
+    {
+      url.AppendQueryParameter("NextPartitionKey", Azure::Core::Url::Encode(nextPartitionKey));
+      url.AppendQueryParameter("NextRowKey", Azure::Core::Url::Encode(nextRowKey));
+    }
+
+    Core::Http::Request request(Core::Http::HttpMethod::Get, url);
+    request.SetHeader(AcceptHeader, AcceptFullMeta);
+    auto rawResponse = m_pipeline->Send(request, context);
+    if (rawResponse->GetStatusCode() != Core::Http::HttpStatusCode::Ok)
+    {
+      throw Core::RequestFailedException(rawResponse);
+    }
+
+    auto const& responseBody = rawResponse->GetBody();
+    auto const jsonRoot
+        = Core::Json::_internal::json::parse(responseBody.begin(), responseBody.end());
+    if (jsonRoot.contains(Value) && !jsonRoot[Value].empty())
+    {
+      return Serializers::DeserializeEntity(jsonRoot[Value][0]).GetPartitionKey().Value;
+    }
+
+    auto const& headers = rawResponse->GetHeaders();
+    auto const partitionKeyHeader = headers.find("x-ms-continuation-NextPartitionKey");
+    auto const rowKeyHeader = headers.find("x-ms-continuation-NextRowKey");
+    nextPartitionKey = partitionKeyHeader == headers.end() ? "" : partitionKeyHeader->second;
+    nextRowKey = rowKeyHeader == headers.end() ? "" : rowKeyHeader->second;
+  } while (!nextPartitionKey.empty());
+
+  return Azure::Nullable<std::string>();
+}
+
+std::vector<std::string> TableClient::SamplePartitionKeySplitPoints(
+    int32_t rangeCount,
+    int32_t concurrency,
+    Core::Context const& context) const
+{
+  // Probes for the first partition key at or after the prefix followed by printable characters,
+  // and probes again after the common prefix of the keys found, until there are enough distinct
+  // keys, the common prefix does not grow, or the probes allowed are used up. When a single key
+  // is found, its next character is added to the prefix.
+  constexpr size_t MaxProbeCount = 256;
+  std::vector<char> characters;
+  for (char c = ' '; c <= '~'; ++c)
+  {
+    // These characters are not allowed in keys.
+    if (c != '/' && c != '\\' && c != '#' && c != '?')
+    {
+      characters.push_back(c);
+    }
+  }
+
+  std::set<std::string> sampledKeys;
+  std::string prefix;
+  for (size_t probeCount = 0; probeCount < MaxProbeCount;)
+  {
+    // The last round probes the characters it can afford, spread evenly.
+    auto const roundProbeCount = std::min(characters.size(), MaxProbeCount - probeCount);
+    probeCount += roundProbeCount;
+    std::vector<std::string> probes;
+    for (size_t i = 0; i < roundProbeCount; ++i)
+    {
+      probes.emplace_back(prefix + characters[(i * characters.size()) / roundProbeCount]);
+    }
+
+    std::vector<Azure::Nullable<std::string>> firstKeys(probes.size());
+    RunConcurrently(
+        probes.size(),
+        concurrency,
+        context,
+        [&](size_t index, Core::Context const& probeContext) {
+          firstKeys[index] = GetFirstPartitionKey(probes[index], probeContext);
+        });
+    for (auto const& key : firstKeys)
+    {
+      if (key.HasValue())
+      {
+        sampledKeys.insert(key.Value());
+      }
+    }
+
+    if (sampledKeys.size() >= static_cast<size_t>(rangeCount) || sampledKeys.empty())
+    {
+      break;
+    }
+    auto const& first = *sampledKeys.begin();
+    auto const& last = *sampledKeys.rbegin();
+    size_t commonLength = 0;
+    while (commonLength < first.size() && commonLength < last.size()
+           && first[commonLength] == last[commonLength])
+    {
+      ++commonLength;
+    }
+    if (sampledKeys.size() == 1)
+    {
+      commonLength = std::min(commonLength, prefix.size() + 1);
+    }
+    if (commonLength <= prefix.size())
+    {
+      break;
+    }
+    prefix = first.substr(0, commonLength);
+  }
+
+  // The first range starts at the smallest key, which is not a split point.
+  std::vector<std::string> const keys(
+      sampledKeys.empty() ? sampledKeys.end() : std::next(sampledKeys.begin()),
+      sampledKeys.end());
+  std::vector<std::string> splitPoints;
+  auto const splitPointCount = std::min(keys.size(), static_cast<size_t>(rangeCount - 1));
+  for (size_t i = 0; i < splitPointCount; ++i)
+  {
+    splitPoints.push_back(keys[(i * keys.size()) / splitPointCount]);
+  }
+  return splitPoints;
+}
+
+void TableClient::QueryEntitiesParallel(
+    std::function<void(std::vector<Models::TableEntity> const&)> const& onEntities,
+    Models::ParallelQueryEntitiesOptions const& options,
+    Core::Context const& context) const
+{
+  if (options.Concurrency < 1)
+  {
+    throw std::invalid_argument("The query concurrency must be at least 1.");
+  }
+  if (!std::is_sorted(
+          options.PartitionKeySplitPoints.begin(), options.PartitionKeySplitPoints.end()))
+  {
+    throw std::invalid_argument("The partition key split points must be in ascending order.");
+  }
+
+  auto const splitPoints = !options.PartitionKeySplitPoints.empty() || options.RangeCount <= 1
+      ? options.PartitionKeySplitPoints
+      : SamplePartitionKeySplitPoints(options.RangeCount, options.Concurrency, context);
+
+  std::mutex callbackMutex;
+  RunConcurrently(
+      splitPoints.size() + 1,
+      options.Concurrency,
+      context,
+      [&](size_t range, Core::Context const& rangeContext) {
+        std::string filter;
+        if (range > 0)
+        {
+          filter = "PartitionKey ge " + QuoteODataString(splitPoints[range - 1]);
+        }
+        if (range < splitPoints.size())
+        {
+          filter += std::string(filter.empty() ? "" : " and ") + "PartitionKey lt "
+              + QuoteODataString(splitPoints[range]);
+        }
+
+        Models::QueryEntitiesOptions queryOptions;
+        queryOptions.SelectColumns = options.SelectColumns;
+        if (options.Filter.HasValue())
+        {
+          filter = filter.empty() ? options.Filter.Value()
+                                  : "(" + options.Filter.Value() + ") and " + filter;
+        }
+        if (!filter.empty())
+        {
+          queryOptions.Filter = filter;
+        }
+
+        for (auto page = QueryEntities(queryOptions, rangeContext); page.HasPage();
+             page.MoveToNextPage(rangeContext))
+        {
+          std::lock_guard<std::mutex> lock(callbackMutex);
+          onEntities(page.TableEntities);
+        }
+      });
+}
+
 Azure::Response<Models::SubmitTransactionResult> TableClient::SubmitTransaction(
     std::vector<Models::TransactionStep> const& steps,
     Core::Context const& context) const
 {
-  auto url = m_url;
-  url.AppendPath("$batch");
   std::string const batchId = "batch_" + Azure::Core::Uuid::CreateUuid().ToString();
   std::string const changesetId = "changeset_" + Azure::Core::Uuid::CreateUuid().ToString();
 
-  std::string const body = PreparePayload(batchId, changesetId, steps);
+  return SubmitTransactionPayload(
+      batchId, PreparePayload(batchId, changesetId, steps), context);
+}
+
+Azure::Response<Models::SubmitTransactionResult> TableClient::SubmitTransactionPayload(
+    std::string const& batchId,
+    std::string const& body,
+    Core::Context const& context) const
+{
+  auto url = m_url;
+  url.AppendPath("$batch");
   Core::IO::MemoryBodyStream requestBody(
       reinterpret_cast<std::uint8_t const*>(body.data()), body.length());
 
@@ -797,6 +1077,323 @@ Azure::Response<Models::SubmitTransactionResult> TableClient::SubmitTransaction(
   return Response<Models::SubmitTransactionResult>(std::move(response), std::move(rawResponse));
 }
 
+namespace {
+// The limits of the service for a single transaction.
+constexpr size_t MaxTransactionSteps = 100;
+// The payload is limited to 4 MiB, some of which is left for the batch envelope.
+constexpr size_t MaxTransactionPayloadSize = 4 * 1024 * 1024 - 4 * 1024;
+
+struct BulkTransaction final
+{
+  std::string ChangesetId;
+  std::vector<Models::TransactionStep> Steps;
+  std::vector<std::string> Payloads;
+  std::set<std::string> RowKeys;
+  size_t PayloadSize = 0;
+};
+
+// The service rejects a transaction with the index of the failed step at the start of the error
+// message, e.g. "1:The specified entity already exists.".
+bool TryParseFailedStepIndex(std::string const& message, size_t& index)
+{
+  auto const separator = message.find(':');
+  if (separator == 0 || separator == std::string::npos || separator > 3)
+  {
+    return false;
+  }
+  index = 0;
+  for (size_t i = 0; i < separator; ++i)
+  {
+    if (!std::isdigit(static_cast<unsigned char>(message[i])))
+    {
+      return false;
+    }
+    index = index * 10 + static_cast<size_t>(message[i] - '0');
+  }
+  return true;
+}
+} // namespace
+
+Models::BulkOperationResult TableClient::SubmitBulkOperation(
+    std::vector<Models::TransactionStep> const& steps,
+    Models::BulkOperationOptions const& options,
+    Core::Context const& context) const
+{
+  size_t next = 0;
+  return SubmitBulkOperation(
+      [&](Models::TransactionStep& step) {
+        if (next == steps.size())
+        {
+          return false;
+        }
+        step = steps[next++];
+        return true;
+      },
+      options,
+      context);
+}
+
+Models::BulkOperationResult TableClient::SubmitBulkOperation(
+    std::function<bool(Models::TransactionStep&)> const& getNextStep,
+    Models::BulkOperationOptions const& options,
+    Core::Context const& context) const
+{
+  if (options.Concurrency < 1)
+  {
+    throw std::invalid_argument("The bulk operation concurrency must be at least 1.");
+  }
+
+  Models::BulkOperationResult result;
+  std::mutex mutex;
+  std::condition_variable stateChanged;
+  std::deque<BulkTransaction> readyTransactions;
+  bool allStepsRead = false;
+  std::exception_ptr fatalError;
+
+  auto const addFailure = [&](Models::TransactionStep step,
+                              std::string statusCode,
+                              Models::TransactionError error) {
+    std::lock_guard<std::mutex> lock(mutex);
+    result.Failures.push_back({std::move(step), std::move(statusCode), std::move(error)});
+  };
+
+  // Submits a transaction until it succeeds, removing the steps reported as failed.
+  auto const submit = [&](BulkTransaction transaction) {
+    std::string const batchId = "batch_" + Azure::Core::Uuid::CreateUuid().ToString();
+    while (!transaction.Steps.empty())
+    {
+      std::string body = "--" + batchId
+          + "\nContent-Type: multipart/mixed; boundary=" + transaction.ChangesetId + "\n\n";
+      for (auto const& payload : transaction.Payloads)
+      {
+        body += payload;
+      }
+      body += "\n\n--" + transaction.ChangesetId + "--\n--" + batchId + "\n";
+
+      Models::SubmitTransactionResult response;
+      bool failed = true;
+      std::string failureStatusCode;
+      Models::TransactionError failureError;
+      try
+      {
+        response = SubmitTransactionPayload(batchId, body, context).Value;
+        failed = false;
+      }
+      catch (Core::Http::TransportException const& e)
+      {
+        // The transaction failed without a response, so that its status code is left empty.
+        failureError.Message = e.what();
+      }
+      catch (Core::RequestFailedException const& e)
+      {
+        failureStatusCode = std::to_string(static_cast<int>(e.StatusCode));
+        failureError = {e.Message, e.ErrorCode};
+      }
+      catch (Core::OperationCancelledException const&)
+      {
+        throw;
+      }
+      catch (std::exception const& e)
+      {
+        failureError.Message = e.what();
+      }
+      if (failed)
+      {
+        for (auto& step : transaction.Steps)
+        {
+          addFailure(std::move(step), failureStatusCode, failureError);
+        }
+        return;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++result.TransactionCount;
+        if (!response.Error.HasValue())
+        {
+          result.SucceededCount += static_cast<int64_t>(transaction.Steps.size());
+          return;
+        }
+      }
+
+      size_t failedIndex = 0;
+      if (!TryParseFailedStepIndex(response.Error.Value().Message, failedIndex)
+          || failedIndex >= transaction.Steps.size())
+      {
+        for (auto& step : transaction.Steps)
+        {
+          addFailure(std::move(step), response.StatusCode, response.Error.Value());
+        }
+        return;
+      }
+
+      // The transaction was rolled back, so that the other steps are submitted again.
+      addFailure(
+          std::move(transaction.Steps[failedIndex]),
+          response.StatusCode,
+          response.Error.Value());
+      transaction.Steps.erase(transaction.Steps.begin() + failedIndex);
+      transaction.Payloads.erase(transaction.Payloads.begin() + failedIndex);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  auto const stopWorkers = [&]() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      allStepsRead = true;
+    }
+    stateChanged.notify_all();
+    for (auto& worker : workers)
+    {
+      worker.join();
+    }
+    workers.clear();
+  };
+
+  for (int32_t i = 0; i < options.Concurrency; ++i)
+  {
+    workers.emplace_back([&]() {
+      while (true)
+      {
+        BulkTransaction transaction;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          stateChanged.wait(lock, [&]() {
+            return !readyTransactions.empty() || allStepsRead || fatalError;
+          });
+          if (fatalError || readyTransactions.empty())
+          {
+            return;
+          }
+          transaction = std::move(readyTransactions.front());
+          readyTransactions.pop_front();
+        }
+        // Unblocks the reader of the steps.
+        stateChanged.notify_all();
+
+        try
+        {
+          submit(std::move(transaction));
+        }
+        catch (...)
+        {
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!fatalError)
+            {
+              fatalError = std::current_exception();
+            }
+          }
+          stateChanged.notify_all();
+          return;
+        }
+      }
+    });
+  }
+
+  // Queues a transaction, waiting while enough transactions are queued to keep the workers busy.
+  auto const enqueue = [&](BulkTransaction& transaction) {
+    if (transaction.Steps.empty())
+    {
+      return;
+    }
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      stateChanged.wait(lock, [&]() {
+        return readyTransactions.size() < static_cast<size_t>(options.Concurrency) * 2
+            || fatalError;
+      });
+      if (fatalError)
+      {
+        return;
+      }
+      readyTransactions.push_back(std::move(transaction));
+    }
+    stateChanged.notify_all();
+    transaction = BulkTransaction{};
+  };
+
+  try
+  {
+    std::map<std::string, BulkTransaction> partitions;
+    int64_t bufferedSteps = 0;
+    Models::TransactionStep step;
+    while (getNextStep(step))
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (fatalError)
+        {
+          break;
+        }
+      }
+
+      auto& transaction = partitions[step.Entity.GetPartitionKey().Value];
+      if (transaction.Steps.empty())
+      {
+        transaction.ChangesetId = "changeset_" + Azure::Core::Uuid::CreateUuid().ToString();
+      }
+      std::string payload = PrepStep(transaction.ChangesetId, step);
+      if (!transaction.Steps.empty()
+          && (transaction.PayloadSize + payload.size() > MaxTransactionPayloadSize
+              || transaction.RowKeys.count(step.Entity.GetRowKey().Value) != 0))
+      {
+        bufferedSteps -= static_cast<int64_t>(transaction.Steps.size());
+        enqueue(transaction);
+        transaction.ChangesetId = "changeset_" + Azure::Core::Uuid::CreateUuid().ToString();
+        payload = PrepStep(transaction.ChangesetId, step);
+      }
+
+      transaction.RowKeys.insert(step.Entity.GetRowKey().Value);
+      transaction.PayloadSize += payload.size();
+      transaction.Payloads.push_back(std::move(payload));
+      transaction.Steps.push_back(std::move(step));
+      step = Models::TransactionStep{};
+      ++bufferedSteps;
+
+      if (transaction.Steps.size() == MaxTransactionSteps)
+      {
+        bufferedSteps -= static_cast<int64_t>(transaction.Steps.size());
+        enqueue(transaction);
+      }
+      else if (bufferedSteps >= options.MaxBufferedSteps)
+      {
+        for (auto& partition : partitions)
+        {
+          enqueue(partition.second);
+        }
+        partitions.clear();
+        bufferedSteps = 0;
+      }
+    }
+
+    for (auto& partition : partitions)
+    {
+      enqueue(partition.second);
+    }
+  }
+  catch (...)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!fatalError)
+      {
+        fatalError = std::current_exception();
+      }
+    }
+    stopWorkers();
+    throw;
+  }
+
+  stopWorkers();
+  if (fatalError)
+  {
+    std::rethrow_exception(fatalError);
+  }
+  return result;
+}
+
 std::string TableClient::PreparePayload(
     std::string const& batchId,
     std::string const& changesetId,
@@ -805,33 +1402,36 @@ std::string TableClient::PreparePayload(
   std::string accumulator
       = "--" + batchId + "\nContent-Type: multipart/mixed; boundary=" + changesetId + "\n\n";
 
-  for (auto step : steps)
+  for (auto const& step : steps)
   {
-    switch (step.Action)
-    {
-      case Models::TransactionActionType::Add:
-        accumulator += PrepAddEntity(changesetId, step.Entity);
-        break;
-      case Models::TransactionActionType::Delete:
-        accumulator += PrepDeleteEntity(changesetId, step.Entity);
-        break;
-      case Models::TransactionActionType::InsertMerge:
-      case Models::TransactionActionType::UpdateMerge:
-        accumulator += PrepMergeEntity(changesetId, step.Entity);
-        break;
-      case Models::TransactionActionType::InsertReplace:
-        accumulator += PrepInsertEntity(changesetId, step.Entity);
-        break;
-      case Models::TransactionActionType::UpdateReplace:
-        accumulator += PrepUpdateEntity(changesetId, step.Entity);
-        break;
-    }
+    accumulator += PrepStep(changesetId, step);
   }
 
   accumulator += "\n\n--" + changesetId + "--\n";
   accumulator += "--" + batchId + "\n";
   return accumulator;
 }
+
+std::string TableClient::PrepStep(
+    std::string const& changesetId,
+    Models::TransactionStep const& step) const
+{
+  switch (step.Action)
+  {
+    case Models::TransactionActionType::Add:
+      return PrepAddEntity(changesetId, step.Entity);
+    case Models::TransactionActionType::Delete:
+      return PrepDeleteEntity(changesetId, step.Entity);
+    case Models::TransactionActionType::InsertMerge:
+    case Models::TransactionActionType::UpdateMerge:
+      return PrepMergeEntity(changesetId, step.Entity);
+    case Models::TransactionActionType::InsertReplace:
+      return PrepInsertEntity(changesetId, step.Entity);
+    case Models::TransactionActionType::UpdateReplace:
+      return PrepUpdateEntity(changesetId, step.Entity);
+  }
+  return {};
+}
 std::string TableClient::PrepAddEntity(std::string const& changesetId, Models::TableEntity entity)
     const
 {
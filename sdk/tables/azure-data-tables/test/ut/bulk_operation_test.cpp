@@ -0,0 +1,294 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/data/tables/table_client.hpp"
+
+#include <azure/core/test/test_transport.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Azure::Data::Tables;
+using Azure::Core::Http::HttpStatusCode;
+using Azure::Core::Http::RawResponse;
+using Azure::Core::Http::Request;
+
+namespace Azure { namespace Data { namespace Test {
+  namespace {
+    struct SubmittedTransaction final
+    {
+      std::set<std::string> PartitionKeys;
+      std::vector<std::string> RowKeys;
+      size_t PayloadSize = 0;
+    };
+
+    // Accepts every transaction, except for the ones which have a step with the row key "fail",
+    // which are rejected the way the service does, the ones for the partition "bad", which fail
+    // with an HTTP error, and the ones for the partition "down", which fail without a response.
+    class TestTransactionTransport final : public Azure::Core::Test::TestTransport {
+      std::mutex m_mutex;
+      std::atomic<int> m_inFlight{0};
+
+      static std::string GetKey(std::string const& line, std::string const& name)
+      {
+        auto const start = line.find(name + "='");
+        if (start == std::string::npos)
+        {
+          return {};
+        }
+        auto const valueStart = start + name.size() + 2;
+        return line.substr(valueStart, line.find('\'', valueStart) - valueStart);
+      }
+
+    public:
+      std::vector<SubmittedTransaction> Transactions;
+      std::atomic<int> MaxInFlight{0};
+
+      std::unique_ptr<RawResponse> Send(Request& request, Azure::Core::Context const& context)
+          override
+      {
+        auto const inFlight = ++m_inFlight;
+        int maxInFlight = MaxInFlight;
+        while (inFlight > maxInFlight && !MaxInFlight.compare_exchange_weak(maxInFlight, inFlight))
+        {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+        auto const body = request.GetBodyStream()->ReadToEnd(context);
+        std::string const payload(body.begin(), body.end());
+        SubmittedTransaction transaction;
+        transaction.PayloadSize = payload.size();
+        size_t lineStart = 0;
+        while (lineStart < payload.size())
+        {
+          auto lineEnd = payload.find('\n', lineStart);
+          if (lineEnd == std::string::npos)
+          {
+            lineEnd = payload.size();
+          }
+          auto const line = payload.substr(lineStart, lineEnd - lineStart);
+          if (line.find(" HTTP/1.1") != std::string::npos)
+          {
+            transaction.PartitionKeys.insert(GetKey(line, "PartitionKey"));
+            transaction.RowKeys.push_back(GetKey(line, "RowKey"));
+          }
+          lineStart = lineEnd + 1;
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          Transactions.push_back(transaction);
+        }
+        --m_inFlight;
+
+        if (transaction.PartitionKeys.count("bad") != 0)
+        {
+          return CreateResponse(HttpStatusCode::BadRequest, {});
+        }
+        if (transaction.PartitionKeys.count("down") != 0)
+        {
+          throw Azure::Core::Http::TransportException("The connection was reset.");
+        }
+
+        std::string response = "--batchresponse_1\r\nContent-Type: multipart/mixed; "
+                               "boundary=changesetresponse_1\r\n\r\n";
+        auto const failed
+            = std::find(transaction.RowKeys.begin(), transaction.RowKeys.end(), "fail");
+        if (failed != transaction.RowKeys.end())
+        {
+          response += "--changesetresponse_1\r\nContent-Type: application/http\r\n\r\n"
+                      "HTTP/1.1 409 Conflict\r\nContent-Type: application/json\r\n\r\n"
+                      "{\"odata.error\":{\"code\":\"EntityAlreadyExists\",\"message\":{\"lang\":"
+                      "\"en-US\",\"value\":\""
+              + std::to_string(failed - transaction.RowKeys.begin())
+              + ":The specified entity already exists.\\nRequestId:1\"}}}\r\n";
+        }
+        else
+        {
+          for (size_t i = 0; i < transaction.RowKeys.size(); ++i)
+          {
+            response += "--changesetresponse_1\r\nContent-Type: application/http\r\n\r\n"
+                        "HTTP/1.1 204 No Content\r\n\r\n";
+          }
+        }
+        response += "--changesetresponse_1--\r\n--batchresponse_1--\r\n";
+        return CreateResponse(HttpStatusCode::Accepted, std::move(response));
+      }
+    };
+
+    TableClient CreateClient(std::shared_ptr<TestTransactionTransport> transport)
+    {
+      TableClientOptions options;
+      options.Retry.MaxRetries = 0;
+      options.Transport.Transport = transport;
+      return TableClient("https://account.table.core.windows.net", "table", options);
+    }
+
+    Models::TransactionStep CreateStep(
+        std::string const& partitionKey,
+        std::string const& rowKey,
+        std::string const& value = {})
+    {
+      Models::TableEntity entity;
+      entity.SetPartitionKey(partitionKey);
+      entity.SetRowKey(rowKey);
+      if (!value.empty())
+      {
+        entity.Properties["Value"] = Models::TableEntityProperty(value);
+      }
+      return {Models::TransactionActionType::InsertMerge, entity};
+    }
+  } // namespace
+
+  TEST(BulkOperationTest, GroupsByPartition)
+  {
+    auto transport = std::make_shared<TestTransactionTransport>();
+    std::vector<Models::TransactionStep> steps;
+    for (int i = 0; i < 250; ++i)
+    {
+      steps.push_back(CreateStep(i % 10 == 0 ? "b" : "a", std::to_string(i)));
+    }
+
+    auto const result = CreateClient(transport).SubmitBulkOperation(steps);
+
+    EXPECT_EQ(result.SucceededCount, 250);
+    EXPECT_TRUE(result.Failures.empty());
+    // 225 steps for "a" and 25 for "b".
+    EXPECT_EQ(result.TransactionCount, 4);
+    ASSERT_EQ(transport->Transactions.size(), 4u);
+    size_t steps100 = 0;
+    for (auto const& transaction : transport->Transactions)
+    {
+      EXPECT_EQ(transaction.PartitionKeys.size(), 1u);
+      EXPECT_LE(transaction.RowKeys.size(), 100u);
+      steps100 += transaction.RowKeys.size() == 100 ? 1 : 0;
+    }
+    EXPECT_EQ(steps100, 2u);
+  }
+
+  TEST(BulkOperationTest, RepeatedEntity)
+  {
+    auto transport = std::make_shared<TestTransactionTransport>();
+
+    auto const result = CreateClient(transport).SubmitBulkOperation(
+        std::vector<Models::TransactionStep>(3, CreateStep("a", "0")));
+
+    // The same entity is never repeated in a transaction.
+    EXPECT_EQ(result.SucceededCount, 3);
+    EXPECT_EQ(transport->Transactions.size(), 3u);
+  }
+
+  TEST(BulkOperationTest, PayloadSizeLimit)
+  {
+    auto transport = std::make_shared<TestTransactionTransport>();
+    std::string const value(100 * 1024, 'x');
+
+    int next = 0;
+    auto const result = CreateClient(transport).SubmitBulkOperation(
+        [&](Models::TransactionStep& step) {
+          if (next == 50)
+          {
+            return false;
+          }
+          step = CreateStep("a", std::to_string(next++), value);
+          return true;
+        });
+
+    EXPECT_EQ(result.SucceededCount, 50);
+    EXPECT_EQ(transport->Transactions.size(), 2u);
+    for (auto const& transaction : transport->Transactions)
+    {
+      EXPECT_LE(transaction.PayloadSize, 4u * 1024 * 1024);
+    }
+  }
+
+  TEST(BulkOperationTest, FailedStepIsReported)
+  {
+    auto transport = std::make_shared<TestTransactionTransport>();
+    std::vector<Models::TransactionStep> steps{
+        CreateStep("a", "0"),
+        CreateStep("a", "1"),
+        CreateStep("a", "fail"),
+        CreateStep("a", "3"),
+        CreateStep("bad", "0"),
+        CreateStep("bad", "1"),
+        CreateStep("down", "0"),
+        CreateStep("down", "1"),
+    };
+
+    auto const result = CreateClient(transport).SubmitBulkOperation(steps);
+
+    EXPECT_EQ(result.SucceededCount, 3);
+    ASSERT_EQ(result.Failures.size(), 5u);
+    // The transaction with the failed step is submitted again without it.
+    EXPECT_EQ(transport->Transactions.size(), 4u);
+    for (auto const& failure : result.Failures)
+    {
+      if (failure.Step.Entity.GetPartitionKey().Value == "a")
+      {
+        EXPECT_EQ(failure.Step.Entity.GetRowKey().Value, "fail");
+        EXPECT_EQ(failure.StatusCode, "409");
+        EXPECT_EQ(failure.Error.Code, "EntityAlreadyExists");
+      }
+      else if (failure.Step.Entity.GetPartitionKey().Value == "down")
+      {
+        EXPECT_TRUE(failure.StatusCode.empty());
+        EXPECT_EQ(failure.Error.Message, "The connection was reset.");
+      }
+      else
+      {
+        EXPECT_EQ(failure.StatusCode, "400");
+      }
+    }
+  }
+
+  TEST(BulkOperationTest, Concurrency)
+  {
+    auto transport = std::make_shared<TestTransactionTransport>();
+    std::vector<Models::TransactionStep> steps;
+    for (int i = 0; i < 40; ++i)
+    {
+      steps.push_back(CreateStep(std::to_string(i), "0"));
+    }
+    Models::BulkOperationOptions options;
+    options.Concurrency = 3;
+    options.MaxBufferedSteps = 10;
+
+    auto const result = CreateClient(transport).SubmitBulkOperation(steps, options);
+
+    EXPECT_EQ(result.SucceededCount, 40);
+    EXPECT_EQ(result.TransactionCount, 40);
+    EXPECT_LE(transport->MaxInFlight, 3);
+
+    options.Concurrency = 0;
+    EXPECT_THROW(
+        CreateClient(transport).SubmitBulkOperation(steps, options), std::invalid_argument);
+  }
+
+  TEST(BulkOperationTest, StepReaderException)
+  {
+    auto transport = std::make_shared<TestTransactionTransport>();
+    int next = 0;
+    EXPECT_THROW(
+        CreateClient(transport).SubmitBulkOperation([&](Models::TransactionStep& step) {
+          if (next == 150)
+          {
+            throw std::runtime_error("Failed to read the steps.");
+          }
+          step = CreateStep("a", std::to_string(next++));
+          return true;
+        }),
+        std::runtime_error);
+  }
+}}} // namespace Azure::Data::Test
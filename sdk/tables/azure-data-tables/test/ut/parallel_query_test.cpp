@@ -0,0 +1,325 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/data/tables/table_client.hpp"
+
+#include <azure/core/test/test_transport.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Azure::Data::Tables;
+using Azure::Core::Url;
+using Azure::Core::Http::HttpStatusCode;
+using Azure::Core::Http::RawResponse;
+using Azure::Core::Http::Request;
+
+namespace Azure { namespace Data { namespace Test {
+  namespace {
+    // Serves the entities of a table in pages of 3, applying the partition key ranges of the
+    // filter and ignoring its other conditions. The queries starting at BlockingLowerBound wait
+    // for their context to be cancelled.
+    class TestQueryTransport final : public Azure::Core::Test::TestTransport {
+      std::mutex m_mutex;
+
+      static std::vector<std::string> GetBounds(std::string const& filter, std::string const& op)
+      {
+        std::vector<std::string> bounds;
+        std::string const prefix = "PartitionKey " + op + " '";
+        for (auto start = filter.find(prefix); start != std::string::npos;
+             start = filter.find(prefix, start + 1))
+        {
+          std::string bound;
+          for (auto i = start + prefix.size(); i < filter.size(); ++i)
+          {
+            if (filter[i] == '\'' && (i + 1 == filter.size() || filter[i + 1] != '\''))
+            {
+              break;
+            }
+            bound += filter[i];
+            i += filter[i] == '\'' ? 1 : 0;
+          }
+          bounds.push_back(bound);
+        }
+        return bounds;
+      }
+
+      static std::string GetQueryParameter(Request const& request, std::string const& name)
+      {
+        auto const parameters = request.GetUrl().GetQueryParameters();
+        auto const parameter = parameters.find(name);
+        return parameter == parameters.end() ? "" : Url::Decode(parameter->second);
+      }
+
+    public:
+      // Sorted partition and row keys.
+      std::vector<std::pair<std::string, std::string>> Entities;
+      std::vector<std::string> Filters;
+      std::vector<std::string> Selects;
+      size_t ProbeCount = 0;
+      std::string BlockingLowerBound;
+      std::atomic<bool> Blocking{false};
+      bool ObservedCancellation = false;
+
+      std::unique_ptr<RawResponse> Send(Request& request, Azure::Core::Context const& context)
+          override
+      {
+        auto const filter = GetQueryParameter(request, "$filter");
+        auto const top = GetQueryParameter(request, "$top");
+        auto const lowerBounds = GetBounds(filter, "ge");
+        if (!BlockingLowerBound.empty() && lowerBounds.size() == 1
+            && lowerBounds[0] == BlockingLowerBound)
+        {
+          Blocking = true;
+          auto const timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+          while (!context.IsCancelled() && std::chrono::steady_clock::now() < timeout)
+          {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          }
+          std::lock_guard<std::mutex> lock(m_mutex);
+          ObservedCancellation = context.IsCancelled();
+          context.ThrowIfCancelled();
+        }
+        auto const upperBounds = GetBounds(filter, "lt");
+        std::pair<std::string, std::string> const next{
+            GetQueryParameter(request, "NextPartitionKey"),
+            GetQueryParameter(request, "NextRowKey")};
+
+        size_t const pageSize = top.empty() ? 3 : std::min<size_t>(3, std::stoul(top));
+        std::string values;
+        size_t count = 0;
+        auto entity = std::lower_bound(Entities.begin(), Entities.end(), next);
+        for (; entity != Entities.end(); ++entity)
+        {
+          bool const inRange = std::all_of(
+                                   lowerBounds.begin(),
+                                   lowerBounds.end(),
+                                   [&](std::string const& b) { return entity->first >= b; })
+              && std::all_of(upperBounds.begin(), upperBounds.end(), [&](std::string const& b) {
+                                 return entity->first < b;
+                               });
+          if (!inRange)
+          {
+            continue;
+          }
+          if (count == pageSize)
+          {
+            break;
+          }
+          values += std::string(count == 0 ? "" : ",") + "{\"PartitionKey\":\"" + entity->first
+              + "\",\"RowKey\":\"" + entity->second + "\"}";
+          ++count;
+        }
+
+        auto response = CreateResponse(HttpStatusCode::Ok, "{\"value\":[" + values + "]}");
+        if (entity != Entities.end() && top.empty())
+        {
+          response->SetHeader("x-ms-continuation-NextPartitionKey", entity->first);
+          response->SetHeader("x-ms-continuation-NextRowKey", entity->second);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (top.empty())
+        {
+          Filters.push_back(filter);
+          Selects.push_back(GetQueryParameter(request, "$select"));
+        }
+        else
+        {
+          ++ProbeCount;
+        }
+        return response;
+      }
+    };
+
+    std::shared_ptr<TestQueryTransport> CreateTransport()
+    {
+      auto transport = std::make_shared<TestQueryTransport>();
+      for (char partition = 'a'; partition <= 'z'; ++partition)
+      {
+        for (int row = 0; row < 4; ++row)
+        {
+          transport->Entities.emplace_back(std::string("p") + partition, std::to_string(row));
+        }
+      }
+      return transport;
+    }
+
+    TableClient CreateClient(std::shared_ptr<TestQueryTransport> transport)
+    {
+      TableClientOptions options;
+      options.Retry.MaxRetries = 0;
+      options.Transport.Transport = transport;
+      return TableClient("https://account.table.core.windows.net", "table", options);
+    }
+
+    std::vector<std::pair<std::string, std::string>> QueryAll(
+        std::shared_ptr<TestQueryTransport> transport,
+        Models::ParallelQueryEntitiesOptions const& options)
+    {
+      std::vector<std::pair<std::string, std::string>> entities;
+      CreateClient(transport).QueryEntitiesParallel(
+          [&](std::vector<Models::TableEntity> const& page) {
+            for (auto const& entity : page)
+            {
+              entities.emplace_back(
+                  entity.GetPartitionKey().Value, entity.GetRowKey().Value);
+            }
+          },
+          options);
+      std::sort(entities.begin(), entities.end());
+      return entities;
+    }
+  } // namespace
+
+  TEST(ParallelQueryTest, SplitPoints)
+  {
+    auto transport = CreateTransport();
+    Models::ParallelQueryEntitiesOptions options;
+    options.PartitionKeySplitPoints = {"pf", "pm'"};
+    options.SelectColumns = "PartitionKey,RowKey";
+    options.Filter = "Value eq 1";
+
+    EXPECT_EQ(QueryAll(transport, options), transport->Entities);
+
+    EXPECT_NE(
+        std::find(
+            transport->Filters.begin(),
+            transport->Filters.end(),
+            "(Value eq 1) and PartitionKey lt 'pf'"),
+        transport->Filters.end());
+    EXPECT_NE(
+        std::find(
+            transport->Filters.begin(),
+            transport->Filters.end(),
+            "(Value eq 1) and PartitionKey ge 'pf' and PartitionKey lt 'pm'''"),
+        transport->Filters.end());
+    EXPECT_NE(
+        std::find(
+            transport->Filters.begin(),
+            transport->Filters.end(),
+            "(Value eq 1) and PartitionKey ge 'pm'''"),
+        transport->Filters.end());
+    for (auto const& select : transport->Selects)
+    {
+      EXPECT_EQ(select, "PartitionKey,RowKey");
+    }
+  }
+
+  TEST(ParallelQueryTest, SampledSplitPoints)
+  {
+    auto transport = CreateTransport();
+    Models::ParallelQueryEntitiesOptions options;
+    options.RangeCount = 4;
+
+    EXPECT_EQ(QueryAll(transport, options), transport->Entities);
+
+    std::vector<std::string> filters(transport->Filters);
+    std::sort(filters.begin(), filters.end());
+    filters.erase(std::unique(filters.begin(), filters.end()), filters.end());
+    EXPECT_NE(
+        std::find(filters.begin(), filters.end(), "PartitionKey ge 'pj' and PartitionKey lt 'pr'"),
+        filters.end());
+    EXPECT_EQ(filters.size(), 4u);
+  }
+
+  TEST(ParallelQueryTest, SampledSplitPointsProbeLimit)
+  {
+    // Every key has a long common prefix, so that each round of probes only grows the prefix.
+    auto transport = std::make_shared<TestQueryTransport>();
+    std::string const commonPrefix(100, 'k');
+    for (char partition = 'a'; partition <= 'z'; ++partition)
+    {
+      transport->Entities.emplace_back(commonPrefix + partition, "0");
+    }
+    Models::ParallelQueryEntitiesOptions options;
+    options.RangeCount = 4;
+
+    EXPECT_EQ(QueryAll(transport, options), transport->Entities);
+    EXPECT_LE(transport->ProbeCount, 256u);
+
+    transport->ProbeCount = 0;
+    options.RangeCount = 1000;
+    EXPECT_EQ(QueryAll(transport, options), transport->Entities);
+    EXPECT_LE(transport->ProbeCount, 256u);
+  }
+
+  TEST(ParallelQueryTest, SingleRange)
+  {
+    auto transport = CreateTransport();
+    Models::ParallelQueryEntitiesOptions options;
+    options.RangeCount = 1;
+
+    EXPECT_EQ(QueryAll(transport, options), transport->Entities);
+    for (auto const& filter : transport->Filters)
+    {
+      EXPECT_TRUE(filter.empty());
+    }
+  }
+
+  TEST(ParallelQueryTest, CallbackException)
+  {
+    auto transport = CreateTransport();
+    Models::ParallelQueryEntitiesOptions options;
+    options.PartitionKeySplitPoints = {"pf", "pm"};
+
+    EXPECT_THROW(
+        CreateClient(transport).QueryEntitiesParallel(
+            [](std::vector<Models::TableEntity> const&) {
+              throw std::runtime_error("Failed to process the entities.");
+            },
+            options),
+        std::runtime_error);
+  }
+
+  TEST(ParallelQueryTest, ExceptionCancelsOtherRanges)
+  {
+    auto transport = CreateTransport();
+    transport->BlockingLowerBound = "pm";
+    Models::ParallelQueryEntitiesOptions options;
+    options.PartitionKeySplitPoints = {"pm"};
+    options.Concurrency = 2;
+
+    EXPECT_THROW(
+        CreateClient(transport).QueryEntitiesParallel(
+            [&](std::vector<Models::TableEntity> const&) {
+              // Fails once the query of the other range is in progress.
+              while (!transport->Blocking)
+              {
+                std::this_thread::yield();
+              }
+              throw std::runtime_error("Failed to process the entities.");
+            },
+            options),
+        std::runtime_error);
+    EXPECT_TRUE(transport->ObservedCancellation);
+  }
+
+  TEST(ParallelQueryTest, InvalidOptions)
+  {
+    auto transport = CreateTransport();
+    Models::ParallelQueryEntitiesOptions options;
+    options.PartitionKeySplitPoints = {"pm", "pf"};
+    EXPECT_THROW(
+        CreateClient(transport).QueryEntitiesParallel(
+            [](std::vector<Models::TableEntity> const&) {}, options),
+        std::invalid_argument);
+
+    options.PartitionKeySplitPoints.clear();
+    options.Concurrency = 0;
+    EXPECT_THROW(
+        CreateClient(transport).QueryEntitiesParallel(
+            [](std::vector<Models::TableEntity> const&) {}, options),
+        std::invalid_argument);
+  }
+}}} // namespace Azure::Data::Test